@@ -0,0 +1,163 @@
+#include "benchmark/benchmark_api.h"
+#include "netlist/nl_base.h"
+
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Replays netlist event queue traces through the linear and calendar
+// queues.  The traces keep a fixed number of events pending, popping the
+// earliest and scheduling its net again 10-60ns later, with the occasional
+// reschedule and a top() before every pop like the main clock loop.  The
+// argument is the number of pending events; TTL netlists such as pong keep
+// only a handful.
+
+namespace {
+
+using netlist::netlist_time;
+
+struct bench_net { };
+using bench_entry = netlist::pqentry_t<const bench_net *, netlist_time>;
+
+class event_trace
+{
+public:
+	enum op_t : std::uint32_t
+	{
+		PUSH,
+		POP,
+		TOP,
+		REMOVE,
+		RETIME
+	};
+
+	static constexpr const std::uint32_t NO_NET = ~static_cast<std::uint32_t>(0);
+
+	// build a trace keeping the given number of events pending
+	void generate(std::size_t depth, std::size_t events)
+	{
+		std::mt19937 rng(1234);
+		std::uniform_int_distribution<netlist_time::internal_type> delay(netlist_time::from_nsec(10).as_raw(), netlist_time::from_nsec(60).as_raw());
+		std::uniform_int_distribution<std::size_t> pick(0, depth - 1);
+		std::uniform_int_distribution<unsigned> chance(0, 99);
+
+		std::set<std::pair<netlist_time::internal_type, std::uint32_t>> pending;
+		std::vector<netlist_time::internal_type> scheduled(depth);
+		for (std::uint32_t net = 0; net < depth; net++)
+		{
+			scheduled[net] = delay(rng);
+			pending.emplace(scheduled[net], net);
+			add(PUSH, net, scheduled[net]);
+		}
+		for (std::size_t event = 0; event < events; event++)
+		{
+			add(TOP, NO_NET, 0);
+			add(POP, NO_NET, 0);
+			const auto now(*pending.begin());
+			pending.erase(pending.begin());
+
+			// occasionally an input change moves another pending event
+			if (chance(rng) == 0)
+			{
+				const auto net(static_cast<std::uint32_t>(pick(rng)));
+				if (net != now.second)
+				{
+					add(REMOVE, net, scheduled[net]);
+					pending.erase(std::make_pair(scheduled[net], net));
+					scheduled[net] = now.first + delay(rng);
+					pending.emplace(scheduled[net], net);
+					add(PUSH, net, scheduled[net]);
+				}
+			}
+
+			scheduled[now.second] = now.first + delay(rng);
+			pending.emplace(scheduled[now.second], now.second);
+			add(PUSH, now.second, scheduled[now.second]);
+		}
+		resolve();
+	}
+
+	template <typename Queue>
+	std::size_t replay(Queue &queue) const
+	{
+		std::size_t result = 0;
+		queue.clear();
+		for (const record &r : m_records)
+		{
+			switch (r.op)
+			{
+			case PUSH:   queue.push(bench_entry(r.time, r.net)); break;
+			case POP:    result += reinterpret_cast<std::uintptr_t>(queue.pop().m_object); break;
+			case TOP:    result += queue.top().m_exec_time.as_raw(); break;
+			case REMOVE: queue.remove(bench_entry(r.time, r.net)); break;
+			case RETIME: queue.retime(bench_entry(r.time, r.net)); break;
+			}
+		}
+		return result;
+	}
+
+	std::size_t size() const { return m_records.size(); }
+
+private:
+	struct record
+	{
+		std::uint32_t       op;
+		std::uint32_t       index;
+		netlist_time        time;
+		const bench_net *   net;
+	};
+
+	void add(std::uint32_t op, std::uint32_t net, netlist_time::internal_type time)
+	{
+		m_records.push_back(record{ op, net, netlist_time::from_raw(time), nullptr });
+	}
+
+	// give each net an object to point at once they are all known
+	void resolve()
+	{
+		std::uint32_t nets = 0;
+		for (const record &r : m_records)
+			if (r.index != NO_NET && r.index >= nets)
+				nets = r.index + 1;
+		m_nets.resize(nets);
+		for (record &r : m_records)
+			r.net = (r.index == NO_NET) ? nullptr : &m_nets[r.index];
+	}
+
+	std::vector<bench_net> m_nets;
+	std::vector<record> m_records;
+};
+
+
+template <typename Queue>
+void run_trace(benchmark::State &state, const event_trace &trace)
+{
+	Queue queue(512);
+	std::size_t result = 0;
+	while (state.KeepRunning())
+		result += trace.replay(queue);
+	benchmark::DoNotOptimize(result);
+	state.SetItemsProcessed(state.iterations() * trace.size());
+}
+
+template <typename Queue>
+void run_synthetic(benchmark::State &state)
+{
+	event_trace trace;
+	trace.generate(state.range(0), 100000);
+	run_trace<Queue>(state, trace);
+}
+
+using linear_queue = netlist::timed_queue_linear<bench_entry, false, false>;
+using calendar_queue = netlist::timed_queue_calendar<bench_entry, false, false>;
+
+} // anonymous namespace
+
+
+static void BM_nlqueue_synthetic_linear(benchmark::State &state) { run_synthetic<linear_queue>(state); }
+static void BM_nlqueue_synthetic_calendar(benchmark::State &state) { run_synthetic<calendar_queue>(state); }
+
+// Register the functions as benchmarks
+BENCHMARK(BM_nlqueue_synthetic_linear)->Arg(4)->Arg(32)->Arg(48)->Arg(64)->Arg(96)->Arg(256);
+BENCHMARK(BM_nlqueue_synthetic_calendar)->Arg(4)->Arg(32)->Arg(48)->Arg(64)->Arg(96)->Arg(256);
@@ -0,0 +1,573 @@
+#include "benchmark/benchmark_api.h"
+#include "emu.h"
+#include "video/poly.h"
+#include "video/tc0780fpa.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+extern int osd_num_processors;
+
+// Replays polygon streams through poly_manager.  Streams are captured from a
+// running system with "-polycapture <file>" (and "-polycapture_frames") and
+// listed in the POLY_CAPTURES environment variable, separated by ';'.
+//
+// Streams from the Taito TC0780FPA (taitotz) are replayed through its own
+// scanline functions, with the object data and texture RAM they were drawn
+// with, and draw the same frames as the running system did.  Other drivers'
+// rasterizers need their whole device to run, so their streams measure
+// poly_manager's setup, binning and threading only: every primitive is drawn
+// by the same z-buffered Gouraud scanline function, which depth tests on the
+// first parameter and shades from up to three more.  Drivers whose scanline
+// functions do much more per pixel (texturing, fog, blending) will scale
+// differently, hence the "gouraud" in those benchmark names.
+//
+// The synthetic stream is frames of small triangles scattered over a 640x480
+// screen, the argument after the thread count being their size.  The first
+// argument is the number of threads, the second selects tile binning;
+// items/s is pixels per second.
+//
+// Each run is labelled with the speedup the bins allow at that thread count:
+// a frame takes at least as long as its busiest bin, whose work is ordered,
+// or its total work spread over the threads.  This counts the pixels of an
+// untimed single-threaded Gouraud replay, so it's the same on any host.
+
+namespace {
+
+const int REPLAY_PARAMS = 16;
+const int REPLAY_POLYS = 10000;
+
+// parameters the scanline function may read
+struct replay_object { int paramcount; };
+
+
+class poly_stream
+{
+public:
+	// read a stream written by poly_manager::capture_start
+	bool load(const std::string &filename)
+	{
+		std::ifstream file(filename, std::ios::binary);
+		if (!file.read(reinterpret_cast<char *>(&m_header), sizeof(m_header)) || m_header.magic != poly_capture::MAGIC)
+			return false;
+
+		poly_capture::primitive record;
+		while (file.read(reinterpret_cast<char *>(&record), sizeof(record)))
+		{
+			std::size_t length = 0;
+			switch (record.type)
+			{
+			case poly_capture::TILE:
+			case poly_capture::TRIANGLE:
+			case poly_capture::POLYGON:  length = record.count * (2 + record.paramcount) * m_header.basesize; break;
+			case poly_capture::CUSTOM:   length = record.count * (2 * sizeof(s32) + 2 * m_header.maxparams * m_header.basesize); break;
+			case poly_capture::CALLBACK:
+			case poly_capture::OBJECT:
+			case poly_capture::DATA:     length = record.count; break;
+			}
+			std::vector<u8> data(length);
+			if (length != 0 && !file.read(reinterpret_cast<char *>(&data[0]), length))
+				break;
+
+			// callbacks are looked up by name once, before replaying
+			if (record.type == poly_capture::CALLBACK)
+			{
+				m_callbacks.resize(std::max<std::size_t>(m_callbacks.size(), record.id + 1));
+				m_callbacks[record.id].assign(data.begin(), data.end());
+			}
+			else
+				add(record, data);
+		}
+		return !m_records.empty();
+	}
+
+	// frames of triangles of about the given size, with z and three colour parameters
+	void generate(int size, int frames, int triangles)
+	{
+		m_header.magic = poly_capture::MAGIC;
+		m_header.basesize = sizeof(float);
+		m_header.basefloat = 1;
+		m_header.maxparams = 0;
+		m_header.objectsize = 0;
+		m_header.flags = 0;
+		m_callbacks.assign(1, std::string());
+
+		u32 seed = 0x13579bdf;
+		auto random = [&seed] (float range) { seed = seed * 1103515245 + 12345; return float((seed >> 8) & 0xffff) * range / 65536.0f; };
+		for (int frame = 0; frame < frames; frame++)
+		{
+			add(primitive(poly_capture::FRAME, 0), std::vector<u8>());
+			for (int triangle = 0; triangle < triangles; triangle++)
+			{
+				const float x = random(640.0f - size), y = random(480.0f - size);
+				std::vector<float> vertices;
+				for (int vertex = 0; vertex < 3; vertex++)
+				{
+					vertices.push_back(x + random(size));
+					vertices.push_back(y + random(size));
+					vertices.push_back(random(1.0f));
+					for (int param = 1; param < 4; param++)
+						vertices.push_back(random(255.0f));
+				}
+				poly_capture::primitive record(primitive(poly_capture::TRIANGLE, 4));
+				record.count = 3;
+				add(record, std::vector<u8>(reinterpret_cast<u8 *>(&vertices[0]), reinterpret_cast<u8 *>(&vertices[0] + vertices.size())));
+			}
+		}
+	}
+
+	bool is_float() const { return m_header.basefloat && m_header.basesize == sizeof(float); }
+	bool is_double() const { return m_header.basefloat && m_header.basesize == sizeof(double); }
+	u32 object_size() const { return m_header.objectsize; }
+	const std::vector<std::string> &callbacks() const { return m_callbacks; }
+	int width() const { return m_width; }
+	int height() const { return m_height; }
+
+	template <typename Renderer>
+	u64 replay(Renderer &renderer) const
+	{
+		using base_type = typename Renderer::base_type;
+		using vertex_t = typename Renderer::vertex_t;
+		using extent_t = typename Renderer::extent_t;
+		using render_delegate = typename Renderer::render_delegate;
+
+		std::vector<render_delegate> callbacks;
+		for (const std::string &name : m_callbacks)
+			callbacks.push_back(renderer.callback(name));
+
+		u64 pixels = 0;
+		vertex_t vertices[8];
+		std::vector<extent_t> extents;
+		for (const record &r : m_records)
+		{
+			const u8 *data = &m_data[r.data];
+			const int paramcount = std::min(r.paramcount, REPLAY_PARAMS);
+			const render_delegate callback = (r.type >= poly_capture::TILE && r.type <= poly_capture::CUSTOM) ? callbacks[r.id] : render_delegate();
+
+			switch (r.type)
+			{
+			case poly_capture::FRAME:
+				renderer.wait("frame");
+				break;
+
+			case poly_capture::OBJECT:
+				renderer.object(data, r.count);
+				break;
+
+			case poly_capture::DATA:
+				renderer.data(r.id, data, r.count);
+				break;
+
+			case poly_capture::TILE:
+			case poly_capture::TRIANGLE:
+			case poly_capture::POLYGON:
+				renderer.parameters(paramcount);
+				for (int vertnum = 0; vertnum < std::min(r.count, 8); vertnum++)
+				{
+					const base_type *values = reinterpret_cast<const base_type *>(data) + vertnum * (2 + r.paramcount);
+					vertices[vertnum].x = values[0];
+					vertices[vertnum].y = values[1];
+					for (int paramnum = 0; paramnum < paramcount; paramnum++)
+						vertices[vertnum].p[paramnum] = values[2 + paramnum];
+				}
+				if (r.type == poly_capture::TILE)
+					pixels += renderer.render_tile(r.clip, callback, paramcount, vertices[0], vertices[1]);
+				else if (r.type == poly_capture::TRIANGLE)
+					pixels += renderer.render_triangle(r.clip, callback, paramcount, vertices[0], vertices[1], vertices[2]);
+				else
+					pixels += render_polygon(renderer, r, callback, paramcount, vertices);
+				break;
+
+			case poly_capture::CUSTOM:
+				// custom extents don't say which parameters the driver filled in
+				renderer.parameters(0);
+				extents.resize(r.count);
+				for (int extnum = 0; extnum < r.count; extnum++)
+				{
+					s32 x[2];
+					memcpy(x, data, sizeof(x));
+					data += sizeof(x);
+					extents[extnum].startx = x[0];
+					extents[extnum].stopx = x[1];
+					extents[extnum].userdata = nullptr;
+					const base_type *values = reinterpret_cast<const base_type *>(data);
+					for (int paramnum = 0; paramnum < paramcount; paramnum++)
+					{
+						extents[extnum].param[paramnum].start = values[2 * paramnum];
+						extents[extnum].param[paramnum].dpdx = values[2 * paramnum + 1];
+					}
+					data += 2 * m_header.maxparams * sizeof(base_type);
+				}
+				pixels += renderer.render_triangle_custom(r.clip, callback, r.startscanline, r.count, &extents[0]);
+				break;
+			}
+		}
+		renderer.wait("end");
+		return pixels;
+	}
+
+private:
+	struct record
+	{
+		u32         type;
+		u32         id;
+		rectangle   clip;
+		int         paramcount;
+		int         count;
+		int         startscanline;
+		std::size_t data;
+	};
+
+	static poly_capture::primitive primitive(u32 type, int paramcount)
+	{
+		poly_capture::primitive result = {};
+		result.type = type;
+		result.clip[1] = 639;
+		result.clip[3] = 479;
+		result.paramcount = paramcount;
+		return result;
+	}
+
+	void add(const poly_capture::primitive &primitive, const std::vector<u8> &data)
+	{
+		record r;
+		r.type = primitive.type;
+		r.id = primitive.id;
+		r.clip.set(std::max(primitive.clip[0], 0), primitive.clip[1], std::max(primitive.clip[2], 0), primitive.clip[3]);
+		r.paramcount = primitive.paramcount;
+		r.count = primitive.count;
+		r.startscanline = primitive.startscanline;
+		r.data = m_data.size();
+		m_data.insert(m_data.end(), data.begin(), data.end());
+		m_data.resize(m_data.size() + 16);  // keep a valid pointer for empty payloads, and align the next
+		m_data.resize((m_data.size() + 15) & ~15);
+		m_records.push_back(r);
+
+		if (r.type >= poly_capture::TILE && r.type <= poly_capture::CUSTOM)
+		{
+			m_callbacks.resize(std::max<std::size_t>(m_callbacks.size(), r.id + 1));
+			m_width = std::max(m_width, r.clip.right() + 1);
+			m_height = std::max(m_height, r.clip.bottom() + 1);
+		}
+	}
+
+	// render_polygon takes the vertex count as a template argument
+	template <typename Renderer>
+	static u32 render_polygon(Renderer &renderer, const record &r, const typename Renderer::render_delegate &callback, int paramcount, const typename Renderer::vertex_t *vertices)
+	{
+		switch (r.count)
+		{
+		case 3: return renderer.template render_polygon<3>(r.clip, callback, paramcount, vertices);
+		case 4: return renderer.template render_polygon<4>(r.clip, callback, paramcount, vertices);
+		case 5: return renderer.template render_polygon<5>(r.clip, callback, paramcount, vertices);
+		case 6: return renderer.template render_polygon<6>(r.clip, callback, paramcount, vertices);
+		case 7: return renderer.template render_polygon<7>(r.clip, callback, paramcount, vertices);
+		case 8: return renderer.template render_polygon<8>(r.clip, callback, paramcount, vertices);
+		default: return 0;
+		}
+	}
+
+	poly_capture::header m_header;
+	std::vector<std::string> m_callbacks;
+	std::vector<record> m_records;
+	std::vector<u8> m_data;
+	int m_width = 1;
+	int m_height = 1;
+};
+
+
+// pixels drawn in each bin of every frame
+class bin_load
+{
+public:
+	bin_load(bool tiled) : m_tiled(tiled) { }
+
+	void add(s32 scanline, s32 startx, s32 pixels)
+	{
+		const s32 column = m_tiled ? (startx / TILE_WIDTH) : 0;
+		m_bins[std::make_pair(scanline / SCANLINES_PER_BUCKET, column)] += pixels;
+	}
+
+	void frame()
+	{
+		u64 total = 0, busiest = 0;
+		for (const auto &bin : m_bins)
+		{
+			total += bin.second;
+			busiest = std::max(busiest, bin.second);
+		}
+		m_frames.emplace_back(total, busiest);
+		m_bins.clear();
+	}
+
+	// the best speedup over one thread that the bins' ordering allows
+	double bound(int threads) const
+	{
+		double total = 0, bounded = 0;
+		for (const auto &frame : m_frames)
+		{
+			total += frame.first;
+			bounded += std::max(double(frame.first) / threads, double(frame.second));
+		}
+		return (bounded != 0) ? (total / bounded) : 1.0;
+	}
+
+private:
+	static constexpr int TILE_WIDTH = poly_manager<float, replay_object, REPLAY_PARAMS, REPLAY_POLYS>::TILE_WIDTH;
+	static constexpr int SCANLINES_PER_BUCKET = poly_manager<float, replay_object, REPLAY_PARAMS, REPLAY_POLYS>::SCANLINES_PER_BUCKET;
+
+	bool m_tiled;
+	std::map<std::pair<s32, s32>, u64> m_bins;
+	std::vector<std::pair<u64, u64>> m_frames;
+};
+
+
+// draws every primitive with one Gouraud scanline function, whatever the
+// driver used
+template <typename BaseType>
+class replay_renderer : public poly_manager<BaseType, replay_object, REPLAY_PARAMS, REPLAY_POLYS>
+{
+public:
+	using base_type = BaseType;
+	using manager = poly_manager<BaseType, replay_object, REPLAY_PARAMS, REPLAY_POLYS>;
+	using typename manager::vertex_t;
+	using typename manager::extent_t;
+	using typename manager::render_delegate;
+
+	replay_renderer(u8 flags, int width, int height, bin_load *load = nullptr)
+		: manager(flags)
+		, m_width(width)
+		, m_height(height)
+		, m_color(width * height, 0)
+		, m_depth(width * height, 0)
+		, m_paramcount(-1)
+		, m_load(load)
+	{
+		manager::configure_bins(width, height);
+	}
+
+	void wait(const char *debug_reason)
+	{
+		manager::wait(debug_reason);
+		if (m_load != nullptr)
+			m_load->frame();
+	}
+
+	render_delegate callback(const std::string &name) { return render_delegate(&replay_renderer::draw_scanline, this); }
+
+	// the driver's object data and other data mean nothing to draw_scanline
+	void object(const u8 *data, std::size_t length) { }
+	void data(u32 tag, const u8 *data, std::size_t length) { }
+
+	// tell the scanline function how many parameters are valid
+	void parameters(int paramcount)
+	{
+		if (paramcount != m_paramcount)
+		{
+			manager::object_data_alloc().paramcount = paramcount;
+			m_paramcount = paramcount;
+		}
+	}
+
+private:
+	// depth test on the first parameter, shade from the next three; only
+	// the parameters the primitive has are valid, the rest stay zero
+	void draw_scanline(s32 scanline, const extent_t &extent, const replay_object &object, int threadid)
+	{
+		if (scanline < 0 || scanline >= m_height)
+			return;
+		const int startx = std::max<int>(extent.startx, 0), stopx = std::min<int>(extent.stopx, m_width);
+		if (m_load != nullptr && startx < stopx)
+			m_load->add(scanline, startx, stopx - startx);
+		BaseType start[4] = { 0, 0, 0, 0 }, dpdx[4] = { 0, 0, 0, 0 };
+		for (int paramnum = 0; paramnum < std::min(object.paramcount, 4); paramnum++)
+		{
+			start[paramnum] = extent.param[paramnum].start;
+			dpdx[paramnum] = extent.param[paramnum].dpdx;
+		}
+		BaseType z = start[0], r = start[1], g = start[2], b = start[3];
+		const BaseType dz = dpdx[0], dr = dpdx[1], dg = dpdx[2], db = dpdx[3];
+		u32 *const color = &m_color[scanline * m_width];
+		u32 *const depth = &m_depth[scanline * m_width];
+		for (int x = startx; x < stopx; x++)
+		{
+			const u32 iz = u32(z * BaseType(0xffffff));
+			if (iz >= depth[x])
+			{
+				depth[x] = iz;
+				color[x] = (u32(r) & 0xff) << 16 | (u32(g) & 0xff) << 8 | (u32(b) & 0xff);
+			}
+			z += dz;
+			r += dr;
+			g += dg;
+			b += db;
+		}
+	}
+
+	int m_width;
+	int m_height;
+	std::vector<u32> m_color;
+	std::vector<u32> m_depth;
+	int m_paramcount;
+	bin_load *m_load;
+};
+
+
+// texture RAM for tc0780fpa_replay, set up before the renderer reading it
+struct tc0780fpa_texture
+{
+	std::vector<u8> m_texture_ram = std::vector<u8>(2048 * 2048);
+};
+
+// draws with the TC0780FPA's own scanline functions; texture RAM is copied
+// in whenever the stream has a new one, which the timing includes
+class tc0780fpa_replay : private tc0780fpa_texture, public tc0780fpa_renderer
+{
+public:
+	using base_type = float;
+
+	tc0780fpa_replay(u8 flags, int width, int height) : tc0780fpa_renderer(width, height, &m_texture_ram[0], flags) { }
+
+	// whether a stream was captured from this renderer
+	static bool replays(const poly_stream &stream)
+	{
+		if (!stream.is_float() || stream.object_size() != sizeof(tc0780fpa_polydata) || stream.callbacks().empty())
+			return false;
+		for (const std::string &name : stream.callbacks())
+			if (name != "render_solid_scan" && name != "render_shade_scan" && name != "render_texture_scan")
+				return false;
+		return true;
+	}
+
+	render_delegate callback(const std::string &name)
+	{
+		tc0780fpa_renderer *const renderer = this;
+		if (name == "render_solid_scan")
+			return render_delegate(&tc0780fpa_renderer::render_solid_scan, renderer);
+		else if (name == "render_shade_scan")
+			return render_delegate(&tc0780fpa_renderer::render_shade_scan, renderer);
+		else
+			return render_delegate(&tc0780fpa_renderer::render_texture_scan, renderer);
+	}
+
+	void object(const u8 *data, std::size_t length) { memcpy(&object_data_alloc(), data, sizeof(tc0780fpa_polydata)); }
+
+	void data(u32 tag, const u8 *data, std::size_t length)
+	{
+		switch (tag)
+		{
+		case CAPTURE_TEXTURE:
+			wait("texture");
+			memcpy(&m_texture_ram[0], data, std::min(length, m_texture_ram.size()));
+			break;
+
+		case CAPTURE_SWAP:
+			swap_buffers();
+			break;
+		}
+	}
+
+	void parameters(int paramcount) { }
+};
+
+
+template <typename Renderer>
+void run_stream(benchmark::State &state, const poly_stream &stream, bool tiled)
+{
+	// the bins only depend on the geometry, so any renderer's stream can be measured with the Gouraud one
+	using gouraud = replay_renderer<typename Renderer::base_type>;
+	bin_load load(tiled);
+	{
+		gouraud renderer((tiled ? gouraud::FLAG_TILE_BINNING : 0) | gouraud::FLAG_NO_WORK_QUEUE, stream.width(), stream.height(), &load);
+		stream.replay(renderer);
+	}
+	char label[32];
+	snprintf(label, sizeof(label), "bound %.2fx", load.bound(state.range(0)));
+	state.SetLabel(label);
+
+	// the work queue takes its thread count from the processor count when created
+	const int saved = osd_num_processors;
+	osd_num_processors = state.range(0);
+	Renderer renderer(tiled ? Renderer::FLAG_TILE_BINNING : 0, stream.width(), stream.height());
+	osd_num_processors = saved;
+
+	u64 pixels = 0;
+	while (state.KeepRunning())
+		pixels = stream.replay(renderer);
+	state.SetItemsProcessed(state.iterations() * pixels);
+}
+
+void run_capture(benchmark::State &state, const poly_stream &stream)
+{
+	if (stream.is_float())
+		run_stream<replay_renderer<float>>(state, stream, state.range(1));
+	else
+		run_stream<replay_renderer<double>>(state, stream, state.range(1));
+}
+
+void thread_args(benchmark::internal::Benchmark *b)
+{
+	for (int tiled = 0; tiled < 2; tiled++)
+		for (int threads = 1; threads <= 16; threads *= 2)
+			b->Args({ threads, tiled });
+}
+
+
+// register a benchmark for each captured stream
+class capture_registrar
+{
+public:
+	capture_registrar()
+	{
+		const char *list = std::getenv("POLY_CAPTURES");
+		std::string names(list != nullptr ? list : "");
+		while (!names.empty())
+		{
+			const std::size_t sep = names.find(';');
+			const std::string name(names.substr(0, sep));
+			names = (sep == std::string::npos) ? "" : names.substr(sep + 1);
+
+			// integer coordinates (the N64 RDP) aren't supported
+			auto stream = std::make_unique<poly_stream>();
+			if (name.empty() || !stream->load(name) || !(stream->is_float() || stream->is_double()))
+				continue;
+			const poly_stream &ref(*stream);
+			m_streams.push_back(std::move(stream));
+			if (tc0780fpa_replay::replays(ref))
+				benchmark::RegisterBenchmark(("BM_poly_replay_tc0780fpa/" + name).c_str(), [&ref] (benchmark::State &state) { run_stream<tc0780fpa_replay>(state, ref, state.range(1)); })->Apply(thread_args)->UseRealTime();
+			else
+				benchmark::RegisterBenchmark(("BM_poly_replay_gouraud/" + name).c_str(), [&ref] (benchmark::State &state) { run_capture(state, ref); })->Apply(thread_args)->UseRealTime();
+		}
+	}
+
+private:
+	std::vector<std::unique_ptr<poly_stream>> m_streams;
+};
+
+capture_registrar s_registrar;
+
+} // anonymous namespace
+
+
+static void BM_poly_synthetic_gouraud(benchmark::State &state)
+{
+	poly_stream stream;
+	stream.generate(state.range(2), 4, 20000);
+	run_stream<replay_renderer<float>>(state, stream, state.range(1));
+}
+
+static void synthetic_args(benchmark::internal::Benchmark *b)
+{
+	for (int size : { 8, 48 })
+		for (int tiled = 0; tiled < 2; tiled++)
+			for (int threads = 1; threads <= 16; threads *= 2)
+				b->Args({ threads, tiled, size });
+}
+
+// Register the functions as benchmarks
+BENCHMARK(BM_poly_synthetic_gouraud)->Apply(synthetic_args)->UseRealTime();
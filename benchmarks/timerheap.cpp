@@ -0,0 +1,164 @@
+#include "benchmark/benchmark_api.h"
+#include "emucore.h"
+#include "eminline.h"
+#include "attotime.h"
+
+#include <vector>
+
+// Compares the d-ary heap used by device_scheduler against the sorted
+// linked list it replaced, with the same tie-breaking rules.  "adjust"
+// re-arms a random timer relative to the current time; "expire" fires the
+// soonest timer and re-queues it one period later, like a periodic timer.
+
+namespace {
+
+struct bench_timer
+{
+	bench_timer *   m_next = nullptr;
+	bench_timer *   m_prev = nullptr;
+	attotime        m_expire;
+	attotime        m_period;
+	u64             m_sequence = 0;
+	std::size_t     m_index = ~std::size_t(0);
+};
+
+struct bench_traits
+{
+	static bool less(const bench_timer &a, const bench_timer &b) { return (a.m_expire < b.m_expire) || ((a.m_expire == b.m_expire) && (a.m_sequence < b.m_sequence)); }
+	static std::size_t &index(bench_timer &timer) { return timer.m_index; }
+};
+
+
+class heap_queue
+{
+public:
+	bench_timer &head() { return *m_heap.top(); }
+	void update(bench_timer &timer)
+	{
+		timer.m_sequence = m_sequence++;
+		if (m_heap.contains(timer))
+			m_heap.update(timer);
+		else
+			m_heap.push(timer);
+	}
+
+private:
+	util::intrusive_heap<bench_timer, bench_traits> m_heap;
+	u64 m_sequence = 0;
+};
+
+
+class list_queue
+{
+public:
+	bench_timer &head() { return *m_head; }
+	void update(bench_timer &timer)
+	{
+		if (timer.m_prev || timer.m_next || (m_head == &timer))
+			remove(timer);
+
+		bench_timer *prev = nullptr;
+		for (bench_timer *cur = m_head; cur != nullptr; prev = cur, cur = cur->m_next)
+			if (cur->m_expire > timer.m_expire)
+			{
+				timer.m_prev = cur->m_prev;
+				timer.m_next = cur;
+				if (cur->m_prev != nullptr)
+					cur->m_prev->m_next = &timer;
+				else
+					m_head = &timer;
+				cur->m_prev = &timer;
+				return;
+			}
+
+		if (prev != nullptr)
+			prev->m_next = &timer;
+		else
+			m_head = &timer;
+		timer.m_prev = prev;
+		timer.m_next = nullptr;
+	}
+
+private:
+	void remove(bench_timer &timer)
+	{
+		if (timer.m_prev != nullptr)
+			timer.m_prev->m_next = timer.m_next;
+		else
+			m_head = timer.m_next;
+		if (timer.m_next != nullptr)
+			timer.m_next->m_prev = timer.m_prev;
+		timer.m_prev = timer.m_next = nullptr;
+	}
+
+	bench_timer *m_head = nullptr;
+};
+
+
+// simple LCG so both queues see identical sequences
+inline u32 next_random(u32 &seed)
+{
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+template <typename Queue>
+void setup_timers(Queue &queue, std::vector<bench_timer> &timers, u32 &seed)
+{
+	for (bench_timer &timer : timers)
+	{
+		timer.m_period = attotime::from_usec(1 + (next_random(seed) % 1000));
+		timer.m_expire = timer.m_period;
+		queue.update(timer);
+	}
+}
+
+template <typename Queue>
+void run_adjust(benchmark::State &state)
+{
+	Queue queue;
+	std::vector<bench_timer> timers(state.range(0));
+	u32 seed = 0x12345678;
+	setup_timers(queue, timers, seed);
+
+	attotime now = attotime::zero;
+	while (state.KeepRunning())
+	{
+		bench_timer &timer = timers[next_random(seed) % timers.size()];
+		timer.m_expire = now + attotime::from_usec(next_random(seed) % 1000);
+		queue.update(timer);
+		now += attotime::from_nsec(100);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Queue>
+void run_expire(benchmark::State &state)
+{
+	Queue queue;
+	std::vector<bench_timer> timers(state.range(0));
+	u32 seed = 0x12345678;
+	setup_timers(queue, timers, seed);
+
+	while (state.KeepRunning())
+	{
+		bench_timer &timer = queue.head();
+		timer.m_expire += timer.m_period;
+		queue.update(timer);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+} // anonymous namespace
+
+
+static void BM_timer_heap_adjust(benchmark::State &state) { run_adjust<heap_queue>(state); }
+static void BM_timer_list_adjust(benchmark::State &state) { run_adjust<list_queue>(state); }
+static void BM_timer_heap_expire(benchmark::State &state) { run_expire<heap_queue>(state); }
+static void BM_timer_list_expire(benchmark::State &state) { run_expire<list_queue>(state); }
+
+// Register the functions as benchmarks
+BENCHMARK(BM_timer_heap_adjust)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_timer_list_adjust)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_timer_heap_expire)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_timer_list_expire)->Arg(10)->Arg(100)->Arg(1000);
@@ -0,0 +1,147 @@
+#include "benchmark/benchmark_api.h"
+#include "emu.h"
+#include "cpu/drcuml.h"
+
+#include <vector>
+
+// Runs the UML block optimizer over synthetic blocks shaped like the output
+// of the MIPS III front-end: guest registers live in memory and are loaded,
+// operated on and stored back for each instruction, most operations produce
+// flags nobody reads, and branches skip over exits to labels.  "local" is
+// the single forward scan used unless -drc_optimize is on, with no forwarding.
+// The label reports how many instructions survive, how many memory operands
+// they still have and how many still produce flags.
+
+namespace {
+
+using namespace uml;
+
+struct guest_state
+{
+	u64     r[32];
+	u32     pc;
+	s32     icount;
+};
+
+guest_state s_state;
+
+
+class block_builder
+{
+public:
+	block_builder(u32 count)
+	{
+		u32 seed = 0x12345678;
+		u32 labelnum = 1;
+		for (u32 index = 0; index < count; index++)
+		{
+			seed = seed * 1103515245 + 12345;
+			const u32 rs = (seed >> 8) & 7, rt = (seed >> 12) & 7, rd = (seed >> 16) & 7;
+			const u32 imm = (seed >> 20) & 0xff;
+
+			add().mov(mem(&s_state.pc), 0x80001000 + index * 4);
+			switch ((seed >> 28) % 7)
+			{
+			case 0: // addiu
+				add().add(I0, mem(&s_state.r[rs]), imm);
+				add().dsext(mem(&s_state.r[rt]), I0, SIZE_DWORD);
+				break;
+
+			case 1: // addu
+				add().add(I0, mem(&s_state.r[rs]), mem(&s_state.r[rt]));
+				add().dsext(mem(&s_state.r[rd]), I0, SIZE_DWORD);
+				break;
+
+			case 2: // lui followed by ori
+				add().dmov(mem(&s_state.r[rt]), s64(s32(imm << 16)));
+				add().dor(mem(&s_state.r[rt]), mem(&s_state.r[rt]), imm);
+				break;
+
+			case 3: // slt
+				add().dcmp(mem(&s_state.r[rs]), mem(&s_state.r[rt]));
+				add().dset(COND_L, mem(&s_state.r[rd]));
+				break;
+
+			case 4: // beq over an exit
+				add().cmp(mem(&s_state.r[rs]), mem(&s_state.r[rt]));
+				add().jmp(COND_NZ, labelnum);
+				add().mov(mem(&s_state.pc), 0x80002000 + index * 4);
+				add().exit(0);
+				add().label(labelnum++);
+				break;
+
+			case 5: // load through a register
+				add().mov(I0, mem(&s_state.r[rs]));
+				add().add(I0, I0, imm);
+				add().mov(I1, mem(&s_state.r[rs]));
+				add().dmov(mem(&s_state.r[rt]), I0);
+				break;
+
+			case 6: // move and shift
+				add().dmov(mem(&s_state.r[rd]), mem(&s_state.r[rs]));
+				add().dshl(mem(&s_state.r[rd]), mem(&s_state.r[rd]), imm & 31);
+				break;
+			}
+
+			// cycle counting at the end of each instruction
+			add().sub(mem(&s_state.icount), mem(&s_state.icount), 1);
+			add().exit(COND_S, 1);
+		}
+		add().exit(2);
+	}
+
+	const std::vector<instruction> &instructions() const { return m_inst; }
+
+private:
+	instruction &add() { m_inst.emplace_back(); return m_inst.back(); }
+
+	std::vector<instruction> m_inst;
+};
+
+
+template <typename Func>
+void run_optimizer(benchmark::State &state, Func &&func)
+{
+	block_builder builder(state.range(0));
+	const std::vector<instruction> &source(builder.instructions());
+	std::vector<instruction> work(source.size());
+	while (state.KeepRunning())
+	{
+		std::copy(source.begin(), source.end(), work.begin());
+		func(work.data(), work.size());
+	}
+	state.SetItemsProcessed(state.iterations() * source.size());
+
+	u32 live = 0, memory = 0, flagged = 0;
+	for (const instruction &inst : work)
+	{
+		if (inst.opcode() == OP_NOP)
+			continue;
+		live++;
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			if (inst.param(pnum).is_memory())
+				memory++;
+		if (inst.flags() != 0)
+			flagged++;
+	}
+	state.SetLabel(util::string_format("%u/%u insts, %u memory operands, %u with flags", live, u32(source.size()), memory, flagged));
+}
+
+} // anonymous namespace
+
+
+static void BM_uml_optimize_local(benchmark::State &state)
+{
+	drcuml_optimizer optimizer;
+	run_optimizer(state, [&optimizer] (instruction *instlist, u32 numinst) { optimizer.optimize_local(instlist, numinst); });
+}
+
+static void BM_uml_optimize(benchmark::State &state)
+{
+	drcuml_optimizer optimizer;
+	run_optimizer(state, [&optimizer] (instruction *instlist, u32 numinst) { optimizer.optimize(instlist, numinst); });
+}
+
+// Register the functions as benchmarks
+BENCHMARK(BM_uml_optimize_local)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK(BM_uml_optimize)->Arg(16)->Arg(64)->Arg(256);
@@ -0,0 +1,245 @@
+#include "benchmark/benchmark_api.h"
+#include "emu.h"
+#include "divtlb.h"
+
+#include <memory>
+#include <vector>
+
+// Replays a synthetic trace of memory accesses through a first-level TLB
+// shaped like the virtual TLB: a page-indexed table with a small FIFO of
+// live entries that is emptied on every context switch.  A handful of
+// processes each touch a working set of pages with some locality, and
+// switch after a fixed number of accesses.  "walk" translates every miss
+// by walking two-level page tables spread through guest RAM, as CPU cores
+// did before the second-level cache; "cached" looks the miss up in a
+// vtlb_cache tagged with the process first.  The label reports the miss count and how many
+// of them needed a walk.
+
+namespace {
+
+const u32 PAGE_SHIFT = 12;
+const u32 PAGES = 1 << (32 - PAGE_SHIFT);
+const u32 LIVE_ENTRIES = 96;
+const u32 PROCESSES = 8;
+const u32 SWITCH_INTERVAL = 2000;
+const u32 TRACE_LENGTH = 200000;
+const u32 RAM_BYTES = 64 << 20;
+
+
+// page table walks go through the memory system, which looks up a handler
+// for the address and calls it; model that with one RAM handler per 64KB
+class ram_handler
+{
+public:
+	ram_handler(u32 *base) : m_base(base) { }
+	virtual ~ram_handler() = default;
+
+	virtual u32 read(offs_t offset) { return m_base[offset / 4]; }
+	virtual void write(offs_t offset, u32 data) { m_base[offset / 4] = data; }
+
+private:
+	u32 *m_base;
+};
+
+class guest_memory
+{
+public:
+	guest_memory() : m_ram(RAM_BYTES / 4, 0)
+	{
+		for (offs_t base = 0; base < RAM_BYTES; base += 0x10000)
+			m_handlers.push_back(std::make_unique<ram_handler>(&m_ram[base / 4]));
+	}
+
+	u32 read_dword(offs_t address) { return m_handlers[address >> 16]->read(address & 0xffff); }
+	void write_dword(offs_t address, u32 data) { m_handlers[address >> 16]->write(address & 0xffff, data); }
+
+private:
+	std::vector<u32> m_ram;
+	std::vector<std::unique_ptr<ram_handler>> m_handlers;
+};
+
+
+class access_trace
+{
+public:
+	access_trace(u32 workingset) : m_memory(std::make_unique<guest_memory>()), m_nextframe(1)
+	{
+		// each process gets its own scattered working set and x86-style page tables
+		u32 seed = 0x2468ace0;
+		for (u32 process = 0; process < PROCESSES; process++)
+		{
+			std::vector<u32> &pages = m_pages[process];
+			m_directory[process] = allocate_frame();
+			for (u32 index = 0; index < workingset; index++)
+			{
+				seed = seed * 1103515245 + 12345;
+				const u32 page = (seed >> 8) & (PAGES - 1);
+				pages.push_back(page);
+
+				const offs_t pdeaddr = m_directory[process] + (page >> 10) * 4;
+				u32 pde = m_memory->read_dword(pdeaddr);
+				if (!(pde & 1))
+				{
+					pde = allocate_frame() | 1;
+					m_memory->write_dword(pdeaddr, pde);
+				}
+				m_memory->write_dword((pde & ~0xfff) + (page & 1023) * 4, ((seed & 0xfffff) << PAGE_SHIFT) | 1);
+			}
+		}
+
+		// mostly revisit recent pages, occasionally jump elsewhere in the working set
+		u32 process = 0, current = 0;
+		for (u32 index = 0; index < TRACE_LENGTH; index++)
+		{
+			if (index % SWITCH_INTERVAL == 0)
+			{
+				process = (process + 1) % PROCESSES;
+				m_accesses.push_back(~u32(0));
+			}
+			seed = seed * 1103515245 + 12345;
+			const u32 roll = (seed >> 16) & 0xff;
+			if (roll < 16)
+				current = (seed >> 4) % workingset;
+			else if (roll < 96)
+				current = (current + 1) % workingset;
+			m_accesses.push_back((process << 24) | current);
+		}
+	}
+
+	template <typename Func>
+	void replay(Func &&func) const
+	{
+		for (u32 access : m_accesses)
+		{
+			if (access == ~u32(0))
+				func(~u32(0), 0);
+			else
+				func(access >> 24, m_pages[access >> 24][access & 0xffffff]);
+		}
+	}
+
+	u32 walk(u32 process, u32 page)
+	{
+		// read both levels, marking them accessed as the CPU would
+		const offs_t pdeaddr = m_directory[process] + (page >> 10) * 4;
+		const u32 pde = m_memory->read_dword(pdeaddr);
+		if (!(pde & 1))
+			return 0;
+		const offs_t pteaddr = (pde & ~0xfff) + (page & 1023) * 4;
+		const u32 pte = m_memory->read_dword(pteaddr);
+		if (!(pde & 0x20))
+			m_memory->write_dword(pdeaddr, pde | 0x20);
+		if (!(pte & 0x20))
+			m_memory->write_dword(pteaddr, pte | 0x20);
+		return (pte & ~0xfff) | 1;
+	}
+
+	size_t size() const { return m_accesses.size(); }
+
+private:
+	// page tables are spread through guest RAM; an odd stride never revisits a frame
+	u32 allocate_frame()
+	{
+		m_nextframe = (m_nextframe + 4099) % (RAM_BYTES >> PAGE_SHIFT);
+		return m_nextframe << PAGE_SHIFT;
+	}
+
+	std::unique_ptr<guest_memory> m_memory;
+	u32 m_nextframe;
+	u32 m_directory[PROCESSES];
+	std::vector<u32> m_pages[PROCESSES];
+	std::vector<u32> m_accesses;
+};
+
+
+class first_level
+{
+public:
+	first_level() : m_table(PAGES, 0), m_live(LIVE_ENTRIES, 0), m_index(0) { }
+
+	bool lookup(u32 page, u32 &entry) const
+	{
+		entry = m_table[page];
+		return entry != 0;
+	}
+
+	void load(u32 page, u32 entry)
+	{
+		u32 &live = m_live[m_index++ % LIVE_ENTRIES];
+		if (live != 0)
+			m_table[live - 1] = 0;
+		live = page + 1;
+		m_table[page] = entry;
+	}
+
+	void flush()
+	{
+		for (u32 &live : m_live)
+			if (live != 0)
+			{
+				m_table[live - 1] = 0;
+				live = 0;
+			}
+	}
+
+private:
+	std::vector<u32> m_table;
+	std::vector<u32> m_live;
+	u32 m_index;
+};
+
+
+void run_trace(benchmark::State &state, bool cached)
+{
+	access_trace trace(state.range(0));
+	first_level tlb;
+	vtlb_cache cache;
+	if (cached)
+		cache.allocate(4096);
+
+	u64 misses = 0, walks = 0;
+	u32 result = 0;
+	while (state.KeepRunning())
+	{
+		misses = walks = 0;
+		trace.replay([&] (u32 process, u32 page)
+		{
+			// a context switch empties the first level but leaves the tagged cache alone
+			if (process == ~u32(0))
+			{
+				tlb.flush();
+				return;
+			}
+
+			u32 entry;
+			if (!tlb.lookup(page, entry))
+			{
+				misses++;
+				vtlb_entry value;
+				if (cache.find(process, page, value))
+					entry = value;
+				else
+				{
+					walks++;
+					entry = trace.walk(process, page);
+					cache.insert(process, page, entry);
+				}
+				tlb.load(page, entry);
+			}
+			result += entry;
+		});
+	}
+	benchmark::DoNotOptimize(result);
+	state.SetItemsProcessed(state.iterations() * trace.size());
+	state.SetLabel(util::string_format("%u misses, %u walks", misses, walks));
+}
+
+} // anonymous namespace
+
+
+static void BM_vtlb_trace_walk(benchmark::State &state) { run_trace(state, false); }
+static void BM_vtlb_trace_cached(benchmark::State &state) { run_trace(state, true); }
+
+// Register the functions as benchmarks
+BENCHMARK(BM_vtlb_trace_walk)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(BM_vtlb_trace_cached)->Arg(64)->Arg(256)->Arg(1024);
@@ -470,6 +470,17 @@ bool drcbe_c::hash_exists(uint32_t mode, uint32_t pc)
 }
 
 
+//-------------------------------------------------
+//  hash_reset - unlink the given mode/pc if it
+//  points into the given range of code
+//-------------------------------------------------
+
+void drcbe_c::hash_reset(uint32_t mode, uint32_t pc, drccodeptr start, drccodeptr end)
+{
+	m_hash.reset_codeptr(mode, pc, start, end);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -36,6 +36,7 @@ public:
 	virtual int execute(uml::code_handle &entry) override;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, uint32_t numinst) override;
 	virtual bool hash_exists(uint32_t mode, uint32_t pc) override;
+	virtual void hash_reset(uint32_t mode, uint32_t pc, drccodeptr start, drccodeptr end) override;
 	virtual void get_info(drcbe_info &info) override;
 
 private:
@@ -188,6 +188,22 @@ bool drc_hash_table::set_codeptr(uint32_t mode, uint32_t pc, drccodeptr code)
 }
 
 
+//-------------------------------------------------
+//  reset_codeptr - point the entry for the given
+//  mode/pc back at the missing code handler, if
+//  it still refers to code in the given range
+//-------------------------------------------------
+
+void drc_hash_table::reset_codeptr(uint32_t mode, uint32_t pc, drccodeptr start, drccodeptr end)
+{
+	// entries in the shared empty tables never point at real code, so this never writes to them
+	assert(mode < m_modes);
+	drccodeptr &entry = m_base[mode][(pc >> m_l1shift) & m_l1mask][(pc >> m_l2shift) & m_l2mask];
+	if (entry >= start && entry < end)
+		entry = m_nocodeptr;
+}
+
+
 
 //**************************************************************************
 //  DRC MAP VARIABLES
@@ -169,10 +169,16 @@
 #include <stddef.h>
 #include "emu.h"
 #include "debugger.h"
+#include "debug/debugcmd.h"
+#include "debug/debugcon.h"
 #include "emuopts.h"
 #include "drcuml.h"
 #include "drcbex64.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+
 // This is a trick to make it build on Android where the ARM SDK declares ::REG_Rn
 // and the x64 SDK declares ::REG_Exx and ::REG_Rxx
 namespace drc {
@@ -621,6 +627,8 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, u
 		m_map(cache, 0xaaaaaaaa5555),
 		m_labels(cache),
 		m_log(nullptr),
+		m_perf_map(device.machine().options().drc_perf_map()),
+		m_profile(device.machine().options().drc_profile()),
 		m_sse41(false),
 		m_absmask32((uint32_t *)cache.alloc_near(16*2 + 15)),
 		m_absmask64(nullptr),
@@ -693,6 +701,17 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, u
 		std::string filename = std::string("drcbex64_").append(device.shortname()).append(".asm");
 		m_log = x86log_create_context(filename.c_str());
 	}
+
+	// the first profiled back-end adds the debugger command to show the counts
+	if (m_profile)
+	{
+		if (s_profiled.empty() && (device.machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+		{
+			using namespace std::placeholders;
+			device.machine().debugger().console().register_command("drcprofile", CMDFLAG_NONE, 0, 0, 1, std::bind(&drcbe_x64::execute_drcprofile, std::ref(device.machine()), _1, _2));
+		}
+		s_profiled.push_back(this);
+	}
 }
 
 
@@ -705,6 +724,9 @@ drcbe_x64::~drcbe_x64()
 	// free the log context
 	if (m_log != nullptr)
 		x86log_free_context(m_log);
+
+	// stop reporting our counts
+	s_profiled.erase(std::remove(s_profiled.begin(), s_profiled.end(), this), s_profiled.end());
 }
 
 
@@ -783,6 +805,8 @@ void drcbe_x64::reset()
 	// finish up codegen
 	*cachetop = (drccodeptr)dst;
 	m_cache.end_codegen();
+	if (m_perf_map)
+		perf_map_add((x86code *)m_entry, dst, "glue");
 
 	// reset our hash tables
 	m_hash.reset();
@@ -823,7 +847,7 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, uint3
 	x86code *dst = base;
 
 	// generate code
-	const char *blockname = nullptr;
+	std::string blockname;
 	for (int inum = 0; inum < numinst; inum++)
 	{
 		const instruction &inst = instlist[inum];
@@ -837,12 +861,12 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, uint3
 		}
 
 		// extract a blockname
-		if (blockname == nullptr)
+		if (blockname.empty())
 		{
 			if (inst.opcode() == OP_HANDLE)
 				blockname = inst.param(0).handle().string();
 			else if (inst.opcode() == OP_HASH)
-				blockname = string_format("Code: mode=%d PC=%08X", (uint32_t)inst.param(0).immediate(), (offs_t)inst.param(1).immediate()).c_str();
+				blockname = string_format("Code: mode=%d PC=%08X", (uint32_t)inst.param(0).immediate(), (offs_t)inst.param(1).immediate());
 		}
 
 		// generate code
@@ -855,7 +879,9 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, uint3
 
 	// log it
 	if (m_log != nullptr)
-		x86log_disasm_code_range(m_log, (blockname == nullptr) ? "Unknown block" : blockname, base, m_cache.top());
+		x86log_disasm_code_range(m_log, blockname.empty() ? "Unknown block" : blockname.c_str(), base, m_cache.top());
+	if (m_perf_map)
+		perf_map_add(base, m_cache.top(), blockname.empty() ? "Unknown block" : blockname);
 
 	// tell all of our utility objects that the block is finished
 	m_hash.block_end(block);
@@ -875,6 +901,17 @@ bool drcbe_x64::hash_exists(uint32_t mode, uint32_t pc)
 }
 
 
+//-------------------------------------------------
+//  hash_reset - unlink the given mode/pc if it
+//  points into the given range of code
+//-------------------------------------------------
+
+void drcbe_x64::hash_reset(uint32_t mode, uint32_t pc, drccodeptr start, drccodeptr end)
+{
+	m_hash.reset_codeptr(mode, pc, start, end);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -2674,6 +2711,70 @@ void drcbe_x64::debug_log_hashjmp_fail()
 
 
 
+/***************************************************************************
+    PROFILING
+***************************************************************************/
+
+std::vector<drcbe_x64 *> drcbe_x64::s_profiled;
+
+
+//-------------------------------------------------
+//  perf_map_add - name a range of generated code
+//  in /tmp/perf-<pid>.map, where the Linux perf
+//  tool looks for symbols for JIT code
+//-------------------------------------------------
+
+void drcbe_x64::perf_map_add(const x86code *start, const x86code *end, const std::string &name)
+{
+	// the file is shared by every back-end in the process
+	static std::mutex s_mutex;
+	static std::FILE *s_file = nullptr;
+	std::lock_guard<std::mutex> lock(s_mutex);
+	if (s_file == nullptr)
+	{
+		s_file = std::fopen(string_format("/tmp/perf-%d.map", osd_getpid()).c_str(), "w");
+		if (s_file == nullptr)
+		{
+			m_perf_map = false;
+			return;
+		}
+	}
+
+	// later entries for the same addresses win, which suits reclaimed space
+	std::fprintf(s_file, "%llx %llx %s %s\n", (unsigned long long)(uintptr_t)start, (unsigned long long)(end - start), m_device.tag(), name.c_str());
+	std::fflush(s_file);
+}
+
+
+//-------------------------------------------------
+//  execute_drcprofile - debugger command to list
+//  the most frequently entered code
+//-------------------------------------------------
+
+void drcbe_x64::execute_drcprofile(running_machine &machine, int ref, const std::vector<std::string> &params)
+{
+	u64 count = 20;
+	if (!params.empty() && !machine.debugger().commands().validate_number_parameter(params[0], count))
+		return;
+
+	// gather the counts from every profiled back-end
+	struct entry { const char *tag; uint32_t mode; uint32_t pc; uint64_t hits; };
+	std::vector<entry> entries;
+	for (drcbe_x64 const *be : s_profiled)
+		for (auto const &counter : be->m_counters)
+			if (counter.second != 0)
+				entries.push_back(entry{ be->m_device.tag(), counter.first.first, counter.first.second, counter.second });
+
+	// show the busiest first
+	std::sort(entries.begin(), entries.end(), [] (entry const &a, entry const &b) { return a.hits > b.hits; });
+	debugger_console &console = machine.debugger().console();
+	console.printf("%-20s %4s %-8s %16s\n", "CPU", "Mode", "PC", "Entries");
+	for (size_t index = 0; index < entries.size() && index < count; index++)
+		console.printf("%-20s %4d %08X %16d\n", entries[index].tag, entries[index].mode, entries[index].pc, entries[index].hits);
+}
+
+
+
 /***************************************************************************
     COMPILE-TIME OPCODES
 ***************************************************************************/
@@ -2716,6 +2817,15 @@ void drcbe_x64::op_hash(x86code *&dst, const instruction &inst)
 
 	// register the current pointer for the mode/PC
 	m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), dst);
+
+	// count entries if profiling; nothing is live in rax or the flags at a hash point, and
+	// counters outlive the cache, so a recompiled PC keeps adding to the same one
+	if (m_profile)
+	{
+		uint64_t &counter = m_counters[std::make_pair(uint32_t(inst.param(0).immediate()), uint32_t(inst.param(1).immediate()))];
+		emit_mov_r64_imm(dst, REG_RAX, (uintptr_t)&counter);                            // mov   rax,&counter
+		emit_add_m64_imm(dst, MBD(REG_RAX, 0), 1);                                      // add   [rax],1
+	}
 }
 
 
@@ -17,6 +17,9 @@
 #include "drcbeut.h"
 #include "x86log.h"
 
+#include <map>
+#include <utility>
+
 #define X86EMIT_SIZE 64
 #include "x86emit.h"
 
@@ -40,6 +43,7 @@ public:
 	virtual int execute(uml::code_handle &entry) override;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, uint32_t numinst) override;
 	virtual bool hash_exists(uint32_t mode, uint32_t pc) override;
+	virtual void hash_reset(uint32_t mode, uint32_t pc, drccodeptr start, drccodeptr end) override;
 	virtual void get_info(drcbe_info &info) override;
 	virtual bool logging() const override { return m_log != nullptr; }
 
@@ -127,6 +131,10 @@ private:
 	static void debug_log_hashjmp(offs_t pc, int mode);
 	static void debug_log_hashjmp_fail();
 
+	// profiling helpers
+	void perf_map_add(const x86code *start, const x86code *end, const std::string &name);
+	static void execute_drcprofile(running_machine &machine, int ref, const std::vector<std::string> &params);
+
 	// code generators
 	void op_handle(x86code *&dst, const uml::instruction &inst);
 	void op_hash(x86code *&dst, const uml::instruction &inst);
@@ -298,6 +306,10 @@ private:
 	drc_map_variables       m_map;                  // code map
 	drc_label_list          m_labels;               // label list
 	x86log_context *        m_log;                  // logging
+	bool                    m_perf_map;             // write generated code to the perf map?
+	bool                    m_profile;              // count entries to each hash?
+	std::map<std::pair<uint32_t, uint32_t>, uint64_t> m_counters; // entry counters by mode/pc; map nodes don't move
+	static std::vector<drcbe_x64 *> s_profiled;     // back-ends with counters, for the debugger
 	bool                    m_sse41;                // do we have SSE4.1 support?
 
 	uint32_t *                m_absmask32;            // absolute value mask (32-bit)
@@ -836,6 +836,18 @@ bool drcbe_x86::hash_exists(uint32_t mode, uint32_t pc)
 }
 
 
+//-------------------------------------------------
+//  drcbex86_hash_reset - unlink the given
+//  mode/pc if it points into the given range of
+//  code
+//-------------------------------------------------
+
+void drcbe_x86::hash_reset(uint32_t mode, uint32_t pc, drccodeptr start, drccodeptr end)
+{
+	m_hash.reset_codeptr(mode, pc, start, end);
+}
+
+
 //-------------------------------------------------
 //  drcbex86_get_info - return information about
 //  the back-end implementation
@@ -38,7 +38,13 @@ drc_cache::drc_cache(size_t bytes)
 		m_top(m_base),
 		m_end(m_near + bytes),
 		m_codegen(nullptr),
-		m_size(bytes)
+		m_size(bytes),
+		m_reclaimed(0),
+		m_tracking(false),
+		m_blockstart(nullptr),
+		m_blockend(nullptr),
+		m_maintop(nullptr),
+		m_holeend(nullptr)
 {
 	memset(m_free, 0, sizeof(m_free));
 	memset(m_nearfree, 0, sizeof(m_nearfree));
@@ -65,9 +71,14 @@ void drc_cache::flush()
 {
 	// can't flush in the middle of codegen
 	assert(m_codegen == nullptr);
+	assert(m_maintop == nullptr);
 
 	// just reset the top back to the base and re-seed
 	m_top = m_base;
+
+	// any reclaimed space is part of what we just threw away
+	m_holes.clear();
+	m_reclaimed = 0;
 }
 
 
@@ -94,7 +105,7 @@ void *drc_cache::alloc(size_t bytes)
 
 	// if no space, we just fail
 	drccodeptr ptr = (drccodeptr)ALIGN_PTR_DOWN(m_end - bytes);
-	if (m_top > ptr)
+	if (main_top() > ptr)
 		return nullptr;
 
 	// otherwise update the end of the cache
@@ -146,12 +157,16 @@ void *drc_cache::alloc_temporary(size_t bytes)
 	assert(m_codegen == nullptr);
 
 	// if no space, we just fail
-	drccodeptr ptr = m_top;
+	drccodeptr ptr = main_top();
 	if (ptr + bytes >= m_end)
 		return nullptr;
 
-	// otherwise, update the cache top
-	m_top = (drccodeptr)ALIGN_PTR_UP(ptr + bytes);
+	// otherwise, update the cache top; temporary memory is never reclaimed, so it
+	// always comes from the main part of the cache
+	if (m_maintop != nullptr)
+		m_maintop = (drccodeptr)ALIGN_PTR_UP(ptr + bytes);
+	else
+		m_top = (drccodeptr)ALIGN_PTR_UP(ptr + bytes);
 	return ptr;
 }
 
@@ -190,11 +205,19 @@ drccodeptr *drc_cache::begin_codegen(uint32_t reserve_bytes)
 	assert(m_codegen == nullptr);
 	assert(m_ooblist.first() == nullptr);
 
-	// if still no space, we just fail
+	// if still no space, we just fail; the reserve is only an estimate, so
+	// reclaimed space must also hold the most a single codegen can write,
+	// as overrunning it would overwrite live code
 	drccodeptr ptr = m_top;
-	if (ptr + reserve_bytes >= m_end)
+	if (ptr + reserve_bytes >= codegen_end())
+		return nullptr;
+	if (m_maintop != nullptr && ptr + CODEGEN_MAX_BYTES >= m_holeend)
 		return nullptr;
 
+	// note where a reclaimable block starts
+	if (m_tracking && m_blockstart == nullptr)
+		m_blockstart = m_top;
+
 	// otherwise, return a pointer to the cache top
 	m_codegen = m_top;
 	return &m_top;
@@ -225,6 +248,12 @@ drccodeptr drc_cache::end_codegen()
 	// update the cache top
 	m_top = (drccodeptr)ALIGN_PTR_UP(m_top);
 	m_codegen = nullptr;
+	if (m_top > codegen_end())
+		throw emu_fatalerror("drc_cache: generated code overran the space reserved for it\n");
+
+	// note where a reclaimable block ends so far
+	if (m_tracking)
+		m_blockend = m_top;
 
 	return result;
 }
@@ -252,3 +281,121 @@ void drc_cache::request_oob_codegen(drc_oob_delegate callback, void *param1, voi
 	// add to the tail
 	m_ooblist.append(*oob);
 }
+
+
+
+//-------------------------------------------------
+//  begin_reclaimable - begin generating a block
+//  of code that may later be reclaimed, reusing
+//  reclaimed space if a big enough run is free
+//-------------------------------------------------
+
+bool drc_cache::begin_reclaimable(size_t reserve_bytes, bool reuse)
+{
+	assert(m_codegen == nullptr);
+	assert(!m_tracking);
+
+	// start tracking
+	m_tracking = true;
+	m_blockstart = m_blockend = nullptr;
+	if (!reuse)
+		return false;
+
+	// find the smallest run of reclaimed space that fits, leaving room for
+	// begin_codegen's bound on top of the reserve
+	auto best = m_holes.end();
+	for (auto hole = m_holes.begin(); hole != m_holes.end(); ++hole)
+		if (size_t(hole->second - hole->first) > reserve_bytes + CODEGEN_MAX_BYTES && (best == m_holes.end() || (hole->second - hole->first) < (best->second - best->first)))
+			best = hole;
+	if (best == m_holes.end())
+		return false;
+
+	// generate into it until end_reclaimable
+	m_maintop = m_top;
+	m_top = best->first;
+	m_holeend = best->second;
+	m_reclaimed -= m_holeend - m_top;
+	m_holes.erase(best);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  end_reclaimable - finish a reclaimable block,
+//  returning the extent of the code generated
+//-------------------------------------------------
+
+void drc_cache::end_reclaimable(drccodeptr &start, drccodeptr &end)
+{
+	assert(m_codegen == nullptr);
+	assert(m_tracking);
+
+	// return the extent, which is empty if nothing was generated
+	start = m_blockstart;
+	end = m_blockend;
+	if (start == nullptr || end == nullptr)
+		start = end = nullptr;
+	m_tracking = false;
+
+	// give back whatever we didn't use of reclaimed space
+	if (m_maintop != nullptr)
+	{
+		drccodeptr const unused = (end != nullptr) ? end : m_top;
+		drccodeptr const holeend = m_holeend;
+		m_top = m_maintop;
+		m_maintop = m_holeend = nullptr;
+		add_hole(unused, holeend);
+	}
+}
+
+
+//-------------------------------------------------
+//  reclaim - return a block of code to the cache
+//  so its space can be reused
+//-------------------------------------------------
+
+void drc_cache::reclaim(drccodeptr start, drccodeptr end)
+{
+	assert(m_codegen == nullptr);
+	assert(start >= m_base && start <= end && end <= m_top);
+	add_hole(start, end);
+}
+
+
+//-------------------------------------------------
+//  add_hole - add a run of space to the reclaimed
+//  list, merging with its neighbours
+//-------------------------------------------------
+
+void drc_cache::add_hole(drccodeptr start, drccodeptr end)
+{
+	if (start >= end)
+		return;
+
+	// merge with the run that follows, if any
+	auto next = m_holes.find(end);
+	if (next != m_holes.end())
+	{
+		end = next->second;
+		m_reclaimed -= next->second - next->first;
+		m_holes.erase(next);
+	}
+
+	// merge with the run that precedes, if any
+	auto prev = m_holes.lower_bound(start);
+	if (prev != m_holes.begin() && (--prev)->second == start)
+	{
+		start = prev->first;
+		m_reclaimed -= prev->second - prev->first;
+		m_holes.erase(prev);
+	}
+
+	// space at the top of the cache just lowers the top
+	if (end == m_top && m_maintop == nullptr)
+		m_top = start;
+	else
+	{
+		m_holes.emplace(start, end);
+		m_reclaimed += end - start;
+	}
+}
@@ -13,6 +13,7 @@
 #ifndef __DRCCACHE_H__
 #define __DRCCACHE_H__
 
+#include <map>
 
 
 //**************************************************************************
@@ -67,7 +68,18 @@ public:
 	drccodeptr end_codegen();
 	void request_oob_codegen(drc_oob_delegate callback, void *param1 = nullptr, void *param2 = nullptr);
 
+	// reclamation of code that is no longer needed
+	bool begin_reclaimable(size_t reserve_bytes, bool reuse = true);
+	void end_reclaimable(drccodeptr &start, drccodeptr &end);
+	void reclaim(drccodeptr start, drccodeptr end);
+	size_t reclaimed_bytes() const { return m_reclaimed; }
+
 private:
+	// helpers
+	drccodeptr main_top() const { return (m_maintop != nullptr) ? m_maintop : m_top; }
+	drccodeptr codegen_end() const { return (m_maintop != nullptr) ? m_holeend : m_end; }
+	void add_hole(drccodeptr start, drccodeptr end);
+
 	// largest block of code that can be generated at once
 	static const size_t CODEGEN_MAX_BYTES = 131072;
 
@@ -89,6 +101,15 @@ private:
 	drccodeptr          m_codegen;          // start of generated code
 	size_t              m_size;             // size of the cache in bytes
 
+	// reclaimed space
+	std::map<drccodeptr, drccodeptr> m_holes; // start and end of each run of reclaimed space
+	size_t              m_reclaimed;        // total bytes of reclaimed space
+	bool                m_tracking;         // true if recording the extent of generated code
+	drccodeptr          m_blockstart;       // start of code generated since begin_reclaimable
+	drccodeptr          m_blockend;         // end of code generated since begin_reclaimable
+	drccodeptr          m_maintop;          // saved cache top while generating into reclaimed space
+	drccodeptr          m_holeend;          // end of the reclaimed space being generated into
+
 	// oob management
 	struct oob_handler
 	{
@@ -18,6 +18,8 @@
 #include "emu.h"
 #include "drcfe.h"
 
+#include "emuopts.h"
+
 
 namespace {
 
@@ -178,6 +180,7 @@ opcode_desc *drc_frontend::describe_one(offs_t curpc, opcode_desc const *prevdes
 	desc->flags = in_delay_slot ? OPFLAG_IN_DELAY_SLOT : 0;
 	desc->userflags = 0;
 	desc->userdata0 = 0;
+	desc->userptr = nullptr;
 	desc->cycles = 0;
 	memset(desc->regin, 0x00, sizeof(desc->regin));
 	memset(desc->regout, 0x00, sizeof(desc->regout));
@@ -391,3 +394,97 @@ void drc_frontend::release_descriptions()
 	// reclaim all the descriptors
 	m_desc_allocator.reclaim_all(m_desc_live_list);
 }
+
+
+
+//**************************************************************************
+//  DRC BACKGROUND COMPILER
+//**************************************************************************
+
+//-------------------------------------------------
+//  drc_background_compiler - constructor; the
+//  worker is only used with -drc_background, and
+//  never under the debugger
+//-------------------------------------------------
+
+drc_background_compiler::drc_background_compiler(device_t &cpu, describe_func &&describe, generate_func &&generate, interpret_func &&interpret)
+	: m_cpudevice(cpu)
+	, m_describe(std::move(describe))
+	, m_generate(std::move(generate))
+	, m_interpret(std::move(interpret))
+	, m_queue(nullptr)
+	, m_mode(0)
+	, m_pc(0)
+	, m_desclist(nullptr)
+{
+	if (cpu.machine().options().drc_background() && !(cpu.machine().debug_flags & DEBUG_FLAG_ENABLED))
+		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+}
+
+
+//-------------------------------------------------
+//  ~drc_background_compiler - destructor
+//-------------------------------------------------
+
+drc_background_compiler::~drc_background_compiler()
+{
+	if (m_queue != nullptr)
+		osd_work_queue_free(m_queue);
+}
+
+
+//-------------------------------------------------
+//  compile - generate code for a block of the
+//  given mode at the specified pc on the worker,
+//  interpreting the rest of the timeslice
+//  meanwhile; returns false if the block was
+//  compiled here instead
+//-------------------------------------------------
+
+bool drc_background_compiler::compile(u8 mode, offs_t pc)
+{
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	// everything that reads the guest state is done here, on the emulation thread
+	opcode_desc const *const desclist = m_describe(mode, pc);
+	if (desclist == nullptr)
+	{
+		g_profiler.stop();
+		return false;
+	}
+
+	// hand the descriptions to the worker; if it can't take them, finish the job here
+	m_mode = mode;
+	m_pc = pc;
+	m_desclist = desclist;
+	osd_work_item *const item = (m_queue != nullptr) ? osd_work_item_queue(m_queue, generate_callback, this, 0) : nullptr;
+	if (item == nullptr)
+	{
+		m_generate(mode, pc, desclist, false);
+		g_profiler.stop();
+		return false;
+	}
+	g_profiler.stop();
+
+	// the interpreter never touches the cache or the descriptions, so it can run alongside
+	m_interpret();
+
+	// always switch back at the end of the timeslice, so host timing can't change the outcome
+	if (!osd_work_item_wait(item, 100 * osd_ticks_per_second()))
+		fatalerror("%s: background compile of %08X did not complete\n", m_cpudevice.tag(), pc);
+	osd_work_item_release(item);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  generate_callback - generate code for the
+//  pending block on the worker thread
+//-------------------------------------------------
+
+void *drc_background_compiler::generate_callback(void *param, int threadid)
+{
+	drc_background_compiler &compiler = *reinterpret_cast<drc_background_compiler *>(param);
+	compiler.m_generate(compiler.m_mode, compiler.m_pc, compiler.m_desclist, true);
+	return nullptr;
+}
@@ -33,6 +33,8 @@
 
 #pragma once
 
+#include <functional>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -114,6 +116,7 @@ struct opcode_desc
 	u32             flags;                  // OPFLAG_* opcode flags
 	u32             userflags;              // core specific flags
 	u32             userdata0;              // core specific data
+	const void *    userptr;                // core specific pointer
 	u32             cycles;                 // number of cycles needed to execute
 
 	// register usage information
@@ -161,4 +164,45 @@ private:
 	std::vector<opcode_desc *> m_desc_array;        // array of descriptions in PC order
 };
 
+
+// generates code for a block on a worker thread while the CPU interprets
+class drc_background_compiler
+{
+public:
+	// describe a block on the emulation thread; nullptr if there's nothing left to generate
+	typedef std::function<opcode_desc const * (u8 mode, offs_t pc)> describe_func;
+
+	// generate code for a described block; background is set on the worker thread
+	typedef std::function<void (u8 mode, offs_t pc, opcode_desc const *desclist, bool background)> generate_func;
+
+	// interpret the rest of the timeslice, leaving the state where generated code can resume
+	typedef std::function<void ()> interpret_func;
+
+	// construction/destruction
+	drc_background_compiler(device_t &cpu, describe_func &&describe, generate_func &&generate, interpret_func &&interpret);
+	~drc_background_compiler();
+
+	// getters
+	bool enabled() const { return m_queue != nullptr; }
+
+	// compile a block; returns false if it was compiled here instead
+	bool compile(u8 mode, offs_t pc);
+
+private:
+	// internal helpers
+	static void *generate_callback(void *param, int threadid);
+
+	// CPU hooks
+	device_t &          m_cpudevice;                // CPU device object
+	describe_func       m_describe;                 // describes a block
+	generate_func       m_generate;                 // generates code for a described block
+	interpret_func      m_interpret;                // interprets the rest of the timeslice
+
+	// pending block
+	osd_work_queue *    m_queue;                    // worker queue, or nullptr if disabled
+	u8                  m_mode;                     // mode of the block being generated
+	offs_t              m_pc;                       // PC of the block being generated
+	opcode_desc const * m_desclist;                 // descriptions of the block being generated
+};
+
 #endif // MAME_CPU_DRCFE_H
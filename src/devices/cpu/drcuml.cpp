@@ -11,7 +11,8 @@
     Future improvements/changes:
 
     * UML optimizer:
-        - constant folding
+        - dead store elimination
+        - forwarding across labels with a single predecessor
 
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
@@ -38,8 +39,11 @@
 #include "drcbec.h"
 #include "drcbex86.h"
 #include "drcbex64.h"
+#include "hashing.h"
 
+#include <algorithm>
 #include <fstream>
+#include <map>
 
 
 
@@ -75,6 +79,76 @@ struct bevalidate_test
 };
 
 
+// persistent translation cache: blocks are saved as UML with every host pointer
+// replaced by a name registered by the front-end and an offset from it
+struct drcuml_state::persist_state
+{
+	static constexpr u32 MAGIC = 0x43555244;                    // 'DRUC'
+	static constexpr u32 FORMAT = 1 | (uml::OP_MAX << 8) | (uml::parameter::PTYPE_MAX << 24);
+	static constexpr u16 NO_NAME = 0xffff;
+
+	// a parameter, with pointers made relative to a name
+	struct param
+	{
+		u8                  type;
+		u16                 name;
+		u64                 value;
+	};
+
+	// an instruction
+	struct inst
+	{
+		u8                  opcode;
+		u8                  size;
+		u8                  condition;
+		u8                  flags;
+		u8                  numparams;
+		param               params[uml::instruction::MAX_PARAMS];
+	};
+
+	// a block, with what it was compiled from
+	struct entry
+	{
+		offs_t                                  physpc;     // physical PC of the first instruction
+		std::vector<std::pair<offs_t, offs_t>>  code;       // guest code ranges hashed
+		std::vector<std::pair<offs_t, offs_t>>  guest;      // guest code ranges noted for invalidation
+		util::sha1_t                            hash;       // hash of the guest code
+		std::vector<inst>                       insts;      // instructions
+	};
+
+	persist_state(drcuml_state &drcuml, address_space &space, u32 version, std::string &&filename);
+
+	// names
+	u16 name_index(std::string const &name);
+	bool encode(uml::parameter const &src, param &dst, std::vector<std::pair<offs_t, offs_t>> const &code);
+	bool decode(param const &src, uml::parameter &dst);
+	bool hash(std::vector<std::pair<offs_t, offs_t>> const &code, util::sha1_t &result) const;
+	void update_handles();
+
+	// file I/O
+	bool load(std::vector<u8> const &data);
+	void save(std::vector<u8> &data) const;
+
+	static u64 key(u32 mode, offs_t pc) { return (u64(mode) << 32) | pc; }
+
+	drcuml_state &                                  drcuml;         // owning UML state
+	address_space &                                 space;          // space the guest code is read from
+	u32 const                                       version;        // front-end version and configuration
+	std::string const                               filename;       // file name within the cfg directory
+	bool                                            dirty;          // true if entries have changed
+	std::unordered_map<u64, entry>                  entries;        // blocks by mode and PC
+	std::vector<std::string>                        names;          // names referenced by parameters
+	std::unordered_map<std::string, u16>            nameindex;      // index of each name
+	std::map<uintptr_t, std::pair<size_t, std::string>> regions;    // registered memory by base
+	std::unordered_map<std::string, uintptr_t>      regionbase;     // registered memory by name
+	std::unordered_map<uintptr_t, std::string>      funcname;       // registered functions by pointer
+	std::unordered_map<std::string, uml::c_function> functions;     // registered functions by name
+	std::vector<uml::code_handle *>                 handles;        // handles in allocation order
+	std::unordered_map<uml::code_handle const *, u32> handleindex;  // index of each handle
+	std::vector<uml::instruction>                   scratch;        // instructions being replayed
+};
+
+
 
 //**************************************************************************
 //  DRC BACKEND INTERFACE
@@ -143,9 +217,13 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, u32 flags, int mo
 	, m_umllog(device.machine().options().drc_log_uml()
 			? new std::ofstream(util::string_format("drcuml_%s.asm", device.shortname()))
 			: nullptr)
+	, m_optimize(device.machine().options().drc_optimize())
 	, m_blocklist()
 	, m_handlelist()
 	, m_symlist()
+	, m_codeblocks()
+	, m_codepages()
+	, m_persist()
 {
 }
 
@@ -169,7 +247,9 @@ void drcuml_state::reset()
 	// if we error here, we are screwed
 	try
 	{
-		// flush the cache
+		// flush the cache, and with it every block we were tracking
+		m_codeblocks.clear();
+		m_codepages.clear();
 		m_cache.flush();
 
 		// reset all handle code pointers
@@ -223,6 +303,143 @@ drcuml_block &drcuml_state::begin_block(uint32_t maxinst)
 }
 
 
+//-------------------------------------------------
+//  generate - generate code for a block via the
+//  back-end, tracking it if it can be invalidated
+//-------------------------------------------------
+
+void drcuml_state::generate(drcuml_block &block, uml::instruction *instructions, u32 count)
+{
+	// only blocks compiled from guest code we know about can be invalidated; anything
+	// defining a handle may be referenced directly, so it has to stay put
+	code_block info;
+	bool reclaimable = !block.guest_ranges().empty();
+	for (u32 inum = 0; reclaimable && inum < count; inum++)
+	{
+		uml::instruction const &inst(instructions[inum]);
+		if (inst.opcode() == uml::OP_HANDLE)
+			reclaimable = false;
+		else if (inst.opcode() == uml::OP_HASH)
+			info.hashes.emplace_back(u32(inst.param(0).immediate()), u32(inst.param(1).immediate()));
+	}
+	if (!reclaimable || info.hashes.empty())
+	{
+		m_beintf->generate(block, instructions, count);
+		return;
+	}
+
+	// try reclaimed space first, then fall back to the top of the cache
+	for (bool reuse = true; ; reuse = false)
+	{
+		bool const reusing = m_cache.begin_reclaimable(count * REUSE_BYTES_PER_INST, reuse);
+		try
+		{
+			m_beintf->generate(block, instructions, count);
+			m_cache.end_reclaimable(info.start, info.end);
+			break;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			// give back anything generated before the failure
+			m_cache.end_reclaimable(info.start, info.end);
+			if (info.start != nullptr)
+				m_cache.reclaim(info.start, info.end);
+			if (!reusing)
+				throw;
+		}
+	}
+
+	// index the block by the guest pages it covers
+	info.ranges = block.guest_ranges();
+	code_block_ref const ref(m_codeblocks.emplace(m_codeblocks.end(), std::move(info)));
+	for (std::pair<offs_t, offs_t> const &range : ref->ranges)
+		for (offs_t page = range.first >> GUEST_PAGE_SHIFT; page <= (range.second >> GUEST_PAGE_SHIFT); page++)
+		{
+			std::vector<code_block_ref> &blocks(m_codepages[page]);
+			if (blocks.empty() || (blocks.back() != ref))
+				blocks.push_back(ref);
+		}
+}
+
+
+//-------------------------------------------------
+//  invalidate_range - discard all blocks compiled
+//  from guest code in the given range, returning
+//  the number discarded
+//-------------------------------------------------
+
+u32 drcuml_state::invalidate_range(offs_t start, offs_t end)
+{
+	assert(start <= end);
+
+	// gather blocks that overlap the range
+	std::vector<code_block_ref> victims;
+	auto const collect = [start, end, &victims] (std::vector<code_block_ref> const &blocks)
+	{
+		for (code_block_ref const &ref : blocks)
+		{
+			bool overlaps = false;
+			for (std::pair<offs_t, offs_t> const &range : ref->ranges)
+				overlaps = overlaps || ((range.first <= end) && (range.second >= start));
+			if (overlaps && (std::find(victims.begin(), victims.end(), ref) == victims.end()))
+				victims.push_back(ref);
+		}
+	};
+
+	// look up each page, unless there are fewer pages with code than that
+	offs_t const firstpage = start >> GUEST_PAGE_SHIFT;
+	offs_t const lastpage = end >> GUEST_PAGE_SHIFT;
+	if ((lastpage - firstpage) < m_codepages.size())
+	{
+		for (offs_t page = firstpage; page <= lastpage; page++)
+		{
+			auto const found(m_codepages.find(page));
+			if (found != m_codepages.end())
+				collect(found->second);
+		}
+	}
+	else
+	{
+		for (auto const &page : m_codepages)
+			if ((page.first >= firstpage) && (page.first <= lastpage))
+				collect(page.second);
+	}
+
+	// then throw them away
+	for (code_block_ref const &ref : victims)
+		discard_block(ref);
+	return victims.size();
+}
+
+
+//-------------------------------------------------
+//  discard_block - unlink a block from the hash
+//  tables and give its space back to the cache
+//-------------------------------------------------
+
+void drcuml_state::discard_block(code_block_ref block)
+{
+	// anything jumping to the block goes through the hash tables, so resetting its
+	// entries leaves nothing referring to it
+	for (std::pair<u32, u32> const &hash : block->hashes)
+		m_beintf->hash_reset(hash.first, hash.second, block->start, block->end);
+	m_cache.reclaim(block->start, block->end);
+
+	// remove it from the page index
+	for (std::pair<offs_t, offs_t> const &range : block->ranges)
+		for (offs_t page = range.first >> GUEST_PAGE_SHIFT; page <= (range.second >> GUEST_PAGE_SHIFT); page++)
+		{
+			auto const found(m_codepages.find(page));
+			if (found == m_codepages.end())
+				continue;
+			found->second.erase(std::remove(found->second.begin(), found->second.end(), block), found->second.end());
+			if (found->second.empty())
+				m_codepages.erase(found);
+		}
+	m_codeblocks.erase(block);
+}
+
+
 //-------------------------------------------------
 //  handle_alloc - allocate a new handle
 //-------------------------------------------------
@@ -291,143 +508,1142 @@ void drcuml_state::log_vprintf(util::format_argument_pack<std::ostream> const &a
 
 
 //**************************************************************************
-//  DRCUML BLOCK
+//  PERSISTENT CACHE
 //**************************************************************************
 
 //-------------------------------------------------
-//  drcuml_block - constructor
+//  persist_open - start saving blocks for later
+//  sessions and load those saved by earlier
+//  ones; the version must change whenever the
+//  front-end would translate the same code
+//  differently
 //-------------------------------------------------
 
-drcuml_block::drcuml_block(drcuml_state &drcuml, u32 maxinst)
-	: m_drcuml(drcuml)
-	, m_nextinst(0)
-	, m_maxinst(maxinst * 3/2)
-	, m_inst(m_maxinst)
-	, m_inuse(false)
+bool drcuml_state::persist_open(u32 version)
 {
+	// only if enabled, and only once
+	device_memory_interface *memory;
+	if (m_persist || !m_device.machine().options().drc_cache() || !m_device.interface(memory) || !memory->has_space(AS_PROGRAM))
+		return false;
+
+	// one file per CPU, alongside the system's configuration
+	std::string tag(m_device.tag() + 1);
+	std::replace(tag.begin(), tag.end(), ':', '_');
+	m_persist = std::make_unique<persist_state>(*this, memory->space(AS_PROGRAM), version, util::string_format("%s/%s.drc", m_device.machine().basename(), tag));
+
+	// a file from another version, or damaged, is simply replaced
+	emu_file file(m_device.machine().options().cfg_directory(), OPEN_FLAG_READ);
+	if (file.open(m_persist->filename) == osd_file::error::NONE)
+	{
+		std::vector<u8> data(file.size());
+		if (data.empty() || (file.read(&data[0], data.size()) != data.size()) || !m_persist->load(data))
+			osd_printf_verbose("Ignoring DRC cache %s\n", m_persist->filename.c_str());
+	}
+	return true;
 }
 
 
 //-------------------------------------------------
-//  ~drcuml_block - destructor
+//  persist_region - name a block of memory that
+//  generated code may refer to
 //-------------------------------------------------
 
-drcuml_block::~drcuml_block()
+void drcuml_state::persist_region(void const *base, size_t length, char const *name)
 {
+	if (m_persist && length != 0)
+	{
+		m_persist->regions[uintptr_t(base)] = std::make_pair(length, std::string(name));
+		m_persist->regionbase[name] = uintptr_t(base);
+	}
 }
 
 
 //-------------------------------------------------
-//  begin - begin code generation
+//  persist_function - name a C function that
+//  generated code may call
 //-------------------------------------------------
 
-void drcuml_block::begin()
+void drcuml_state::persist_function(uml::c_function func, char const *name)
 {
-	// set up the block information and return it
-	m_inuse = true;
-	m_nextinst = 0;
+	if (m_persist)
+	{
+		m_persist->funcname[uintptr_t(func)] = name;
+		m_persist->functions[name] = func;
+	}
 }
 
 
 //-------------------------------------------------
-//  end - complete a code block and commit it to
-//  the cache via the back-end
+//  persist_replay - generate the block saved for
+//  a mode and PC, if there is one and the guest
+//  code it came from hasn't changed
 //-------------------------------------------------
 
-void drcuml_block::end()
+bool drcuml_state::persist_replay(u32 mode, offs_t pc, offs_t physpc)
 {
-	assert(m_inuse);
+	if (!m_persist)
+		return false;
+	persist_state &persist(*m_persist);
+
+	// the same PC may be mapped elsewhere this time around
+	auto const found(persist.entries.find(persist_state::key(mode, pc)));
+	if ((found == persist.entries.end()) || (found->second.physpc != physpc))
+		return false;
+	persist_state::entry const &entry(found->second);
+
+	// rebuild the instructions; code that has changed, or that refers to something
+	// the front-end no longer registers, is dropped so it can be replaced
+	util::sha1_t hash;
+	bool valid = persist.hash(entry.code, hash) && (hash == entry.hash);
+	persist.scratch.resize(entry.insts.size());
+	for (size_t inum = 0; valid && (inum < entry.insts.size()); inum++)
+	{
+		persist_state::inst const &src(entry.insts[inum]);
+		uml::parameter params[uml::instruction::MAX_PARAMS];
+		for (int pnum = 0; valid && (pnum < src.numparams) && (pnum < uml::instruction::MAX_PARAMS); pnum++)
+			valid = persist.decode(src.params[pnum], params[pnum]);
+		valid = valid && persist.scratch[inum].restore(uml::opcode_t(src.opcode), src.size, uml::condition_t(src.condition), src.flags, src.numparams, params);
+	}
+	if (!valid)
+	{
+		persist.entries.erase(found);
+		persist.dirty = true;
+		return false;
+	}
+
+	// the instructions were saved after optimization, so they go straight to the back-end
+	try
+	{
+		drcuml_block &block(begin_block(persist.scratch.size()));
+		for (std::pair<offs_t, offs_t> const &range : entry.guest)
+			block.add_guest_range(range.first, range.second);
+		block.m_replayed = true;
+		for (uml::instruction const &inst : persist.scratch)
+			block.append() = inst;
+		block.end();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		// leave it to the front-end to make space and compile it
+		return false;
+	}
+	return true;
+}
 
-	// optimize the resulting code first
-	optimize();
 
-	// if we have a logfile, generate a disassembly of the block
-	if (m_drcuml.logging())
-		disassemble();
+//-------------------------------------------------
+//  persist_save - write the saved blocks out, if
+//  any have changed
+//-------------------------------------------------
 
-	// generate the code via the back-end
-	m_drcuml.generate(*this, &m_inst[0], m_nextinst);
+void drcuml_state::persist_save()
+{
+	if (!m_persist || !m_persist->dirty)
+		return;
 
-	// block is no longer in use
-	m_inuse = false;
+	std::vector<u8> data;
+	m_persist->save(data);
+	emu_file file(m_device.machine().options().cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if ((file.open(m_persist->filename) == osd_file::error::NONE) && (file.write(&data[0], data.size()) == data.size()))
+		m_persist->dirty = false;
+	else
+		osd_printf_verbose("Unable to write DRC cache %s\n", m_persist->filename.c_str());
 }
 
 
 //-------------------------------------------------
-//  abort - abort a code block in progress
+//  persist_record - save a block the front-end
+//  identified once it has been generated
 //-------------------------------------------------
 
-void drcuml_block::abort()
+void drcuml_state::persist_record(drcuml_block &block, uml::instruction const *instructions, u32 count)
 {
-	assert(m_inuse);
+	if (!m_persist)
+		return;
+	persist_state &persist(*m_persist);
+
+	// blocks compiled from code we can't read directly can't be checked later
+	persist_state::entry entry;
+	entry.physpc = block.m_persist_physpc;
+	entry.code = block.m_code;
+	entry.guest = block.m_guest;
+	if (entry.code.empty() || !persist.hash(entry.code, entry.hash))
+		return;
 
-	// block is no longer in use
-	m_inuse = false;
+	// comments and no-ops aren't needed; anything else we can't express by name means
+	// the block can't be saved
+	entry.insts.reserve(count);
+	for (u32 inum = 0; inum < count; inum++)
+	{
+		uml::instruction const &inst(instructions[inum]);
+		if ((inst.opcode() == uml::OP_COMMENT) || (inst.opcode() == uml::OP_NOP))
+			continue;
+
+		entry.insts.emplace_back();
+		persist_state::inst &dst(entry.insts.back());
+		dst.opcode = inst.opcode();
+		dst.size = inst.size();
+		dst.condition = inst.condition();
+		dst.flags = inst.flags();
+		dst.numparams = inst.numparams();
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			if (!persist.encode(inst.param(pnum), dst.params[pnum], entry.code))
+				return;
+	}
 
-	// unwind
-	throw abort_compilation();
+	persist.entries[persist_state::key(block.m_persist_mode, block.m_persist_pc)] = std::move(entry);
+	persist.dirty = true;
 }
 
 
 //-------------------------------------------------
-//  append - append an opcode to the block
+//  persist_state - constructor
 //-------------------------------------------------
 
-uml::instruction &drcuml_block::append()
+drcuml_state::persist_state::persist_state(drcuml_state &drcuml, address_space &space, u32 version, std::string &&filename)
+	: drcuml(drcuml)
+	, space(space)
+	, version(version)
+	, filename(std::move(filename))
+	, dirty(false)
 {
-	// get a pointer to the next instruction
-	uml::instruction &curinst(m_inst[m_nextinst++]);
-	if (m_nextinst > m_maxinst)
-		fatalerror("Overran maxinst in drcuml_block_append\n");
+}
 
-	return curinst;
+
+//-------------------------------------------------
+//  name_index - return the index of a name,
+//  adding it if necessary
+//-------------------------------------------------
+
+u16 drcuml_state::persist_state::name_index(std::string const &name)
+{
+	auto const found(nameindex.find(name));
+	if (found != nameindex.end())
+		return found->second;
+	if (names.size() >= NO_NAME)
+		return NO_NAME;
+
+	names.push_back(name);
+	return nameindex.emplace(name, u16(names.size() - 1)).first->second;
 }
 
 
 //-------------------------------------------------
-//  optimize - apply various optimizations to a
-//  block of code
+//  encode - convert a parameter for saving,
+//  returning false if it refers to something
+//  that wasn't registered
 //-------------------------------------------------
 
-void drcuml_block::optimize()
+bool drcuml_state::persist_state::encode(uml::parameter const &src, param &dst, std::vector<std::pair<offs_t, offs_t>> const &code)
 {
-	u32 mapvar[uml::MAPVAR_COUNT] = { 0 };
+	dst.type = src.type();
+	dst.name = NO_NAME;
+	dst.value = src.raw_value();
 
-	// iterate over instructions
-	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	switch (src.type())
 	{
-		uml::instruction &inst(m_inst[instnum]);
+	case uml::parameter::PTYPE_MEMORY:
+		{
+			// registered memory
+			uintptr_t const ptr(uintptr_t(src.raw_value()));
+			auto const next(regions.upper_bound(ptr));
+			if (next != regions.begin())
+			{
+				auto const region(std::prev(next));
+				if ((ptr - region->first) < region->second.first)
+				{
+					dst.name = name_index("m:" + region->second.second);
+					dst.value = ptr - region->first;
+					return dst.name != NO_NAME;
+				}
+			}
 
-		// first compute what flags we need
-		u8 accumflags(0);
-		u8 remainingflags(inst.output_flags());
+			// the guest code itself, which validation reads
+			for (std::pair<offs_t, offs_t> const &range : code)
+			{
+				uintptr_t const base(uintptr_t(space.get_read_ptr(range.first)));
+				if ((base != 0) && (ptr >= base) && ((ptr - base) <= (range.second - range.first)))
+				{
+					dst.name = name_index("c:");
+					dst.value = range.first + (ptr - base);
+					return dst.name != NO_NAME;
+				}
+			}
+			return false;
+		}
 
-		// scan ahead until we run out of possible remaining flags
-		for (int scannum = instnum + 1; remainingflags != 0 && scannum < m_nextinst; scannum++)
+	case uml::parameter::PTYPE_C_FUNCTION:
 		{
-			// any input flags are required
-			uml::instruction const &scan(m_inst[scannum]);
-			accumflags |= scan.input_flags();
+			auto const found(funcname.find(uintptr_t(src.raw_value())));
+			if (found == funcname.end())
+				return false;
+			dst.name = name_index("f:" + found->second);
+			dst.value = 0;
+			return dst.name != NO_NAME;
+		}
 
-			// if the scanahead instruction is unconditional, assume his flags are modified
-			if (scan.condition() == uml::COND_ALWAYS)
-				remainingflags &= ~scan.modified_flags();
+	case uml::parameter::PTYPE_CODE_HANDLE:
+		{
+			// handles are allocated in the same order each time; the name is a sanity check
+			update_handles();
+			auto const found(handleindex.find(reinterpret_cast<uml::code_handle const *>(src.raw_value())));
+			if (found == handleindex.end())
+				return false;
+			dst.name = name_index(util::string_format("h:%u:%s", found->second, handles[found->second]->string()));
+			dst.value = 0;
+			return dst.name != NO_NAME;
 		}
-		inst.set_flags(accumflags);
 
-		// track mapvars
-		if (inst.opcode() == uml::OP_MAPVAR)
-			mapvar[inst.param(0).mapvar() - uml::MAPVAR_M0] = inst.param(1).immediate();
+	case uml::parameter::PTYPE_STRING:
+		return false;
 
-		// convert all mapvar parameters to immediates
-		else if (inst.opcode() != uml::OP_RECOVER)
-			for (int pnum = 0; pnum < inst.numparams(); pnum++)
-				if (inst.param(pnum).is_mapvar())
-					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - uml::MAPVAR_M0]);
+	default:
+		return true;
+	}
+}
 
-		// now that flags are correct, simplify the instruction
-		inst.simplify();
+
+//-------------------------------------------------
+//  decode - convert a saved parameter back,
+//  returning false if what it refers to can't
+//  be found
+//-------------------------------------------------
+
+bool drcuml_state::persist_state::decode(param const &src, uml::parameter &dst)
+{
+	if ((src.type <= uml::parameter::PTYPE_NONE) || (src.type >= uml::parameter::PTYPE_MAX))
+		return false;
+	uml::parameter::parameter_type const type(uml::parameter::parameter_type(src.type));
+	uml::parameter::parameter_value value(src.value);
+
+	if (src.name == NO_NAME)
+	{
+		// anything holding a pointer must have been saved with a name
+		if ((type == uml::parameter::PTYPE_MEMORY) || (type == uml::parameter::PTYPE_C_FUNCTION) || (type == uml::parameter::PTYPE_CODE_HANDLE) || (type == uml::parameter::PTYPE_STRING))
+			return false;
+	}
+	else
+	{
+		if (src.name >= names.size())
+			return false;
+		std::string const &name(names[src.name]);
+		if ((type == uml::parameter::PTYPE_MEMORY) && !name.compare(0, 2, "m:"))
+		{
+			auto const found(regionbase.find(name.substr(2)));
+			auto const region((found != regionbase.end()) ? regions.find(found->second) : regions.end());
+			if ((region == regions.end()) || (src.value >= region->second.first))
+				return false;
+			value = region->first + src.value;
+		}
+		else if ((type == uml::parameter::PTYPE_MEMORY) && (name == "c:"))
+		{
+			value = uintptr_t(space.get_read_ptr(offs_t(src.value)));
+			if (value == 0)
+				return false;
+		}
+		else if ((type == uml::parameter::PTYPE_C_FUNCTION) && !name.compare(0, 2, "f:"))
+		{
+			auto const found(functions.find(name.substr(2)));
+			if (found == functions.end())
+				return false;
+			value = reinterpret_cast<uml::parameter::parameter_value>(found->second);
+		}
+		else if ((type == uml::parameter::PTYPE_CODE_HANDLE) && !name.compare(0, 2, "h:"))
+		{
+			update_handles();
+			unsigned long const index(strtoul(name.c_str() + 2, nullptr, 10));
+			if ((index >= handles.size()) || (name != util::string_format("h:%u:%s", index, handles[index]->string())))
+				return false;
+			value = reinterpret_cast<uml::parameter::parameter_value>(handles[index]);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	dst = uml::parameter::make_raw(type, value);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  hash - compute the hash of a set of guest
+//  code ranges, returning false if any of them
+//  isn't in directly readable memory
+//-------------------------------------------------
+
+bool drcuml_state::persist_state::hash(std::vector<std::pair<offs_t, offs_t>> const &code, util::sha1_t &result) const
+{
+	util::sha1_creator creator;
+	for (std::pair<offs_t, offs_t> const &range : code)
+	{
+		u8 const *const start(reinterpret_cast<u8 const *>(space.get_read_ptr(range.first)));
+		u8 const *const end(reinterpret_cast<u8 const *>(space.get_read_ptr(range.second)));
+		if (!start || !end || ((end - start) != (range.second - range.first)))
+			return false;
+
+		u32 const bounds[2] = { range.first, range.second };
+		creator.append(bounds, sizeof(bounds));
+		creator.append(start, range.second - range.first + 1);
+	}
+	result = creator.finish();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  update_handles - index any handles allocated
+//  since last time
+//-------------------------------------------------
+
+void drcuml_state::persist_state::update_handles()
+{
+	if (handles.size() == drcuml.m_handlelist.size())
+		return;
+	for (auto it = std::next(drcuml.m_handlelist.begin(), handles.size()); it != drcuml.m_handlelist.end(); ++it)
+	{
+		handleindex.emplace(&*it, u32(handles.size()));
+		handles.push_back(&*it);
+	}
+}
+
+
+//-------------------------------------------------
+//  load - parse a saved file, leaving the state
+//  alone unless it's all valid
+//-------------------------------------------------
+
+bool drcuml_state::persist_state::load(std::vector<u8> const &data)
+{
+	// everything is little-endian
+	u8 const *ptr(&data[0]);
+	u8 const *const end(ptr + data.size());
+	bool ok = true;
+	auto const read = [&ptr, end, &ok] (int bytes) -> u64
+	{
+		u64 result = 0;
+		if ((end - ptr) < bytes)
+			ok = false;
+		else
+			for (int byte = 0; byte < bytes; byte++)
+				result |= u64(*ptr++) << (byte * 8);
+		return result;
+	};
+
+	// header
+	if ((read(4) != MAGIC) || (read(4) != FORMAT) || (read(4) != version) || !ok)
+		return false;
+
+	// names
+	std::vector<std::string> newnames;
+	u32 const namecount(read(4));
+	if (!ok || (namecount >= NO_NAME))
+		return false;
+	for (u32 index = 0; index < namecount; index++)
+	{
+		u16 const length(read(2));
+		if (!ok || ((end - ptr) < length))
+			return false;
+		newnames.emplace_back(reinterpret_cast<char const *>(ptr), length);
+		ptr += length;
+	}
+
+	// blocks; counts are checked against what's left before allocating anything
+	std::unordered_map<u64, entry> newentries;
+	u32 const entrycount(read(4));
+	for (u32 index = 0; ok && (index < entrycount); index++)
+	{
+		u32 const mode(read(4));
+		offs_t const pc(read(4));
+		entry block;
+		block.physpc = read(4);
+		if (!ok || ((end - ptr) < sizeof(block.hash.m_raw)))
+			return false;
+		memcpy(block.hash.m_raw, ptr, sizeof(block.hash.m_raw));
+		ptr += sizeof(block.hash.m_raw);
+
+		for (std::vector<std::pair<offs_t, offs_t>> *ranges : { &block.code, &block.guest })
+		{
+			u32 const count(read(4));
+			if (!ok || (count > ((end - ptr) / 8)))
+				return false;
+			for (u32 rnum = 0; rnum < count; rnum++)
+			{
+				offs_t const start(read(4));
+				ranges->emplace_back(start, offs_t(read(4)));
+			}
+		}
+
+		u32 const count(read(4));
+		if (!ok || (count > ((end - ptr) / 5)))
+			return false;
+		block.insts.resize(count);
+		for (inst &cur : block.insts)
+		{
+			cur.opcode = read(1);
+			cur.size = read(1);
+			cur.condition = read(1);
+			cur.flags = read(1);
+			cur.numparams = read(1);
+			if (cur.numparams > uml::instruction::MAX_PARAMS)
+				return false;
+			for (int pnum = 0; pnum < cur.numparams; pnum++)
+			{
+				cur.params[pnum].type = read(1);
+				cur.params[pnum].name = read(2);
+				cur.params[pnum].value = read(8);
+				if ((cur.params[pnum].name != NO_NAME) && (cur.params[pnum].name >= newnames.size()))
+					return false;
+			}
+		}
+		newentries[key(mode, pc)] = std::move(block);
+	}
+	if (!ok || (ptr != end))
+		return false;
+
+	// it's all good
+	names = std::move(newnames);
+	nameindex.clear();
+	for (size_t index = 0; index < names.size(); index++)
+		nameindex.emplace(names[index], u16(index));
+	entries = std::move(newentries);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  save - build the file contents
+//-------------------------------------------------
+
+void drcuml_state::persist_state::save(std::vector<u8> &data) const
+{
+	auto const write = [&data] (u64 value, int bytes)
+	{
+		for (int byte = 0; byte < bytes; byte++)
+			data.push_back(u8(value >> (byte * 8)));
+	};
+
+	// header
+	write(MAGIC, 4);
+	write(FORMAT, 4);
+	write(version, 4);
+
+	// names
+	write(names.size(), 4);
+	for (std::string const &name : names)
+	{
+		write(name.length(), 2);
+		data.insert(data.end(), name.begin(), name.end());
 	}
+
+	// blocks
+	write(entries.size(), 4);
+	for (auto const &block : entries)
+	{
+		write(block.first >> 32, 4);
+		write(block.first, 4);
+		write(block.second.physpc, 4);
+		data.insert(data.end(), std::begin(block.second.hash.m_raw), std::end(block.second.hash.m_raw));
+		for (std::vector<std::pair<offs_t, offs_t>> const *ranges : { &block.second.code, &block.second.guest })
+		{
+			write(ranges->size(), 4);
+			for (std::pair<offs_t, offs_t> const &range : *ranges)
+			{
+				write(range.first, 4);
+				write(range.second, 4);
+			}
+		}
+		write(block.second.insts.size(), 4);
+		for (inst const &cur : block.second.insts)
+		{
+			write(cur.opcode, 1);
+			write(cur.size, 1);
+			write(cur.condition, 1);
+			write(cur.flags, 1);
+			write(cur.numparams, 1);
+			for (int pnum = 0; pnum < cur.numparams; pnum++)
+			{
+				write(cur.params[pnum].type, 1);
+				write(cur.params[pnum].name, 2);
+				write(cur.params[pnum].value, 8);
+			}
+		}
+	}
+}
+
+
+
+//**************************************************************************
+//  DRCUML OPTIMIZER
+//**************************************************************************
+
+//-------------------------------------------------
+//  optimize - run each pass over a list of
+//  instructions
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize(uml::instruction *instlist, u32 numinst)
+{
+	// mapvars must be immediates before flags can be computed
+	convert_mapvars(instlist, numinst);
+
+	// work out which flags are actually consumed
+	compute_flags(instlist, numinst);
+
+	// now that flags are correct, forward known values and simplify
+	propagate_values(instlist, numinst);
+}
+
+
+//-------------------------------------------------
+//  optimize_local - compute flags by scanning
+//  ahead from each instruction without following
+//  jumps, convert mapvars and simplify; nothing
+//  is forwarded between instructions
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize_local(uml::instruction *instlist, u32 numinst)
+{
+	u32 mapvar[uml::MAPVAR_COUNT] = { 0 };
+
+	// iterate over instructions
+	for (u32 instnum = 0; instnum < numinst; instnum++)
+	{
+		uml::instruction &inst(instlist[instnum]);
+
+		// first compute what flags we need
+		u8 accumflags(0);
+		u8 remainingflags(inst.output_flags());
+
+		// scan ahead until we run out of possible remaining flags
+		for (u32 scannum = instnum + 1; remainingflags != 0 && scannum < numinst; scannum++)
+		{
+			// any input flags are required
+			uml::instruction const &scan(instlist[scannum]);
+			accumflags |= scan.input_flags();
+
+			// if the scanahead instruction is unconditional, assume his flags are modified
+			if (scan.condition() == uml::COND_ALWAYS)
+				remainingflags &= ~scan.modified_flags();
+		}
+		inst.set_flags(accumflags);
+
+		// track mapvars
+		if (inst.opcode() == uml::OP_MAPVAR)
+			mapvar[inst.param(0).mapvar() - uml::MAPVAR_M0] = inst.param(1).immediate();
+
+		// convert all mapvar parameters to immediates
+		else if (inst.opcode() != uml::OP_RECOVER)
+			for (int pnum = 0; pnum < inst.numparams(); pnum++)
+				if (inst.param(pnum).is_mapvar())
+					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - uml::MAPVAR_M0]);
+
+		// now that flags are correct, simplify the instruction
+		inst.simplify();
+	}
+}
+
+
+//-------------------------------------------------
+//  convert_mapvars - replace mapvar parameters
+//  with the values in effect at each instruction
+//-------------------------------------------------
+
+void drcuml_optimizer::convert_mapvars(uml::instruction *instlist, u32 numinst)
+{
+	u32 mapvar[uml::MAPVAR_COUNT] = { 0 };
+
+	for (u32 instnum = 0; instnum < numinst; instnum++)
+	{
+		uml::instruction &inst(instlist[instnum]);
+
+		// track mapvars
+		if (inst.opcode() == uml::OP_MAPVAR)
+			mapvar[inst.param(0).mapvar() - uml::MAPVAR_M0] = inst.param(1).immediate();
+
+		// convert all mapvar parameters to immediates
+		else if (inst.opcode() != uml::OP_RECOVER)
+			for (int pnum = 0; pnum < inst.numparams(); pnum++)
+				if (inst.param(pnum).is_mapvar())
+					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - uml::MAPVAR_M0]);
+	}
+}
+
+
+//-------------------------------------------------
+//  compute_flags - backwards liveness analysis
+//  of the flags, so each instruction only
+//  produces the flags something later reads
+//-------------------------------------------------
+
+void drcuml_optimizer::compute_flags(uml::instruction *instlist, u32 numinst)
+{
+	// flags are dead at the end of the block; iterate until the flags live at
+	// each label settle, which only takes more than one pass for backward jumps
+	m_labelflags.clear();
+	bool changed;
+	do
+	{
+		changed = false;
+		u8 live(0);
+		for (u32 instnum = numinst; instnum-- > 0; )
+		{
+			uml::instruction &inst(instlist[instnum]);
+
+			// labels remember what is live on entry for jumps to them
+			if (inst.opcode() == uml::OP_LABEL)
+			{
+				u8 &labelflags(m_labelflags[inst.param(0).label()]);
+				if ((labelflags | live) != labelflags)
+				{
+					labelflags |= live;
+					changed = true;
+				}
+			}
+
+			// jumps also need whatever is live at their target
+			else if (inst.opcode() == uml::OP_JMP)
+			{
+				u8 const target(m_labelflags[inst.param(0).label()]);
+				live = (inst.condition() == uml::COND_ALWAYS) ? target : (live | target);
+			}
+
+			// only produce flags that are live afterwards
+			inst.set_flags(live & inst.output_flags());
+
+			// unconditional instructions kill the flags they modify
+			if (inst.condition() == uml::COND_ALWAYS)
+				live &= ~inst.modified_flags();
+			live |= inst.input_flags();
+		}
+	}
+	while (changed);
+}
+
+
+//-------------------------------------------------
+//  propagate_values - forward constants and
+//  stored values into later instructions within
+//  each straight-line run, dropping moves that
+//  would leave their destination unchanged
+//-------------------------------------------------
+
+void drcuml_optimizer::propagate_values(uml::instruction *instlist, u32 numinst)
+{
+	reset_values();
+	for (u32 instnum = 0; instnum < numinst; instnum++)
+	{
+		uml::instruction &inst(instlist[instnum]);
+
+		// entry points can be reached from anywhere
+		if (inst.opcode() == uml::OP_HANDLE || inst.opcode() == uml::OP_HASH || inst.opcode() == uml::OP_LABEL)
+			reset_values();
+
+		// replace register and memory inputs with known values
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			if ((inst.param(pnum).is_int_register() || inst.param(pnum).is_memory()) && inst.param_is_input(pnum) && !inst.param_is_output(pnum))
+				forward_value(inst, pnum);
+
+		// a move of what's already there does nothing; otherwise simplify
+		if (inst.opcode() == uml::OP_MOV && inst.condition() == uml::COND_ALWAYS && value_matches(inst.param(0), inst.param(1), inst.size()))
+			inst.nop();
+		else
+			inst.simplify();
+
+		switch (inst.opcode())
+		{
+			// anything may change across subroutines, exceptions and the debugger
+			case uml::OP_DEBUG:
+			case uml::OP_EXIT:
+			case uml::OP_HASHJMP:
+			case uml::OP_EXH:
+			case uml::OP_CALLH:
+			case uml::OP_RET:
+			case uml::OP_RESTORE:
+				reset_values();
+				continue;
+
+			// memory may change through pointers and callbacks; registers are preserved
+			case uml::OP_CALLC:
+			case uml::OP_SAVE:
+			case uml::OP_STORE:
+			case uml::OP_READ:
+			case uml::OP_READM:
+			case uml::OP_WRITE:
+			case uml::OP_WRITEM:
+			case uml::OP_FSTORE:
+			case uml::OP_FREAD:
+			case uml::OP_FWRITE:
+				m_memvalues.clear();
+				break;
+
+			default:
+				break;
+		}
+
+		// forget anything the instruction writes
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			uml::parameter const &param(inst.param(pnum));
+			if ((param.is_int_register() || param.is_memory()) && inst.param_is_output(pnum))
+			{
+				if (param.is_int_register())
+					forget_register(param.ireg() - uml::REG_I0);
+				else if (param.is_memory())
+				{
+					u8 const size(inst.param_size(pnum));
+					if (size != 0)
+						forget_memory(uintptr_t(param.memory()), size);
+					else
+						m_memvalues.clear();
+				}
+			}
+		}
+
+		// an unconditional move leaves its destination known
+		if (inst.opcode() == uml::OP_MOV && inst.condition() == uml::COND_ALWAYS)
+			remember_value(inst.param(0), inst.param(1), inst.size());
+	}
+}
+
+
+//-------------------------------------------------
+//  reset_values - forget all known values
+//-------------------------------------------------
+
+void drcuml_optimizer::reset_values()
+{
+	std::fill(std::begin(m_regsize), std::end(m_regsize), 0);
+	m_memvalues.clear();
+}
+
+
+//-------------------------------------------------
+//  forward_value - replace an input parameter
+//  with its known value, if the opcode accepts
+//  it
+//-------------------------------------------------
+
+void drcuml_optimizer::forward_value(uml::instruction &inst, int paramnum)
+{
+	u8 const size(inst.param_size(paramnum));
+	if (size == 0)
+		return;
+
+	uml::parameter const &param(inst.param(paramnum));
+	u64 const sizemask((size == 4) ? 0xffffffffU : ~u64(0));
+
+	// registers are forwarded as constants; a 32-bit read can use a 64-bit value
+	if (param.is_int_register())
+	{
+		int const regnum(param.ireg() - uml::REG_I0);
+		if (m_regsize[regnum] >= size && inst.param_allows(paramnum, uml::parameter::PTYPE_IMMEDIATE))
+			inst.set_param(paramnum, m_regvalue[regnum] & sizemask);
+	}
+
+	// memory is forwarded as whatever was last stored to or loaded from it
+	else if (param.is_memory())
+	{
+		memory_value const *const known(find_memory(uintptr_t(param.memory()), size));
+		if (known && inst.param_allows(paramnum, known->value.type()))
+		{
+			if (known->value.is_immediate())
+				inst.set_param(paramnum, known->value.immediate() & sizemask);
+			else
+				inst.set_param(paramnum, known->value);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  value_matches - return true if a destination
+//  is known to already hold a value
+//-------------------------------------------------
+
+bool drcuml_optimizer::value_matches(uml::parameter const &dst, uml::parameter const &src, u8 size) const
+{
+	u64 const sizemask((size == 4) ? 0xffffffffU : ~u64(0));
+
+	// require the exact size for registers, since 32-bit writes don't treat the upper half the same on every back-end
+	if (dst.is_int_register())
+	{
+		int const regnum(dst.ireg() - uml::REG_I0);
+		return src.is_immediate() && (m_regsize[regnum] == size) && (m_regvalue[regnum] == (src.immediate() & sizemask));
+	}
+	else if (dst.is_memory())
+	{
+		memory_value const *const known(find_memory(uintptr_t(dst.memory()), size));
+		if (!known)
+			return false;
+		if (known->value.is_immediate())
+			return src.is_immediate() && ((src.immediate() & sizemask) == known->value.immediate());
+		return src == known->value;
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  forget_register - forget a register's value
+//  and any memory known to match it
+//-------------------------------------------------
+
+void drcuml_optimizer::forget_register(int regnum)
+{
+	m_regsize[regnum] = 0;
+
+	uml::parameter const reg(uml::parameter::make_ireg(uml::REG_I0 + regnum));
+	m_memvalues.erase(
+			std::remove_if(m_memvalues.begin(), m_memvalues.end(), [&reg] (memory_value const &known) { return known.value == reg; }),
+			m_memvalues.end());
+}
+
+
+//-------------------------------------------------
+//  forget_memory - forget the value of any
+//  memory overlapping a range
+//-------------------------------------------------
+
+void drcuml_optimizer::forget_memory(uintptr_t base, u8 size)
+{
+	m_memvalues.erase(
+			std::remove_if(m_memvalues.begin(), m_memvalues.end(), [base, size] (memory_value const &known) { return (known.base < base + size) && (base < known.base + known.size); }),
+			m_memvalues.end());
+}
+
+
+//-------------------------------------------------
+//  remember_value - note the result of an
+//  unconditional move
+//-------------------------------------------------
+
+void drcuml_optimizer::remember_value(uml::parameter const &dst, uml::parameter const &src, u8 size)
+{
+	u64 const sizemask((size == 4) ? 0xffffffffU : ~u64(0));
+
+	// a register loaded with a constant
+	if (dst.is_int_register())
+	{
+		int const regnum(dst.ireg() - uml::REG_I0);
+		if (src.is_immediate())
+		{
+			m_regvalue[regnum] = src.immediate() & sizemask;
+			m_regsize[regnum] = size;
+			return;
+		}
+
+		// a register loaded from memory stands in for it from now on
+		if (!src.is_memory())
+			return;
+		if (m_memvalues.size() >= MAX_MEMORY_VALUES)
+			m_memvalues.erase(m_memvalues.begin());
+		m_memvalues.push_back(memory_value{ uintptr_t(src.memory()), size, dst });
+	}
+
+	// memory stored from a constant or a register
+	else if (dst.is_memory() && (src.is_immediate() || src.is_int_register()))
+	{
+		if (m_memvalues.size() >= MAX_MEMORY_VALUES)
+			m_memvalues.erase(m_memvalues.begin());
+		m_memvalues.push_back(memory_value{ uintptr_t(dst.memory()), size, src.is_immediate() ? uml::parameter(src.immediate() & sizemask) : src });
+	}
+}
+
+
+//-------------------------------------------------
+//  find_memory - find the known value of a
+//  memory location of a given size
+//-------------------------------------------------
+
+drcuml_optimizer::memory_value const *drcuml_optimizer::find_memory(uintptr_t base, u8 size) const
+{
+	for (memory_value const &known : m_memvalues)
+		if (known.base == base && known.size == size)
+			return &known;
+	return nullptr;
+}
+
+
+
+//**************************************************************************
+//  DRCUML BLOCK
+//**************************************************************************
+
+//-------------------------------------------------
+//  drcuml_block - constructor
+//-------------------------------------------------
+
+drcuml_block::drcuml_block(drcuml_state &drcuml, u32 maxinst)
+	: m_drcuml(drcuml)
+	, m_nextinst(0)
+	, m_maxinst(maxinst * 3/2)
+	, m_inst(m_maxinst)
+	, m_inuse(false)
+	, m_persist(false)
+	, m_replayed(false)
+	, m_persist_mode(0)
+	, m_persist_pc(0)
+	, m_persist_physpc(0)
+{
+}
+
+
+//-------------------------------------------------
+//  ~drcuml_block - destructor
+//-------------------------------------------------
+
+drcuml_block::~drcuml_block()
+{
+}
+
+
+//-------------------------------------------------
+//  begin - begin code generation
+//-------------------------------------------------
+
+void drcuml_block::begin()
+{
+	// set up the block information and return it
+	m_inuse = true;
+	m_nextinst = 0;
+	m_guest.clear();
+	m_persist = false;
+	m_replayed = false;
+	m_code.clear();
+}
+
+
+//-------------------------------------------------
+//  end - complete a code block and commit it to
+//  the cache via the back-end
+//-------------------------------------------------
+
+void drcuml_block::end()
+{
+	assert(m_inuse);
+
+	// optimize the resulting code first, unless it was saved that way
+	if (!m_replayed)
+		optimize();
+
+	// if we have a logfile, generate a disassembly of the block
+	if (m_drcuml.logging())
+		disassemble();
+
+	// generate the code via the back-end
+	m_drcuml.generate(*this, &m_inst[0], m_nextinst);
+
+	// keep a copy for later sessions if the front-end identified it
+	if (m_persist)
+		m_drcuml.persist_record(*this, &m_inst[0], m_nextinst);
+
+	// block is no longer in use
+	m_inuse = false;
+}
+
+
+//-------------------------------------------------
+//  abort - abort a code block in progress
+//-------------------------------------------------
+
+void drcuml_block::abort()
+{
+	assert(m_inuse);
+
+	// block is no longer in use
+	m_inuse = false;
+
+	// unwind
+	throw abort_compilation();
+}
+
+
+//-------------------------------------------------
+//  append - append an opcode to the block
+//-------------------------------------------------
+
+uml::instruction &drcuml_block::append()
+{
+	// get a pointer to the next instruction
+	uml::instruction &curinst(m_inst[m_nextinst++]);
+	if (m_nextinst > m_maxinst)
+		fatalerror("Overran maxinst in drcuml_block_append\n");
+
+	return curinst;
+}
+
+
+//-------------------------------------------------
+//  add_guest_range - note a range of guest code,
+//  inclusive, that the block was compiled from
+//-------------------------------------------------
+
+void drcuml_block::add_guest_range(offs_t start, offs_t end)
+{
+	assert(m_inuse);
+	if (start > end)
+		std::swap(start, end);
+
+	// extend the last range if this continues it
+	if (!m_guest.empty() && (m_guest.back().second + 1 >= start) && (m_guest.back().first <= start))
+		m_guest.back().second = std::max(m_guest.back().second, end);
+	else
+		m_guest.emplace_back(start, end);
+}
+
+
+//-------------------------------------------------
+//  set_persist_key - identify the block so it
+//  can be saved to the persistent cache; only
+//  blocks compiled the same way whatever else is
+//  in the cache should be identified
+//-------------------------------------------------
+
+void drcuml_block::set_persist_key(u32 mode, offs_t pc, offs_t physpc)
+{
+	assert(m_inuse);
+	m_persist = m_drcuml.persist_enabled();
+	m_persist_mode = mode;
+	m_persist_pc = pc;
+	m_persist_physpc = physpc;
+}
+
+
+//-------------------------------------------------
+//  add_code_range - note a range of guest code,
+//  inclusive, whose contents the block depends
+//  on, whether or not it can be invalidated
+//-------------------------------------------------
+
+void drcuml_block::add_code_range(offs_t start, offs_t end)
+{
+	assert(m_inuse);
+	if (start > end)
+		std::swap(start, end);
+
+	// extend the last range if this continues it
+	if (!m_code.empty() && (m_code.back().second + 1 >= start) && (m_code.back().first <= start))
+		m_code.back().second = std::max(m_code.back().second, end);
+	else
+		m_code.emplace_back(start, end);
+}
+
+
+//-------------------------------------------------
+//  optimize - apply various optimizations to a
+//  block of code
+//-------------------------------------------------
+
+void drcuml_block::optimize()
+{
+	// the block-level passes are opt-in until their output has been checked
+	// against unoptimized code on a back-end
+	if (m_drcuml.block_optimizer())
+		m_optimizer.optimize(&m_inst[0], m_nextinst);
+	else
+		m_optimizer.optimize_local(&m_inst[0], m_nextinst);
 }
 
 
@@ -18,6 +18,8 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 
@@ -80,6 +82,49 @@ struct drcbe_info
 };
 
 
+// block-level optimizer, run over a block's instructions before they are
+// handed to the back-end
+class drcuml_optimizer
+{
+public:
+	// optimize a list of instructions in place, with the block-level passes or
+	// only looking at one instruction at a time
+	void optimize(uml::instruction *instlist, u32 numinst);
+	void optimize_local(uml::instruction *instlist, u32 numinst);
+
+private:
+	// a memory location whose contents are known to match an immediate or register
+	struct memory_value
+	{
+		uintptr_t       base;                   // address of the location
+		u8              size;                   // size in bytes
+		uml::parameter  value;                  // immediate or integer register holding the contents
+	};
+
+	static constexpr unsigned MAX_MEMORY_VALUES = 16;
+
+	// individual passes
+	void convert_mapvars(uml::instruction *instlist, u32 numinst);
+	void compute_flags(uml::instruction *instlist, u32 numinst);
+	void propagate_values(uml::instruction *instlist, u32 numinst);
+
+	// value tracking helpers
+	void reset_values();
+	void forward_value(uml::instruction &inst, int paramnum);
+	bool value_matches(uml::parameter const &dst, uml::parameter const &src, u8 size) const;
+	void forget_register(int regnum);
+	void forget_memory(uintptr_t base, u8 size);
+	void remember_value(uml::parameter const &dst, uml::parameter const &src, u8 size);
+	memory_value const *find_memory(uintptr_t base, u8 size) const;
+
+	// internal state
+	std::unordered_map<u32, u8>     m_labelflags;                       // flags live at each label
+	u64                             m_regvalue[uml::REG_I_COUNT];       // known integer register contents
+	u8                              m_regsize[uml::REG_I_COUNT];        // size the contents are known for, or 0
+	std::vector<memory_value>       m_memvalues;                        // known memory contents
+};
+
+
 // a drcuml_block describes a basic block of instructions
 class drcuml_block
 {
@@ -93,6 +138,7 @@ public:
 	// getters
 	bool inuse() const { return m_inuse; }
 	u32 maxinst() const { return m_maxinst; }
+	std::vector<std::pair<offs_t, offs_t>> const &guest_ranges() const { return m_guest; }
 
 	// code generation
 	void begin();
@@ -103,6 +149,13 @@ public:
 	uml::instruction &append();
 	template <typename Format, typename... Params> void append_comment(Format &&fmt, Params &&... args);
 
+	// note guest code the block was compiled from, so it can be invalidated
+	void add_guest_range(offs_t start, offs_t end);
+
+	// identify the block for the persistent cache, and note the code it depends on
+	void set_persist_key(u32 mode, offs_t pc, offs_t physpc);
+	void add_code_range(offs_t start, offs_t end);
+
 	// this class is thrown if abort() is called
 	class abort_compilation : public emu_exception
 	{
@@ -111,6 +164,8 @@ public:
 	};
 
 private:
+	friend class drcuml_state;
+
 	// internal helpers
 	void optimize();
 	void disassemble();
@@ -122,6 +177,14 @@ private:
 	u32                             m_maxinst;  // maximum number of instructions
 	std::vector<uml::instruction>   m_inst;     // pointer to the instruction list
 	bool                            m_inuse;    // this block is in use
+	std::vector<std::pair<offs_t, offs_t>> m_guest; // guest code ranges covered
+	drcuml_optimizer                m_optimizer; // optimizer state, reused between blocks
+	bool                            m_persist;  // save this block to the persistent cache
+	bool                            m_replayed; // block was loaded from the persistent cache
+	u32                             m_persist_mode; // mode the block was compiled for
+	offs_t                          m_persist_pc; // logical PC the block was compiled for
+	offs_t                          m_persist_physpc; // physical PC the block was compiled for
+	std::vector<std::pair<offs_t, offs_t>> m_code; // guest code ranges the block was compiled from
 };
 
 
@@ -137,6 +200,7 @@ public:
 	virtual int execute(uml::code_handle &entry) = 0;
 	virtual void generate(drcuml_block &block, uml::instruction const *instlist, u32 numinst) = 0;
 	virtual bool hash_exists(u32 mode, u32 pc) = 0;
+	virtual void hash_reset(u32 mode, u32 pc, drccodeptr start, drccodeptr end) = 0;
 	virtual void get_info(drcbe_info &info) = 0;
 	virtual bool logging() const { return false; }
 
@@ -176,7 +240,10 @@ public:
 	// back-end interface
 	void get_backend_info(drcbe_info &info) { m_beintf->get_info(info); }
 	bool hash_exists(u32 mode, u32 pc) { return m_beintf->hash_exists(mode, pc); }
-	void generate(drcuml_block &block, uml::instruction *instructions, u32 count) { m_beintf->generate(block, instructions, count); }
+	void generate(drcuml_block &block, uml::instruction *instructions, u32 count);
+
+	// code invalidation
+	u32 invalidate_range(offs_t start, offs_t end);
 
 	// handle management
 	uml::code_handle *handle_alloc(char const *name);
@@ -185,6 +252,14 @@ public:
 	void symbol_add(void *base, u32 length, char const *name);
 	char const *symbol_find(void *base, u32 *offset = nullptr);
 
+	// persistent translation cache
+	bool persist_open(u32 version);
+	bool persist_enabled() const { return bool(m_persist); }
+	void persist_region(void const *base, size_t length, char const *name);
+	void persist_function(uml::c_function func, char const *name);
+	bool persist_replay(u32 mode, offs_t pc, offs_t physpc);
+	void persist_save();
+
 	// logging
 	bool logging() const { return bool(m_umllog); }
 	template <typename Format, typename... Params>
@@ -196,7 +271,12 @@ public:
 	void log_flush() { if (logging()) m_umllog->flush(); }
 	bool logging_native() const { return m_beintf->logging(); }
 
+	// optimization
+	bool block_optimizer() const { return m_optimize; }
+
 private:
+	friend class drcuml_block;
+
 	// symbol class
 	class symbol
 	{
@@ -220,14 +300,43 @@ private:
 		std::string m_name;     // name of the symbol
 	};
 
+	// generated code that can be invalidated
+	struct code_block
+	{
+		drccodeptr                              start;      // start of the block's code
+		drccodeptr                              end;        // end of the block's code
+		std::vector<std::pair<u32, u32>>        hashes;     // mode/pc entries the block defines
+		std::vector<std::pair<offs_t, offs_t>>  ranges;     // guest code ranges covered
+	};
+	typedef std::list<code_block>::iterator code_block_ref;
+
+	// guest code is tracked in pages of this size
+	static constexpr int GUEST_PAGE_SHIFT = 12;
+
+	// backends reserve this much per instruction for code; double it to leave room
+	// for out-of-band code and the map table when reusing reclaimed space (the
+	// cache adds its own hard bound on top of this)
+	static constexpr u32 REUSE_BYTES_PER_INST = 8 * 4 * 2;
+
+	// persistent cache state, defined internally
+	struct persist_state;
+
+	// internal helpers
+	void discard_block(code_block_ref block);
+	void persist_record(drcuml_block &block, uml::instruction const *instructions, u32 count);
+
 	// internal state
 	device_t &                              m_device;           // CPU device we are associated with
 	drc_cache &                             m_cache;            // pointer to the codegen cache
 	std::unique_ptr<drcbe_interface> const  m_beintf;           // backend interface pointer
 	std::unique_ptr<std::ostream> const     m_umllog;           // handle to the UML logfile
+	bool const                              m_optimize;         // run the block-level optimizer?
 	std::list<drcuml_block>                 m_blocklist;        // list of active blocks
 	std::list<uml::code_handle>             m_handlelist;       // list of active handles
 	std::list<symbol>                       m_symlist;          // list of symbols
+	std::list<code_block>                   m_codeblocks;       // blocks that can be invalidated
+	std::unordered_map<offs_t, std::vector<code_block_ref>> m_codepages; // blocks covering each guest page
+	std::unique_ptr<persist_state>          m_persist;          // persistent cache, if open
 };
 
 
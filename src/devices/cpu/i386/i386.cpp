@@ -61,6 +61,9 @@ i386_device::i386_device(const machine_config &mconfig, device_type type, const
 {
 	// 32 unified
 	set_vtlb_dynamic_entries(32);
+
+	// translations evicted from the small TLB are kept until CR3 is reloaded
+	set_vtlb_cache_entries(4096);
 }
 
 i386sx_device::i386sx_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock)
@@ -291,6 +294,12 @@ bool i386_device::translate_address(int pl, int type, uint32_t *address, uint32_
 	uint32_t test_addr = *address;
 #endif
 
+	if (!(entry & VTLB_FLAG_VALID) || ((type & TRANSLATE_WRITE) && !(entry & VTLB_FLAG_DIRTY)))
+	{
+		// the page may still be in the second-level cache
+		if (vtlb_dynreload(index))
+			entry = table[index];
+	}
 	if (!(entry & VTLB_FLAG_VALID) || ((type & TRANSLATE_WRITE) && !(entry & VTLB_FLAG_DIRTY)))
 	{
 		if (!i386_translate_address(type, address, &entry))
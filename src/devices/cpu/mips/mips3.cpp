@@ -174,6 +174,8 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	, m_drcfe(nullptr)
 	, m_drcoptions(0)
 	, m_drc_cache_dirty(0)
+	, m_drcbg(nullptr)
+	, m_compile_replace(false)
 	, m_entry(nullptr)
 	, m_nocode(nullptr)
 	, m_out_of_cycles(nullptr)
@@ -223,6 +225,9 @@ device_memory_interface::space_config_vector mips3_device::memory_space_config()
 
 void mips3_device::device_stop()
 {
+	m_drcbg = nullptr;
+	if (m_drcuml != nullptr)
+		m_drcuml->persist_save();
 	if (m_drcfe != nullptr)
 	{
 		m_drcfe = nullptr;
@@ -489,6 +494,14 @@ void mips3_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<mips3_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
+	/* compile misses on a worker thread if requested, interpreting in the meantime; */
+	/* blocks generated there aren't saved, since recording them hashes guest memory */
+	if (m_isdrc)
+		m_drcbg = std::make_unique<drc_background_compiler>(*this,
+				[this] (u8 mode, offs_t pc) { return code_describe_block(mode, pc, m_compile_replace); },
+				[this] (u8 mode, offs_t pc, const opcode_desc *desclist, bool background) { code_generate_block(mode, pc, desclist, m_compile_replace && !background, !background); },
+				[this] () { code_interpret_background(); });
+
 	/* allocate memory for cache-local state and initialize it */
 	memcpy(m_fpmode, fpmode_source, sizeof(fpmode_source));
 
@@ -5073,10 +5086,17 @@ void mips3_device::execute_run()
 			/* run as much as we can */
 			execute_result = m_drcuml->execute(*m_entry);
 
-			/* if we need to recompile, do it */
+			/* if we need to recompile, do it; a background compile interprets the rest of */
+			/* the timeslice, and blocks that failed validation are always done here */
 			if (execute_result == EXECUTE_MISSING_CODE)
 			{
-				code_compile_block(m_core->mode, m_core->pc);
+				if (m_drcbg->enabled() && !m_drcuml->hash_exists(m_core->mode, m_core->pc))
+				{
+					if (m_drcbg->compile(m_core->mode, m_core->pc))
+						return;
+				}
+				else
+					code_compile_block(m_core->mode, m_core->pc);
 			}
 			else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			{
@@ -5092,6 +5112,17 @@ void mips3_device::execute_run()
 		return;
 	}
 
+	interpreter_run();
+}
+
+
+/*-------------------------------------------------
+    interpreter_run - execute instructions with
+    the interpreter until out of cycles
+-------------------------------------------------*/
+
+void mips3_device::interpreter_run()
+{
 	/* count cycles and interrupt cycles */
 	m_core->icount -= m_interrupt_cycles;
 	m_interrupt_cycles = 0;
@@ -470,6 +470,8 @@ protected:
 
 												/* internal stuff */
 	uint8_t         m_drc_cache_dirty;          /* true if we need to flush the cache */
+	std::unique_ptr<drc_background_compiler> m_drcbg; /* background compiler, or nullptr */
+	bool            m_compile_replace;          /* true if the block being described replaces one that failed validation */
 
 												/* tables */
 	uint8_t         m_fpmode[4];                /* FPU mode table */
@@ -585,7 +587,12 @@ private:
 	void load_fast_iregs(drcuml_block &block);
 	void save_fast_iregs(drcuml_block &block);
 	void code_flush_cache();
+	void code_persist_setup();
 	void code_compile_block(uint8_t mode, offs_t pc);
+	const opcode_desc *code_describe_block(uint8_t mode, offs_t pc, bool &replace);
+	void code_generate_block(uint8_t mode, offs_t pc, const opcode_desc *desclist, bool replace, bool persist);
+	void code_interpret_background();
+	void interpreter_run();
 public:
 	void func_get_cycles();
 	void func_printf_exception();
@@ -24,6 +24,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "debugger.h"
 #include "mips3com.h"
 #include "mips3fe.h"
@@ -32,6 +33,7 @@
 #include "cpu/drcfe.h"
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
+#include "coreutil.h"
 
 
 /***************************************************************************
@@ -64,15 +66,27 @@
 #define FCCSHIFT(which)         fcc_shift[(m_flavor < MIPS3_TYPE_MIPS_IV) ? 0 : ((which) & 7)]
 #define FCCMASK(which)          (uint32_t(1 << FCCSHIFT(which)))
 
+/* change this whenever the same code would be translated differently, to
+   discard blocks saved by -drc_cache */
+#define DRC_CACHE_VERSION       1
+
 
 
 /***************************************************************************
     FUNCTION PROTOTYPES
 ***************************************************************************/
 
+static void cfunc_mips3com_update_cycle_counting(void *param);
+static void cfunc_mips3com_asid_changed(void *param);
+static void cfunc_mips3com_tlbr(void *param);
+static void cfunc_mips3com_tlbwi(void *param);
+static void cfunc_mips3com_tlbwr(void *param);
+static void cfunc_mips3com_tlbp(void *param);
 static void cfunc_printf_exception(void *param);
+static void cfunc_printf_debug(void *param);
 static void cfunc_get_cycles(void *param);
 static void cfunc_printf_probe(void *param);
+static void cfunc_unimplemented(void *param);
 
 
 /***************************************************************************
@@ -269,6 +283,49 @@ void mips3_device::code_flush_cache()
 	{
 		fatalerror("Unrecoverable error generating static code\n");
 	}
+
+	/* now the handles exist, blocks can be saved and restored */
+	code_persist_setup();
+}
+
+
+/*-------------------------------------------------
+    code_persist_setup - open the persistent
+    cache, naming everything compiled blocks may
+    refer to
+-------------------------------------------------*/
+
+void mips3_device::code_persist_setup()
+{
+	/* everything that affects translation is part of the version */
+	std::vector<uint32_t> config = { DRC_CACHE_VERSION, uint32_t(m_flavor), m_bigendian, m_data_bits, m_drcoptions, (machine().debug_flags & DEBUG_FLAG_ENABLED) != 0 };
+
+	/* blocks refer to offsets within this build's layout of the core and device, */
+	/* so tie them to the build too; the sizes catch a rebuilt tree with local changes */
+	const char *const build = emulator_info::get_build_version();
+	config.insert(config.end(), { core_crc32(0, reinterpret_cast<const uint8_t *>(build), strlen(build)), uint32_t(sizeof(*m_core)), uint32_t(sizeof(*this)), machine().options().drc_optimize() });
+	for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+		config.insert(config.end(), { m_fastram[ramnum].start, m_fastram[ramnum].end, m_fastram[ramnum].readonly });
+	for (int hotnum = 0; hotnum < m_hotspot_select; hotnum++)
+		config.insert(config.end(), { m_hotspot[hotnum].pc, m_hotspot[hotnum].opcode, m_hotspot[hotnum].cycles });
+	if (!m_drcuml->persist_open(core_crc32(0, reinterpret_cast<const uint8_t *>(&config[0]), config.size() * sizeof(config[0]))))
+		return;
+
+	m_drcuml->persist_region(m_core, sizeof(*m_core), "core");
+	m_drcuml->persist_region(this, sizeof(*this), "device");
+	m_drcuml->persist_region(vtlb_table(), vtlb_table_size() * sizeof(vtlb_entry), "vtlb");
+
+	m_drcuml->persist_function(cfunc_mips3com_update_cycle_counting, "update_cycle_counting");
+	m_drcuml->persist_function(cfunc_mips3com_asid_changed, "asid_changed");
+	m_drcuml->persist_function(cfunc_mips3com_tlbr, "tlbr");
+	m_drcuml->persist_function(cfunc_mips3com_tlbwi, "tlbwi");
+	m_drcuml->persist_function(cfunc_mips3com_tlbwr, "tlbwr");
+	m_drcuml->persist_function(cfunc_mips3com_tlbp, "tlbp");
+	m_drcuml->persist_function(cfunc_get_cycles, "get_cycles");
+	m_drcuml->persist_function(cfunc_printf_exception, "printf_exception");
+	m_drcuml->persist_function(cfunc_printf_debug, "printf_debug");
+	m_drcuml->persist_function(cfunc_printf_probe, "printf_probe");
+	m_drcuml->persist_function(cfunc_unimplemented, "unimplemented");
 }
 
 
@@ -279,18 +336,66 @@ void mips3_device::code_flush_cache()
 
 void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 {
-	compiler_state compiler = { 0 };
-	const opcode_desc *seqhead, *seqlast;
-	const opcode_desc *desclist;
-	bool override = false;
-
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
+	bool replace;
+	const opcode_desc *desclist = code_describe_block(mode, pc, replace);
+	if (desclist != nullptr)
+		code_generate_block(mode, pc, desclist, replace, true);
+
+	g_profiler.stop();
+}
+
+
+/*-------------------------------------------------
+    code_describe_block - analyze a block of the
+    given mode at the specified pc; returns
+    nullptr if a saved block was used instead
+-------------------------------------------------*/
+
+const opcode_desc *mips3_device::code_describe_block(uint8_t mode, offs_t pc, bool &replace)
+{
+	const opcode_desc *desclist, *seqlast;
+
+	/* a block saved by an earlier session needs no analysis; only if there's no */
+	/* code here already, as that means it failed validation */
+	replace = m_drcuml->hash_exists(mode, pc);
+	if (m_drcuml->persist_enabled() && !replace)
+	{
+		offs_t physpc = pc;
+		if (memory_translate(AS_PROGRAM, TRANSLATE_FETCH, physpc) && m_drcuml->persist_replay(mode, pc, physpc))
+			return nullptr;
+	}
+
 	/* get a description of this sequence */
 	desclist = m_drcfe->describe_code(pc);
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(desclist, 0);
 
+	/* if we already have code here, it failed validation; throw away every block */
+	/* compiled from the first sequence rather than leaving them in the cache */
+	if (replace)
+	{
+		for (seqlast = desclist; seqlast->next() != nullptr && !(seqlast->flags & OPFLAG_END_SEQUENCE); seqlast = seqlast->next()) { }
+		m_drcuml->invalidate_range(desclist->physpc, seqlast->physpc + (seqlast->skipslots + 1) * 4 - 1);
+	}
+	return desclist;
+}
+
+
+/*-------------------------------------------------
+    code_generate_block - generate code for a
+    described block; this only looks at the
+    descriptions, not at the guest state, so it
+    can run on the background compiler
+-------------------------------------------------*/
+
+void mips3_device::code_generate_block(uint8_t mode, offs_t pc, const opcode_desc *desclist, bool replace, bool persist)
+{
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	bool override = false;
+
 	/* if we get an error back, flush the cache and try again */
 	bool succeeded = false;
 	while (!succeeded)
@@ -300,6 +405,15 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 			/* start the block */
 			drcuml_block &block(m_drcuml->begin_block(4096));
 
+			/* it can be saved unless it depends on the TLB state or replaces other code */
+			if (persist && m_drcuml->persist_enabled() && !replace)
+			{
+				const opcode_desc *curdesc;
+				for (curdesc = desclist; curdesc != nullptr && !(curdesc->flags & OPFLAG_COMPILER_PAGE_FAULT); curdesc = curdesc->next()) { }
+				if (curdesc == nullptr)
+					block.set_persist_key(mode, pc, desclist->physpc);
+			}
+
 			/* loop until we get through all instruction sequences */
 			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
 			{
@@ -337,9 +451,13 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 					continue;
 				}
 
-				/* validate this code block if we're not pointing into ROM */
-				if (m_program->get_write_ptr(seqhead->physpc) != nullptr)
+				/* validate this code block if we're not pointing into ROM, and note it for invalidation */
+				if (seqhead->userflags & USERFLAG_WRITABLE)
+				{
 					generate_checksum_block(block, compiler, seqhead, seqlast);
+					block.add_guest_range(seqhead->physpc, seqlast->physpc + (seqlast->skipslots + 1) * 4 - 1);
+				}
+				block.add_code_range(seqhead->physpc, seqlast->physpc + (seqlast->skipslots + 1) * 4 - 1);
 
 				/* label this instruction, if it may be jumped to locally */
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
@@ -377,7 +495,6 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 
 			/* end the sequence */
 			block.end();
-			g_profiler.stop();
 			succeeded = true;
 		}
 		catch (drcuml_block::abort_compilation &)
@@ -389,6 +506,23 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 
 
 
+/*-------------------------------------------------
+    code_interpret_background - interpret the
+    rest of the timeslice while a block is
+    generated in the background
+-------------------------------------------------*/
+
+void mips3_device::code_interpret_background()
+{
+	interpreter_run();
+
+	/* the interpreter doesn't track the mode, so recompute it for the DRC */
+	uint32_t const sr = m_core->cpr[0][COP0_Status];
+	m_core->mode = ((sr & (SR_EXL | SR_ERL)) ? 0 : ((sr >> 2) & 6)) | ((sr >> 26) & 1);
+}
+
+
+
 /***************************************************************************
     C FUNCTION CALLBACKS
 ***************************************************************************/
@@ -1081,7 +1215,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 		if (!(seqhead->flags & OPFLAG_VIRTUAL_NOOP))
 		{
 			uint32_t sum = seqhead->opptr.l[0];
-			const void *base = m_prptr(seqhead->physpc);
+			const void *base = seqhead->userptr;
 			uint32_t low_bits = (seqhead->physpc & (m_data_bits == 64 ? 4 : 0)) ^ m_dword_xor;
 			UML_LOAD(block, I0, base, low_bits, SIZE_DWORD, SCALE_x1);         // load    i0,base,0,dword
 
@@ -1090,7 +1224,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 				&& seqhead->physpc != seqhead->delay.first()->physpc)
 			{
 				uint32_t low_bits = (seqhead->delay.first()->physpc & (m_data_bits == 64 ? 4 : 0)) ^ m_dword_xor;
-				base = m_prptr(seqhead->delay.first()->physpc);
+				base = seqhead->delay.first()->userptr;
 				assert(base != nullptr);
 				UML_LOAD(block, I1, base, low_bits, SIZE_DWORD, SCALE_x1);                 // load    i1,base,dword
 				UML_ADD(block, I0, I0, I1);                     // add     i0,i0,i1
@@ -1110,14 +1244,14 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 		for (curdesc = seqhead->next(); curdesc != seqlast->next(); curdesc = curdesc->next())
 			if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
 			{
-				const void *base = m_prptr(seqhead->physpc);
+				const void *base = seqhead->userptr;
 				UML_LOAD(block, I0, base, m_dword_xor, SIZE_DWORD, SCALE_x1);     // load    i0,base,0,dword
 				UML_CMP(block, I0, curdesc->opptr.l[0]);                    // cmp     i0,opptr[0]
 				UML_EXHc(block, COND_NE, *m_nocode, epc(seqhead));   // exne    nocode,seqhead->pc
 			}
 #else
 		uint32_t sum = 0;
-		const void *base = m_prptr(seqhead->physpc);
+		const void *base = seqhead->userptr;
 		uint32_t low_bits = (seqhead->physpc & (m_data_bits == 64 ? 4 : 0)) ^ m_dword_xor;
 		UML_LOAD(block, I0, base, low_bits, SIZE_DWORD, SCALE_x1);             // load    i0,base,0,dword
 		sum += seqhead->opptr.l[0];
@@ -1125,7 +1259,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 		{
 			if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
 			{
-				base = m_prptr(curdesc->physpc);
+				base = curdesc->userptr;
 				assert(base != nullptr);
 				uint32_t low_bits = (curdesc->physpc & (m_data_bits == 64 ? 4 : 0)) ^ m_dword_xor;
 				UML_LOAD(block, I1, base, low_bits, SIZE_DWORD, SCALE_x1);     // load    i1,base,dword
@@ -1136,7 +1270,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 					&& !(curdesc->delay.first()->flags & OPFLAG_VIRTUAL_NOOP)
 					&& (curdesc == seqlast || (curdesc->next() != nullptr && curdesc->next()->physpc != curdesc->delay.first()->physpc)))
 				{
-					base = m_prptr(curdesc->delay.first()->physpc);
+					base = curdesc->delay.first()->userptr;
 					assert(base != nullptr);
 					uint32_t low_bits = (curdesc->delay.first()->physpc & (m_data_bits == 64 ? 4 : 0)) ^ m_dword_xor;
 					UML_LOAD(block, I1, base, low_bits, SIZE_DWORD, SCALE_x1); // load    i1,base,dword
@@ -1225,8 +1359,8 @@ void mips3_device::generate_sequence_instruction(drcuml_block &block, compiler_s
 	{
 		const vtlb_entry *tlbtable = vtlb_table();
 
-		/* if we currently have a valid TLB read entry, we just verify */
-		if (tlbtable[desc->pc >> 12] & VTLB_FETCH_ALLOWED)
+		/* if we had a valid TLB read entry when the code was described, we just verify */
+		if (desc->userdata0 & VTLB_FETCH_ALLOWED)
 		{
 			if (PRINTF_MMU)
 			{
@@ -1236,7 +1370,7 @@ void mips3_device::generate_sequence_instruction(drcuml_block &block, compiler_s
 				UML_CALLC(block, cfunc_printf_debug, this);                        // callc   printf_debug
 			}
 			UML_LOAD(block, I0, &tlbtable[desc->pc >> 12], 0, SIZE_DWORD, SCALE_x4);        // load i0,tlbtable[desc->pc >> 12],0,dword
-			UML_CMP(block, I0, tlbtable[desc->pc >> 12]);                   // cmp     i0,*tlbentry
+			UML_CMP(block, I0, desc->userdata0);                            // cmp     i0,*tlbentry
 			UML_EXHc(block, COND_NE, *m_tlb_mismatch, 0);            // exh     tlb_mismatch,0,NE
 		}
 
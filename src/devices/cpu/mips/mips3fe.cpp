@@ -40,7 +40,17 @@ bool mips3_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
 
 	// compute the physical PC
 	assert((desc.physpc & 3) == 0);
-	if (!m_mips3->memory_translate(AS_PROGRAM, TRANSLATE_FETCH, desc.physpc))
+	bool const mapped = m_mips3->memory_translate(AS_PROGRAM, TRANSLATE_FETCH, desc.physpc);
+
+	// note the TLB entry, whether the code is in RAM and where the checksum code
+	// reads it back from now, so the code generator never has to look at guest
+	// state that may have changed since, or use the interpreter's fetch cache
+	desc.userdata0 = m_mips3->vtlb_table()[desc.pc >> 12];
+	if (m_mips3->m_program->get_write_ptr(desc.physpc) != nullptr)
+		desc.userflags |= USERFLAG_WRITABLE;
+	desc.userptr = m_mips3->m_prptr(desc.physpc);
+
+	if (!mapped)
 	{
 		// uh-oh: a page fault; leave the description empty and just if this is the first instruction, leave it empty and
 		// mark as needing to validate; otherwise, just end the sequence here
@@ -28,5 +28,8 @@
 #define REGFLAG_HI                      (1 << 1)
 #define REGFLAG_FCC                     (1 << 2)
 
+// user flags
+#define USERFLAG_WRITABLE               (1 << 0)    // code is in memory that can be written
+
 
 #endif // MAME_CPU_MIPS_MIPS3FE_H
@@ -239,9 +239,11 @@ public:
 	void ppccom_execute_mftb();
 	void ppccom_execute_mtspr();
 	void ppccom_tlb_flush();
+	void ppccom_segment_changed();
 	void ppccom_execute_mfdcr();
 	void ppccom_execute_mtdcr();
 	void ppccom_get_dsisr();
+	uint32_t ppccom_tlb_asid(offs_t address) const;
 
 protected:
 	// device-level overrides
@@ -643,6 +645,7 @@ protected:
 	uint32_t compute_crf_mask(uint8_t crm);
 	uint32_t compute_spr(uint32_t spr);
 	void code_flush_cache();
+	void code_persist_setup();
 	void code_compile_block(uint8_t mode, offs_t pc);
 	void static_generate_entry_point();
 	void static_generate_nocode_handler();
@@ -229,6 +229,10 @@ ppc_device::ppc_device(const machine_config &mconfig, device_type type, const ch
 	set_vtlb_dynamic_entries(POWERPC_TLB_ENTRIES);
 	if (m_cap & PPCCAP_603_MMU)
 		set_vtlb_fixed_entries(PPC603_FIXED_TLB_ENTRIES);
+
+	// page table walks are slow enough to be worth caching the results
+	if (m_cap & PPCCAP_OEA)
+		set_vtlb_cache_entries(4096);
 }
 
 ppc_device::~ppc_device()
@@ -1123,6 +1127,8 @@ void ppc_device::state_string_export(const device_state_entry &entry, std::strin
 
 void ppc_device::device_stop()
 {
+	if (m_drcuml != nullptr)
+		m_drcuml->persist_save();
 }
 
 
@@ -1445,7 +1451,20 @@ bool ppc_device::memory_translate(int spacenum, int intention, offs_t &address)
 
 void ppc_device::ppccom_tlb_fill()
 {
-	vtlb_fill(m_core->param0, m_core->param1);
+	vtlb_fill(m_core->param0, m_core->param1, ppccom_tlb_asid(m_core->param0));
+}
+
+
+/*-------------------------------------------------
+    ppccom_tlb_asid - identify the address space
+    an address is translated in, for caching
+    translations across segment register changes
+-------------------------------------------------*/
+
+uint32_t ppc_device::ppccom_tlb_asid(offs_t address) const
+{
+	/* the segment's VSID and protection bits, plus whether translation is on */
+	return (m_core->sr[address >> 28] & 0xf0ffffff) | ((m_core->msr & (MSROEA_IR | MSROEA_DR)) << 20);
 }
 
 
@@ -1460,6 +1479,18 @@ void ppc_device::ppccom_tlb_flush()
 }
 
 
+/*-------------------------------------------------
+    ppccom_segment_changed - a segment register
+    was written; translations made with the old
+    value stay cached under its VSID
+-------------------------------------------------*/
+
+void ppc_device::ppccom_segment_changed()
+{
+	vtlb_asid_changed();
+}
+
+
 
 /***************************************************************************
     OPCODE HANDLING
@@ -15,6 +15,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "ppc.h"
 #include "ppccom.h"
 #include "ppcfe.h"
@@ -24,6 +25,7 @@
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
 #include "debugger.h"
+#include "coreutil.h"
 
 
 
@@ -48,6 +50,35 @@
 #define EXECUTE_UNMAPPED_CODE           2
 #define EXECUTE_RESET_CACHE             3
 
+/* change this whenever the same code would be translated differently, to
+   discard blocks saved by -drc_cache */
+#define DRC_CACHE_VERSION               2
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+static void cfunc_printf_exception(void *param);
+static void cfunc_printf_debug(void *param);
+static void cfunc_printf_probe(void *param);
+static void cfunc_unimplemented(void *param);
+static void cfunc_ppccom_mismatch(void *param);
+static void cfunc_ppccom_tlb_fill(void *param);
+static void cfunc_ppccom_update_fprf(void *param);
+static void cfunc_ppccom_dcstore_callback(void *param);
+static void cfunc_ppccom_execute_tlbie(void *param);
+static void cfunc_ppccom_execute_tlbia(void *param);
+static void cfunc_ppccom_execute_tlbl(void *param);
+static void cfunc_ppccom_execute_mfspr(void *param);
+static void cfunc_ppccom_execute_mftb(void *param);
+static void cfunc_ppccom_execute_mtspr(void *param);
+static void cfunc_ppccom_segment_changed(void *param);
+static void cfunc_ppccom_execute_mfdcr(void *param);
+static void cfunc_ppccom_execute_mtdcr(void *param);
+static void cfunc_ppccom_get_dsisr(void *param);
+
 
 
 /***************************************************************************
@@ -368,6 +399,56 @@ void ppc_device::code_flush_cache()
 	{
 		fatalerror("Error generating PPC static handlers\n");
 	}
+
+	/* now the handles exist, blocks can be saved and restored */
+	code_persist_setup();
+}
+
+
+/*-------------------------------------------------
+    code_persist_setup - open the persistent
+    cache, naming everything compiled blocks may
+    refer to
+-------------------------------------------------*/
+
+void ppc_device::code_persist_setup()
+{
+	/* everything that affects translation is part of the version */
+	std::vector<uint32_t> config = { DRC_CACHE_VERSION, uint32_t(m_flavor), m_cap, m_drcoptions, (machine().debug_flags & DEBUG_FLAG_ENABLED) != 0 };
+
+	/* blocks refer to offsets within this build's layout of the core and device, */
+	/* so tie them to the build too; the sizes catch a rebuilt tree with local changes */
+	const char *const build = emulator_info::get_build_version();
+	config.insert(config.end(), { core_crc32(0, reinterpret_cast<const uint8_t *>(build), strlen(build)), uint32_t(sizeof(*m_core)), uint32_t(sizeof(*this)), machine().options().drc_optimize() });
+	for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+		config.insert(config.end(), { m_fastram[ramnum].start, m_fastram[ramnum].end, m_fastram[ramnum].readonly });
+	for (int hotnum = 0; hotnum < m_hotspot_select; hotnum++)
+		config.insert(config.end(), { m_hotspot[hotnum].pc, m_hotspot[hotnum].opcode, m_hotspot[hotnum].cycles });
+	if (!m_drcuml->persist_open(core_crc32(0, reinterpret_cast<const uint8_t *>(&config[0]), config.size() * sizeof(config[0]))))
+		return;
+
+	m_drcuml->persist_region(m_core, sizeof(*m_core), "core");
+	m_drcuml->persist_region(this, sizeof(*this), "device");
+	m_drcuml->persist_region(vtlb_table(), vtlb_table_size() * sizeof(vtlb_entry), "vtlb");
+
+	m_drcuml->persist_function(cfunc_printf_exception, "printf_exception");
+	m_drcuml->persist_function(cfunc_printf_debug, "printf_debug");
+	m_drcuml->persist_function(cfunc_printf_probe, "printf_probe");
+	m_drcuml->persist_function(cfunc_unimplemented, "unimplemented");
+	m_drcuml->persist_function(cfunc_ppccom_mismatch, "mismatch");
+	m_drcuml->persist_function(cfunc_ppccom_tlb_fill, "tlb_fill");
+	m_drcuml->persist_function(cfunc_ppccom_update_fprf, "update_fprf");
+	m_drcuml->persist_function(cfunc_ppccom_dcstore_callback, "dcstore_callback");
+	m_drcuml->persist_function(cfunc_ppccom_execute_tlbie, "tlbie");
+	m_drcuml->persist_function(cfunc_ppccom_execute_tlbia, "tlbia");
+	m_drcuml->persist_function(cfunc_ppccom_execute_tlbl, "tlbl");
+	m_drcuml->persist_function(cfunc_ppccom_execute_mfspr, "mfspr");
+	m_drcuml->persist_function(cfunc_ppccom_execute_mftb, "mftb");
+	m_drcuml->persist_function(cfunc_ppccom_execute_mtspr, "mtspr");
+	m_drcuml->persist_function(cfunc_ppccom_segment_changed, "segment_changed");
+	m_drcuml->persist_function(cfunc_ppccom_execute_mfdcr, "mfdcr");
+	m_drcuml->persist_function(cfunc_ppccom_execute_mtdcr, "mtdcr");
+	m_drcuml->persist_function(cfunc_ppccom_get_dsisr, "get_dsisr");
 }
 
 
@@ -385,11 +466,32 @@ void ppc_device::code_compile_block(uint8_t mode, offs_t pc)
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
+	/* a block saved by an earlier session needs no analysis; only if there's no */
+	/* code here already, as that means it failed validation */
+	const bool replace = m_drcuml->hash_exists(mode, pc);
+	if (m_drcuml->persist_enabled() && !replace)
+	{
+		offs_t physpc = pc;
+		if (memory_translate(AS_PROGRAM, TRANSLATE_FETCH, physpc) && m_drcuml->persist_replay(mode, pc, physpc))
+		{
+			g_profiler.stop();
+			return;
+		}
+	}
+
 	/* get a description of this sequence */
 	desclist = m_drcfe->describe_code(pc);
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(desclist, 0);
 
+	/* if we already have code here, it failed validation; throw away every block */
+	/* compiled from the first sequence rather than leaving them in the cache */
+	if (replace)
+	{
+		for (seqlast = desclist; seqlast->next() != nullptr && !(seqlast->flags & OPFLAG_END_SEQUENCE); seqlast = seqlast->next()) { }
+		m_drcuml->invalidate_range(desclist->physpc, seqlast->physpc + (seqlast->skipslots + 1) * 4 - 1);
+	}
+
 	bool succeeded = false;
 	while (!succeeded)
 	{
@@ -398,6 +500,15 @@ void ppc_device::code_compile_block(uint8_t mode, offs_t pc)
 			/* start the block */
 			drcuml_block &block(m_drcuml->begin_block(4096));
 
+			/* it can be saved unless it depends on the TLB state or replaces other code */
+			if (m_drcuml->persist_enabled() && !replace)
+			{
+				const opcode_desc *curdesc;
+				for (curdesc = desclist; curdesc != nullptr && !(curdesc->flags & OPFLAG_COMPILER_PAGE_FAULT); curdesc = curdesc->next()) { }
+				if (curdesc == nullptr)
+					block.set_persist_key(mode, pc, desclist->physpc);
+			}
+
 			/* loop until we get through all instruction sequences */
 			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
 			{
@@ -435,9 +546,13 @@ void ppc_device::code_compile_block(uint8_t mode, offs_t pc)
 					continue;
 				}
 
-				/* validate this code block if we're not pointing into ROM */
+				/* validate this code block if we're not pointing into ROM, and note it for invalidation */
 				if (m_program->get_write_ptr(seqhead->physpc) != nullptr)
+				{
 					generate_checksum_block(block, &compiler, seqhead, seqlast);               // <checksum>
+					block.add_guest_range(seqhead->physpc, seqlast->physpc + (seqlast->skipslots + 1) * 4 - 1);
+				}
+				block.add_code_range(seqhead->physpc, seqlast->physpc + (seqlast->skipslots + 1) * 4 - 1);
 
 				/* label this instruction, if it may be jumped to locally */
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
@@ -635,10 +750,10 @@ static void cfunc_ppccom_execute_mtspr(void *param)
 	ppc->ppccom_execute_mtspr();
 }
 
-static void cfunc_ppccom_tlb_flush(void *param)
+static void cfunc_ppccom_segment_changed(void *param)
 {
 	ppc_device *ppc = (ppc_device *)param;
-	ppc->ppccom_tlb_flush();
+	ppc->ppccom_segment_changed();
 }
 
 static void cfunc_ppccom_execute_mfdcr(void *param)
@@ -3395,13 +3510,13 @@ bool ppc_device::generate_instruction_1f(drcuml_block &block, compiler_state *co
 
 		case 0x0d2: /* MTSR */
 			UML_MOV(block, SR32(G_SR(op)), R32(G_RS(op)));                                  // mov     sr[G_SR],rs
-			UML_CALLC(block, (c_function)cfunc_ppccom_tlb_flush, this);                                        // callc   ppccom_tlb_flush,ppc
+			UML_CALLC(block, (c_function)cfunc_ppccom_segment_changed, this);                                  // callc   ppccom_segment_changed,ppc
 			return true;
 
 		case 0x0f2: /* MTSRIN */
 			UML_SHR(block, I0, R32(G_RB(op)), 28);                              // shr     i0,G_RB,28
 			UML_STORE(block, &m_core->sr[0], I0, R32(G_RS(op)), SIZE_DWORD, SCALE_x4); // store   sr,i0,rs,dword
-			UML_CALLC(block, (c_function)cfunc_ppccom_tlb_flush, this);                            // callc   ppccom_tlb_flush,ppc
+			UML_CALLC(block, (c_function)cfunc_ppccom_segment_changed, this);                      // callc   ppccom_segment_changed,ppc
 			return true;
 
 		case 0x200: /* MCRXR */
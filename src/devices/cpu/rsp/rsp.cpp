@@ -110,6 +110,7 @@ rsp_device::rsp_device(const machine_config &mconfig, const char *tag, device_t
 	, m_drcfe(nullptr)
 	, m_drcoptions(0)
 	, m_cache_dirty(true)
+	, m_drcbg(nullptr)
 	, m_numcycles(0)
 	, m_format(nullptr)
 	, m_arg2(0)
@@ -422,6 +423,13 @@ void rsp_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
+	/* compile misses on a worker thread if requested, interpreting in the meantime */
+	if (m_isdrc)
+		m_drcbg = std::make_unique<drc_background_compiler>(*this,
+				[this] (u8 mode, offs_t pc) { return m_drcfe->describe_code(pc); },
+				[this] (u8 mode, offs_t pc, const opcode_desc *desclist, bool background) { code_generate_block(pc, desclist); },
+				[this] () { code_interpret_background(); });
+
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
 	{
@@ -563,6 +571,8 @@ void rsp_device::state_string_export(const device_state_entry &entry, std::strin
 
 void rsp_device::device_stop()
 {
+	m_drcbg = nullptr;
+
 #if SAVE_DISASM
 	{
 		char string[200];
@@ -627,6 +637,11 @@ void rsp_device::execute_run()
 		m_rsp_state->icount = std::min(m_rsp_state->icount, 0);
 	}
 
+	interpreter_run();
+}
+
+void rsp_device::interpreter_run()
+{
 	while (m_rsp_state->icount > 0)
 	{
 		m_ppc = m_rsp_state->pc;
@@ -177,6 +177,7 @@ private:
 
 	/* internal stuff */
 	uint8_t               m_cache_dirty;                /* true if we need to flush the cache */
+	std::unique_ptr<drc_background_compiler> m_drcbg;   /* background compiler, or nullptr */
 
 	/* parameters for subroutines */
 	uint64_t              m_numcycles;                  /* return value from gettotalcycles */
@@ -262,6 +263,9 @@ private:
 	void execute_run_drc();
 	void code_flush_cache();
 	void code_compile_block(offs_t pc);
+	void code_generate_block(offs_t pc, const opcode_desc *desclist);
+	void code_interpret_background();
+	void interpreter_run();
 	void static_generate_entry_point();
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
@@ -279,10 +279,17 @@ void rsp_device::execute_run_drc()
 		/* run as much as we can */
 		execute_result = m_drcuml->execute(*m_entry);
 
-		/* if we need to recompile, do it */
+		/* if we need to recompile, do it; a background compile interprets the rest of */
+		/* the timeslice, and blocks that failed validation are always done here */
 		if (execute_result == EXECUTE_MISSING_CODE)
 		{
-			code_compile_block(m_rsp_state->pc);
+			if (m_drcbg->enabled() && !m_drcuml->hash_exists(0, m_rsp_state->pc))
+			{
+				if (m_drcbg->compile(0, m_rsp_state->pc))
+					return;
+			}
+			else
+				code_compile_block(m_rsp_state->pc);
 		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 		{
@@ -348,17 +355,29 @@ void rsp_device::code_flush_cache()
 -------------------------------------------------*/
 
 void rsp_device::code_compile_block(offs_t pc)
+{
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence and generate code for it */
+	code_generate_block(pc, m_drcfe->describe_code(pc));
+
+	g_profiler.stop();
+}
+
+
+/*-------------------------------------------------
+    code_generate_block - generate code for a
+    described block; this only looks at the
+    descriptions, not at the guest state, so it
+    can run on the background compiler
+-------------------------------------------------*/
+
+void rsp_device::code_generate_block(offs_t pc, const opcode_desc *desclist)
 {
 	compiler_state compiler = { 0 };
 	const opcode_desc *seqhead, *seqlast;
-	const opcode_desc *desclist;
 	int override = false;
 
-	g_profiler.start(PROFILER_DRC_COMPILE);
-
-	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
-
 	bool succeeded = false;
 	while (!succeeded)
 	{
@@ -405,7 +424,7 @@ void rsp_device::code_compile_block(offs_t pc)
 				}
 
 				/* validate this code block if we're not pointing into ROM */
-				if (m_program->get_write_ptr(seqhead->physpc) != nullptr)
+				if (seqhead->userflags & USERFLAG_WRITABLE)
 					generate_checksum_block(block, compiler, seqhead, seqlast);
 
 				/* label this instruction, if it may be jumped to locally */
@@ -434,7 +453,6 @@ void rsp_device::code_compile_block(offs_t pc)
 
 			/* end the sequence */
 			block.end();
-			g_profiler.stop();
 			succeeded = true;
 		}
 		catch (drcuml_block::abort_compilation &)
@@ -444,6 +462,34 @@ void rsp_device::code_compile_block(offs_t pc)
 	}
 }
 
+
+/*-------------------------------------------------
+    code_interpret_background - interpret the
+    rest of the timeslice while a block is
+    generated in the background
+-------------------------------------------------*/
+
+void rsp_device::code_interpret_background()
+{
+	/* the interpreter stops at a halt or break the same way the loop above does */
+	if (m_sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
+		m_rsp_state->icount = std::min(m_rsp_state->icount, 0);
+	m_rsp_state->pc = 0x04001000 | (m_rsp_state->pc & 0xfff);
+	interpreter_run();
+
+	/* generated code can't resume in a delay slot, so step through one if we stopped there */
+	if (m_nextpc != ~0)
+	{
+		int const remaining = m_rsp_state->icount;
+		m_rsp_state->icount = 1;
+		interpreter_run();
+		m_rsp_state->icount += remaining - 1;
+	}
+
+	/* generated code hashes the PC in the form the SP_PC register uses */
+	m_rsp_state->pc = 0x1000 | (m_rsp_state->pc & 0xfff);
+}
+
 /***************************************************************************
     C FUNCTION CALLBACKS
 ***************************************************************************/
@@ -654,12 +700,12 @@ void rsp_device::generate_checksum_block(drcuml_block &block, compiler_state &co
 		if (!(seqhead->flags & OPFLAG_VIRTUAL_NOOP))
 		{
 			uint32_t sum = seqhead->opptr.l[0];
-			void *base = m_pcache->read_ptr(seqhead->physpc | 0x1000);
+			const void *base = seqhead->userptr;
 			UML_LOAD(block, I0, base, 0, SIZE_DWORD, SCALE_x4);                         // load    i0,base,0,dword
 
 			if (seqhead->delay.first() != nullptr && seqhead->physpc != seqhead->delay.first()->physpc)
 			{
-				base = m_pcache->read_ptr((seqhead->delay.first()->physpc & 0x00000fff) | 0x1000);
+				base = seqhead->delay.first()->userptr;
 				assert(base != nullptr);
 				UML_LOAD(block, I1, base, 0, SIZE_DWORD, SCALE_x4);                 // load    i1,base,dword
 				UML_ADD(block, I0, I0, I1);                     // add     i0,i0,i1
@@ -676,13 +722,13 @@ void rsp_device::generate_checksum_block(drcuml_block &block, compiler_state &co
 	else
 	{
 		uint32_t sum = 0;
-		void *base = m_pcache->read_ptr(seqhead->physpc | 0x1000);
+		const void *base = seqhead->userptr;
 		UML_LOAD(block, I0, base, 0, SIZE_DWORD, SCALE_x4);                             // load    i0,base,0,dword
 		sum += seqhead->opptr.l[0];
 		for (curdesc = seqhead->next(); curdesc != seqlast->next(); curdesc = curdesc->next())
 			if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
 			{
-				base = m_pcache->read_ptr(curdesc->physpc | 0x1000);
+				base = curdesc->userptr;
 				assert(base != nullptr);
 				UML_LOAD(block, I1, base, 0, SIZE_DWORD, SCALE_x4);                     // load    i1,base,dword
 				UML_ADD(block, I0, I0, I1);                         // add     i0,i0,i1
@@ -690,7 +736,7 @@ void rsp_device::generate_checksum_block(drcuml_block &block, compiler_state &co
 
 				if (curdesc->delay.first() != nullptr && (curdesc == seqlast || (curdesc->next() != nullptr && curdesc->next()->physpc != curdesc->delay.first()->physpc)))
 				{
-					base = m_pcache->read_ptr((curdesc->delay.first()->physpc & 0x00000fff) | 0x1000);
+					base = curdesc->delay.first()->userptr;
 					assert(base != nullptr);
 					UML_LOAD(block, I1, base, 0, SIZE_DWORD, SCALE_x4);                 // load    i1,base,dword
 					UML_ADD(block, I0, I0, I1);                     // add     i0,i0,i1
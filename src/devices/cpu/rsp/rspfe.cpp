@@ -37,6 +37,12 @@ bool rsp_device::frontend::describe(opcode_desc &desc, const opcode_desc *prev)
 {
 	uint32_t op, opswitch;
 
+	// note whether the code is in RAM and where the checksum code reads it back
+	// from now, so the code generator never has to look at guest memory
+	if (m_rsp.m_program->get_write_ptr(desc.physpc) != nullptr)
+		desc.userflags |= USERFLAG_WRITABLE;
+	desc.userptr = m_rsp.m_pcache->read_ptr((desc.physpc & 0x00000fff) | 0x1000);
+
 	// fetch the opcode
 	op = desc.opptr.l[0] = m_rsp.m_pcache->read_dword((desc.physpc & 0x00000fff) | 0x1000);
 
@@ -23,6 +23,9 @@
 // register flags 0
 #define REGFLAG_R(n)                    (((n) == 0) ? 0 : (1 << (n)))
 
+// user flags
+#define USERFLAG_WRITABLE               (1 << 0)    // code is in memory that can be written
+
 
 
 //**************************************************************************
@@ -86,6 +86,12 @@ void sh_common_execution::device_start()
 }
 
 
+void sh_common_execution::device_stop()
+{
+	m_drcbg = nullptr;
+}
+
+
 void sh_common_execution::drc_start()
 {
 	/* DRC helpers */
@@ -120,6 +126,13 @@ void sh_common_execution::drc_start()
 	/* initialize the front-end helper */
 	init_drc_frontend();
 
+	/* compile misses on a worker thread if requested, interpreting in the meantime */
+	if (m_isdrc)
+		m_drcbg = std::make_unique<drc_background_compiler>(*this,
+				[this] (u8 mode, offs_t pc) { return code_describe_block(mode, pc); },
+				[this] (u8 mode, offs_t pc, const opcode_desc *desclist, bool background) { code_generate_block(mode, pc, desclist); },
+				[this] () { code_interpret_background(); });
+
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 16; regnum++)
 	{
@@ -2314,10 +2327,17 @@ void sh_common_execution::execute_run_drc()
 		/* run as much as we can */
 		execute_result = m_drcuml->execute(*m_entry);
 
-		/* if we need to recompile, do it */
+		/* if we need to recompile, do it; a background compile interprets the rest of */
+		/* the timeslice, and blocks that failed validation are always done here */
 		if (execute_result == EXECUTE_MISSING_CODE)
 		{
-			code_compile_block(0, m_sh2_state->pc);
+			if (m_drcbg->enabled() && !m_drcuml->hash_exists(0, m_sh2_state->pc))
+			{
+				if (m_drcbg->compile(0, m_sh2_state->pc))
+					return;
+			}
+			else
+				code_compile_block(0, m_sh2_state->pc);
 		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 		{
@@ -2338,19 +2358,53 @@ void sh_common_execution::execute_run_drc()
 
 void sh_common_execution::code_compile_block(uint8_t mode, offs_t pc)
 {
-	compiler_state compiler = { 0 };
-	const opcode_desc *seqhead, *seqlast;
-	const opcode_desc *desclist;
-	bool override = false;
-
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
+	code_generate_block(mode, pc, code_describe_block(mode, pc));
+
+	g_profiler.stop();
+}
+
+
+/*-------------------------------------------------
+    code_describe_block - analyze a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+const opcode_desc *sh_common_execution::code_describe_block(uint8_t mode, offs_t pc)
+{
+	const opcode_desc *desclist, *seqlast;
+
 	/* get a description of this sequence */
 	desclist = get_desclist(pc);
 
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(desclist, 0);
 
+	/* if we already have code here, it failed validation; throw away every block */
+	/* compiled from the first sequence rather than leaving them in the cache */
+	if (m_drcuml->hash_exists(mode, pc))
+	{
+		for (seqlast = desclist; seqlast->next() != nullptr && !(seqlast->flags & OPFLAG_END_SEQUENCE); seqlast = seqlast->next()) { }
+		m_drcuml->invalidate_range(desclist->physpc, seqlast->physpc + (seqlast->skipslots + 1) * 2 - 1);
+	}
+	return desclist;
+}
+
+
+/*-------------------------------------------------
+    code_generate_block - generate code for a
+    described block; this only looks at the
+    descriptions, not at the guest state, so it
+    can run on the background compiler
+-------------------------------------------------*/
+
+void sh_common_execution::code_generate_block(uint8_t mode, offs_t pc, const opcode_desc *desclist)
+{
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	bool override = false;
+
 	bool succeeded = false;
 	while (!succeeded)
 	{
@@ -2396,9 +2450,12 @@ void sh_common_execution::code_compile_block(uint8_t mode, offs_t pc)
 					continue;
 				}
 
-				/* validate this code block if we're not pointing into ROM */
-				if (m_program->get_write_ptr(seqhead->physpc) != nullptr)
+				/* validate this code block if we're not pointing into ROM, and note it for invalidation */
+				if (seqhead->userflags & USERFLAG_WRITABLE)
+				{
 					generate_checksum_block(block, compiler, seqhead, seqlast);
+					block.add_guest_range(seqhead->physpc, seqlast->physpc + (seqlast->skipslots + 1) * 2 - 1);
+				}
 
 				/* label this instruction, if it may be jumped to locally */
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
@@ -2436,7 +2493,6 @@ void sh_common_execution::code_compile_block(uint8_t mode, offs_t pc)
 
 			/* end the sequence */
 			block.end();
-			g_profiler.stop();
 			succeeded = true;
 		}
 		catch (drcuml_block::abort_compilation &)
@@ -2447,6 +2503,25 @@ void sh_common_execution::code_compile_block(uint8_t mode, offs_t pc)
 }
 
 
+/*-------------------------------------------------
+    code_interpret_background - interpret the
+    rest of the timeslice while a block is
+    generated in the background
+-------------------------------------------------*/
+
+void sh_common_execution::code_interpret_background()
+{
+	/* generated code has always taken a delayed branch by the time it exits, but RTE */
+	/* leaves the target behind, which would make the interpreter branch again */
+	m_sh2_state->m_delay = 0;
+	interpreter_run();
+
+	/* generated code can't resume in a delay slot, so step through one if we stopped there */
+	while (m_sh2_state->m_delay != 0)
+		interpreter_run();
+}
+
+
 /*-------------------------------------------------
     static_generate_nocode_handler - generate an
     exception handler for "out of code"
@@ -2506,7 +2581,7 @@ void sh_common_execution::generate_checksum_block(drcuml_block &block, compiler_
 	{
 		if (!(seqhead->flags & OPFLAG_VIRTUAL_NOOP))
 		{
-			const void *base = m_prptr(seqhead->physpc);
+			const void *base = seqhead->userptr;
 
 			UML_LOAD(block, I0, base, 0, SIZE_WORD, SCALE_x2);                          // load    i0,base,word
 			UML_CMP(block, I0, seqhead->opptr.w[0]);                        // cmp     i0,*opptr
@@ -2518,14 +2593,14 @@ void sh_common_execution::generate_checksum_block(drcuml_block &block, compiler_
 	else
 	{
 		uint32_t sum = 0;
-		const void *base = m_prptr(seqhead->physpc);
+		const void *base = seqhead->userptr;
 
 		UML_LOAD(block, I0, base, 0, SIZE_WORD, SCALE_x4);                              // load    i0,base,word
 		sum += seqhead->opptr.w[0];
 		for (curdesc = seqhead->next(); curdesc != seqlast->next(); curdesc = curdesc->next())
 			if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
 			{
-				base = m_prptr(curdesc->physpc);
+				base = curdesc->userptr;
 
 				UML_LOAD(block, I1, base, 0, SIZE_WORD, SCALE_x2);                      // load    i1,*opptr,word
 				UML_ADD(block, I0, I0, I1);                         // add     i0,i0,i1
@@ -40,6 +40,9 @@
 
 #define SH2_MAX_FASTRAM       4
 
+/* front-end user flags */
+#define USERFLAG_WRITABLE       0x0001          /* code is in memory that can be written */
+
 /* map variables */
 #define MAPVAR_PC                   M0
 #define MAPVAR_CYCLES               M1
@@ -107,6 +110,7 @@ public:
 		, m_cache(CACHE_SIZE + sizeof(internal_sh2_state))
 		, m_drcuml(nullptr)
 		, m_drcoptions(0)
+		, m_drcbg(nullptr)
 		, m_entry(nullptr)
 		, m_read8(nullptr)
 		, m_write8(nullptr)
@@ -391,6 +395,7 @@ public:
 
 	/* internal stuff */
 	uint8_t               m_cache_dirty;                /* true if we need to flush the cache */
+	std::unique_ptr<drc_background_compiler> m_drcbg;   /* background compiler, or nullptr */
 
 	/* register mappings */
 	uml::parameter      m_regmap[16];                 /* parameter to register mappings for all 16 integer registers */
@@ -472,11 +477,16 @@ public:
 	void code_flush_cache();
 	void execute_run_drc();
 	void code_compile_block(uint8_t mode, offs_t pc);
+	const opcode_desc *code_describe_block(uint8_t mode, offs_t pc);
+	void code_generate_block(uint8_t mode, offs_t pc, const opcode_desc *desclist);
+	void code_interpret_background();
+	virtual void interpreter_run() = 0;
 
 
 protected:
 	// device-level overrides
 	virtual void device_start() override;
+	virtual void device_stop() override;
 };
 
 class sh_frontend : public drc_frontend
@@ -166,6 +166,7 @@ sh2_device::~sh2_device()
 
 void sh2_device::device_stop()
 {
+	sh_common_execution::device_stop();
 }
 
 
@@ -398,6 +399,13 @@ void sh2_device::execute_run()
 		return;
 	}
 
+	interpreter_run();
+}
+
+
+/* Interpret instructions until out of cycles */
+void sh2_device::interpreter_run()
+{
 	do
 	{
 		debugger_instruction_hook(m_sh2_state->pc);
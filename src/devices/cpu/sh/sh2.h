@@ -105,6 +105,7 @@ protected:
 	virtual uint32_t execute_default_irq_vector(int inputnum) const override { return 0; }
 	virtual bool execute_input_edge_triggered(int inputnum) const override { return inputnum == INPUT_LINE_NMI; }
 	virtual void execute_run() override;
+	virtual void interpreter_run() override;
 	virtual void execute_set_input(int inputnum, int state) override;
 
 	// device_memory_interface overrides
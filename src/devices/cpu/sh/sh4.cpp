@@ -1867,6 +1867,12 @@ void sh34_base_device::execute_run()
 		return;
 	}
 
+	interpreter_run();
+}
+
+/* Interpret instructions until out of cycles */
+void sh34_base_device::interpreter_run()
+{
 	do
 	{
 		m_sh2_state->m_ppc = m_sh2_state->pc & SH34_AM;
@@ -1910,6 +1916,12 @@ void sh3be_device::execute_run()
 		return;
 	}
 
+	interpreter_run();
+}
+
+/* Interpret instructions until out of cycles */
+void sh3be_device::interpreter_run()
+{
 	do
 	{
 		m_sh2_state->m_ppc = m_sh2_state->pc & SH34_AM;
@@ -1950,6 +1962,12 @@ void sh4be_device::execute_run()
 		return;
 	}
 
+	interpreter_run();
+}
+
+/* Interpret instructions until out of cycles */
+void sh4be_device::interpreter_run()
+{
 	do
 	{
 		m_sh2_state->m_ppc = m_sh2_state->pc & SH34_AM;
@@ -265,6 +265,7 @@ protected:
 	virtual uint32_t execute_max_cycles() const override { return 4; }
 	virtual uint32_t execute_input_lines() const override { return 5; }
 	virtual void execute_run() override;
+	virtual void interpreter_run() override;
 	virtual void execute_set_input(int inputnum, int state) override;
 	virtual bool execute_input_edge_triggered(int inputnum) const override { return inputnum == INPUT_LINE_NMI; }
 
@@ -749,6 +750,7 @@ public:
 
 protected:
 	virtual void execute_run() override;
+	virtual void interpreter_run() override;
 };
 
 
@@ -777,6 +779,7 @@ public:
 
 protected:
 	virtual void execute_run() override;
+	virtual void interpreter_run() override;
 };
 
 class sh4_frontend : public sh_frontend
@@ -38,6 +38,12 @@ bool sh_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
 {
 	uint16_t opcode;
 
+	/* note whether the code is in RAM and where the checksum code reads it back */
+	/* from now, so the code generator never has to look at guest memory */
+	if (m_sh->m_program->get_write_ptr(desc.physpc) != nullptr)
+		desc.userflags |= USERFLAG_WRITABLE;
+	desc.userptr = m_sh->m_prptr(desc.physpc);
+
 	/* fetch the opcode */
 	opcode = desc.opptr.w[0] = read_word(desc);
 
@@ -388,6 +388,41 @@ void uml::instruction::configure(opcode_t op, u8 size, parameter p0, parameter p
 }
 
 
+//-------------------------------------------------
+//  restore - rebuild an instruction from its
+//  parts, as recorded from an earlier one;
+//  returns false if they don't make a valid
+//  instruction
+//-------------------------------------------------
+
+bool uml::instruction::restore(opcode_t op, u8 size, condition_t cond, u8 flags, u8 numparams, parameter const *params)
+{
+	// the parts may have come from disk, so check them against the table
+	if (op <= OP_INVALID || op >= OP_MAX || numparams > MAX_PARAMS)
+		return false;
+	opcode_info const &opinfo = s_opcode_info_table[op];
+	if ((size != 1 && size != 2 && size != 4 && size != 8) || !(opinfo.sizes & size))
+		return false;
+	if (cond != COND_ALWAYS && (!opinfo.condition || cond < COND_Z || cond > COND_GE))
+		return false;
+	if ((flags & ~OPFLAGS_ALL) != 0)
+		return false;
+	for (int pnum = 0; pnum < MAX_PARAMS; pnum++)
+		if ((pnum < numparams) ? ((params[pnum].type() >= parameter::PTYPE_MAX) || !((opinfo.param[pnum].typemask >> params[pnum].type()) & 1)) : (opinfo.param[pnum].typemask != 0))
+			return false;
+
+	// fill in the instruction
+	m_opcode = op;
+	m_size = size;
+	m_condition = cond;
+	m_flags = flags;
+	m_numparams = numparams;
+	for (int pnum = 0; pnum < numparams; pnum++)
+		m_param[pnum] = params[pnum];
+	return true;
+}
+
+
 //-------------------------------------------------
 //  simplify - simplify instructions that have
 //  immediate values we can evaluate at compile
@@ -836,6 +871,67 @@ u8 uml::instruction::modified_flags() const
 }
 
 
+//-------------------------------------------------
+//  param_is_input - return true if the given
+//  parameter is read by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_input(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].output & PIO_IN) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_is_output - return true if the given
+//  parameter is written by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_output(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].output & PIO_OUT) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_size - return the size in bytes of the
+//  value a parameter refers to, or 0 if it isn't
+//  a plain value of a known size
+//-------------------------------------------------
+
+u8 uml::instruction::param_size(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	opcode_info::parameter_info const &info = s_opcode_info_table[m_opcode].param[paramnum];
+
+	// pointers and machine state are addresses, not values
+	if (info.typemask & (PTYPES_PTR | PTYPES_STATE) & ~PTYPES_MEM)
+		return 0;
+
+	switch (info.size)
+	{
+	case PSIZE_OP:  return m_size;
+	case PSIZE_4:   return 4;
+	case PSIZE_8:   return 8;
+	default:        return 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  param_allows - return true if the given
+//  parameter may be of the given type
+//-------------------------------------------------
+
+bool uml::instruction::param_allows(int paramnum, parameter::parameter_type type) const
+{
+	assert(paramnum < m_numparams);
+	return ((s_opcode_info_table[m_opcode].param[paramnum].typemask >> type) & 1) != 0;
+}
+
+
 //-------------------------------------------------
 //  disasm - disassemble an instruction to the
 //  given buffer
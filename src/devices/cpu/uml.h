@@ -317,6 +317,7 @@ namespace uml
 		static parameter make_string(char const *string) { return parameter(PTYPE_STRING, reinterpret_cast<parameter_value>(const_cast<char *>(string))); }
 		static parameter make_cfunc(c_function func) { return parameter(PTYPE_C_FUNCTION, reinterpret_cast<parameter_value>(func)); }
 		static parameter make_rounding(float_rounding_mode mode) { assert(mode >= ROUND_TRUNC && mode <= ROUND_DEFAULT); return parameter(PTYPE_ROUNDING, mode); }
+		static parameter make_raw(parameter_type type, parameter_value value) { assert(type > PTYPE_NONE && type < PTYPE_MAX); return parameter(type, value); }
 
 		// operators
 		constexpr bool operator==(parameter const &rhs) const { return (m_type == rhs.m_type) && (m_value == rhs.m_value); }
@@ -324,6 +325,7 @@ namespace uml
 
 		// getters
 		constexpr parameter_type type() const { return m_type; }
+		constexpr parameter_value raw_value() const { return m_value; }
 		u64 immediate() const { assert(m_type == PTYPE_IMMEDIATE); return m_value; }
 		int ireg() const { assert(m_type == PTYPE_INT_REGISTER); assert(m_value >= REG_I0 && m_value < REG_I_END); return m_value; }
 		int freg() const { assert(m_type == PTYPE_FLOAT_REGISTER); assert(m_value >= REG_F0 && m_value < REG_F_END); return m_value; }
@@ -405,6 +407,8 @@ namespace uml
 		// setters
 		void set_flags(u8 flags) { m_flags = flags; }
 		void set_mapvar(int paramnum, u32 value) { assert(paramnum < m_numparams); assert(m_param[paramnum].is_mapvar()); m_param[paramnum] = value; }
+		void set_param(int paramnum, parameter value) { assert(paramnum < m_numparams); assert(param_allows(paramnum, value.type())); m_param[paramnum] = value; }
+		bool restore(opcode_t op, u8 size, condition_t cond, u8 flags, u8 numparams, parameter const *params);
 
 		// misc
 		std::string disasm(drcuml_state *drcuml = nullptr) const;
@@ -413,6 +417,12 @@ namespace uml
 		u8 modified_flags() const;
 		void simplify();
 
+		// parameter information for the optimizer
+		bool param_is_input(int paramnum) const;
+		bool param_is_output(int paramnum) const;
+		u8 param_size(int paramnum) const;
+		bool param_allows(int paramnum, parameter::parameter_type type) const;
+
 		// compile-time opcodes
 		void handle(code_handle &hand) { configure(OP_HANDLE, 4, hand); }
 		void hash(u32 mode, u32 pc) { configure(OP_HASH, 4, mode, pc); }
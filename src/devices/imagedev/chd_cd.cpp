@@ -12,6 +12,7 @@
 #include "chd_cd.h"
 
 #include "cdrom.h"
+#include "emuopts.h"
 #include "romload.h"
 
 // device type definition
@@ -92,6 +93,7 @@ image_init_result cdrom_image_device::call_load()
 	if (!loaded_through_softlist())
 	{
 		if (is_filetype("chd") && is_loaded()) {
+			m_self_chd.set_cache_hunks(device().machine().options().chd_cache_hunks());
 			err = m_self_chd.open( image_core_file() );    /* CDs are never writeable */
 			if ( err )
 				goto error;
@@ -219,6 +219,8 @@ image_init_result diablo_image_device::internal_load_dsk()
 	}
 	else
 	{
+		m_origchd.set_cache_hunks(device().machine().options().chd_cache_hunks());
+		m_diffchd.set_cache_hunks(device().machine().options().chd_cache_hunks());
 		err = m_origchd.open(image_core_file(), true);
 		if (err == CHDERR_NONE)
 		{
@@ -10,6 +10,7 @@
 
 #include "emu.h"
 #include "netlist.h"
+#include "emuopts.h"
 
 #include "netlist/nl_base.h"
 #include "netlist/nl_setup.h"
@@ -85,6 +86,9 @@ protected:
 		}
 	}
 
+	// the generated solvers are compiled into the netlist library
+	const netlist::static_solver_sym *static_solvers() const override { return netlist::static_solvers; }
+
 private:
 	netlist_mame_device &m_parent;
 };
@@ -852,6 +856,20 @@ void netlist_mame_device::device_start()
 
 	m_netlist = global_alloc(netlist_mame_t(*this, "netlist"));
 
+	// compile static solvers that aren't built in, keeping them for later sessions
+	if (machine().options().netlist_cache())
+	{
+		// writing a note there makes sure the directory exists
+		emu_file file(machine().options().cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		if (file.open("netlist/README.txt") == osd_file::error::NONE)
+		{
+			file.puts("Netlist solvers compiled for reuse by later sessions; safe to delete.\n");
+			std::string const path(file.fullpath());
+			file.close();
+			netlist().nlstate().set_static_solver_cache(pstring(path.substr(0, path.find_last_of("/\\")).c_str()));
+		}
+	}
+
 	// register additional devices
 
 	nl_register_devices();
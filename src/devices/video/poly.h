@@ -37,6 +37,7 @@
 
 #pragma once
 
+#include "emuopts.h"
 #include "screen.h"
 
 #include <limits.h>
@@ -56,6 +57,159 @@
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+// polygon stream captures, written by poly_manager::capture_start (and the
+// legacy manager's poly_capture_start) and read back by the replay benchmark;
+// values are in host byte order.  Besides the geometry, each primitive names
+// the render callback that drew it and is preceded by the object data it was
+// drawn with whenever that changes.  Drivers add whatever else their
+// callbacks read (texture memory, buffer swaps) as tagged data records, so
+// those that can be built outside a running machine can be replayed through
+// their own rasterizers
+struct poly_capture
+{
+	static constexpr uint32_t MAGIC = 0x33594c50; // "PLY3"
+
+	// every record starts with a primitive
+	enum record_type : uint32_t
+	{
+		FRAME,                                  // a new screen frame started
+		TILE,                                   // render_tile, 2 vertices follow
+		TRIANGLE,                               // render_triangle, 3 vertices follow
+		POLYGON,                                // render_polygon, count vertices follow
+		CUSTOM,                                 // render_triangle_custom, count extents follow
+		CALLBACK,                               // callback id is first used, count bytes of its name follow
+		OBJECT,                                 // object data for what follows, count bytes of it follow
+		DATA                                    // driver data tagged id, count bytes of it follow
+	};
+
+	// the file starts with a header
+	struct header
+	{
+		uint32_t    magic;                      // MAGIC
+		uint32_t    basesize;                   // size of the coordinate and parameter type
+		uint32_t    basefloat;                  // nonzero if it is floating point
+		uint32_t    maxparams;                  // parameters in each custom extent
+		uint32_t    objectsize;                 // size of the object data
+		uint32_t    flags;                      // flags the manager was created with
+	};
+
+	// vertices are x, y and paramcount parameters; custom extents are startx
+	// and stopx as int32_t, then start and dpdx for each of maxparams
+	struct primitive
+	{
+		uint32_t    type;                       // record_type
+		uint32_t    id;                         // callback index, or data tag
+		int32_t     clip[4];                    // cliprect left, right, top, bottom
+		int32_t     paramcount;                 // parameters per vertex
+		int32_t     count;                      // vertices, scanlines of custom extents, or bytes
+		int32_t     startscanline;              // first scanline of custom extents
+	};
+
+	// managers after the first capture to numbered files
+	static std::string filename(const char *base)
+	{
+		static std::atomic<int> s_index(0);
+		int const index = s_index++;
+		return index ? util::string_format("%s.%d", base, index) : std::string(base);
+	}
+
+	// writes the records for a manager; callbacks are identified by the
+	// manager as an index in order of first use
+	class writer
+	{
+	public:
+		writer(util::core_file::ptr &&file, const poly_capture::header &info, screen_device *screen, int frames)
+			: m_file(std::move(file))
+			, m_screen(screen)
+			, m_frame(0)
+			, m_frames(frames)
+			, m_captured(0)
+			, m_callbacks(0)
+			, m_object(info.objectsize)
+			, m_objects(0)
+		{
+			m_file->write(&info, sizeof(info));
+		}
+
+		// mark the start of each frame; returns false once the last one is done
+		bool frame()
+		{
+			uint64_t const frame = (m_screen != nullptr) ? m_screen->frame_number() : 0;
+			if (m_captured != 0 && frame == m_frame)
+				return true;
+			if (m_frames != 0 && m_captured == m_frames)
+				return false;
+			m_frame = frame;
+			m_captured++;
+			record(FRAME, 0, 0);
+			return true;
+		}
+
+		// name callbacks as they are first used
+		bool new_callback(uint32_t index) const { return index >= m_callbacks; }
+		void callback(uint32_t index, const char *name)
+		{
+			record(CALLBACK, index, strlen(name));
+			m_file->write(name, strlen(name));
+			m_callbacks = index + 1;
+		}
+
+		// write the object data if it changed
+		void object(const void *data)
+		{
+			if (m_object.empty() || (m_objects != 0 && memcmp(&m_object[0], data, m_object.size()) == 0))
+				return;
+			memcpy(&m_object[0], data, m_object.size());
+			m_objects++;
+			record(OBJECT, 0, m_object.size());
+			m_file->write(data, m_object.size());
+		}
+
+		void data(uint32_t tag, const void *data, std::size_t length)
+		{
+			record(DATA, tag, length);
+			m_file->write(data, length);
+		}
+
+		void primitive(uint32_t type, uint32_t callback, const rectangle &cliprect, int paramcount, int count, int startscanline = 0)
+		{
+			poly_capture::primitive record = {};
+			record.type = type;
+			record.id = callback;
+			record.clip[0] = cliprect.left();
+			record.clip[1] = cliprect.right();
+			record.clip[2] = cliprect.top();
+			record.clip[3] = cliprect.bottom();
+			record.paramcount = paramcount;
+			record.count = count;
+			record.startscanline = startscanline;
+			m_file->write(&record, sizeof(record));
+		}
+
+		void write(const void *data, std::size_t length) { m_file->write(data, length); }
+
+	private:
+		void record(uint32_t type, uint32_t id, std::size_t length)
+		{
+			poly_capture::primitive record = {};
+			record.type = type;
+			record.id = id;
+			record.count = length;
+			m_file->write(&record, sizeof(record));
+		}
+
+		util::core_file::ptr    m_file;         // file being written
+		screen_device *         m_screen;       // screen frames are counted on, if any
+		uint64_t                m_frame;        // frame number last written
+		int                     m_frames;       // frames to capture, or 0 for no limit
+		int                     m_captured;     // frames started so far
+		uint32_t                m_callbacks;    // callbacks named so far
+		std::vector<uint8_t>    m_object;       // object data last written
+		uint32_t                m_objects;      // object data records written
+	};
+};
+
+
 // poly_manager is a template class
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 class poly_manager
@@ -64,6 +218,14 @@ public:
 	static constexpr uint8_t FLAG_INCLUDE_BOTTOM_EDGE = 0x01;
 	static constexpr uint8_t FLAG_INCLUDE_RIGHT_EDGE  = 0x02;
 	static constexpr uint8_t FLAG_NO_WORK_QUEUE       = 0x04;
+	static constexpr uint8_t FLAG_TILE_BINNING        = 0x08;
+
+	// work is ordered per bin of SCANLINES_PER_BUCKET scanlines; with
+	// FLAG_TILE_BINNING bins are also split into columns of TILE_WIDTH pixels,
+	// and callbacks get extents clipped to a column with their parameters
+	// advanced to the new start (custom extents must run left to right)
+	static constexpr int SCANLINES_PER_BUCKET = 32;
+	static constexpr int TILE_WIDTH           = 64;
 
 	// each vertex has an X/Y coordinate and a set of parameters
 	struct vertex_t
@@ -93,16 +255,31 @@ public:
 	// construction/destruction
 	poly_manager(running_machine &machine, uint8_t flags = 0);
 	poly_manager(screen_device &screen, uint8_t flags = 0);
+	explicit poly_manager(uint8_t flags); // outside of a running machine, for replaying captures
 	virtual ~poly_manager();
 
 	// getters
-	running_machine &machine() const { return m_machine; }
+	running_machine &machine() const { assert(m_machine != nullptr); return *m_machine; }
 	screen_device &screen() const { assert(m_screen != nullptr); return *m_screen; }
 	uint32_t triangles_drawn() const { return m_triangles; }
 
 	// synchronization
 	void wait(const char *debug_reason = "general");
 
+	// set the area covered by bins before they wrap around
+	void configure_bins(int width, int height);
+
+	// capture what is rendered for the given number of frames, 0 for no limit
+	void capture_start(const char *filename, int frames = 0);
+	void capture_stop() { m_capture.reset(); }
+	bool capturing() const { return bool(m_capture); }
+
+	// name a callback in captures, so a replay can find it again
+	void capture_name(render_delegate callback, const char *name) { m_capture_names.emplace_back(callback, name); }
+
+	// add driver data the callbacks depend on to the capture, if any
+	void capture_data(uint32_t tag, const void *data, std::size_t length) { if (m_capture) m_capture->data(tag, data, length); }
+
 	// object data allocators
 	_ObjectData &object_data_alloc();
 	_ObjectData &object_data_last() const { return m_object.last(); }
@@ -124,7 +301,7 @@ public:
 	int zclip_if_less(int numverts, const vertex_t *v, vertex_t *outv, int paramcount, _BaseType clipval);
 
 private:
-	poly_manager(running_machine &machine, screen_device *screen, uint8_t flags);
+	poly_manager(running_machine *machine, screen_device *screen, uint8_t flags);
 
 	// turn this on to log the reasons for any long waits
 	static constexpr bool POLY_LOG_WAITS = false;
@@ -132,9 +309,9 @@ private:
 	// number of profiling ticks before we consider a wait "long"
 	static constexpr osd_ticks_t POLY_LOG_WAIT_THRESHOLD = 1000;
 
-	static constexpr int SCANLINES_PER_BUCKET = 32;
 	static constexpr int CACHE_LINE_SIZE      = 64;          // this is a general guess
-	static constexpr int TOTAL_BUCKETS        = (512 / SCANLINES_PER_BUCKET);
+	static constexpr int DEFAULT_BIN_WIDTH    = 1024;
+	static constexpr int DEFAULT_BIN_HEIGHT   = 512;
 	static constexpr int UNITS_PER_POLY       = (100 / SCANLINES_PER_BUCKET);
 
 	// polygon_info describes a single polygon, which includes the poly_params
@@ -185,7 +362,7 @@ private:
 
 	public:
 		// construction
-		poly_array(running_machine &machine, poly_manager &manager)
+		poly_array(poly_manager &manager)
 			: m_manager(manager),
 				m_base(make_unique_clear<uint8_t[]>(k_itemsize * _Count)),
 				m_next(0),
@@ -237,11 +414,14 @@ private:
 	}
 
 	// internal helpers
-	polygon_info &polygon_alloc(int minx, int maxx, int miny, int maxy, render_delegate callback)
+	polygon_info &polygon_alloc(const rectangle &cliprect, int minx, int maxx, int miny, int maxy, render_delegate callback)
 	{
-		// wait for space in the polygon and unit arrays
+		// wait for space in the polygon and unit arrays; tiled polygons take a unit per tile
 		m_polygon.wait_for_space();
-		m_unit.wait_for_space((maxy - miny) / SCANLINES_PER_BUCKET + 2);
+		int units = (maxy - miny) / SCANLINES_PER_BUCKET + 2;
+		if (m_flags & FLAG_TILE_BINNING)
+			units *= std::max(std::min(maxx, cliprect.right() + 1) - std::max(minx, cliprect.left()), 0) / TILE_WIDTH + 2;
+		m_unit.wait_for_space(units);
 
 		// return and initialize the next one
 		polygon_info &polygon = m_polygon.next();
@@ -251,11 +431,21 @@ private:
 		return polygon;
 	}
 
+	// tile column containing an X coordinate, rounding down
+	static int32_t tile_column(int32_t x) { return (x >= 0) ? (x / TILE_WIDTH) : (-1 - (-1 - x) / TILE_WIDTH); }
+
+	void bin_unit(work_unit &unit, uint32_t unit_index, int paramcount);
+	void link_unit(work_unit &unit, uint32_t unit_index, uint32_t row, int32_t column);
+	static void clip_extent(extent_t &dest, const extent_t &source, int32_t left, int32_t right, int paramcount);
 	static void *work_item_callback(void *param, int threadid);
 	void presave() { wait("pre-save"); }
 
+	// capture helpers
+	bool capture_primitive(uint32_t type, render_delegate callback, const rectangle &cliprect, int paramcount, int count, int startscanline = 0);
+	void capture_vertex(const vertex_t &v, int paramcount);
+
 	// queue management
-	running_machine &   m_machine;
+	running_machine *   m_machine;
 	screen_device *     m_screen;
 	osd_work_queue *    m_queue;                    // work queue
 
@@ -268,7 +458,9 @@ private:
 	uint8_t const         m_flags;                    // flags
 
 	// buckets
-	uint16_t              m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
+	std::vector<uint16_t> m_unit_bucket;              // last unit queued in each bin
+	uint32_t              m_bin_rows;                 // bins down before wrapping around
+	uint32_t              m_bin_columns;              // bins across before wrapping around
 
 	// statistics
 	uint32_t              m_tiles;                    // number of tiles queued
@@ -279,6 +471,11 @@ private:
 	uint32_t              m_conflicts[WORK_MAX_THREADS]; // number of conflicts found, per thread
 	uint32_t              m_resolved[WORK_MAX_THREADS];   // number of conflicts resolved, per thread
 #endif
+
+	// capture
+	std::unique_ptr<poly_capture::writer> m_capture;  // polygon stream capture, if active
+	std::vector<render_delegate> m_capture_callbacks; // callbacks in the capture, in order of first use
+	std::vector<std::pair<render_delegate, const char *>> m_capture_names; // names given to callbacks
 };
 
 
@@ -288,27 +485,36 @@ private:
 
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(running_machine &machine, uint8_t flags)
-	: poly_manager(machine, nullptr, flags)
+	: poly_manager(&machine, nullptr, flags)
 {
 }
 
 
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(screen_device &screen, uint8_t flags)
-	: poly_manager(screen.machine(), &screen, flags)
+	: poly_manager(&screen.machine(), &screen, flags)
+{
+}
+
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(uint8_t flags)
+	: poly_manager(nullptr, nullptr, flags)
 {
 }
 
 
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
-poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(running_machine &machine, screen_device *screen, uint8_t flags)
+poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(running_machine *machine, screen_device *screen, uint8_t flags)
 	: m_machine(machine)
 	, m_screen(screen)
 	, m_queue(nullptr)
-	, m_polygon(machine, *this)
-	, m_object(machine, *this)
-	, m_unit(machine, *this)
+	, m_polygon(*this)
+	, m_object(*this)
+	, m_unit(*this)
 	, m_flags(flags)
+	, m_bin_rows(0)
+	, m_bin_columns(0)
 	, m_tiles(0)
 	, m_triangles(0)
 	, m_quads(0)
@@ -323,10 +529,17 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 	if (!(flags & FLAG_NO_WORK_QUEUE))
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
-	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
+	configure_bins(DEFAULT_BIN_WIDTH, DEFAULT_BIN_HEIGHT);
+
+	if (machine != nullptr)
+	{
+		// request a pre-save callback for synchronization
+		machine->save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
 
-	// request a pre-save callback for synchronization
-	machine.save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
+		// capture the polygon stream if asked to
+		if (machine->options().poly_capture()[0] != 0)
+			capture_start(poly_capture::filename(machine->options().poly_capture()).c_str(), machine->options().poly_capture_frames());
+	}
 }
 
 
@@ -463,7 +676,7 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 	// reset the state
 	m_polygon.reset();
 	m_unit.reset();
-	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
+	std::fill(m_unit_bucket.begin(), m_unit_bucket.end(), 0xffff);
 
 	// we need to preserve the last object data that was supplied
 	if (m_object.count() > 0)
@@ -477,6 +690,205 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 }
 
 
+//-------------------------------------------------
+//  configure_bins - set the area covered by the
+//  bins; work further apart than this shares
+//  bins, which is safe but serializes it
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::configure_bins(int width, int height)
+{
+	// pending units are linked through the old bins
+	if (!m_unit_bucket.empty())
+		wait("bin configuration");
+
+	m_bin_rows = std::max((height + SCANLINES_PER_BUCKET - 1) / SCANLINES_PER_BUCKET, 1);
+	m_bin_columns = (m_flags & FLAG_TILE_BINNING) ? std::max((width + TILE_WIDTH - 1) / TILE_WIDTH, 1) : 1;
+	m_unit_bucket.assign(m_bin_rows * m_bin_columns, 0xffff);
+}
+
+
+//-------------------------------------------------
+//  capture_start - start writing the primitives
+//  rendered to a file
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::capture_start(const char *filename, int frames)
+{
+	util::core_file::ptr file;
+	if (util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, file) != osd_file::error::NONE)
+	{
+		osd_printf_warning("Unable to open polygon capture file %s\n", filename);
+		return;
+	}
+
+	poly_capture::header header;
+	header.magic = poly_capture::MAGIC;
+	header.basesize = sizeof(_BaseType);
+	header.basefloat = std::is_floating_point<_BaseType>::value;
+	header.maxparams = _MaxParams;
+	header.objectsize = sizeof(_ObjectData);
+	header.flags = m_flags;
+
+	// frames are counted on our screen, or the first one
+	screen_device *screen = m_screen;
+	if (screen == nullptr && m_machine != nullptr)
+		screen = screen_device_iterator(m_machine->root_device()).first();
+	m_capture = std::make_unique<poly_capture::writer>(std::move(file), header, screen, frames);
+	m_capture_callbacks.clear();
+}
+
+
+//-------------------------------------------------
+//  capture_primitive - write the record for a
+//  primitive, preceded by a frame record when a
+//  new frame starts, the callback's name when it
+//  is first used and the object data when it
+//  changes; returns false once the capture is
+//  complete
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+bool poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::capture_primitive(uint32_t type, render_delegate callback, const rectangle &cliprect, int paramcount, int count, int startscanline)
+{
+	// mark the start of each frame, stopping after the last one
+	if (!m_capture->frame())
+	{
+		capture_stop();
+		return false;
+	}
+
+	// identify the callback, naming it the first time
+	uint32_t index = std::find(m_capture_callbacks.begin(), m_capture_callbacks.end(), callback) - m_capture_callbacks.begin();
+	if (m_capture->new_callback(index))
+	{
+		m_capture_callbacks.push_back(callback);
+		auto name = std::find_if(m_capture_names.begin(), m_capture_names.end(), [&callback] (auto const &entry) { return entry.first == callback; });
+		m_capture->callback(index, (name != m_capture_names.end()) ? name->second : "");
+	}
+
+	// the object data goes with the primitives allocated after it
+	if (m_object.count() > 0)
+		m_capture->object(&object_data_last());
+
+	m_capture->primitive(type, index, cliprect, paramcount, count, startscanline);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  capture_vertex - write a vertex of the
+//  primitive just captured
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::capture_vertex(const vertex_t &v, int paramcount)
+{
+	m_capture->write(&v.x, sizeof(v.x));
+	m_capture->write(&v.y, sizeof(v.y));
+	m_capture->write(&v.p[0], sizeof(v.p[0]) * paramcount);
+}
+
+
+//-------------------------------------------------
+//  link_unit - queue a unit behind the last one
+//  in its bin
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::link_unit(work_unit &unit, uint32_t unit_index, uint32_t row, int32_t column)
+{
+	uint32_t bucketnum = (row % m_bin_rows) * m_bin_columns + (uint32_t)column % m_bin_columns;
+	unit.previtem = m_unit_bucket[bucketnum];
+	m_unit_bucket[bucketnum] = unit_index;
+}
+
+
+//-------------------------------------------------
+//  clip_extent - copy an extent, clipped to the
+//  given columns
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::clip_extent(extent_t &dest, const extent_t &source, int32_t left, int32_t right, int paramcount)
+{
+	int32_t startx = std::max<int32_t>(source.startx, left);
+	int32_t stopx = std::min<int32_t>(source.stopx, right);
+
+	if (&dest != &source)
+		dest = source;
+
+	// nothing of the extent falls in the columns, so it draws nothing
+	if (startx >= stopx)
+	{
+		dest.startx = dest.stopx = left;
+		return;
+	}
+
+	// advance the parameters to the new starting point
+	for (int paramnum = 0; paramnum < paramcount; paramnum++)
+		dest.param[paramnum].start = source.param[paramnum].start + _BaseType(startx - source.startx) * source.param[paramnum].dpdx;
+	dest.startx = startx;
+	dest.stopx = stopx;
+}
+
+
+//-------------------------------------------------
+//  bin_unit - queue a freshly filled unit in its
+//  bin, splitting it into one unit per tile
+//  column it touches when tile binning
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::bin_unit(work_unit &unit, uint32_t unit_index, int paramcount)
+{
+	uint32_t row = (uint32_t)unit.scanline / SCANLINES_PER_BUCKET;
+	if (!(m_flags & FLAG_TILE_BINNING))
+	{
+		link_unit(unit, unit_index, row, 0);
+		return;
+	}
+
+	// find the columns covered by the unit's extents
+	int count = unit.count_next & 0xffff;
+	int32_t minx = INT_MAX, maxx = INT_MIN;
+	for (int extnum = 0; extnum < count; extnum++)
+		if (unit.extent[extnum].startx < unit.extent[extnum].stopx)
+		{
+			minx = std::min<int32_t>(minx, unit.extent[extnum].startx);
+			maxx = std::max<int32_t>(maxx, unit.extent[extnum].stopx);
+		}
+	if (minx >= maxx)
+	{
+		link_unit(unit, unit_index, row, 0);
+		return;
+	}
+	int32_t firstcol = tile_column(minx);
+	int32_t lastcol = tile_column(maxx - 1);
+
+	// every column past the first gets a clipped copy of the unit
+	for (int32_t column = firstcol + 1; column <= lastcol; column++)
+	{
+		uint32_t tile_index = m_unit.count();
+		work_unit &tile = m_unit.next();
+		tile.polygon = unit.polygon;
+		tile.count_next = count;
+		tile.scanline = unit.scanline;
+		for (int extnum = 0; extnum < count; extnum++)
+			clip_extent(tile.extent[extnum], unit.extent[extnum], column * TILE_WIDTH, (column + 1) * TILE_WIDTH, paramcount);
+		link_unit(tile, tile_index, row, column);
+	}
+
+	// then the unit itself is clipped to the first
+	if (lastcol != firstcol)
+		for (int extnum = 0; extnum < count; extnum++)
+			clip_extent(unit.extent[extnum], unit.extent[extnum], firstcol * TILE_WIDTH, (firstcol + 1) * TILE_WIDTH, paramcount);
+	link_unit(unit, unit_index, row, firstcol);
+}
+
+
 //-------------------------------------------------
 //  object_data_alloc - allocate a new _ObjectData
 //-------------------------------------------------
@@ -497,6 +909,12 @@ _ObjectData &poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::object
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(const rectangle &cliprect, render_delegate callback, int paramcount, const vertex_t &_v1, const vertex_t &_v2)
 {
+	if (m_capture && capture_primitive(poly_capture::TILE, callback, cliprect, paramcount, 2))
+	{
+		capture_vertex(_v1, paramcount);
+		capture_vertex(_v2, paramcount);
+	}
+
 	const vertex_t *v1 = &_v1;
 	const vertex_t *v2 = &_v2;
 
@@ -527,7 +945,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_til
 		return 0;
 
 	// allocate and populate a new polygon
-	polygon_info &polygon = polygon_alloc(round_coordinate(minx), round_coordinate(maxx), v1yclip, v2yclip, callback);
+	polygon_info &polygon = polygon_alloc(cliprect, round_coordinate(minx), round_coordinate(maxx), v1yclip, v2yclip, callback);
 
 	// compute parameter deltas
 	_BaseType param_dpdx[_MaxParams];
@@ -573,7 +991,6 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_til
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v2yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = ((uint32_t)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
@@ -584,8 +1001,6 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_til
 		unit.polygon = &polygon;
 		unit.count_next = std::min(v2yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -608,6 +1023,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_til
 				extent.param[paramnum].dpdx = param_dpdx[paramnum];
 			}
 		}
+		bin_unit(unit, unit_index, paramcount);
 	}
 
 	// enqueue the work items
@@ -629,6 +1045,13 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_til
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_triangle(const rectangle &cliprect, render_delegate callback, int paramcount, const vertex_t &_v1, const vertex_t &_v2, const vertex_t &_v3)
 {
+	if (m_capture && capture_primitive(poly_capture::TRIANGLE, callback, cliprect, paramcount, 3))
+	{
+		capture_vertex(_v1, paramcount);
+		capture_vertex(_v2, paramcount);
+		capture_vertex(_v3, paramcount);
+	}
+
 	const vertex_t *v1 = &_v1;
 	const vertex_t *v2 = &_v2;
 	const vertex_t *v3 = &_v3;
@@ -674,7 +1097,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 	else if (v3->x > maxx) maxx = v3->x;
 
 	// allocate and populate a new polygon
-	polygon_info &polygon = polygon_alloc(round_coordinate(minx), round_coordinate(maxx), v1yclip, v3yclip, callback);
+	polygon_info &polygon = polygon_alloc(cliprect, round_coordinate(minx), round_coordinate(maxx), v1yclip, v3yclip, callback);
 
 	// compute the slopes for each portion of the triangle
 	_BaseType dxdy_v1v2 = (v2->y == v1->y) ? _BaseType(0.0) : (v2->x - v1->x) / (v2->y - v1->y);
@@ -731,7 +1154,6 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = ((uint32_t)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
@@ -742,8 +1164,6 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 		unit.polygon = &polygon;
 		unit.count_next = std::min(v3yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -796,6 +1216,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 				extent.param[paramnum].dpdx = param_dpdx[paramnum];
 			}
 		}
+		bin_unit(unit, unit_index, paramcount);
 	}
 
 	// enqueue the work items
@@ -849,6 +1270,18 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_triangle_custom(const rectangle &cliprect, render_delegate callback, int startscanline, int numscanlines, const extent_t *extents)
 {
+	if (m_capture && capture_primitive(poly_capture::CUSTOM, callback, cliprect, _MaxParams, numscanlines, startscanline))
+		for (int extnum = 0; extnum < numscanlines; extnum++)
+		{
+			int32_t const x[2] = { extents[extnum].startx, extents[extnum].stopx };
+			m_capture->write(x, sizeof(x));
+			for (int paramnum = 0; paramnum < _MaxParams; paramnum++)
+			{
+				m_capture->write(&extents[extnum].param[paramnum].start, sizeof(_BaseType));
+				m_capture->write(&extents[extnum].param[paramnum].dpdx, sizeof(_BaseType));
+			}
+		}
+
 	// clip coordinates
 	int32_t v1yclip = std::max(startscanline, cliprect.top());
 	int32_t v3yclip = std::min(startscanline + numscanlines, cliprect.bottom() + 1);
@@ -856,7 +1289,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 		return 0;
 
 	// allocate and populate a new polygon
-	polygon_info &polygon = polygon_alloc(0, 0, v1yclip, v3yclip, callback);
+	polygon_info &polygon = polygon_alloc(cliprect, cliprect.left(), cliprect.right() + 1, v1yclip, v3yclip, callback);
 
 	// compute the X extents for each scanline
 	int32_t pixels = 0;
@@ -864,7 +1297,6 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = ((uint32_t)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
@@ -875,8 +1307,6 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 		unit.polygon = &polygon;
 		unit.count_next = std::min(v3yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -912,6 +1342,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 			else if(istopx < istartx)
 				pixels += istartx - istopx;
 		}
+		bin_unit(unit, unit_index, _MaxParams);
 	}
 
 	// enqueue the work items
@@ -934,6 +1365,10 @@ template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 template<int _NumVerts>
 uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_polygon(const rectangle &cliprect, render_delegate callback, int paramcount, const vertex_t *v)
 {
+	if (m_capture && capture_primitive(poly_capture::POLYGON, callback, cliprect, paramcount, _NumVerts))
+		for (int vertnum = 0; vertnum < _NumVerts; vertnum++)
+			capture_vertex(v[vertnum], paramcount);
+
 	// determine min/max Y vertices
 	_BaseType minx = v[0].x;
 	_BaseType maxx = v[0].x;
@@ -964,7 +1399,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_pol
 		return 0;
 
 	// allocate a new polygon
-	polygon_info &polygon = polygon_alloc(round_coordinate(minx), round_coordinate(maxx), minyclip, maxyclip, callback);
+	polygon_info &polygon = polygon_alloc(cliprect, round_coordinate(minx), round_coordinate(maxx), minyclip, maxyclip, callback);
 
 	// walk forward to build up the forward edge list
 	struct poly_edge
@@ -1039,7 +1474,6 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_pol
 	int32_t scaninc = 1;
 	for (int32_t curscan = minyclip; curscan < maxyclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = ((uint32_t)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
@@ -1050,8 +1484,6 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_pol
 		unit.polygon = &polygon;
 		unit.count_next = std::min(maxyclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -1111,6 +1543,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_pol
 			extent.userdata = nullptr;
 			pixels += istopx - istartx;
 		}
+		bin_unit(unit, unit_index, paramcount);
 	}
 
 	// enqueue the work items
@@ -10,6 +10,7 @@
 
 #include "emu.h"
 #include "polylgcy.h"
+#include "poly.h"
 
 #include <atomic>
 
@@ -146,6 +147,8 @@ struct polygon_info
 /* full poly manager description */
 struct legacy_poly_manager
 {
+	running_machine *   machine;                /* machine we belong to */
+
 	/* queue management */
 	osd_work_queue *    queue;                  /* work queue */
 
@@ -178,6 +181,11 @@ struct legacy_poly_manager
 	/* buckets */
 	uint16_t              unit_bucket[TOTAL_BUCKETS]; /* buckets for tracking unit usage */
 
+	/* capture */
+	std::unique_ptr<poly_capture::writer> capture; /* polygon stream capture, if active */
+	std::vector<poly_draw_scanline_func> capture_callbacks; /* callbacks in the capture, in order of first use */
+	std::vector<std::pair<poly_draw_scanline_func, const char *>> capture_names; /* names given to callbacks */
+
 	/* statistics */
 	uint32_t              triangles;              /* number of triangles queued */
 	uint32_t              quads;                  /* number of quads queued */
@@ -203,6 +211,8 @@ struct legacy_poly_manager
 static void **allocate_array(running_machine &machine, size_t *itemsize, uint32_t itemcount);
 static void *poly_item_callback(void *param, int threadid);
 static void poly_state_presave(legacy_poly_manager &poly);
+static bool capture_primitive(legacy_poly_manager *poly, uint32_t type, poly_draw_scanline_func callback, const rectangle &cliprect, int paramcount, int count, int startscanline = 0);
+static void capture_vertex(legacy_poly_manager *poly, const poly_vertex *v, int paramcount);
 
 
 
@@ -322,6 +332,7 @@ legacy_poly_manager *poly_alloc(running_machine &machine, int max_polys, size_t
 
 	/* allocate the manager itself */
 	poly = auto_alloc_clear(machine, <legacy_poly_manager>());
+	poly->machine = &machine;
 	poly->flags = flags;
 
 	/* allocate polygons */
@@ -348,6 +359,10 @@ legacy_poly_manager *poly_alloc(running_machine &machine, int max_polys, size_t
 
 	/* request a pre-save callback for synchronization */
 	machine.save().register_presave(save_prepost_delegate(FUNC(poly_state_presave), poly));
+
+	/* capture the polygon stream if asked to */
+	if (machine.options().poly_capture()[0] != 0)
+		poly_capture_start(poly, poly_capture::filename(machine.options().poly_capture()).c_str(), machine.options().poly_capture_frames());
 	return poly;
 }
 
@@ -382,6 +397,9 @@ void poly_free(legacy_poly_manager *poly)
 	/* free the work queue */
 	if (poly->queue != nullptr)
 		osd_work_queue_free(poly->queue);
+
+	/* finish the capture */
+	poly->capture.reset();
 }
 
 
@@ -459,6 +477,114 @@ void *poly_get_extra_data(legacy_poly_manager *poly)
 
 
 
+/***************************************************************************
+    POLYGON STREAM CAPTURE
+***************************************************************************/
+
+/*-------------------------------------------------
+    poly_capture_start - start writing the
+    primitives rendered to a file, in the same
+    form as poly_manager
+-------------------------------------------------*/
+
+void poly_capture_start(legacy_poly_manager *poly, const char *filename, int frames)
+{
+	util::core_file::ptr file;
+	if (util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, file) != osd_file::error::NONE)
+	{
+		osd_printf_warning("Unable to open polygon capture file %s\n", filename);
+		return;
+	}
+
+	poly_capture::header header;
+	header.magic = poly_capture::MAGIC;
+	header.basesize = sizeof(float);
+	header.basefloat = 1;
+	header.maxparams = POLYLGCY_MAX_VERTEX_PARAMS;
+	header.objectsize = poly->extra_size;
+	header.flags = poly->flags;
+
+	/* frames are counted on the first screen */
+	screen_device *screen = screen_device_iterator(poly->machine->root_device()).first();
+	poly->capture = std::make_unique<poly_capture::writer>(std::move(file), header, screen, frames);
+	poly->capture_callbacks.clear();
+}
+
+
+/*-------------------------------------------------
+    poly_capture_name - name a callback in
+    captures
+-------------------------------------------------*/
+
+void poly_capture_name(legacy_poly_manager *poly, poly_draw_scanline_func callback, const char *name)
+{
+	poly->capture_names.emplace_back(callback, name);
+}
+
+
+/*-------------------------------------------------
+    poly_capture_data - add tagged driver data
+    to the capture, if there is one
+-------------------------------------------------*/
+
+void poly_capture_data(legacy_poly_manager *poly, uint32_t tag, const void *data, size_t length)
+{
+	if (poly->capture)
+		poly->capture->data(tag, data, length);
+}
+
+
+/*-------------------------------------------------
+    capture_primitive - write the record for a
+    primitive, preceded by a frame record when a
+    new frame starts, the callback's name when it
+    is first used and the extra data when it
+    changes; returns false once the capture is
+    complete
+-------------------------------------------------*/
+
+static bool capture_primitive(legacy_poly_manager *poly, uint32_t type, poly_draw_scanline_func callback, const rectangle &cliprect, int paramcount, int count, int startscanline)
+{
+	poly_capture::writer &capture = *poly->capture;
+
+	/* mark the start of each frame, stopping after the last one */
+	if (!capture.frame())
+	{
+		poly->capture.reset();
+		return false;
+	}
+
+	/* identify the callback, naming it the first time */
+	uint32_t index = std::find(poly->capture_callbacks.begin(), poly->capture_callbacks.end(), callback) - poly->capture_callbacks.begin();
+	if (capture.new_callback(index))
+	{
+		poly->capture_callbacks.push_back(callback);
+		auto name = std::find_if(poly->capture_names.begin(), poly->capture_names.end(), [callback] (auto const &entry) { return entry.first == callback; });
+		capture.callback(index, (name != poly->capture_names.end()) ? name->second : "");
+	}
+
+	/* the extra data goes with the primitives allocated after it */
+	capture.object(poly->extra[poly->extra_next - 1]);
+
+	capture.primitive(type, index, cliprect, paramcount, count, startscanline);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    capture_vertex - write a vertex of the
+    primitive just captured
+-------------------------------------------------*/
+
+static void capture_vertex(legacy_poly_manager *poly, const poly_vertex *v, int paramcount)
+{
+	poly->capture->write(&v->x, sizeof(v->x));
+	poly->capture->write(&v->y, sizeof(v->y));
+	poly->capture->write(&v->p[0], sizeof(v->p[0]) * paramcount);
+}
+
+
+
 /***************************************************************************
     CORE TRIANGLE RENDERING
 ***************************************************************************/
@@ -479,6 +605,13 @@ uint32_t poly_render_triangle(legacy_poly_manager *poly, void *dest, const recta
 	int32_t pixels = 0;
 	uint32_t startunit;
 
+	if (poly->capture && capture_primitive(poly, poly_capture::TRIANGLE, callback, cliprect, paramcount, 3))
+	{
+		capture_vertex(poly, v1, paramcount);
+		capture_vertex(poly, v2, paramcount);
+		capture_vertex(poly, v3, paramcount);
+	}
+
 	/* first sort by Y */
 	if (v2->y < v1->y)
 	{
@@ -676,6 +809,16 @@ uint32_t poly_render_triangle_custom(legacy_poly_manager *poly, void *dest, cons
 	int32_t pixels = 0;
 	uint32_t startunit;
 
+	if (poly->capture && capture_primitive(poly, poly_capture::CUSTOM, callback, cliprect, POLYLGCY_MAX_VERTEX_PARAMS, numscanlines, startscanline))
+	{
+		for (int extnum = 0; extnum < numscanlines; extnum++)
+		{
+			int32_t const x[2] = { extents[extnum].startx, extents[extnum].stopx };
+			poly->capture->write(x, sizeof(x));
+			poly->capture->write(extents[extnum].param, sizeof(extents[extnum].param));
+		}
+	}
+
 	/* clip coordinates */
 	v1yclip = std::max(startscanline, cliprect.min_y);
 	v3yclip = std::min(startscanline + numscanlines, cliprect.max_y + 1);
@@ -780,6 +923,14 @@ uint32_t poly_render_quad(legacy_poly_manager *poly, void *dest, const rectangle
 
 	assert(poly->flags & POLYLGCY_FLAG_ALLOW_QUADS);
 
+	if (poly->capture && capture_primitive(poly, poly_capture::POLYGON, callback, cliprect, paramcount, 4))
+	{
+		capture_vertex(poly, v1, paramcount);
+		capture_vertex(poly, v2, paramcount);
+		capture_vertex(poly, v3, paramcount);
+		capture_vertex(poly, v4, paramcount);
+	}
+
 	/* arrays make things easier */
 	v[0] = v1;
 	v[1] = v2;
@@ -1022,6 +1173,12 @@ uint32_t poly_render_polygon(legacy_poly_manager *poly, void *dest, const rectan
 
 	assert(poly->flags & POLYLGCY_FLAG_ALLOW_QUADS);
 
+	if (poly->capture && capture_primitive(poly, poly_capture::POLYGON, callback, cliprect, paramcount, numverts))
+	{
+		for (vertnum = 0; vertnum < numverts; vertnum++)
+			capture_vertex(poly, &v[vertnum], paramcount);
+	}
+
 	/* determine min/max Y vertices */
 	minv = maxv = 0;
 	for (vertnum = 1; vertnum < numverts; vertnum++)
@@ -116,6 +116,19 @@ void *poly_get_extra_data(legacy_poly_manager *poly);
 
 
 
+/* ----- polygon stream capture ----- */
+
+/* capture what is rendered for the given number of frames, 0 for no limit */
+void poly_capture_start(legacy_poly_manager *poly, const char *filename, int frames);
+
+/* name a callback in captures, so a replay can find it again */
+void poly_capture_name(legacy_poly_manager *poly, poly_draw_scanline_func callback, const char *name);
+
+/* add driver data the callbacks depend on to the capture, if any */
+void poly_capture_data(legacy_poly_manager *poly, uint32_t tag, const void *data, size_t length);
+
+
+
 /* ----- core triangle rendering ----- */
 
 /* render a single triangle given 3 vertexes */
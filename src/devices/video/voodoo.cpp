@@ -852,6 +852,7 @@ void voodoo_device::swap_buffers(voodoo_device *vd)
 	}
 	else
 		vd->fbi.rgboffs[0] = vd->reg[leftOverlayBuf].u & vd->fbi.mask & ~0x0f;
+	poly_capture_data(vd->poly, CAPTURE_SWAP, nullptr, 0);
 
 	/* decrement the pending count and reset our state */
 	if (vd->fbi.swaps_pending)
@@ -875,7 +876,7 @@ void voodoo_device::swap_buffers(voodoo_device *vd)
 	/* periodically log rasterizer info */
 	vd->stats.swaps++;
 	if (LOG_RASTERIZERS && vd->stats.swaps % 1000 == 0)
-		dump_rasterizer_stats(vd);
+		printf("----\n%s", dump_rasterizer_stats(vd, false).c_str());
 
 	/* update the statistics (debug) */
 	if (vd->stats.display)
@@ -898,6 +899,9 @@ void voodoo_device::swap_buffers(voodoo_device *vd)
 		statsptr += sprintf(statsptr, "POut:%6d\n", vd->stats.total_pixels_out);
 		statsptr += sprintf(statsptr, "Clip:%6d\n", vd->stats.total_clipped);
 		statsptr += sprintf(statsptr, "Stip:%6d\n", vd->stats.total_stippled);
+		statsptr += sprintf(statsptr, "Gen: %6d%%\n", vd->stats.generic_pixels * 100 / std::max(vd->stats.raster_pixels, 1));
+		statsptr += sprintf(statsptr, "GenT:%6d\n", vd->stats.generic_triangles);
+		statsptr += sprintf(statsptr, "GenR:%6d\n", count_generic_rasterizers(vd));
 		statsptr += sprintf(statsptr, "Chro:%6d\n", vd->stats.total_chroma_fail);
 		statsptr += sprintf(statsptr, "ZFun:%6d\n", vd->stats.total_zfunc_fail);
 		statsptr += sprintf(statsptr, "AFun:%6d\n", vd->stats.total_afunc_fail);
@@ -923,6 +927,9 @@ void voodoo_device::swap_buffers(voodoo_device *vd)
 	vd->stats.total_afunc_fail = 0;
 	vd->stats.total_clipped = 0;
 	vd->stats.total_stippled = 0;
+	vd->stats.raster_pixels = 0;
+	vd->stats.generic_pixels = 0;
+	vd->stats.generic_triangles = 0;
 	vd->stats.reg_writes = 0;
 	vd->stats.reg_reads = 0;
 	vd->stats.lfb_writes = 0;
@@ -5081,6 +5088,12 @@ void voodoo_device::device_start()
 	poly = poly_alloc(machine(), 64, sizeof(poly_extra_data), 0);
 	thread_stats = auto_alloc_array(machine(), stats_block, WORK_MAX_THREADS);
 
+	/* name the shared rasterizers in captures; the raster key tells the rest apart */
+	poly_capture_name(poly, raster_fastfill, "raster_fastfill");
+	poly_capture_name(poly, raster_generic_0tmu, "raster_generic_0tmu");
+	poly_capture_name(poly, raster_generic_1tmu, "raster_generic_1tmu");
+	poly_capture_name(poly, raster_generic_2tmu, "raster_generic_2tmu");
+
 	/* create a table of precomputed 1/n and log2(n) values */
 	/* n ranges from 1.0000 to 2.0000 */
 	for (val = 0; val <= (1 << RECIPLOG_LOOKUP_BITS); val++)
@@ -5730,9 +5743,23 @@ int32_t voodoo_device::triangle_create_work_item(voodoo_device* vd, uint16_t *dr
 		}
 	}
 
+	/* captures record the register values the rasterizer was chosen for */
+	const uint32_t key[7] = { info->eff_color_path, info->eff_alpha_mode, info->eff_fog_mode, info->eff_fbz_mode, info->eff_tex_mode_0, info->eff_tex_mode_1, uint32_t(texcount) };
+	poly_capture_data(vd->poly, CAPTURE_RASTER, key, sizeof(key));
+
 	/* farm the rasterization out to other threads */
+	int32_t pixels = poly_render_triangle(vd->poly, drawbuf, global_cliprect, info->callback, 0, &vert[0], &vert[1], &vert[2]);
+
+	/* track how much work falls through to the generic rasterizers */
 	info->polys++;
-	return poly_render_triangle(vd->poly, drawbuf, global_cliprect, info->callback, 0, &vert[0], &vert[1], &vert[2]);
+	info->hits += pixels;
+	vd->stats.raster_pixels += pixels;
+	if (info->is_generic)
+	{
+		vd->stats.generic_pixels += pixels;
+		vd->stats.generic_triangles++;
+	}
+	return pixels;
 }
 
 
@@ -5832,18 +5859,37 @@ voodoo_device::raster_info *voodoo_device::find_rasterizer(voodoo_device *vd, in
 }
 
 
+/*-------------------------------------------------
+    count_generic_rasterizers - count the register
+    combinations that fell back to the generic
+    rasterizers
+-------------------------------------------------*/
+
+int voodoo_device::count_generic_rasterizers(voodoo_device *vd)
+{
+	int count = 0;
+	for (int index = 0; index < vd->next_rasterizer; index++)
+		if (vd->rasterizer[index].is_generic)
+			count++;
+	return count;
+}
+
+
 /*-------------------------------------------------
     dump_rasterizer_stats - dump statistics on
-    the current rasterizer usage patterns
+    the current rasterizer usage patterns; with
+    generic_only set, the lines are in the same
+    form as voodoo_rast.hxx and can be pasted
+    straight into it
 -------------------------------------------------*/
 
-void voodoo_device::dump_rasterizer_stats(voodoo_device *vd)
+std::string voodoo_device::dump_rasterizer_stats(voodoo_device *vd, bool generic_only)
 {
 	static uint8_t display_index;
 	raster_info *cur, *best;
+	std::string result;
 	int hash;
 
-	printf("----\n");
 	display_index++;
 
 	/* loop until we've displayed everything */
@@ -5854,7 +5900,7 @@ void voodoo_device::dump_rasterizer_stats(voodoo_device *vd)
 		/* find the highest entry */
 		for (hash = 0; hash < RASTER_HASH_SIZE; hash++)
 			for (cur = vd->raster_hash[hash]; cur; cur = cur->next)
-				if (cur->display != display_index && (best == nullptr || cur->hits > best->hits))
+				if (cur->display != display_index && (!generic_only || cur->is_generic) && (best == nullptr || cur->hits > best->hits))
 					best = cur;
 
 		/* if we're done, we're done */
@@ -5862,21 +5908,22 @@ void voodoo_device::dump_rasterizer_stats(voodoo_device *vd)
 			break;
 
 		/* print it */
-		printf("RASTERIZER_ENTRY( 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) /* %c %2d %8d %10d */\n",
+		result += util::string_format("RASTERIZER_ENTRY( 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) ",
 			best->eff_color_path,
 			best->eff_alpha_mode,
 			best->eff_fog_mode,
 			best->eff_fbz_mode,
 			best->eff_tex_mode_0,
-			best->eff_tex_mode_1,
-			best->is_generic ? '*' : ' ',
-			best->hash,
-			best->polys,
-			best->hits);
+			best->eff_tex_mode_1);
+		if (generic_only)
+			result += util::string_format("/* %10d %10d */\n", best->polys, best->hits);
+		else
+			result += util::string_format("/* %c %2d %8d %10d */\n", best->is_generic ? '*' : ' ', best->hash, best->polys, best->hits);
 
 		/* reset */
 		best->display = display_index;
 	}
+	return result;
 }
 
 voodoo_device::voodoo_device(const machine_config &mconfig, device_type type, const char *tag, device_t *owner, uint32_t clock, uint8_t vdt)
@@ -5914,6 +5961,11 @@ void voodoo_device::device_reset()
 
 void voodoo_device::device_stop()
 {
+	/* log the combinations that missed the compiled rasterizers */
+	std::string generic = dump_rasterizer_stats(this, true);
+	if (!generic.empty())
+		logerror("Generic rasterizers used (add to voodoo_rast.hxx):\n%s", generic);
+
 	/* release the work queue, ensuring all work is finished */
 	if (poly != nullptr)
 		poly_free(poly);
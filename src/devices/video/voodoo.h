@@ -1498,6 +1498,9 @@ protected:
 		int32_t             total_afunc_fail;       // total a func fail
 		int32_t             total_clipped;          // total clipped
 		int32_t             total_stippled;         // total stippled
+		int32_t             raster_pixels;          // pixels handed to the rasterizers
+		int32_t             generic_pixels;         // pixels handed to the generic rasterizers
+		int32_t             generic_triangles;      // triangles handed to the generic rasterizers
 		int32_t             lfb_writes;             // LFB writes
 		int32_t             lfb_reads;              // LFB reads
 		int32_t             reg_writes;             // register writes
@@ -1742,7 +1745,7 @@ protected:
 		poly_draw_scanline_func callback;           // callback pointer
 		bool                is_generic;             // true if this is one of the generic rasterizers
 		uint8_t             display;                // display index
-		uint32_t            hits;                   // how many hits (pixels) we've used this for
+		uint64_t            hits;                   // how many hits (pixels) we've used this for
 		uint32_t            polys;                  // how many polys we've used this for
 		uint32_t            eff_color_path;         // effective fbzColorPath value
 		uint32_t            eff_alpha_mode;         // effective alphaMode value
@@ -1756,6 +1759,13 @@ protected:
 
 	struct poly_extra_data;
 
+	// tags of the driver data in polygon stream captures
+	enum : uint32_t
+	{
+		CAPTURE_RASTER,             // effective fbzColorPath, alphaMode, fogMode, fbzMode, textureMode 0 and 1, and TMU count
+		CAPTURE_SWAP                // swap_buffers
+	};
+
 
 	struct banshee_info
 	{
@@ -1812,7 +1822,8 @@ protected:
 	static int32_t triangle_create_work_item(voodoo_device* vd,uint16_t *drawbuf, int texcount);
 	static raster_info *add_rasterizer(voodoo_device *vd, const raster_info *cinfo);
 	static raster_info *find_rasterizer(voodoo_device *vd, int texcount);
-	static void dump_rasterizer_stats(voodoo_device *vd);
+	static int count_generic_rasterizers(voodoo_device *vd);
+	static std::string dump_rasterizer_stats(voodoo_device *vd, bool generic_only);
 
 	void accumulate_statistics(const stats_block &block);
 	void update_statistics(bool accumulate);
@@ -2,6 +2,11 @@
 // copyright-holders:Aaron Giles
 /***************************************************************************
     GAME-SPECIFIC RASTERIZERS
+
+    Register combinations missing from this table are drawn by the slower
+    generic rasterizers.  They are logged at exit (run with -log) in this
+    format, with the poly and pixel counts, most pixels first; the busiest
+    are worth adding under the game's heading.
 ***************************************************************************/
 
 /* blitz ------> fbzColorPath alphaMode   fogMode,    fbzMode,    texMode0,   texMode1  */
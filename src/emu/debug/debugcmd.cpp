@@ -20,6 +20,8 @@
 #include "debugvw.h"
 #include "natkeyboard.h"
 #include "render.h"
+#include "divtlb.h"
+#include <algorithm>
 #include <ctype.h>
 #include <fstream>
 
@@ -279,6 +281,12 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 	m_console.register_command("mapi",      CMDFLAG_NONE, AS_IO, 1, 1, std::bind(&debugger_commands::execute_map, this, _1, _2));
 	m_console.register_command("mapo",      CMDFLAG_NONE, AS_OPCODES, 1, 1, std::bind(&debugger_commands::execute_map, this, _1, _2));
 	m_console.register_command("memdump",   CMDFLAG_NONE, 0, 0, 1, std::bind(&debugger_commands::execute_memdump, this, _1, _2));
+	m_console.register_command("memprofile", CMDFLAG_NONE, AS_PROGRAM, 1, 3, std::bind(&debugger_commands::execute_memprofile, this, _1, _2));
+	m_console.register_command("memprofiled", CMDFLAG_NONE, AS_DATA, 1, 3, std::bind(&debugger_commands::execute_memprofile, this, _1, _2));
+	m_console.register_command("memprofilei", CMDFLAG_NONE, AS_IO, 1, 3, std::bind(&debugger_commands::execute_memprofile, this, _1, _2));
+	m_console.register_command("memprofileo", CMDFLAG_NONE, AS_OPCODES, 1, 3, std::bind(&debugger_commands::execute_memprofile, this, _1, _2));
+
+	m_console.register_command("tlbstats",  CMDFLAG_NONE, 0, 0, 1, std::bind(&debugger_commands::execute_tlbstats, this, _1, _2));
 
 	m_console.register_command("symlist",   CMDFLAG_NONE, 0, 0, 1, std::bind(&debugger_commands::execute_symlist, this, _1, _2));
 
@@ -3211,6 +3219,106 @@ void debugger_commands::execute_memdump(int ref, const std::vector<std::string>
 }
 
 
+/*-------------------------------------------------
+    execute_memprofile - execute the memprofile
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_memprofile(int ref, const std::vector<std::string> &params)
+{
+	address_space *space;
+	u64 count = 20;
+
+	/* validate parameters */
+	if (!validate_cpu_space_parameter((params.size() > 1 && !params[1].empty()) ? params[1].c_str() : nullptr, ref, space))
+		return;
+	if (params.size() > 2 && !validate_number_parameter(params[2], count))
+		return;
+
+	if (params[0] == "on")
+	{
+		space->profile_start();
+		m_console.printf("Profiling accesses to %s space of %s\n", space->name(), space->device().tag());
+	}
+	else if (params[0] == "off")
+	{
+		space->profile_stop();
+		m_console.printf("Stopped profiling accesses to %s space of %s\n", space->name(), space->device().tag());
+	}
+	else if (params[0] == "clear")
+	{
+		space->profile_reset();
+		m_console.printf("Cleared access profile for %s space of %s\n", space->name(), space->device().tag());
+	}
+	else if (params[0] == "list")
+	{
+		/* gather the handlers that saw any accesses, most expensive first */
+		std::vector<const memory_access_profile *> entries;
+		for (const auto &entry : space->profile())
+			if (entry->m_count != 0)
+				entries.push_back(entry.get());
+		std::sort(entries.begin(), entries.end(), [] (const memory_access_profile *a, const memory_access_profile *b) { return a->m_ticks > b->m_ticks; });
+
+		if (entries.empty())
+		{
+			m_console.printf("No accesses recorded for %s space of %s\n", space->name(), space->device().tag());
+			return;
+		}
+
+		const double usec = 1000000.0 / double(osd_ticks_per_second());
+		const int nc = space->addrchars();
+		m_console.printf("   %-*s  %12s %12s %8s  %s\n", 2 * nc + 1, "Range", "Accesses", "Time (us)", "ns/acc", "Handler");
+		for (const memory_access_profile *entry : entries)
+		{
+			if (count-- == 0)
+				break;
+			m_console.printf("%c  %0*X-%0*X  %12u %12.1f %8.1f  %s\n",
+					(entry->m_type == read_or_write::WRITE) ? 'W' : 'R',
+					nc, entry->m_start, nc, entry->m_end,
+					entry->m_count,
+					double(entry->m_ticks) * usec,
+					double(entry->m_ticks) * usec * 1000.0 / double(entry->m_count),
+					entry->m_name);
+		}
+	}
+	else
+		m_console.printf("Invalid memprofile action '%s', expected on, off, clear or list\n", params[0]);
+}
+
+
+/*-------------------------------------------------
+    execute_tlbstats - execute the tlbstats
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_tlbstats(int ref, const std::vector<std::string> &params)
+{
+	device_t *cpu;
+
+	/* validate parameters */
+	if (!validate_cpu_parameter(!params.empty() ? params[0].c_str() : nullptr, cpu))
+		return;
+
+	device_vtlb_interface *vtlb;
+	if (!cpu->interface(vtlb))
+	{
+		m_console.printf("%s does not have a virtual TLB\n", cpu->tag());
+		return;
+	}
+
+	const vtlb_stats &stats = vtlb->vtlb_statistics();
+	m_console.printf("Virtual TLB statistics for %s:\n", cpu->tag());
+	m_console.printf("  Misses:        %12u\n", stats.misses);
+	m_console.printf("  Cache hits:    %12u", stats.cache_hits);
+	if (stats.misses != 0)
+		m_console.printf(" (%.1f%%)", 100.0 * double(stats.cache_hits) / double(stats.misses));
+	m_console.printf("\n");
+	m_console.printf("  Translations:  %12u\n", stats.translations);
+	m_console.printf("  Flushes:       %12u\n", stats.flushes);
+	m_console.printf("  Cache entries: %12u\n", vtlb->vtlb_cache_size());
+}
+
+
 /*-------------------------------------------------
     execute_symlist - execute the symlist command
 -------------------------------------------------*/
@@ -156,6 +156,8 @@ private:
 	void execute_source(int ref, const std::vector<std::string> &params);
 	void execute_map(int ref, const std::vector<std::string> &params);
 	void execute_memdump(int ref, const std::vector<std::string> &params);
+	void execute_memprofile(int ref, const std::vector<std::string> &params);
+	void execute_tlbstats(int ref, const std::vector<std::string> &params);
 	void execute_symlist(int ref, const std::vector<std::string> &params);
 	void execute_softreset(int ref, const std::vector<std::string> &params);
 	void execute_hardreset(int ref, const std::vector<std::string> &params);
@@ -125,6 +125,8 @@ static const help_item static_help_list[] =
 		"  mapd <address> -- map logical data address to physical address and bank\n"
 		"  mapi <address> -- map logical I/O address to physical address and bank\n"
 		"  memdump [<filename>] -- dump the current memory map to <filename>\n"
+		"  memprofile[{d|i|o}] on|off|clear|list[,<cpu>[,<count>]] -- count accesses to each memory handler\n"
+		"  tlbstats [<cpu>] -- show virtual TLB miss statistics\n"
 	},
 	{
 		"execution",
@@ -1281,6 +1283,51 @@ static const help_item static_help_list[] =
 		"memdump\n"
 		"  Dumps memory to memdump.log.\n"
 	},
+	{
+		"memprofile",
+		"\n"
+		"  memprofile[{d|i|o}] on|off|clear|list[,<cpu>[,<count>]]\n"
+		"\n"
+		"The memprofile commands count the accesses made to each handler in an address space, along "
+		"with the range of addresses accessed and the host time spent in the handler. 'memprofile' "
+		"profiles program space memory, while 'memprofiled', 'memprofilei' and 'memprofileo' profile "
+		"data, I/O and opcode space memory respectively. 'on' starts profiling, 'off' stops it while "
+		"keeping the counts, 'clear' discards the counts, and 'list' shows the <count> most expensive "
+		"handlers (20 by default). The time for a handler includes any accesses it makes itself. "
+		"Accesses made through direct pointers, such as most CPU opcode fetches, bypass the handlers "
+		"and are not counted, and neither are handlers installed after profiling starts. If <cpu> is "
+		"omitted, the currently visible CPU is used.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"memprofile on\n"
+		"  Starts profiling program space accesses of the current CPU.\n"
+		"\n"
+		"memprofile list,,10\n"
+		"  Shows the ten program space handlers of the current CPU that took the most time.\n"
+		"\n"
+		"memprofilei off,1\n"
+		"  Stops profiling I/O space accesses of CPU #1.\n"
+	},
+	{
+		"tlbstats",
+		"\n"
+		"  tlbstats [<cpu>]\n"
+		"\n"
+		"The tlbstats command shows how often the virtual TLB of a CPU with an MMU missed since the "
+		"machine started. Misses are either reloaded from the second-level translation cache or "
+		"translated again by the CPU, usually by walking its page tables; 'Translations' counts the "
+		"latter, along with any entries the CPU loads itself. 'Flushes' counts how many times all "
+		"dynamic entries were discarded. If <cpu> is omitted, the currently visible CPU is used.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"tlbstats\n"
+		"  Shows the virtual TLB statistics of the current CPU.\n"
+		"\n"
+		"tlbstats 1\n"
+		"  Shows the virtual TLB statistics of CPU #1.\n"
+	},
 	{
 		"comlist",
 		"\n"
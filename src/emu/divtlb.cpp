@@ -21,6 +21,108 @@
 
 
 
+//**************************************************************************
+//  SECOND-LEVEL CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  allocate - size the cache to hold at least
+//  the given number of entries
+//-------------------------------------------------
+
+void vtlb_cache::allocate(int entries)
+{
+	// round up to a power-of-two number of sets
+	int setbits = 0;
+	while ((WAYS << setbits) < entries)
+		setbits++;
+	m_setshift = 32 - setbits;
+	m_entries.resize(WAYS << setbits);
+	std::fill(m_entries.begin(), m_entries.end(), entry{ 0, 0, 0 });
+	m_generation = 1;
+}
+
+
+//-------------------------------------------------
+//  find - look up a translation, making it the
+//  most recently used in its set on a hit
+//-------------------------------------------------
+
+bool vtlb_cache::find(u32 asid, offs_t page, vtlb_entry &value)
+{
+	if (!enabled())
+		return false;
+
+	entry *const ways = set(page);
+	u64 const key = (u64(asid) << 32) | page;
+	for (int way = 0; way < WAYS; way++)
+		if (ways[way].key == key && ways[way].generation == m_generation)
+		{
+			entry const found = ways[way];
+			std::copy_backward(ways, ways + way, ways + way + 1);
+			ways[0] = found;
+			value = found.value;
+			return true;
+		}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  insert - add or update a translation,
+//  replacing the least recently used one in its
+//  set if needed
+//-------------------------------------------------
+
+void vtlb_cache::insert(u32 asid, offs_t page, vtlb_entry value)
+{
+	if (!enabled())
+		return;
+
+	entry *const ways = set(page);
+	u64 const key = (u64(asid) << 32) | page;
+	int way;
+	for (way = 0; way < WAYS - 1; way++)
+		if (ways[way].key == key || ways[way].generation != m_generation)
+			break;
+	std::copy_backward(ways, ways + way, ways + way + 1);
+	ways[0] = entry{ key, m_generation, value };
+}
+
+
+//-------------------------------------------------
+//  flush - forget all translations
+//-------------------------------------------------
+
+void vtlb_cache::flush()
+{
+	// entries from older generations are ignored, so only clear them when it wraps
+	if (++m_generation == 0)
+	{
+		std::fill(m_entries.begin(), m_entries.end(), entry{ 0, 0, 0 });
+		m_generation = 1;
+	}
+}
+
+
+//-------------------------------------------------
+//  flush_page - forget all translations of a
+//  page, whatever their ASID
+//-------------------------------------------------
+
+void vtlb_cache::flush_page(offs_t page)
+{
+	if (!enabled())
+		return;
+
+	entry *const ways = set(page);
+	for (int way = 0; way < WAYS; way++)
+		if (u32(ways[way].key) == page)
+			ways[way].generation = 0;
+}
+
+
+
 //**************************************************************************
 //  DEVICE VTLB INTERFACE
 //**************************************************************************
@@ -37,7 +139,8 @@ device_vtlb_interface::device_vtlb_interface(const machine_config &mconfig, devi
 		m_dynindex(0),
 		m_pageshift(0),
 		m_addrwidth(0),
-		m_table_base(nullptr)
+		m_table_base(nullptr),
+		m_cache_entries(0)
 {
 }
 
@@ -98,6 +201,10 @@ void device_vtlb_interface::interface_pre_start()
 	// pointer to first element for quick access
 	m_table_base = &m_table[0];
 
+	// allocate the second-level cache, which only holds dynamic entries
+	if (m_dynamic > 0 && m_cache_entries > 0)
+		m_cache.allocate(m_cache_entries);
+
 	// allocate the fixed page count array
 	if (m_fixed > 0)
 	{
@@ -133,19 +240,34 @@ void device_vtlb_interface::interface_pre_reset()
 }
 
 
+//-------------------------------------------------
+//  interface_post_load - the second-level cache
+//  isn't saved, so forget it after loading
+//-------------------------------------------------
+
+void device_vtlb_interface::interface_post_load()
+{
+	m_cache.flush();
+}
+
+
 //**************************************************************************
 //  FILLING
 //**************************************************************************
 
 //-------------------------------------------------
 //  vtlb_fill - called by the CPU core in
-//  response to an unmapped access
+//  response to an unmapped access; translations
+//  are cached under the given ASID
 //-------------------------------------------------
 
-bool device_vtlb_interface::vtlb_fill(offs_t address, int intention)
+bool device_vtlb_interface::vtlb_fill(offs_t address, int intention, u32 asid)
 {
 	offs_t tableindex = address >> m_pageshift;
 	vtlb_entry entry = m_table[tableindex];
+	vtlb_entry const intentbit = 1 << (intention & (TRANSLATE_TYPE_MASK | TRANSLATE_USER_MASK));
+	bool const fixed = (entry & VTLB_FLAG_FIXED) != 0;
+	vtlb_entry found;
 	offs_t taddress;
 
 #if PRINTF_TLB
@@ -163,15 +285,27 @@ bool device_vtlb_interface::vtlb_fill(offs_t address, int intention)
 #endif
 		return false;
 	}
+	m_stats.misses++;
 
-	// ask the CPU core to translate for us
-	taddress = address;
-	if (!device().memory().translate(m_space, intention, taddress))
+	// a translation evicted from the table may still be cached; fixed entries are the CPU's business
+	if (!fixed && m_cache.find(asid, tableindex, found) && (found & intentbit))
 	{
+		m_stats.cache_hits++;
+		taddress = found & ~((1 << m_pageshift) - 1);
+	}
+	else
+	{
+		// ask the CPU core to translate for us
+		m_stats.translations++;
+		taddress = address;
+		if (!device().memory().translate(m_space, intention, taddress))
+		{
 #if PRINTF_TLB
-		osd_printf_debug("failed: no translation\n");
+			osd_printf_debug("failed: no translation\n");
 #endif
-		return false;
+			return false;
+		}
+		found = ((taddress >> m_pageshift) << m_pageshift) | VTLB_FLAG_VALID | intentbit;
 	}
 
 	// if this is the first successful translation for this address, allocate a new entry
@@ -193,9 +327,8 @@ bool device_vtlb_interface::vtlb_fill(offs_t address, int intention)
 		// claim this new entry
 		m_live[liveindex] = tableindex + 1;
 
-		// form a new blank entry
-		entry = (taddress >> m_pageshift) << m_pageshift;
-		entry |= VTLB_FLAG_VALID;
+		// start from a blank entry, or the cached intentions
+		entry = found;
 
 #if PRINTF_TLB
 		osd_printf_debug("success (%08X), new entry\n", taddress);
@@ -208,14 +341,18 @@ bool device_vtlb_interface::vtlb_fill(offs_t address, int intention)
 		assert((entry >> m_pageshift) == (taddress >> m_pageshift));
 		assert(entry & VTLB_FLAG_VALID);
 
+		// add the intention to the list of valid intentions
+		entry |= found & VTLB_FLAGS_MASK;
+
 #if PRINTF_TLB
 		osd_printf_debug("success (%08X), existing entry\n", taddress);
 #endif
 	}
 
-	// add the intention to the list of valid intentions and store
-	entry |= 1 << (intention & (TRANSLATE_TYPE_MASK | TRANSLATE_USER_MASK));
+	// store, and remember dynamic translations in case they are evicted
 	m_table[tableindex] = entry;
+	if (!fixed)
+		m_cache.insert(asid, tableindex, entry);
 	return true;
 }
 
@@ -258,17 +395,19 @@ void device_vtlb_interface::vtlb_load(int entrynum, int numpages, offs_t address
 	value |= VTLB_FLAG_FIXED;
 	m_fixedpages[entrynum] = numpages;
 	for (pagenum = 0; pagenum < numpages; pagenum++)
+	{
 		m_table[tableindex + pagenum] = value + (pagenum << m_pageshift);
+		m_cache.flush_page(tableindex + pagenum);
+	}
 }
 
 //-------------------------------------------------
-//  vtlb_dynload - load a dynamic VTLB entry
+//  vtlb_dynload - load a dynamic VTLB entry the
+//  CPU core translated itself
 //-------------------------------------------------
 
-void device_vtlb_interface::vtlb_dynload(u32 index, offs_t address, vtlb_entry value)
+void device_vtlb_interface::vtlb_dynload(u32 index, offs_t address, vtlb_entry value, u32 asid)
 {
-	vtlb_entry entry = m_table[index];
-
 	if (m_dynamic == 0)
 	{
 #if PRINTF_TLB
@@ -276,10 +415,53 @@ void device_vtlb_interface::vtlb_dynload(u32 index, offs_t address, vtlb_entry v
 #endif
 		return;
 	}
+	m_stats.translations++;
+
+	// form a new blank entry
+	vtlb_entry entry = (address >> m_pageshift) << m_pageshift;
+	entry |= VTLB_FLAG_VALID | value;
+
+#if PRINTF_TLB
+	osd_printf_debug("success (%08X), new entry\n", address);
+#endif
+	dynamic_store(index, entry);
+	m_cache.insert(asid, index, entry);
+}
+
+
+//-------------------------------------------------
+//  vtlb_dynreload - reload a dynamic VTLB entry
+//  from the second-level cache, returning false
+//  if the CPU core needs to translate it
+//-------------------------------------------------
+
+bool device_vtlb_interface::vtlb_dynreload(u32 index, u32 asid)
+{
+	if (m_dynamic == 0)
+		return false;
+	m_stats.misses++;
+
+	vtlb_entry entry;
+	if (!m_cache.find(asid, index, entry))
+		return false;
+
+	m_stats.cache_hits++;
+	dynamic_store(index, entry);
+	return true;
+}
 
+
+//-------------------------------------------------
+//  dynamic_store - store a dynamic entry,
+//  claiming a live slot for it if needed
+//-------------------------------------------------
+
+void device_vtlb_interface::dynamic_store(u32 index, vtlb_entry entry)
+{
 	int liveindex = m_dynindex++ % m_dynamic;
+
 	// is entry already live?
-	if (!(entry & VTLB_FLAG_VALID))
+	if (!(m_table[index] & VTLB_FLAG_VALID))
 	{
 		// if an entry already exists at this index, free it
 		if (m_live[liveindex] != 0)
@@ -288,13 +470,6 @@ void device_vtlb_interface::vtlb_dynload(u32 index, offs_t address, vtlb_entry v
 		// claim this new entry
 		m_live[liveindex] = index + 1;
 	}
-	// form a new blank entry
-	entry = (address >> m_pageshift) << m_pageshift;
-	entry |= VTLB_FLAG_VALID | value;
-
-#if PRINTF_TLB
-	osd_printf_debug("success (%08X), new entry\n", address);
-#endif
 	m_table[index] = entry;
 }
 
@@ -313,6 +488,35 @@ void device_vtlb_interface::vtlb_flush_dynamic()
 	osd_printf_debug("vtlb_flush_dynamic\n");
 #endif
 
+	m_stats.flushes++;
+	dynamic_flush();
+	m_cache.flush();
+}
+
+
+//-------------------------------------------------
+//  vtlb_asid_changed - flush the dynamic part of
+//  the VTLB when addresses map to different ASIDs,
+//  keeping the translations cached for each ASID
+//-------------------------------------------------
+
+void device_vtlb_interface::vtlb_asid_changed()
+{
+#if PRINTF_TLB
+	osd_printf_debug("vtlb_asid_changed\n");
+#endif
+
+	dynamic_flush();
+}
+
+
+//-------------------------------------------------
+//  dynamic_flush - release the live dynamic
+//  entries from the table
+//-------------------------------------------------
+
+void device_vtlb_interface::dynamic_flush()
+{
 	// loop over live entries and release them from the table
 	for (int liveindex = 0; liveindex < m_dynamic; liveindex++)
 		if (m_live[liveindex] != 0)
@@ -339,6 +543,7 @@ void device_vtlb_interface::vtlb_flush_address(offs_t address)
 
 	// free the entry in the table; for speed, we leave the entry in the live array
 	m_table[tableindex] = 0;
+	m_cache.flush_page(tableindex);
 }
 
 
@@ -40,6 +40,58 @@ constexpr u32 VTLB_FLAG_FIXED           = 0x80;
 typedef u32 vtlb_entry;
 
 
+// ======================> vtlb_cache
+
+// set-associative second-level cache of dynamic translations, tagged with an
+// address space identifier and looked up before asking the CPU to translate
+class vtlb_cache
+{
+public:
+	static constexpr int WAYS = 4;
+
+	// construction
+	vtlb_cache() : m_setshift(32), m_generation(1) { }
+	void allocate(int entries);
+
+	// getters
+	bool enabled() const { return !m_entries.empty(); }
+	size_t size() const { return m_entries.size(); }
+
+	// lookup and replacement
+	bool find(u32 asid, offs_t page, vtlb_entry &value);
+	void insert(u32 asid, offs_t page, vtlb_entry value);
+
+	// flushing
+	void flush();
+	void flush_page(offs_t page);
+
+private:
+	struct entry
+	{
+		u64         key;            // ASID in the upper half, page in the lower
+		u32         generation;     // flush generation the entry belongs to
+		vtlb_entry  value;          // first-level entry to restore
+	};
+
+	// all ASIDs' translations of a page share a set, so a page can be flushed by scanning one
+	entry *set(offs_t page) { return &m_entries[(u64(u32(page * 0x9e3779b1U)) >> m_setshift) * WAYS]; }
+
+	std::vector<entry>  m_entries;      // sets of WAYS entries, most recently used first
+	int                 m_setshift;     // shift from the page hash to the set index
+	u32                 m_generation;   // current flush generation
+};
+
+
+// statistics on first-level misses
+struct vtlb_stats
+{
+	u64         misses = 0;         // lookups that missed the first level
+	u64         cache_hits = 0;     // misses satisfied by the second level
+	u64         translations = 0;   // misses the CPU had to translate
+	u64         flushes = 0;        // full flushes
+};
+
+
 // ======================> device_vtlb_interface
 
 class device_vtlb_interface : public device_interface
@@ -52,18 +104,24 @@ public:
 	// configuration helpers
 	void set_vtlb_dynamic_entries(int entries) { m_dynamic = entries; }
 	void set_vtlb_fixed_entries(int entries) { m_fixed = entries; }
+	void set_vtlb_cache_entries(int entries) { m_cache_entries = entries; }
 
 	// filling
-	bool vtlb_fill(offs_t address, int intention);
+	bool vtlb_fill(offs_t address, int intention, u32 asid = 0);
 	void vtlb_load(int entrynum, int numpages, offs_t address, vtlb_entry value);
-	void vtlb_dynload(u32 index, offs_t address, vtlb_entry value);
+	void vtlb_dynload(u32 index, offs_t address, vtlb_entry value, u32 asid = 0);
+	bool vtlb_dynreload(u32 index, u32 asid = 0);
 
 	// flushing
 	void vtlb_flush_dynamic();
 	void vtlb_flush_address(offs_t address);
+	void vtlb_asid_changed();
 
 	// accessors
 	const vtlb_entry *vtlb_table() const;
+	size_t vtlb_table_size() const { return m_table.size(); }
+	const vtlb_stats &vtlb_statistics() const { return m_stats; }
+	size_t vtlb_cache_size() const { return m_cache.size(); }
 
 protected:
 	// interface-level overrides
@@ -71,8 +129,13 @@ protected:
 	virtual void interface_pre_start() override;
 	virtual void interface_post_start() override;
 	virtual void interface_pre_reset() override;
+	virtual void interface_post_load() override;
 
 private:
+	// internal helpers
+	void dynamic_store(u32 index, vtlb_entry entry);
+	void dynamic_flush();
+
 	// private state
 	int    m_space;            // address space
 	int                 m_dynamic;          // number of dynamic entries
@@ -85,6 +148,9 @@ private:
 	std::vector<vtlb_entry> m_table;        // table of entries by address
 	std::vector<offs_t> m_refcnt;           // table of entry reference counts by address
 	vtlb_entry          *m_table_base;      // pointer to m_table[0]
+	int                 m_cache_entries;    // number of second-level entries
+	vtlb_cache          m_cache;            // second-level cache of dynamic entries
+	vtlb_stats          m_stats;            // miss statistics
 };
 
 
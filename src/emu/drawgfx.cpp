@@ -10,6 +10,18 @@
 #include "emu.h"
 #include "drawgfxm.h"
 
+// vectorise on 64-bit builds, where SSE2 can be assumed, and use the wider
+// AVX2 registers when the build targets them
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DRAWGFX_ROW_AVX2
+#else
+#include <emmintrin.h>
+#define DRAWGFX_ROW_SSE2
+#endif
+#endif
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -62,6 +74,293 @@ static inline s32 normalize_yscroll(const bitmap_t &bitmap, s32 yscroll)
 
 
 
+/***************************************************************************
+    ROW KERNELS
+***************************************************************************/
+
+namespace {
+
+/*-------------------------------------------------
+    row_pen - map a source pen to a destination
+    pixel, by rebasing for indexed bitmaps or
+    through the palette for RGB bitmaps
+-------------------------------------------------*/
+
+inline u16 row_pen(u32 color, u32 srcdata) { return color + srcdata; }
+inline u32 row_pen(const pen_t *paldata, u32 srcdata) { return paldata[srcdata]; }
+
+
+/*-------------------------------------------------
+    row_scalar - draw a row one pixel at a time,
+    exactly as the PIXEL_OP_* macros do
+-------------------------------------------------*/
+
+template <bool Mask, bool Priority, typename PixelType, typename ColorType>
+inline void row_scalar(PixelType *dest, u8 *pri, const u8 *src, u32 count, ColorType color, u32 pmask, u32 trans)
+{
+	for (u32 curx = 0; curx < count; curx++)
+	{
+		u32 srcdata = src[curx];
+		if (Mask ? (((trans >> (srcdata & 0x1f)) & 1) == 0) : (srcdata != trans))
+		{
+			if (!Priority)
+				dest[curx] = row_pen(color, srcdata);
+			else
+			{
+				if (((1U << (pri[curx] & 0x1f)) & pmask) == 0)
+					dest[curx] = row_pen(color, srcdata);
+				pri[curx] = 31;
+			}
+		}
+	}
+}
+
+
+#if defined(DRAWGFX_ROW_SSE2)
+
+/*-------------------------------------------------
+    row_test_bits - return 0xff in each byte whose
+    low 5 bits select a set bit in 'mask'
+-------------------------------------------------*/
+
+inline __m128i row_test_bits(__m128i value, u32 mask)
+{
+	// pick out the byte of the mask holding each bit
+	value = _mm_and_si128(value, _mm_set1_epi8(0x1f));
+	__m128i const byteindex = _mm_and_si128(_mm_srli_epi16(value, 3), _mm_set1_epi8(3));
+	__m128i bits = _mm_setzero_si128();
+	for (int index = 0; index < 4; index++)
+		bits = _mm_or_si128(bits, _mm_and_si128(_mm_cmpeq_epi8(byteindex, _mm_set1_epi8(index)), _mm_set1_epi8(s8(mask >> (index * 8)))));
+
+	// shift the wanted bit up to the sign bit by 4, 2 and 1 as needed
+	__m128i const shift = _mm_andnot_si128(value, _mm_set1_epi8(7));
+	for (int amount = 4; amount != 0; amount >>= 1)
+	{
+		__m128i shifted = bits;
+		for (int step = 0; step < amount; step++)
+			shifted = _mm_add_epi8(shifted, shifted);
+		__m128i const select = _mm_cmpeq_epi8(_mm_and_si128(shift, _mm_set1_epi8(amount)), _mm_set1_epi8(amount));
+		bits = _mm_or_si128(_mm_and_si128(select, shifted), _mm_andnot_si128(select, bits));
+	}
+	return _mm_cmplt_epi8(bits, _mm_setzero_si128());
+}
+
+
+/*-------------------------------------------------
+    row_store - write the 16 pixels selected by
+    'write' from the 16 pens in 'srcdata'
+-------------------------------------------------*/
+
+inline void row_store(u16 *dest, const u8 *src, __m128i srcdata, __m128i write, u32 color)
+{
+	__m128i const zero = _mm_setzero_si128();
+	__m128i const base = _mm_set1_epi16(s16(color));
+	__m128i const lo = _mm_add_epi16(_mm_unpacklo_epi8(srcdata, zero), base);
+	__m128i const hi = _mm_add_epi16(_mm_unpackhi_epi8(srcdata, zero), base);
+	__m128i const writelo = _mm_unpacklo_epi8(write, write);
+	__m128i const writehi = _mm_unpackhi_epi8(write, write);
+	__m128i *const dest128 = reinterpret_cast<__m128i *>(dest);
+	_mm_storeu_si128(dest128 + 0, _mm_or_si128(_mm_and_si128(writelo, lo), _mm_andnot_si128(writelo, _mm_loadu_si128(dest128 + 0))));
+	_mm_storeu_si128(dest128 + 1, _mm_or_si128(_mm_and_si128(writehi, hi), _mm_andnot_si128(writehi, _mm_loadu_si128(dest128 + 1))));
+}
+
+inline void row_store(u32 *dest, const u8 *src, __m128i srcdata, __m128i write, const pen_t *paldata)
+{
+	// no gather in SSE2, so look the pens up one by one but blend in vectors
+	if (_mm_movemask_epi8(write) == 0)
+		return;
+	__m128i const writelo = _mm_unpacklo_epi8(write, write);
+	__m128i const writehi = _mm_unpackhi_epi8(write, write);
+	__m128i const writes[4] = { _mm_unpacklo_epi16(writelo, writelo), _mm_unpackhi_epi16(writelo, writelo), _mm_unpacklo_epi16(writehi, writehi), _mm_unpackhi_epi16(writehi, writehi) };
+	__m128i *const dest128 = reinterpret_cast<__m128i *>(dest);
+	for (int quarter = 0; quarter < 4; quarter++)
+	{
+		const u8 *const pens = src + quarter * 4;
+		__m128i const pixels = _mm_setr_epi32(paldata[pens[0]], paldata[pens[1]], paldata[pens[2]], paldata[pens[3]]);
+		_mm_storeu_si128(dest128 + quarter, _mm_or_si128(_mm_and_si128(writes[quarter], pixels), _mm_andnot_si128(writes[quarter], _mm_loadu_si128(dest128 + quarter))));
+	}
+}
+
+
+/*-------------------------------------------------
+    draw_row - draw a row 16 pixels at a time
+-------------------------------------------------*/
+
+template <bool Mask, bool Priority, typename PixelType, typename ColorType>
+void draw_row(PixelType *dest, u8 *pri, const u8 *src, u32 count, ColorType color, u32 pmask, u32 trans)
+{
+	__m128i const transpen = _mm_set1_epi8(s8(trans));
+	__m128i const ones = _mm_set1_epi8(-1);
+	u32 curx;
+	for (curx = 0; curx + 16 <= count; curx += 16)
+	{
+		__m128i const srcdata = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + curx));
+		__m128i const opaque = _mm_xor_si128(Mask ? row_test_bits(srcdata, trans) : _mm_cmpeq_epi8(srcdata, transpen), ones);
+		__m128i write = opaque;
+		if (Priority)
+		{
+			// hidden where the priority bit is set; opaque pixels claim the priority either way
+			__m128i *const pri128 = reinterpret_cast<__m128i *>(pri + curx);
+			__m128i const pridata = _mm_loadu_si128(pri128);
+			write = _mm_andnot_si128(row_test_bits(pridata, pmask), opaque);
+			_mm_storeu_si128(pri128, _mm_or_si128(_mm_and_si128(opaque, _mm_set1_epi8(31)), _mm_andnot_si128(opaque, pridata)));
+		}
+		row_store(dest + curx, src + curx, srcdata, write, color);
+	}
+	row_scalar<Mask, Priority>(dest + curx, Priority ? pri + curx : nullptr, src + curx, count - curx, color, pmask, trans);
+}
+
+#elif defined(DRAWGFX_ROW_AVX2)
+
+/*-------------------------------------------------
+    row_test_bits - return 0xff in each byte whose
+    low 5 bits select a set bit in 'mask'
+-------------------------------------------------*/
+
+inline __m256i row_test_bits(__m256i value, u32 mask)
+{
+	// widen to 32 bits a quarter at a time and use the variable shift
+	__m256i const mask256 = _mm256_set1_epi32(mask);
+	__m256i const low = _mm256_set1_epi32(0x1f);
+	__m256i result[4];
+	for (int quarter = 0; quarter < 4; quarter++)
+	{
+		__m128i const half = (quarter < 2) ? _mm256_castsi256_si128(value) : _mm256_extracti128_si256(value, 1);
+		__m256i const wide = _mm256_and_si256(_mm256_cvtepu8_epi32((quarter & 1) ? _mm_srli_si128(half, 8) : half), low);
+		result[quarter] = _mm256_slli_epi32(_mm256_srlv_epi32(mask256, wide), 31);
+	}
+
+	// pack the sign bits back down to bytes, undoing the lane interleave
+	__m256i const packed = _mm256_packs_epi16(_mm256_packs_epi32(result[0], result[1]), _mm256_packs_epi32(result[2], result[3]));
+	return _mm256_permutevar8x32_epi32(_mm256_cmpgt_epi8(_mm256_setzero_si256(), packed), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+
+/*-------------------------------------------------
+    row_store - write the 32 pixels selected by
+    'write' from the 32 pens in 'srcdata'
+-------------------------------------------------*/
+
+inline void row_store(u16 *dest, const u8 *src, __m256i srcdata, __m256i write, u32 color)
+{
+	__m256i const base = _mm256_set1_epi16(s16(color));
+	for (int half = 0; half < 2; half++)
+	{
+		__m128i const srchalf = half ? _mm256_extracti128_si256(srcdata, 1) : _mm256_castsi256_si128(srcdata);
+		__m128i const writehalf = half ? _mm256_extracti128_si256(write, 1) : _mm256_castsi256_si128(write);
+		__m256i *const dest256 = reinterpret_cast<__m256i *>(dest + half * 16);
+		__m256i const pixels = _mm256_add_epi16(_mm256_cvtepu8_epi16(srchalf), base);
+		_mm256_storeu_si256(dest256, _mm256_blendv_epi8(_mm256_loadu_si256(dest256), pixels, _mm256_cvtepi8_epi16(writehalf)));
+	}
+}
+
+inline void row_store(u32 *dest, const u8 *src, __m256i srcdata, __m256i write, const pen_t *paldata)
+{
+	for (int eighth = 0; eighth < 4; eighth++)
+	{
+		__m128i const writehalf = (eighth < 2) ? _mm256_castsi256_si128(write) : _mm256_extracti128_si256(write, 1);
+		__m256i const mask = _mm256_cvtepi8_epi32((eighth & 1) ? _mm_srli_si128(writehalf, 8) : writehalf);
+		if (_mm256_testz_si256(mask, mask))
+			continue;
+		__m256i const index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + eighth * 8)));
+		__m256i const pixels = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), reinterpret_cast<const int *>(paldata), index, mask, 4);
+		_mm256_maskstore_epi32(reinterpret_cast<int *>(dest + eighth * 8), mask, pixels);
+	}
+}
+
+
+/*-------------------------------------------------
+    draw_row - draw a row 32 pixels at a time
+-------------------------------------------------*/
+
+template <bool Mask, bool Priority, typename PixelType, typename ColorType>
+void draw_row(PixelType *dest, u8 *pri, const u8 *src, u32 count, ColorType color, u32 pmask, u32 trans)
+{
+	__m256i const transpen = _mm256_set1_epi8(s8(trans));
+	__m256i const ones = _mm256_set1_epi8(-1);
+	u32 curx;
+	for (curx = 0; curx + 32 <= count; curx += 32)
+	{
+		__m256i const srcdata = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + curx));
+		__m256i const opaque = _mm256_xor_si256(Mask ? row_test_bits(srcdata, trans) : _mm256_cmpeq_epi8(srcdata, transpen), ones);
+		__m256i write = opaque;
+		if (Priority)
+		{
+			// hidden where the priority bit is set; opaque pixels claim the priority either way
+			__m256i *const pri256 = reinterpret_cast<__m256i *>(pri + curx);
+			__m256i const pridata = _mm256_loadu_si256(pri256);
+			write = _mm256_andnot_si256(row_test_bits(pridata, pmask), opaque);
+			_mm256_storeu_si256(pri256, _mm256_blendv_epi8(pridata, _mm256_set1_epi8(31), opaque));
+		}
+		row_store(dest + curx, src + curx, srcdata, write, color);
+	}
+	row_scalar<Mask, Priority>(dest + curx, Priority ? pri + curx : nullptr, src + curx, count - curx, color, pmask, trans);
+}
+
+#else
+
+template <bool Mask, bool Priority, typename PixelType, typename ColorType>
+void draw_row(PixelType *dest, u8 *pri, const u8 *src, u32 count, ColorType color, u32 pmask, u32 trans)
+{
+	row_scalar<Mask, Priority>(dest, pri, src, count, color, pmask, trans);
+}
+
+#endif
+
+} // anonymous namespace
+
+
+/*-------------------------------------------------
+    drawgfx_row_* - draw a row of 8bpp pixels;
+    the pen-based variants need a pen below 0x100
+-------------------------------------------------*/
+
+void drawgfx_row_transpen(u16 *dest, const u8 *src, u32 count, u32 color, u32 trans_pen)
+{
+	assert(trans_pen <= 0xff);
+	draw_row<false, false>(dest, nullptr, src, count, color, 0, trans_pen);
+}
+
+void drawgfx_row_transpen(u32 *dest, const u8 *src, u32 count, const pen_t *paldata, u32 trans_pen)
+{
+	assert(trans_pen <= 0xff);
+	draw_row<false, false>(dest, nullptr, src, count, paldata, 0, trans_pen);
+}
+
+void drawgfx_row_transmask(u16 *dest, const u8 *src, u32 count, u32 color, u32 trans_mask)
+{
+	draw_row<true, false>(dest, nullptr, src, count, color, 0, trans_mask);
+}
+
+void drawgfx_row_transmask(u32 *dest, const u8 *src, u32 count, const pen_t *paldata, u32 trans_mask)
+{
+	draw_row<true, false>(dest, nullptr, src, count, paldata, 0, trans_mask);
+}
+
+void drawgfx_row_transpen_priority(u16 *dest, u8 *pri, const u8 *src, u32 count, u32 color, u32 pmask, u32 trans_pen)
+{
+	assert(trans_pen <= 0xff);
+	draw_row<false, true>(dest, pri, src, count, color, pmask, trans_pen);
+}
+
+void drawgfx_row_transpen_priority(u32 *dest, u8 *pri, const u8 *src, u32 count, const pen_t *paldata, u32 pmask, u32 trans_pen)
+{
+	assert(trans_pen <= 0xff);
+	draw_row<false, true>(dest, pri, src, count, paldata, pmask, trans_pen);
+}
+
+void drawgfx_row_transmask_priority(u16 *dest, u8 *pri, const u8 *src, u32 count, u32 color, u32 pmask, u32 trans_mask)
+{
+	draw_row<true, true>(dest, pri, src, count, color, pmask, trans_mask);
+}
+
+void drawgfx_row_transmask_priority(u32 *dest, u8 *pri, const u8 *src, u32 count, const pen_t *paldata, u32 pmask, u32 trans_mask)
+{
+	draw_row<true, true>(dest, pri, src, count, paldata, pmask, trans_mask);
+}
+
+
+
 //**************************************************************************
 //  DEVICE DEFINITIONS
 //**************************************************************************
@@ -408,7 +707,7 @@ void gfx_element::transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_ROW_CORE(u16, ROW_OP_REBASE_TRANSPEN, NO_PRIORITY);
 }
 
 void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -436,7 +735,7 @@ void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_ROW_CORE(u32, ROW_OP_REMAP_TRANSPEN, NO_PRIORITY);
 }
 
 
@@ -506,7 +805,7 @@ void gfx_element::transmask(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u16, PIXEL_OP_REBASE_TRANSMASK, NO_PRIORITY);
+	DRAWGFX_ROW_CORE(u16, ROW_OP_REBASE_TRANSMASK, NO_PRIORITY);
 }
 
 void gfx_element::transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -534,7 +833,7 @@ void gfx_element::transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u32, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY);
+	DRAWGFX_ROW_CORE(u32, ROW_OP_REMAP_TRANSMASK, NO_PRIORITY);
 }
 
 
@@ -674,7 +973,7 @@ void gfx_element::zoom_transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(u16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	DRAWGFXZOOM_ROW_CORE(u16, ROW_OP_REBASE_TRANSPEN, NO_PRIORITY);
 }
 
 void gfx_element::zoom_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -706,7 +1005,7 @@ void gfx_element::zoom_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(u32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	DRAWGFXZOOM_ROW_CORE(u32, ROW_OP_REMAP_TRANSPEN, NO_PRIORITY);
 }
 
 
@@ -788,7 +1087,7 @@ void gfx_element::zoom_transmask(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(u16, PIXEL_OP_REBASE_TRANSMASK, NO_PRIORITY);
+	DRAWGFXZOOM_ROW_CORE(u16, ROW_OP_REBASE_TRANSMASK, NO_PRIORITY);
 }
 
 void gfx_element::zoom_transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -820,7 +1119,7 @@ void gfx_element::zoom_transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(u32, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY);
+	DRAWGFXZOOM_ROW_CORE(u32, ROW_OP_REMAP_TRANSMASK, NO_PRIORITY);
 }
 
 
@@ -968,7 +1267,7 @@ void gfx_element::prio_transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(u16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, u8);
+	DRAWGFX_ROW_CORE(u16, ROW_OP_REBASE_TRANSPEN_PRIORITY, u8);
 }
 
 void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -998,7 +1297,7 @@ void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(u32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, u8);
+	DRAWGFX_ROW_CORE(u32, ROW_OP_REMAP_TRANSPEN_PRIORITY, u8);
 }
 
 
@@ -1074,7 +1373,7 @@ void gfx_element::prio_transmask(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(u16, PIXEL_OP_REBASE_TRANSMASK_PRIORITY, u8);
+	DRAWGFX_ROW_CORE(u16, ROW_OP_REBASE_TRANSMASK_PRIORITY, u8);
 }
 
 void gfx_element::prio_transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1104,7 +1403,7 @@ void gfx_element::prio_transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(u32, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, u8);
+	DRAWGFX_ROW_CORE(u32, ROW_OP_REMAP_TRANSMASK_PRIORITY, u8);
 }
 
 
@@ -1261,7 +1560,7 @@ void gfx_element::prio_zoom_transpen(bitmap_ind16 &dest, const rectangle &clipre
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFXZOOM_CORE(u16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, u8);
+	DRAWGFXZOOM_ROW_CORE(u16, ROW_OP_REBASE_TRANSPEN_PRIORITY, u8);
 }
 
 void gfx_element::prio_zoom_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1296,7 +1595,7 @@ void gfx_element::prio_zoom_transpen(bitmap_rgb32 &dest, const rectangle &clipre
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFXZOOM_CORE(u32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, u8);
+	DRAWGFXZOOM_ROW_CORE(u32, ROW_OP_REMAP_TRANSPEN_PRIORITY, u8);
 }
 
 
@@ -1389,7 +1688,7 @@ void gfx_element::prio_zoom_transmask(bitmap_ind16 &dest, const rectangle &clipr
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFXZOOM_CORE(u16, PIXEL_OP_REBASE_TRANSMASK_PRIORITY, u8);
+	DRAWGFXZOOM_ROW_CORE(u16, ROW_OP_REBASE_TRANSMASK_PRIORITY, u8);
 }
 
 void gfx_element::prio_zoom_transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1424,7 +1723,7 @@ void gfx_element::prio_zoom_transmask(bitmap_rgb32 &dest, const rectangle &clipr
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFXZOOM_CORE(u32, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, u8);
+	DRAWGFXZOOM_ROW_CORE(u32, ROW_OP_REMAP_TRANSMASK_PRIORITY, u8);
 }
 
 
@@ -378,6 +378,47 @@ do
 while (0)
 
 
+/***************************************************************************
+    ROW OPERATIONS
+***************************************************************************/
+
+/*
+    The ROW_OP* macros are the row-at-a-time equivalents of the PIXEL_OP*
+    macros of the same name, for use with the DRAWGFX_ROW_CORE and
+    DRAWGFXZOOM_ROW_CORE macros below. SOURCE points to COUNT contiguous
+    8bpp source pixels in left-to-right order. The functions behind them
+    are vectorised where the host allows and produce exactly the same
+    pixels as the per-pixel versions; transparency masks only look at the
+    low 5 bits of the pen.
+*/
+
+void drawgfx_row_transpen(u16 *dest, const u8 *src, u32 count, u32 color, u32 trans_pen);
+void drawgfx_row_transpen(u32 *dest, const u8 *src, u32 count, const pen_t *paldata, u32 trans_pen);
+void drawgfx_row_transmask(u16 *dest, const u8 *src, u32 count, u32 color, u32 trans_mask);
+void drawgfx_row_transmask(u32 *dest, const u8 *src, u32 count, const pen_t *paldata, u32 trans_mask);
+void drawgfx_row_transpen_priority(u16 *dest, u8 *pri, const u8 *src, u32 count, u32 color, u32 pmask, u32 trans_pen);
+void drawgfx_row_transpen_priority(u32 *dest, u8 *pri, const u8 *src, u32 count, const pen_t *paldata, u32 pmask, u32 trans_pen);
+void drawgfx_row_transmask_priority(u16 *dest, u8 *pri, const u8 *src, u32 count, u32 color, u32 pmask, u32 trans_mask);
+void drawgfx_row_transmask_priority(u32 *dest, u8 *pri, const u8 *src, u32 count, const pen_t *paldata, u32 pmask, u32 trans_mask);
+
+#define ROW_OP_REMAP_TRANSPEN(DEST, PRIORITY, SOURCE, COUNT)                        \
+	drawgfx_row_transpen(DEST, SOURCE, COUNT, paldata, trans_pen)
+#define ROW_OP_REMAP_TRANSPEN_PRIORITY(DEST, PRIORITY, SOURCE, COUNT)               \
+	drawgfx_row_transpen_priority(DEST, PRIORITY, SOURCE, COUNT, paldata, pmask, trans_pen)
+#define ROW_OP_REBASE_TRANSPEN(DEST, PRIORITY, SOURCE, COUNT)                       \
+	drawgfx_row_transpen(DEST, SOURCE, COUNT, color, trans_pen)
+#define ROW_OP_REBASE_TRANSPEN_PRIORITY(DEST, PRIORITY, SOURCE, COUNT)              \
+	drawgfx_row_transpen_priority(DEST, PRIORITY, SOURCE, COUNT, color, pmask, trans_pen)
+#define ROW_OP_REMAP_TRANSMASK(DEST, PRIORITY, SOURCE, COUNT)                       \
+	drawgfx_row_transmask(DEST, SOURCE, COUNT, paldata, trans_mask)
+#define ROW_OP_REMAP_TRANSMASK_PRIORITY(DEST, PRIORITY, SOURCE, COUNT)              \
+	drawgfx_row_transmask_priority(DEST, PRIORITY, SOURCE, COUNT, paldata, pmask, trans_mask)
+#define ROW_OP_REBASE_TRANSMASK(DEST, PRIORITY, SOURCE, COUNT)                      \
+	drawgfx_row_transmask(DEST, SOURCE, COUNT, color, trans_mask)
+#define ROW_OP_REBASE_TRANSMASK_PRIORITY(DEST, PRIORITY, SOURCE, COUNT)             \
+	drawgfx_row_transmask_priority(DEST, PRIORITY, SOURCE, COUNT, color, pmask, trans_mask)
+
+
 /***************************************************************************
     BASIC DRAWGFX CORE
 ***************************************************************************/
@@ -697,6 +738,231 @@ do {
 
 
 
+/***************************************************************************
+    ROW DRAWGFX CORES
+***************************************************************************/
+
+/*
+    These take the same inputs as DRAWGFX_CORE and DRAWGFXZOOM_CORE but
+    hand whole rows to one of the ROW_OP* macros. Flipped and scaled rows
+    are gathered into a small buffer first so the row operation always
+    sees contiguous left-to-right source pixels.
+*/
+
+
+#define DRAWGFX_ROW_CORE(PIXEL_TYPE, ROW_OP, PRIORITY_TYPE)                         \
+do {                                                                                \
+	g_profiler.start(PROFILER_DRAWGFX);                                             \
+	do {                                                                            \
+		const u8 *srcdata;                                                          \
+		s32 destendx, destendy;                                                     \
+		s32 srcx, srcy;                                                             \
+		s32 cury;                                                                   \
+		s32 dy;                                                                     \
+																					\
+		assert(dest.valid());                                                       \
+		assert(!PRIORITY_VALID(PRIORITY_TYPE) || priority.valid());                 \
+		assert(dest.cliprect().contains(cliprect));                                 \
+		assert(code < elements());                                                  \
+																					\
+		/* ignore empty/invalid cliprects */                                        \
+		if (cliprect.empty())                                                       \
+			break;                                                                  \
+																					\
+		/* compute final pixel in X and exit if we are entirely clipped */          \
+		destendx = destx + width() - 1;                                             \
+		if (destx > cliprect.right() || destendx < cliprect.left())                 \
+			break;                                                                  \
+																					\
+		/* apply left clip */                                                       \
+		srcx = 0;                                                                   \
+		if (destx < cliprect.left())                                                \
+		{                                                                           \
+			srcx = cliprect.left() - destx;                                         \
+			destx = cliprect.left();                                                \
+		}                                                                           \
+																					\
+		/* apply right clip */                                                      \
+		if (destendx > cliprect.right())                                            \
+			destendx = cliprect.right();                                            \
+																					\
+		/* compute final pixel in Y and exit if we are entirely clipped */          \
+		destendy = desty + height() - 1;                                            \
+		if (desty > cliprect.bottom() || destendy < cliprect.top())                 \
+			break;                                                                  \
+																					\
+		/* apply top clip */                                                        \
+		srcy = 0;                                                                   \
+		if (desty < cliprect.top())                                                 \
+		{                                                                           \
+			srcy = cliprect.top() - desty;                                          \
+			desty = cliprect.top();                                                 \
+		}                                                                           \
+																					\
+		/* apply bottom clip */                                                     \
+		if (destendy > cliprect.bottom())                                           \
+			destendy = cliprect.bottom();                                           \
+																					\
+		/* apply X flipping */                                                      \
+		if (flipx)                                                                  \
+			srcx = width() - 1 - srcx;                                              \
+																					\
+		/* apply Y flipping */                                                      \
+		dy = rowbytes();                                                            \
+		if (flipy)                                                                  \
+		{                                                                           \
+			srcy = height() - 1 - srcy;                                             \
+			dy = -dy;                                                               \
+		}                                                                           \
+																					\
+		/* fetch the source data */                                                 \
+		srcdata = get_data(code);                                                   \
+																					\
+		/* adjust srcdata to point to the first source pixel of the row */          \
+		srcdata += srcy * rowbytes() + srcx;                                        \
+		u32 count = destendx + 1 - destx;                                           \
+																					\
+		/* iterate over pixels in Y */                                              \
+		for (cury = desty; cury <= destendy; cury++)                                \
+		{                                                                           \
+			PRIORITY_TYPE *priptr = PRIORITY_ADDR(priority, PRIORITY_TYPE, cury, destx); \
+			PIXEL_TYPE *destptr = &dest.pixt<PIXEL_TYPE>(cury, destx);              \
+			const u8 *srcptr = srcdata;                                             \
+			srcdata += dy;                                                          \
+																					\
+			/* non-flipped rows go straight through */                              \
+			if (!flipx)                                                             \
+				ROW_OP(destptr, priptr, srcptr, count);                             \
+																					\
+			/* flipped rows are reversed a chunk at a time */                       \
+			else                                                                    \
+			{                                                                       \
+				u8 rowbuf[256];                                                     \
+				for (u32 start = 0; start < count; start += ARRAY_LENGTH(rowbuf))   \
+				{                                                                   \
+					u32 chunk = std::min<u32>(count - start, ARRAY_LENGTH(rowbuf)); \
+					for (u32 curx = 0; curx < chunk; curx++)                        \
+						rowbuf[curx] = *srcptr--;                                   \
+					ROW_OP(destptr + start, priptr, rowbuf, chunk);                 \
+					PRIORITY_ADVANCE(PRIORITY_TYPE, priptr, chunk);                 \
+				}                                                                   \
+			}                                                                       \
+		}                                                                           \
+	} while (0);                                                                    \
+	g_profiler.stop();                                                              \
+} while (0)
+
+
+#define DRAWGFXZOOM_ROW_CORE(PIXEL_TYPE, ROW_OP, PRIORITY_TYPE)                     \
+do {                                                                                \
+	g_profiler.start(PROFILER_DRAWGFX);                                             \
+	do {                                                                            \
+		const u8 *srcdata;                                                          \
+		u32 dstwidth, dstheight;                                                    \
+		s32 destendx, destendy;                                                     \
+		s32 srcx, srcy;                                                             \
+		s32 cury;                                                                   \
+		s32 dx, dy;                                                                 \
+																					\
+		assert(dest.valid());                                                       \
+		assert(!PRIORITY_VALID(PRIORITY_TYPE) || priority.valid());                 \
+		assert(dest.cliprect().contains(cliprect));                                 \
+																					\
+		/* ignore empty/invalid cliprects */                                        \
+		if (cliprect.empty())                                                       \
+			break;                                                                  \
+																					\
+		/* compute scaled size */                                                   \
+		dstwidth = (scalex * width() + 0x8000) >> 16;                               \
+		dstheight = (scaley * height() + 0x8000) >> 16;                             \
+		if (dstwidth < 1 || dstheight < 1)                                          \
+			break;                                                                  \
+																					\
+		/* compute 16.16 source steps in dx and dy */                               \
+		dx = (width() << 16) / dstwidth;                                            \
+		dy = (height() << 16) / dstheight;                                          \
+																					\
+		/* compute final pixel in X and exit if we are entirely clipped */          \
+		destendx = destx + dstwidth - 1;                                            \
+		if (destx > cliprect.right() || destendx < cliprect.left())                 \
+			break;                                                                  \
+																					\
+		/* apply left clip */                                                       \
+		srcx = 0;                                                                   \
+		if (destx < cliprect.left())                                                \
+		{                                                                           \
+			srcx = (cliprect.left() - destx) * dx;                                  \
+			destx = cliprect.left();                                                \
+		}                                                                           \
+																					\
+		/* apply right clip */                                                      \
+		if (destendx > cliprect.right())                                            \
+			destendx = cliprect.right();                                            \
+																					\
+		/* compute final pixel in Y and exit if we are entirely clipped */          \
+		destendy = desty + dstheight - 1;                                           \
+		if (desty > cliprect.bottom() || destendy < cliprect.top())                 \
+			break;                                                                  \
+																					\
+		/* apply top clip */                                                        \
+		srcy = 0;                                                                   \
+		if (desty < cliprect.top())                                                 \
+		{                                                                           \
+			srcy = (cliprect.top() - desty) * dy;                                   \
+			desty = cliprect.top();                                                 \
+		}                                                                           \
+																					\
+		/* apply bottom clip */                                                     \
+		if (destendy > cliprect.bottom())                                           \
+			destendy = cliprect.bottom();                                           \
+																					\
+		/* apply X flipping */                                                      \
+		if (flipx)                                                                  \
+		{                                                                           \
+			srcx = (dstwidth - 1) * dx - srcx;                                      \
+			dx = -dx;                                                               \
+		}                                                                           \
+																					\
+		/* apply Y flipping */                                                      \
+		if (flipy)                                                                  \
+		{                                                                           \
+			srcy = (dstheight - 1) * dy - srcy;                                     \
+			dy = -dy;                                                               \
+		}                                                                           \
+																					\
+		/* fetch the source data */                                                 \
+		srcdata = get_data(code);                                                   \
+		u32 count = destendx + 1 - destx;                                           \
+																					\
+		/* iterate over pixels in Y */                                              \
+		for (cury = desty; cury <= destendy; cury++)                                \
+		{                                                                           \
+			PRIORITY_TYPE *priptr = PRIORITY_ADDR(priority, PRIORITY_TYPE, cury, destx); \
+			PIXEL_TYPE *destptr = &dest.pixt<PIXEL_TYPE>(cury, destx);              \
+			const u8 *srcptr = srcdata + (srcy >> 16) * rowbytes();                 \
+			s32 cursrcx = srcx;                                                     \
+			srcy += dy;                                                             \
+																					\
+			/* gather the scaled row a chunk at a time */                           \
+			u8 rowbuf[256];                                                         \
+			for (u32 start = 0; start < count; start += ARRAY_LENGTH(rowbuf))       \
+			{                                                                       \
+				u32 chunk = std::min<u32>(count - start, ARRAY_LENGTH(rowbuf));     \
+				for (u32 curx = 0; curx < chunk; curx++)                            \
+				{                                                                   \
+					rowbuf[curx] = srcptr[cursrcx >> 16];                           \
+					cursrcx += dx;                                                  \
+				}                                                                   \
+				ROW_OP(destptr + start, priptr, rowbuf, chunk);                     \
+				PRIORITY_ADVANCE(PRIORITY_TYPE, priptr, chunk);                     \
+			}                                                                       \
+		}                                                                           \
+	} while (0);                                                                    \
+	g_profiler.stop();                                                              \
+} while (0)
+
+
+
 /***************************************************************************
     BASIC COPYBITMAP CORE
 ***************************************************************************/
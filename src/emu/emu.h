@@ -98,6 +98,7 @@
 #include "video.h"
 
 // sound-related
+#include "resampler.h"
 #include "sound.h"
 
 // generic helpers
@@ -24,6 +24,7 @@
 #include "emumem_hedw.h"
 #include "emumem_hep.h"
 #include "emumem_het.h"
+#include "emumem_hepf.h"
 
 
 //**************************************************************************
@@ -331,6 +332,8 @@ public:
 	virtual memory_passthrough_handler *install_write_tap(offs_t addrstart, offs_t addrend, offs_t addrmirror, std::string name, std::function<void (offs_t offset, uX &data, uX mem_mask)> tap, memory_passthrough_handler *mph) override;
 	virtual memory_passthrough_handler *install_readwrite_tap(offs_t addrstart, offs_t addrend, offs_t addrmirror, std::string name, std::function<void (offs_t offset, uX &data, uX mem_mask)> tapr, std::function<void (offs_t offset, uX &data, uX mem_mask)> tapw, memory_passthrough_handler *mph) override;
 
+	virtual void install_profile(memory_passthrough_handler &mph) override;
+
 	// construction/destruction
 	address_space_specific(memory_manager &manager, device_memory_interface &memory, int spacenum, int address_width)
 		: address_space(manager, memory, spacenum)
@@ -515,6 +518,105 @@ public:
 	void write_qword_unaligned(offs_t address, u64 data) override { address &= m_addrmask; memory_write_generic<Width, AddrShift, Endian, 3, false>([this](offs_t offset, NativeType data, NativeType mask) { write_native(offset, data, mask); }, address, data, 0xffffffffffffffffU); }
 	void write_qword_unaligned(offs_t address, u64 data, u64 mask) override {address &= m_addrmask;  memory_write_generic<Width, AddrShift, Endian, 3, false>([this](offs_t offset, NativeType data, NativeType mask) { write_native(offset, data, mask); }, address, data, mask); }
 
+	// block access to these functions
+	void read_block(offs_t address, u8 *dest, offs_t count) override { read_block_generic<0>(address, dest, count); }
+	void read_block(offs_t address, u16 *dest, offs_t count) override { read_block_generic<1>(address, dest, count); }
+	void read_block(offs_t address, u32 *dest, offs_t count) override { read_block_generic<2>(address, dest, count); }
+	void read_block(offs_t address, u64 *dest, offs_t count) override { read_block_generic<3>(address, dest, count); }
+	void write_block(offs_t address, const u8 *src, offs_t count) override { write_block_generic<0>(address, src, count); }
+	void write_block(offs_t address, const u16 *src, offs_t count) override { write_block_generic<1>(address, src, count); }
+	void write_block(offs_t address, const u32 *src, offs_t count) override { write_block_generic<2>(address, src, count); }
+	void write_block(offs_t address, const u64 *src, offs_t count) override { write_block_generic<3>(address, src, count); }
+
+	// units of a block transfer that lie in memory are copied directly when
+	// the memory holds them the way the accesses would see them: in native
+	// units, or in the host's byte order with byte addressing
+	template<int AccessWidth> struct block_traits
+	{
+		static constexpr u32 UNIT_BYTES = 1 << AccessWidth;
+		static constexpr offs_t UNIT_STEP = AddrShift >= 0 ? UNIT_BYTES << iabs(AddrShift) : UNIT_BYTES >> iabs(AddrShift);
+		static constexpr u32 CHUNK_BYTES = std::max<u32>(UNIT_BYTES, NATIVE_BYTES);
+		static constexpr u32 CHUNK_UNITS = CHUNK_BYTES / UNIT_BYTES;
+		static constexpr offs_t CHUNK_STEP = AddrShift >= 0 ? CHUNK_BYTES << iabs(AddrShift) : CHUNK_BYTES >> iabs(AddrShift);
+		static constexpr bool DIRECT = AccessWidth == Width || (AddrShift == 0 && Endian == ENDIANNESS_NATIVE);
+	};
+
+	// find how many whole chunks starting at address lie in contiguous memory
+	// behind the handler, returning a pointer to them or nullptr if none do
+	template<int AccessWidth, typename H> static u8 *block_memory(H *root, offs_t address, offs_t count, offs_t &chunks)
+	{
+		using traits = block_traits<AccessWidth>;
+		if(!traits::DIRECT || count < traits::CHUNK_UNITS || (address & (traits::CHUNK_STEP - 1)) != 0)
+			return nullptr;
+
+		offs_t start, end;
+		H *handler;
+		root->lookup(address, start, end, handler);
+		u8 *const base = static_cast<u8 *>(handler->get_ptr(address));
+		if(!base)
+			return nullptr;
+
+		// a mirror inside the range wraps the memory around, which shows up at the last native unit
+		chunks = std::min<u64>((u64(end) - address + 1) / traits::CHUNK_STEP, count / traits::CHUNK_UNITS);
+		if(chunks == 0 || static_cast<u8 *>(handler->get_ptr(address + chunks * traits::CHUNK_STEP - NATIVE_STEP)) != base + chunks * traits::CHUNK_BYTES - NATIVE_BYTES)
+			return nullptr;
+		return base;
+	}
+
+	template<int AccessWidth> void read_block_generic(offs_t address, typename emu::detail::handler_entry_size<AccessWidth>::uX *dest, offs_t count)
+	{
+		using traits = block_traits<AccessWidth>;
+		using T = typename emu::detail::handler_entry_size<AccessWidth>::uX;
+		if(traits::UNIT_STEP == 0)
+			fatalerror("read_block: %d-bit units are smaller than an address in space %s\n", 8 << AccessWidth, m_name);
+
+		while(count != 0) {
+			address &= m_addrmask;
+			offs_t chunks = 0;
+			u8 *const base = block_memory<AccessWidth>(m_root_read, address, count, chunks);
+			if(base) {
+				memcpy(dest, base, chunks * traits::CHUNK_BYTES);
+				dest += chunks * traits::CHUNK_UNITS;
+				count -= chunks * traits::CHUNK_UNITS;
+				address += chunks * traits::CHUNK_STEP;
+			} else {
+				if(AccessWidth == Width)
+					*dest++ = read_native(address & ~NATIVE_MASK);
+				else
+					*dest++ = memory_read_generic<Width, AddrShift, Endian, AccessWidth, true>([this](offs_t offset, NativeType mask) -> NativeType { return read_native(offset, mask); }, address, T(0xffffffffffffffffU));
+				count--;
+				address += traits::UNIT_STEP;
+			}
+		}
+	}
+
+	template<int AccessWidth> void write_block_generic(offs_t address, const typename emu::detail::handler_entry_size<AccessWidth>::uX *src, offs_t count)
+	{
+		using traits = block_traits<AccessWidth>;
+		using T = typename emu::detail::handler_entry_size<AccessWidth>::uX;
+		if(traits::UNIT_STEP == 0)
+			fatalerror("write_block: %d-bit units are smaller than an address in space %s\n", 8 << AccessWidth, m_name);
+
+		while(count != 0) {
+			address &= m_addrmask;
+			offs_t chunks = 0;
+			u8 *const base = block_memory<AccessWidth>(m_root_write, address, count, chunks);
+			if(base) {
+				memcpy(base, src, chunks * traits::CHUNK_BYTES);
+				src += chunks * traits::CHUNK_UNITS;
+				count -= chunks * traits::CHUNK_UNITS;
+				address += chunks * traits::CHUNK_STEP;
+			} else {
+				if(AccessWidth == Width)
+					write_native(address & ~NATIVE_MASK, *src++);
+				else
+					memory_write_generic<Width, AddrShift, Endian, AccessWidth, true>([this](offs_t offset, NativeType data, NativeType mask) { write_native(offset, data, mask); }, address, *src++, T(0xffffffffffffffffU));
+				count--;
+				address += traits::UNIT_STEP;
+			}
+		}
+	}
+
 	// static access to these functions
 	static u8 read_byte_static(this_type &space, offs_t address) { address &= space.m_addrmask; return Width == 0 ? space.read_native(address & ~NATIVE_MASK) : memory_read_generic<Width, AddrShift, Endian, 0, true>([&space](offs_t offset, NativeType mask) -> NativeType { return space.read_native(offset, mask); }, address, 0xff); }
 	static u16 read_word_static(this_type &space, offs_t address) { address &= space.m_addrmask; return Width == 1 ? space.read_native(address & ~NATIVE_MASK) : memory_read_generic<Width, AddrShift, Endian, 1, true>([&space](offs_t offset, NativeType mask) -> NativeType { return space.read_native(offset, mask); }, address, 0xffff); }
@@ -1024,6 +1126,8 @@ address_space::address_space(memory_manager &manager, device_memory_interface &m
 		m_name(memory.space_config(spacenum)->name()),
 		m_addrchars((m_config.addr_width() + 3) / 4),
 		m_logaddrchars((m_config.logaddr_width() + 3) / 4),
+		m_profile_mph(nullptr),
+		m_profiling(false),
 		m_notifier_id(0),
 		m_in_notification(0),
 		m_manager(manager)
@@ -1864,6 +1968,25 @@ template<int Width, int AddrShift, endianness_t Endian> memory_passthrough_handl
 
 
 
+//-------------------------------------------------
+//  install_profile - wrap every handler in the
+//  space with a profiling passthrough
+//-------------------------------------------------
+
+template<int Width, int AddrShift, endianness_t Endian> void address_space_specific<Width, AddrShift, Endian>::install_profile(memory_passthrough_handler &mph)
+{
+	auto rhandler = new handler_entry_read_profile <Width, AddrShift, Endian>(this, mph, m_profile);
+	m_root_read ->populate_passthrough(0, m_addrmask, 0, rhandler);
+	rhandler->unref();
+
+	auto whandler = new handler_entry_write_profile<Width, AddrShift, Endian>(this, mph, m_profile);
+	m_root_write->populate_passthrough(0, m_addrmask, 0, whandler);
+	whandler->unref();
+
+	invalidate_caches(read_or_write::READWRITE);
+}
+
+
 
 
 //-------------------------------------------------
@@ -2571,6 +2694,56 @@ void address_space::remove_change_notifier(int id)
 }
 
 
+//-------------------------------------------------
+//  profile_start - start counting accesses to
+//  each handler in the space; handlers installed
+//  afterwards are not counted
+//-------------------------------------------------
+
+void address_space::profile_start()
+{
+	if(m_profiling)
+		return;
+
+	// the passthrough handler is kept across stop and start rather than leaking one each time
+	m_profile.clear();
+	if(!m_profile_mph) {
+		m_mphs.emplace_back(std::make_unique<memory_passthrough_handler>(*this));
+		m_profile_mph = m_mphs.back().get();
+	}
+	install_profile(*m_profile_mph);
+	m_profiling = true;
+}
+
+//-------------------------------------------------
+//  profile_stop - remove the profiling handlers,
+//  keeping the counts gathered so far
+//-------------------------------------------------
+
+void address_space::profile_stop()
+{
+	if(!m_profiling)
+		return;
+
+	m_profile_mph->remove();
+	m_profiling = false;
+}
+
+//-------------------------------------------------
+//  profile_reset - clear the counts gathered so
+//  far
+//-------------------------------------------------
+
+void address_space::profile_reset()
+{
+	if(m_profiling)
+		for(auto &entry : m_profile)
+			entry->reset();
+	else
+		m_profile.clear();
+}
+
+
 //**************************************************************************
 //  BANKING HELPERS
 //**************************************************************************
@@ -749,6 +749,32 @@ public:
 	virtual void detach(const std::unordered_set<handler_entry *> &handlers);
 };
 
+// =====================-> Access profile for one handler
+
+// accesses counted by a profiling passthrough, see address_space::profile_start
+struct memory_access_profile
+{
+	memory_access_profile(std::string &&name, read_or_write type) : m_name(std::move(name)), m_type(type) {}
+
+	void account(offs_t offset, osd_ticks_t ticks) {
+		if(offset < m_start)
+			m_start = offset;
+		if(offset > m_end)
+			m_end = offset;
+		m_count++;
+		m_ticks += ticks;
+	}
+
+	void reset() { m_start = ~offs_t(0); m_end = 0; m_count = 0; m_ticks = 0; }
+
+	std::string     m_name;                 // name of the handler underneath
+	read_or_write   m_type;                 // reads or writes
+	offs_t          m_start = ~offs_t(0);   // lowest address accessed
+	offs_t          m_end = 0;              // highest address accessed
+	u64             m_count = 0;            // number of accesses
+	osd_ticks_t     m_ticks = 0;            // host time spent, including nested accesses
+};
+
 // =====================-> Passthrough handler management structure
 class memory_passthrough_handler
 {
@@ -1234,6 +1260,13 @@ public:
 
 	virtual void remove_passthrough(std::unordered_set<handler_entry *> &handlers) = 0;
 
+	// access profiling
+	void profile_start();
+	void profile_stop();
+	void profile_reset();
+	bool profiling() const { return m_profiling; }
+	const std::vector<std::shared_ptr<memory_access_profile>> &profile() const { return m_profile; }
+
 	int data_width() const { return m_config.data_width(); }
 	int addr_width() const { return m_config.addr_width(); }
 	int logaddr_width() const { return m_config.logaddr_width(); }
@@ -1289,6 +1322,16 @@ public:
 	virtual void write_qword_unaligned(offs_t address, u64 data) = 0;
 	virtual void write_qword_unaligned(offs_t address, u64 data, u64 mask) = 0;
 
+	// block accessors, equivalent to count successive aligned accesses of the given size
+	virtual void read_block(offs_t address, u8 *dest, offs_t count) = 0;
+	virtual void read_block(offs_t address, u16 *dest, offs_t count) = 0;
+	virtual void read_block(offs_t address, u32 *dest, offs_t count) = 0;
+	virtual void read_block(offs_t address, u64 *dest, offs_t count) = 0;
+	virtual void write_block(offs_t address, const u8 *src, offs_t count) = 0;
+	virtual void write_block(offs_t address, const u16 *src, offs_t count) = 0;
+	virtual void write_block(offs_t address, const u32 *src, offs_t count) = 0;
+	virtual void write_block(offs_t address, const u64 *src, offs_t count) = 0;
+
 	// address-to-byte conversion helpers
 	offs_t address_to_byte(offs_t address) const { return m_config.addr2byte(address); }
 	offs_t address_to_byte_end(offs_t address) const { return m_config.addr2byte_end(address); }
@@ -1538,6 +1581,7 @@ public:
 protected:
 	// internal helpers
 	virtual void *create_cache() = 0;
+	virtual void install_profile(memory_passthrough_handler &mph) = 0;
 
 	void populate_map_entry(const address_map_entry &entry, read_or_write readorwrite);
 	virtual void unmap_generic(offs_t addrstart, offs_t addrend, offs_t addrmirror, read_or_write readorwrite, bool quiet) = 0;
@@ -1574,6 +1618,10 @@ protected:
 
 	std::vector<std::unique_ptr<memory_passthrough_handler>> m_mphs;
 
+	std::vector<std::shared_ptr<memory_access_profile>> m_profile; // per-handler access counts
+	memory_passthrough_handler *m_profile_mph;  // profiling passthroughs, once profiling has started
+	bool                    m_profiling;        // true while the profiling passthroughs are installed
+
 	std::vector<notifier_t> m_notifiers;        // notifier list for address map change
 	int                     m_notifier_id;      // next notifier id
 	u32                     m_in_notification;  // notification(s) currently being done
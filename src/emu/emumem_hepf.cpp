@@ -0,0 +1,99 @@
+// license:BSD-3-Clause
+
+#include "emu.h"
+#include "emumem_hep.h"
+#include "emumem_hepf.h"
+
+template<int Width, int AddrShift, int Endian> handler_entry_read_profile<Width, AddrShift, Endian>::handler_entry_read_profile(address_space *space, memory_passthrough_handler &mph, handler_entry_read<Width, AddrShift, Endian> *next, std::vector<std::shared_ptr<memory_access_profile>> &profile) : handler_entry_read_passthrough<Width, AddrShift, Endian>(space, mph, next), m_profile(profile), m_stats(std::make_shared<memory_access_profile>(next->name(), read_or_write::READ))
+{
+	m_profile.push_back(m_stats);
+}
+
+template<int Width, int AddrShift, int Endian> typename emu::detail::handler_entry_size<Width>::uX handler_entry_read_profile<Width, AddrShift, Endian>::read(offs_t offset, uX mem_mask)
+{
+	osd_ticks_t start = osd_ticks();
+	uX data = inh::m_next->read(offset, mem_mask);
+	m_stats->account(offset, osd_ticks() - start);
+	return data;
+}
+
+template<int Width, int AddrShift, int Endian> std::string handler_entry_read_profile<Width, AddrShift, Endian>::name() const
+{
+	return "(profile) " + inh::m_next->name();
+}
+
+template<int Width, int AddrShift, int Endian> handler_entry_read_profile<Width, AddrShift, Endian> *handler_entry_read_profile<Width, AddrShift, Endian>::instantiate(handler_entry_read<Width, AddrShift, Endian> *next) const
+{
+	return new handler_entry_read_profile<Width, AddrShift, Endian>(inh::m_space, inh::m_mph, next, m_profile);
+}
+
+
+template<int Width, int AddrShift, int Endian> handler_entry_write_profile<Width, AddrShift, Endian>::handler_entry_write_profile(address_space *space, memory_passthrough_handler &mph, handler_entry_write<Width, AddrShift, Endian> *next, std::vector<std::shared_ptr<memory_access_profile>> &profile) : handler_entry_write_passthrough<Width, AddrShift, Endian>(space, mph, next), m_profile(profile), m_stats(std::make_shared<memory_access_profile>(next->name(), read_or_write::WRITE))
+{
+	m_profile.push_back(m_stats);
+}
+
+template<int Width, int AddrShift, int Endian> void handler_entry_write_profile<Width, AddrShift, Endian>::write(offs_t offset, uX data, uX mem_mask)
+{
+	osd_ticks_t start = osd_ticks();
+	inh::m_next->write(offset, data, mem_mask);
+	m_stats->account(offset, osd_ticks() - start);
+}
+
+template<int Width, int AddrShift, int Endian> std::string handler_entry_write_profile<Width, AddrShift, Endian>::name() const
+{
+	return "(profile) " + inh::m_next->name();
+}
+
+template<int Width, int AddrShift, int Endian> handler_entry_write_profile<Width, AddrShift, Endian> *handler_entry_write_profile<Width, AddrShift, Endian>::instantiate(handler_entry_write<Width, AddrShift, Endian> *next) const
+{
+	return new handler_entry_write_profile<Width, AddrShift, Endian>(inh::m_space, inh::m_mph, next, m_profile);
+}
+
+
+
+template class handler_entry_read_profile<0,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<0,  0, ENDIANNESS_BIG>;
+template class handler_entry_read_profile<1,  3, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<1,  3, ENDIANNESS_BIG>;
+template class handler_entry_read_profile<1,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<1,  0, ENDIANNESS_BIG>;
+template class handler_entry_read_profile<1, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<1, -1, ENDIANNESS_BIG>;
+template class handler_entry_read_profile<2,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<2,  0, ENDIANNESS_BIG>;
+template class handler_entry_read_profile<2, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<2, -1, ENDIANNESS_BIG>;
+template class handler_entry_read_profile<2, -2, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<2, -2, ENDIANNESS_BIG>;
+template class handler_entry_read_profile<3,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<3,  0, ENDIANNESS_BIG>;
+template class handler_entry_read_profile<3, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<3, -1, ENDIANNESS_BIG>;
+template class handler_entry_read_profile<3, -2, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<3, -2, ENDIANNESS_BIG>;
+template class handler_entry_read_profile<3, -3, ENDIANNESS_LITTLE>;
+template class handler_entry_read_profile<3, -3, ENDIANNESS_BIG>;
+
+template class handler_entry_write_profile<0,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<0,  0, ENDIANNESS_BIG>;
+template class handler_entry_write_profile<1,  3, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<1,  3, ENDIANNESS_BIG>;
+template class handler_entry_write_profile<1,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<1,  0, ENDIANNESS_BIG>;
+template class handler_entry_write_profile<1, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<1, -1, ENDIANNESS_BIG>;
+template class handler_entry_write_profile<2,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<2,  0, ENDIANNESS_BIG>;
+template class handler_entry_write_profile<2, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<2, -1, ENDIANNESS_BIG>;
+template class handler_entry_write_profile<2, -2, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<2, -2, ENDIANNESS_BIG>;
+template class handler_entry_write_profile<3,  0, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<3,  0, ENDIANNESS_BIG>;
+template class handler_entry_write_profile<3, -1, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<3, -1, ENDIANNESS_BIG>;
+template class handler_entry_write_profile<3, -2, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<3, -2, ENDIANNESS_BIG>;
+template class handler_entry_write_profile<3, -3, ENDIANNESS_LITTLE>;
+template class handler_entry_write_profile<3, -3, ENDIANNESS_BIG>;
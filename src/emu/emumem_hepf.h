@@ -0,0 +1,49 @@
+// license:BSD-3-Clause
+
+// handler_entry_read_profile/handler_entry_write_profile
+
+// handler which counts the accesses going through it and the host time they take
+
+template<int Width, int AddrShift, int Endian> class handler_entry_read_profile : public handler_entry_read_passthrough<Width, AddrShift, Endian>
+{
+public:
+	using uX = typename emu::detail::handler_entry_size<Width>::uX;
+	using inh = handler_entry_read_passthrough<Width, AddrShift, Endian>;
+
+	handler_entry_read_profile(address_space *space, memory_passthrough_handler &mph, std::vector<std::shared_ptr<memory_access_profile>> &profile) : handler_entry_read_passthrough<Width, AddrShift, Endian>(space, mph), m_profile(profile) {}
+	~handler_entry_read_profile() = default;
+
+	uX read(offs_t offset, uX mem_mask) override;
+
+	std::string name() const override;
+
+	handler_entry_read_profile<Width, AddrShift, Endian> *instantiate(handler_entry_read<Width, AddrShift, Endian> *next) const override;
+
+protected:
+	std::vector<std::shared_ptr<memory_access_profile>> &m_profile;
+	std::shared_ptr<memory_access_profile> m_stats;
+
+	handler_entry_read_profile(address_space *space, memory_passthrough_handler &mph, handler_entry_read<Width, AddrShift, Endian> *next, std::vector<std::shared_ptr<memory_access_profile>> &profile);
+};
+
+template<int Width, int AddrShift, int Endian> class handler_entry_write_profile : public handler_entry_write_passthrough<Width, AddrShift, Endian>
+{
+public:
+	using uX = typename emu::detail::handler_entry_size<Width>::uX;
+	using inh = handler_entry_write_passthrough<Width, AddrShift, Endian>;
+
+	handler_entry_write_profile(address_space *space, memory_passthrough_handler &mph, std::vector<std::shared_ptr<memory_access_profile>> &profile) : handler_entry_write_passthrough<Width, AddrShift, Endian>(space, mph), m_profile(profile) {}
+	~handler_entry_write_profile() = default;
+
+	void write(offs_t offset, uX data, uX mem_mask) override;
+
+	std::string name() const override;
+
+	handler_entry_write_profile<Width, AddrShift, Endian> *instantiate(handler_entry_write<Width, AddrShift, Endian> *next) const override;
+
+protected:
+	std::vector<std::shared_ptr<memory_access_profile>> &m_profile;
+	std::shared_ptr<memory_access_profile> m_stats;
+
+	handler_entry_write_profile(address_space *space, memory_passthrough_handler &mph, handler_entry_write<Width, AddrShift, Endian> *next, std::vector<std::shared_ptr<memory_access_profile>> &profile);
+};
@@ -63,7 +63,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_STATE,                                      nullptr,     OPTION_STRING,     "saved state to load" },
 	{ OPTION_AUTOSAVE,                                   "0",         OPTION_BOOLEAN,    "automatically restore state on start and save on exit for supported systems" },
 	{ OPTION_REWIND,                                     "0",         OPTION_BOOLEAN,    "enable rewind savestates" },
-	{ OPTION_REWIND_CAPACITY "(1-2048)",                 "100",       OPTION_INTEGER,    "rewind buffer size in megabytes" },
+	{ OPTION_REWIND_CAPACITY "(1-2048)",                 "100",       OPTION_INTEGER,    "rewind buffer size in megabytes, counting encoded states" },
+	{ OPTION_REWIND_TRACK_WRITES,                        "0",         OPTION_BOOLEAN,    "only encode pages of large memory blocks written through address spaces since the last rewind state" },
 	{ OPTION_PLAYBACK ";pb",                             nullptr,     OPTION_STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,     OPTION_STRING,     "record an input file" },
 	{ OPTION_RECORD_TIMECODE,                            "0",         OPTION_BOOLEAN,    "record an input timecode file (requires -record option)" },
@@ -72,6 +73,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_MNGWRITE,                                   nullptr,     OPTION_STRING,     "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   nullptr,     OPTION_STRING,     "optional filename to write an AVI movie of the current session" },
 	{ OPTION_WAVWRITE,                                   nullptr,     OPTION_STRING,     "optional filename to write a WAV file of the current session" },
+	{ OPTION_POLYCAPTURE,                                nullptr,     OPTION_STRING,     "optional filename to write the polygons drawn by 3D renderers to, for the poly replay benchmark" },
+	{ OPTION_POLYCAPTURE_FRAMES,                         "10",        OPTION_INTEGER,    "number of frames to capture polygons for, 0 for the whole session" },
 	{ OPTION_SNAPNAME,                                   "%g/%i",     OPTION_STRING,     "override of the default snapshot/movie naming; %g == gamename, %i == index" },
 	{ OPTION_SNAPSIZE,                                   "auto",      OPTION_STRING,     "specify snapshot/movie resolution (<width>x<height>) or 'auto' to use minimal size " },
 	{ OPTION_SNAPVIEW,                                   "internal",  OPTION_STRING,     "specify snapshot/movie view or 'internal' to use internal pixel-aspect views" },
@@ -88,6 +91,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjust emulation speed to keep the emulated refresh rate slower than the host screen" },
+	{ OPTION_TILEMAP_BANDS,                              "0",         OPTION_BOOLEAN,    "draw tall tilemap regions in horizontal bands on multiple threads" },
 
 	// render options
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE RENDER OPTIONS" },
@@ -141,6 +145,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SAMPLERATE ";sr(1000-1000000)",             "48000",     OPTION_INTEGER,    "set sound output sample rate" },
 	{ OPTION_SAMPLES,                                    "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
 	{ OPTION_VOLUME ";vol",                              "0",         OPTION_INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
+	{ OPTION_RESAMPLER,                                  "linear",    OPTION_STRING,     "sample rate conversion between sound streams (linear or sinc)" },
 
 	// input options
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE INPUT OPTIONS" },
@@ -195,6 +200,13 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DRC_USE_C,                                  "0",         OPTION_BOOLEAN,    "force DRC to use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         OPTION_BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         OPTION_BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_BACKGROUND,                             "0",         OPTION_BOOLEAN,    "compile DRC code on a worker thread, interpreting meanwhile where supported" },
+	{ OPTION_DRC_OPTIMIZE,                               "0",         OPTION_BOOLEAN,    "optimize whole DRC blocks with flag liveness and value forwarding" },
+	{ OPTION_DRC_PERF_MAP,                               "0",         OPTION_BOOLEAN,    "name generated DRC code in /tmp/perf-<pid>.map for perf" },
+	{ OPTION_DRC_PROFILE,                                "0",         OPTION_BOOLEAN,    "count entries to each block of DRC code, shown by the drcprofile debugger command" },
+	{ OPTION_DRC_CACHE,                                  "0",         OPTION_BOOLEAN,    "keep translated DRC code in the cfg directory for reuse by later sessions where supported" },
+	{ OPTION_NETLIST_CACHE,                              "0",         OPTION_BOOLEAN,    "compile netlist solvers not built in with the host C++ compiler, keeping them in the cfg directory" },
+	{ OPTION_CHD_CACHE_HUNKS "(1-65536)",                "16",        OPTION_INTEGER,    "number of decompressed hunks each CHD keeps; with 8 or more, sequential reads are decompressed ahead" },
 	{ OPTION_BIOS,                                       nullptr,     OPTION_STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         OPTION_BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         OPTION_BOOLEAN,    "skip displaying the system information screen at startup" },
@@ -53,6 +53,7 @@
 #define OPTION_AUTOSAVE             "autosave"
 #define OPTION_REWIND               "rewind"
 #define OPTION_REWIND_CAPACITY      "rewind_capacity"
+#define OPTION_REWIND_TRACK_WRITES  "rewind_track_writes"
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_RECORD_TIMECODE      "record_timecode"
@@ -60,6 +61,8 @@
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
 #define OPTION_WAVWRITE             "wavwrite"
+#define OPTION_POLYCAPTURE          "polycapture"
+#define OPTION_POLYCAPTURE_FRAMES   "polycapture_frames"
 #define OPTION_SNAPNAME             "snapname"
 #define OPTION_SNAPSIZE             "snapsize"
 #define OPTION_SNAPVIEW             "snapview"
@@ -75,6 +78,7 @@
 #define OPTION_SLEEP                "sleep"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
+#define OPTION_TILEMAP_BANDS        "tilemap_bands"
 
 // core render options
 #define OPTION_KEEPASPECT           "keepaspect"
@@ -122,6 +126,7 @@
 #define OPTION_SAMPLERATE           "samplerate"
 #define OPTION_SAMPLES              "samples"
 #define OPTION_VOLUME               "volume"
+#define OPTION_RESAMPLER            "resampler"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -164,6 +169,13 @@
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_BACKGROUND       "drc_background"
+#define OPTION_DRC_OPTIMIZE         "drc_optimize"
+#define OPTION_DRC_PERF_MAP         "drc_perf_map"
+#define OPTION_DRC_PROFILE          "drc_profile"
+#define OPTION_DRC_CACHE            "drc_cache"
+#define OPTION_NETLIST_CACHE        "netlist_cache"
+#define OPTION_CHD_CACHE_HUNKS      "chd_cache_hunks"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -335,6 +347,7 @@ public:
 	bool autosave() const { return bool_value(OPTION_AUTOSAVE); }
 	int rewind() const { return bool_value(OPTION_REWIND); }
 	int rewind_capacity() const { return int_value(OPTION_REWIND_CAPACITY); }
+	bool rewind_track_writes() const { return bool_value(OPTION_REWIND_TRACK_WRITES); }
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	bool record_timecode() const { return bool_value(OPTION_RECORD_TIMECODE); }
@@ -342,6 +355,8 @@ public:
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
 	const char *wav_write() const { return value(OPTION_WAVWRITE); }
+	const char *poly_capture() const { return value(OPTION_POLYCAPTURE); }
+	int poly_capture_frames() const { return int_value(OPTION_POLYCAPTURE_FRAMES); }
 	const char *snap_name() const { return value(OPTION_SNAPNAME); }
 	const char *snap_size() const { return value(OPTION_SNAPSIZE); }
 	const char *snap_view() const { return value(OPTION_SNAPVIEW); }
@@ -357,6 +372,7 @@ public:
 	bool sleep() const { return m_sleep; }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
+	bool tilemap_bands() const { return bool_value(OPTION_TILEMAP_BANDS); }
 
 	// core render options
 	bool keep_aspect() const { return bool_value(OPTION_KEEPASPECT); }
@@ -404,6 +420,7 @@ public:
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
 	int volume() const { return int_value(OPTION_VOLUME); }
+	const char *resampler() const { return value(OPTION_RESAMPLER); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -444,6 +461,13 @@ public:
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	bool drc_background() const { return bool_value(OPTION_DRC_BACKGROUND); }
+	bool drc_optimize() const { return bool_value(OPTION_DRC_OPTIMIZE); }
+	bool drc_perf_map() const { return bool_value(OPTION_DRC_PERF_MAP); }
+	bool drc_profile() const { return bool_value(OPTION_DRC_PROFILE); }
+	bool drc_cache() const { return bool_value(OPTION_DRC_CACHE); }
+	bool netlist_cache() const { return bool_value(OPTION_NETLIST_CACHE); }
+	int chd_cache_hunks() const { return int_value(OPTION_CHD_CACHE_HUNKS); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
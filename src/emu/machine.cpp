@@ -123,6 +123,7 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 		m_basename(_config.gamedrv().name),
 		m_sample_rate(_config.options().sample_rate()),
 		m_saveload_schedule(saveload_schedule::NONE),
+		m_saveload_async(false),
 		m_saveload_schedule_time(attotime::zero),
 		m_saveload_searchpath(nullptr),
 
@@ -273,6 +274,10 @@ void running_machine::start()
 	else if (options().autosave() && (m_system.flags & MACHINE_SUPPORTS_SAVE) != 0)
 		schedule_load("auto");
 
+	// a startup load has to be applied before the first timeslice runs, so
+	// don't read it in the background
+	m_saveload_async = false;
+
 	manager().update_machine();
 }
 
@@ -602,6 +607,15 @@ std::string running_machine::compose_saveload_filename(std::string &&filename, c
 
 void running_machine::set_saveload_filename(std::string &&filename)
 {
+	// finish off a background write, or abandon a background read
+	if (m_save.file_pending())
+	{
+		if (m_saveload_schedule == saveload_schedule::LOAD)
+			m_save.finish_file(false);
+		else
+			report_saveload(m_save.finish_file());
+	}
+
 	// compose the save/load filename and persist it
 	m_saveload_pending_file = compose_saveload_filename(std::move(filename), &m_saveload_searchpath);
 }
@@ -617,8 +631,10 @@ void running_machine::schedule_save(std::string &&filename)
 	// specify the filename to save or load
 	set_saveload_filename(std::move(filename));
 
-	// note the start time and set a timer for the next timeslice to actually schedule it
+	// note the start time and set a timer for the next timeslice to actually schedule it;
+	// the file I/O happens in the background
 	m_saveload_schedule = saveload_schedule::SAVE;
+	m_saveload_async = true;
 	m_saveload_schedule_time = this->time();
 
 	// we can't be paused since we need to clear out anonymous timers
@@ -637,6 +653,7 @@ void running_machine::immediate_save(const char *filename)
 
 	// set up some parameters for handle_saveload()
 	m_saveload_schedule = saveload_schedule::SAVE;
+	m_saveload_async = false;
 	m_saveload_schedule_time = this->time();
 
 	// jump right into the save, anonymous timers can't hurt us!
@@ -654,8 +671,10 @@ void running_machine::schedule_load(std::string &&filename)
 	// specify the filename to save or load
 	set_saveload_filename(std::move(filename));
 
-	// note the start time and set a timer for the next timeslice to actually schedule it
+	// note the start time and set a timer for the next timeslice to actually schedule it;
+	// the file I/O happens in the background
 	m_saveload_schedule = saveload_schedule::LOAD;
+	m_saveload_async = true;
 	m_saveload_schedule_time = this->time();
 
 	// we can't be paused since we need to clear out anonymous timers
@@ -674,6 +693,7 @@ void running_machine::immediate_load(const char *filename)
 
 	// set up some parameters for handle_saveload()
 	m_saveload_schedule = saveload_schedule::LOAD;
+	m_saveload_async = false;
 	m_saveload_schedule_time = this->time();
 
 	// jump right into the load, anonymous timers can't hurt us
@@ -895,72 +915,75 @@ void running_machine::handle_saveload()
 	// if no name, bail
 	if (!m_saveload_pending_file.empty())
 	{
-		const char *const opname = (m_saveload_schedule == saveload_schedule::LOAD) ? "load" : "save";
+		const bool load = (m_saveload_schedule == saveload_schedule::LOAD);
+		const char *const opname = load ? "load" : "save";
+
+		// wait for any background read or write to complete
+		if (m_save.file_pending() && !m_save.file_ready())
+			return;
+
+		if (!load && m_save.file_pending())
+		{
+			// the background write has finished
+			report_saveload(m_save.finish_file());
+		}
+		else if (load && m_saveload_async && !m_save.file_pending())
+		{
+			// read and decompress the file while the machine keeps running
+			std::unique_ptr<emu_file> file = open_saveload_file();
+			if (file)
+			{
+				save_error const saverr = m_save.read_file_async(std::move(file));
+				if (saverr == STATERR_NONE)
+					return;
+				report_saveload(saverr);
+			}
+		}
 
 		// if there are anonymous timers, we can't save just yet, and we can't load yet either
 		// because the timers might overwrite data we have loaded
-		if (!m_scheduler.can_save())
+		else if (!m_scheduler.can_save())
 		{
 			// if more than a second has passed, we're probably screwed
 			if ((this->time() - m_saveload_schedule_time) > attotime::from_seconds(1))
+			{
 				popmessage("Unable to %s due to pending anonymous timers. See error.log for details.", opname);
+				if (m_save.file_pending())
+					m_save.finish_file(false);
+			}
 			else
 				return; // return without cancelling the operation
 		}
+		else if (m_save.file_pending())
+		{
+			// the background read has finished, so apply it
+			report_saveload(m_save.finish_file());
+		}
 		else
 		{
-			u32 const openflags = (m_saveload_schedule == saveload_schedule::LOAD) ? OPEN_FLAG_READ : (OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-
 			// open the file
-			emu_file file(m_saveload_searchpath, openflags);
-			auto const filerr = file.open(m_saveload_pending_file);
-			if (filerr == osd_file::error::NONE)
+			std::unique_ptr<emu_file> file = open_saveload_file();
+			if (file)
 			{
-				const char *const opnamed = (m_saveload_schedule == saveload_schedule::LOAD) ? "loaded" : "saved";
-
-				// read/write the save state
-				save_error saverr = (m_saveload_schedule == saveload_schedule::LOAD) ? m_save.read_file(file) : m_save.write_file(file);
-
-				// handle the result
-				switch (saverr)
+				if (!load && m_saveload_async)
 				{
-				case STATERR_ILLEGAL_REGISTRATIONS:
-					popmessage("Error: Unable to %s state due to illegal registrations. See error.log for details.", opname);
-					break;
-
-				case STATERR_INVALID_HEADER:
-					popmessage("Error: Unable to %s state due to an invalid header. Make sure the save state is correct for this machine.", opname);
-					break;
-
-				case STATERR_READ_ERROR:
-					popmessage("Error: Unable to %s state due to a read error (file is likely corrupt).", opname);
-					break;
-
-				case STATERR_WRITE_ERROR:
-					popmessage("Error: Unable to %s state due to a write error. Verify there is enough disk space.", opname);
-					break;
-
-				case STATERR_NONE:
-					if (!(m_system.flags & MACHINE_SUPPORTS_SAVE))
-						popmessage("State successfully %s.\nWarning: Save states are not officially supported for this machine.", opnamed);
-					else
-						popmessage("State successfully %s.", opnamed);
-					break;
-
-				default:
-					popmessage("Error: Unknown error during state %s.", opnamed);
-					break;
+					// snapshot the state now and write it out in the background
+					save_error const saverr = m_save.write_file_async(std::move(file));
+					if (saverr == STATERR_NONE)
+						return;
+					report_saveload(saverr);
 				}
+				else
+				{
+					// read/write the save state
+					save_error const saverr = load ? m_save.read_file(*file) : m_save.write_file(*file);
+					report_saveload(saverr);
 
-				// close and perhaps delete the file
-				if (saverr != STATERR_NONE && m_saveload_schedule == saveload_schedule::SAVE)
-					file.remove_on_close();
+					// close and perhaps delete the file
+					if (saverr != STATERR_NONE && !load)
+						file->remove_on_close();
+				}
 			}
-			else if (openflags == OPEN_FLAG_READ && filerr == osd_file::error::NOT_FOUND)
-				// attempt to load a non-existent savestate, report empty slot
-				popmessage("Error: No savestate file to load.", opname);
-			else
-				popmessage("Error: Failed to open file for %s operation.", opname);
 		}
 	}
 
@@ -971,6 +994,75 @@ void running_machine::handle_saveload()
 }
 
 
+//-------------------------------------------------
+//  open_saveload_file - open the pending save or
+//  load file, reporting any failure
+//-------------------------------------------------
+
+std::unique_ptr<emu_file> running_machine::open_saveload_file()
+{
+	const bool load = (m_saveload_schedule == saveload_schedule::LOAD);
+	const char *const opname = load ? "load" : "save";
+	u32 const openflags = load ? OPEN_FLAG_READ : (OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+
+	auto file = std::make_unique<emu_file>(m_saveload_searchpath, openflags);
+	auto const filerr = file->open(m_saveload_pending_file);
+	if (filerr == osd_file::error::NONE)
+		return file;
+
+	if (load && filerr == osd_file::error::NOT_FOUND)
+		// attempt to load a non-existent savestate, report empty slot
+		popmessage("Error: No savestate file to load.", opname);
+	else
+		popmessage("Error: Failed to open file for %s operation.", opname);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  report_saveload - tell the user how a save or
+//  load turned out
+//-------------------------------------------------
+
+void running_machine::report_saveload(save_error saverr)
+{
+	const bool load = (m_saveload_schedule == saveload_schedule::LOAD);
+	const char *const opname = load ? "load" : "save";
+	const char *const opnamed = load ? "loaded" : "saved";
+
+	// handle the result
+	switch (saverr)
+	{
+	case STATERR_ILLEGAL_REGISTRATIONS:
+		popmessage("Error: Unable to %s state due to illegal registrations. See error.log for details.", opname);
+		break;
+
+	case STATERR_INVALID_HEADER:
+		popmessage("Error: Unable to %s state due to an invalid header. Make sure the save state is correct for this machine.", opname);
+		break;
+
+	case STATERR_READ_ERROR:
+		popmessage("Error: Unable to %s state due to a read error (file is likely corrupt).", opname);
+		break;
+
+	case STATERR_WRITE_ERROR:
+		popmessage("Error: Unable to %s state due to a write error. Verify there is enough disk space.", opname);
+		break;
+
+	case STATERR_NONE:
+		if (!(m_system.flags & MACHINE_SUPPORTS_SAVE))
+			popmessage("State successfully %s.\nWarning: Save states are not officially supported for this machine.", opnamed);
+		else
+			popmessage("State successfully %s.", opnamed);
+		break;
+
+	default:
+		popmessage("Error: Unknown error during state %s.", opnamed);
+		break;
+	}
+}
+
+
 //-------------------------------------------------
 //  soft_reset - actually perform a soft-reset
 //  of the system
@@ -294,6 +294,8 @@ private:
 	void start();
 	void set_saveload_filename(std::string &&filename);
 	void handle_saveload();
+	std::unique_ptr<emu_file> open_saveload_file();
+	void report_saveload(save_error saverr);
 	void soft_reset(void *ptr = nullptr, s32 param = 0);
 	std::string nvram_filename(device_t &device) const;
 	void nvram_load();
@@ -356,6 +358,7 @@ private:
 		LOAD
 	};
 	saveload_schedule       m_saveload_schedule;
+	bool                    m_saveload_async;
 	attotime                m_saveload_schedule_time;
 	std::string             m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
@@ -0,0 +1,323 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    resampler.cpp
+
+    Sample rate conversion between sound streams.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "resampler.h"
+
+#include <cmath>
+
+// vector versions of the equal-rate copy
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define RESAMPLER_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RESAMPLER_NEON 1
+#endif
+
+
+//-------------------------------------------------
+//  divide - truncating division for the linear
+//  resampler; the dividends stay within 50 bits
+//  and the divisors within 18, so the quotient
+//  is never within rounding of the next integer
+//  and a double divide gives the same answer as
+//  a much slower 64-bit integer one
+//-------------------------------------------------
+
+static inline s64 divide(s64 dividend, int divisor)
+{
+	return s64(double(dividend) / double(divisor));
+}
+
+
+
+//**************************************************************************
+//  SOUND RESAMPLER
+//**************************************************************************
+
+//-------------------------------------------------
+//  create - allocate a resampler for converting
+//  between the given rates
+//-------------------------------------------------
+
+std::unique_ptr<sound_resampler> sound_resampler::create(const char *type, u32 source_rate, u32 dest_rate)
+{
+	// equal rates are a straight copy whatever the type; past the ratio the sinc
+	// kernel can span it would skip source samples, so averaging does better there
+	if (type != nullptr && !strcmp(type, "sinc") && source_rate != dest_rate && sinc_resampler::supports(source_rate, dest_rate))
+		return std::make_unique<sinc_resampler>(source_rate, dest_rate);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  linear - shared instance of the linear
+//  resampler, for falling back on
+//-------------------------------------------------
+
+const sound_resampler &sound_resampler::linear()
+{
+	static const linear_resampler s_linear;
+	return s_linear;
+}
+
+
+
+//**************************************************************************
+//  LINEAR RESAMPLER
+//**************************************************************************
+
+//-------------------------------------------------
+//  copy - apply gain to samples at the same rate
+//-------------------------------------------------
+
+void linear_resampler::copy(stream_sample_t *dest, const stream_sample_t *source, s64 gain, u32 numsamples)
+{
+#if defined(RESAMPLER_SSE2)
+	// SSE2 only has an unsigned 32x32->64 multiply, so the sign of the sample is
+	// corrected for afterwards; that needs a non-negative gain that fits in 32 bits
+	if (gain >= 0 && gain <= 0x7fffffff)
+	{
+		const __m128i mult = _mm_set1_epi32(s32(gain));
+		const __m128i fixup = _mm_set1_epi32(s32(u32(gain) << 24));
+		const __m128i lowmask = _mm_set_epi32(0, -1, 0, -1);
+		for ( ; numsamples >= 4; numsamples -= 4, source += 4, dest += 4)
+		{
+			// bits 8-39 of each product are the result
+			const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+			const __m128i even = _mm_srli_epi64(_mm_mul_epu32(samples, mult), 8);
+			const __m128i odd = _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(samples, 32), mult), 24);
+			const __m128i result = _mm_or_si128(_mm_and_si128(even, lowmask), _mm_andnot_si128(lowmask, odd));
+
+			// treating negative samples as unsigned added gain << 32 to the product
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_sub_epi32(result, _mm_and_si128(_mm_srai_epi32(samples, 31), fixup)));
+		}
+	}
+#elif defined(RESAMPLER_NEON)
+	// NEON has a signed widening multiply, so anything that fits in 32 bits will do
+	if (gain >= -0x80000000LL && gain <= 0x7fffffff)
+	{
+		const int32x2_t mult = vdup_n_s32(s32(gain));
+		for ( ; numsamples >= 4; numsamples -= 4, source += 4, dest += 4)
+		{
+			const int32x4_t samples = vld1q_s32(source);
+			const int64x2_t low = vshrq_n_s64(vmull_s32(vget_low_s32(samples), mult), 8);
+			const int64x2_t high = vshrq_n_s64(vmull_s32(vget_high_s32(samples), mult), 8);
+			vst1q_s32(dest, vcombine_s32(vmovn_s64(low), vmovn_s64(high)));
+		}
+	}
+#endif
+
+	// handle whatever's left
+	while (numsamples--)
+	{
+		// compute the sample
+		s64 sample = *source++;
+		*dest++ = (sample * gain) >> 8;
+	}
+}
+
+
+//-------------------------------------------------
+//  upsample - the source rate is lower, so point
+//  sample, blending where an output sample
+//  straddles a source boundary
+//-------------------------------------------------
+
+void linear_resampler::upsample(stream_sample_t *dest, const stream_sample_t *source, u32 basefrac, u32 step, s64 gain, u32 numsamples)
+{
+	while (numsamples != 0)
+	{
+		// fill in with point samples until we hit a boundary; they're all the same,
+		// but the stores through dest would stop the compiler seeing that
+		const stream_sample_t point = (source[0] * gain) >> 8;
+		int nextfrac;
+		while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
+		{
+			*dest++ = point;
+			basefrac = nextfrac;
+		}
+
+		// if we're done, we're done; that includes reaching a boundary right
+		// after the last sample, which mustn't produce an extra one
+		if (s32(numsamples) <= 0)
+			break;
+		numsamples--;
+
+		// compute starting and ending fractional positions
+		int startfrac = basefrac >> (FRAC_BITS - 12);
+		int endfrac = nextfrac >> (FRAC_BITS - 12);
+
+		// blend between the two samples accordingly
+		s64 sample = divide(s64(source[0]) * (0x1000 - startfrac) + s64(source[1]) * (endfrac - 0x1000), endfrac - startfrac);
+		*dest++ = (sample * gain) >> 8;
+
+		// advance
+		basefrac = nextfrac & FRAC_MASK;
+		source++;
+	}
+}
+
+
+//-------------------------------------------------
+//  downsample - the source rate is higher, so
+//  average the samples each output covers
+//-------------------------------------------------
+
+void linear_resampler::downsample(stream_sample_t *dest, const stream_sample_t *source, u32 basefrac, u32 step, s64 gain, u32 numsamples)
+{
+	// use 8 bits to allow some extra headroom
+	int smallstep = step >> (FRAC_BITS - 8);
+
+	// below 4:1 each output covers a couple of whole samples at most, and stepping
+	// through them one at a time beats setting up a vector loop
+	if (step < 4 * FRAC_ONE)
+	{
+		while (numsamples--)
+		{
+			// compute the sample: a partial first sample, the whole ones, and
+			// whatever's left of the last one
+			s64 remainder = smallstep;
+			int tpos = 0;
+			s64 scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
+			s64 sample = s64(source[tpos++]) * scale;
+			remainder -= scale;
+			while (remainder > 0x100)
+			{
+				sample += s64(source[tpos++]) * s64(0x100);
+				remainder -= 0x100;
+			}
+			sample += s64(source[tpos]) * remainder;
+			sample = divide(sample, smallstep);
+
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac += step;
+			source += basefrac >> FRAC_BITS;
+			basefrac &= FRAC_MASK;
+		}
+		return;
+	}
+
+	while (numsamples--)
+	{
+		// compute the sample: a partial first sample, a run of whole ones, and
+		// whatever's left of the last one
+		s64 scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
+		s64 sample = s64(source[0]) * scale;
+		s64 remainder = smallstep - scale;
+		const int whole = (remainder > 0) ? int((remainder - 1) >> 8) : 0;
+
+		// the whole samples are summed separately so the loop can be vectorized
+		s64 total = 0;
+		for (int tpos = 1; tpos <= whole; tpos++)
+			total += source[tpos];
+		sample += total * 0x100;
+		remainder -= s64(whole) * 0x100;
+		sample += s64(source[whole + 1]) * remainder;
+		sample = divide(sample, smallstep);
+
+		*dest++ = (sample * gain) >> 8;
+
+		// advance
+		basefrac += step;
+		source += basefrac >> FRAC_BITS;
+		basefrac &= FRAC_MASK;
+	}
+}
+
+
+//**************************************************************************
+//  SINC RESAMPLER
+//**************************************************************************
+
+//-------------------------------------------------
+//  sinc_resampler - build the coefficient table
+//  for a pair of rates
+//-------------------------------------------------
+
+sinc_resampler::sinc_resampler(u32 source_rate, u32 dest_rate)
+{
+	// cut off at the lower of the two Nyquist frequencies; the kernel widens
+	// in proportion when downsampling, up to a limit (see supports)
+	const double cutoff = std::min(1.0, double(dest_rate) / double(source_rate));
+	m_half_taps = std::min<u32>(MAX_HALF_TAPS, u32(std::ceil(ZERO_CROSSINGS / cutoff)));
+	m_half_taps = (m_half_taps + 1) & ~1;
+	const u32 taps = 2 * m_half_taps;
+
+	// one row per phase, plus a final one so phases can be blended
+	m_coeffs.resize((PHASES + 1) * taps);
+	for (u32 phase = 0; phase <= PHASES; phase++)
+	{
+		float *const row = &m_coeffs[phase * taps];
+		double total = 0.0;
+		for (u32 tap = 0; tap < taps; tap++)
+		{
+			// distance from the interpolated position, in source samples
+			const double t = double(tap) - double(m_half_taps - 1) - double(phase) / PHASES;
+			const double x = M_PI * cutoff * t;
+			const double sinc = (x == 0.0) ? 1.0 : (std::sin(x) / x);
+
+			// Blackman window over the kernel
+			const double w = t / m_half_taps;
+			const double window = (std::fabs(w) >= 1.0) ? 0.0 : (0.42 + 0.5 * std::cos(M_PI * w) + 0.08 * std::cos(2.0 * M_PI * w));
+			row[tap] = float(sinc * window);
+			total += row[tap];
+		}
+
+		// normalize each row for unity gain at DC
+		for (u32 tap = 0; tap < taps; tap++)
+			row[tap] = float(row[tap] / total);
+	}
+}
+
+
+//-------------------------------------------------
+//  resample - convolve each position with the
+//  kernel, blending the two nearest phases
+//-------------------------------------------------
+
+void sinc_resampler::resample(stream_sample_t *dest, const stream_sample_t *source, u32 basefrac, u32 step, s64 gain, u32 numsamples) const
+{
+	constexpr u32 BLEND_BITS = FRAC_BITS - PHASE_BITS;
+	const u32 taps = 2 * m_half_taps;
+	const float scale = float(gain) * (1.0f / 256.0f);
+	const float blendscale = 1.0f / float(1 << BLEND_BITS);
+
+	source -= m_half_taps - 1;
+	while (numsamples--)
+	{
+		const float *const row0 = &m_coeffs[(basefrac >> BLEND_BITS) * taps];
+		const float *const row1 = row0 + taps;
+
+		// four independent accumulators per phase so the loop can be vectorized;
+		// the tap count is always a multiple of four
+		float sum0[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float sum1[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (u32 tap = 0; tap < taps; tap += 4)
+			for (u32 lane = 0; lane < 4; lane++)
+			{
+				const float sample = float(source[tap + lane]);
+				sum0[lane] += sample * row0[tap + lane];
+				sum1[lane] += sample * row1[tap + lane];
+			}
+		const float value0 = (sum0[0] + sum0[1]) + (sum0[2] + sum0[3]);
+		const float value1 = (sum1[0] + sum1[1]) + (sum1[2] + sum1[3]);
+		const float blend = float(basefrac & ((1 << BLEND_BITS) - 1)) * blendscale;
+
+		*dest++ = stream_sample_t(std::floor((value0 + (value1 - value0) * blend) * scale + 0.5f));
+
+		// advance
+		basefrac += step;
+		source += basefrac >> FRAC_BITS;
+		basefrac &= FRAC_MASK;
+	}
+}
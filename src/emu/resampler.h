@@ -0,0 +1,113 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    resampler.h
+
+    Sample rate conversion between sound streams.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_EMU_RESAMPLER_H
+#define MAME_EMU_RESAMPLER_H
+
+#include "emucore.h"
+
+#include <memory>
+#include <vector>
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> sound_resampler
+
+// converts one stream's output to another stream's sample rate
+class sound_resampler
+{
+public:
+	// positions within the source are fixed point with this many fraction bits
+	static constexpr u32 FRAC_BITS              = 22;
+	static constexpr u32 FRAC_ONE               = 1 << FRAC_BITS;
+	static constexpr u32 FRAC_MASK              = FRAC_ONE - 1;
+
+	// construction/destruction
+	virtual ~sound_resampler() { }
+
+	// source samples needed before source[0], and beyond the one following the last position
+	virtual u32 history() const = 0;
+	virtual u32 lookahead() const = 0;
+
+	// generate numsamples samples, the first basefrac beyond source[0] and each one step further;
+	// gain is 8.8 fixed point
+	virtual void resample(stream_sample_t *dest, const stream_sample_t *source, u32 basefrac, u32 step, s64 gain, u32 numsamples) const = 0;
+
+	// create a resampler by name ("linear" or "sinc"); returns nullptr where linear
+	// should be used, so callers can convert through linear_resampler::convert
+	// without a virtual call
+	static std::unique_ptr<sound_resampler> create(const char *type, u32 source_rate, u32 dest_rate);
+	static const sound_resampler &linear();
+};
+
+
+// ======================> linear_resampler
+
+// the classic resampler: point sampling with blending across boundaries when
+// upsampling, and averaging when downsampling
+class linear_resampler : public sound_resampler
+{
+public:
+	virtual u32 history() const override { return 0; }
+	virtual u32 lookahead() const override { return 0; }
+	virtual void resample(stream_sample_t *dest, const stream_sample_t *source, u32 basefrac, u32 step, s64 gain, u32 numsamples) const override { convert(dest, source, basefrac, step, gain, numsamples); }
+
+	// pick the right case for the step
+	static void convert(stream_sample_t *dest, const stream_sample_t *source, u32 basefrac, u32 step, s64 gain, u32 numsamples)
+	{
+		if (step == FRAC_ONE)
+			copy(dest, source, gain, numsamples);
+		else if (step < FRAC_ONE)
+			upsample(dest, source, basefrac, step, gain, numsamples);
+		else
+			downsample(dest, source, basefrac, step, gain, numsamples);
+	}
+
+	// the individual cases, exposed for benchmarking
+	static void copy(stream_sample_t *dest, const stream_sample_t *source, s64 gain, u32 numsamples);
+	static void upsample(stream_sample_t *dest, const stream_sample_t *source, u32 basefrac, u32 step, s64 gain, u32 numsamples);
+	static void downsample(stream_sample_t *dest, const stream_sample_t *source, u32 basefrac, u32 step, s64 gain, u32 numsamples);
+};
+
+
+// ======================> sinc_resampler
+
+// polyphase windowed-sinc filter, band limited to the lower of the two rates
+class sinc_resampler : public sound_resampler
+{
+public:
+	// construction/destruction
+	sinc_resampler(u32 source_rate, u32 dest_rate);
+
+	virtual u32 history() const override { return m_half_taps - 1; }
+	virtual u32 lookahead() const override { return m_half_taps; }
+	virtual void resample(stream_sample_t *dest, const stream_sample_t *source, u32 basefrac, u32 step, s64 gain, u32 numsamples) const override;
+
+	// true if the kernel can keep all its zero crossings for this pair of rates
+	static bool supports(u32 source_rate, u32 dest_rate) { return source_rate != 0 && dest_rate != 0 && u64(source_rate) * ZERO_CROSSINGS <= u64(dest_rate) * MAX_HALF_TAPS; }
+
+	// limits
+	static constexpr u32 ZERO_CROSSINGS         = 8;      // zero crossings either side at full bandwidth
+	static constexpr u32 MAX_HALF_TAPS          = 32;     // caps the filter length, and so the downsampling ratio
+	static constexpr u32 PHASE_BITS             = 8;
+	static constexpr u32 PHASES                 = 1 << PHASE_BITS;
+
+private:
+	u32                 m_half_taps;            // taps either side of the interpolated position
+	std::vector<float>  m_coeffs;               // PHASES + 1 rows of 2 * m_half_taps coefficients
+};
+
+
+#endif  // MAME_EMU_RESAMPLER_H
@@ -1184,6 +1184,8 @@ void rom_load_manager::process_disk_entries(const char *regiontag, const rom_ent
 		if (ROMENTRY_ISFILE(romp))
 		{
 			auto chd = std::make_unique<open_chd>(regiontag);
+			chd->orig_chd().set_cache_hunks(machine().options().chd_cache_hunks());
+			chd->diff_chd().set_cache_hunks(machine().options().chd_cache_hunks());
 
 			util::hash_collection hashes(ROM_GETHASHDATA(romp));
 			chd_error err;
@@ -52,6 +52,113 @@ enum
 
 #define STATE_MAGIC_NUM         "MAMESAVE"
 
+// blocks at least this large have dirty pages tracked
+const u32 DIRTY_TRACK_MIN   = 64 * 1024;
+
+// rewind states are encoded as a sequence of (skip, count, bytes) records,
+// where skip and count are varints and the bytes are XORed into the image
+const u32 REWIND_MIN_GAP    = 8;    // unchanged runs shorter than this are folded into the literal
+
+
+
+//**************************************************************************
+//  REWIND ENCODING
+//**************************************************************************
+
+namespace {
+
+inline void put_varint(std::vector<u8> &out, u32 value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back(u8(value) | 0x80);
+		value >>= 7;
+	}
+	out.push_back(u8(value));
+}
+
+inline u32 get_varint(const u8 *&src)
+{
+	u32 result = 0;
+	for (int shift = 0; ; shift += 7)
+	{
+		const u8 byte = *src++;
+		result |= u32(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return result;
+	}
+}
+
+
+// ======================> delta_encoder
+
+// encodes a sequence of blocks against a reference image, which is brought
+// up to date as it goes; keyframes are encoded against zero instead
+class delta_encoder
+{
+public:
+	delta_encoder(std::vector<u8> &out) : m_out(out), m_skip(0) { m_out.clear(); }
+
+	void skip(u32 size) { m_skip += size; }
+
+	void add(const u8 *src, u8 *ref, u32 size, bool keyframe)
+	{
+		u32 pos = 0;
+		while (pos < size)
+		{
+			// skip over unchanged bytes, a word at a time where possible
+			const u32 start = pos;
+			for ( ; pos + 8 <= size; pos += 8)
+			{
+				u64 a, b = 0;
+				memcpy(&a, src + pos, 8);
+				if (!keyframe)
+					memcpy(&b, ref + pos, 8);
+				if (a != b)
+					break;
+			}
+			while (pos < size && src[pos] == (keyframe ? 0 : ref[pos]))
+				pos++;
+			m_skip += pos - start;
+			if (pos == size)
+				break;
+
+			// extend the literal until we find a long enough unchanged run
+			u32 end = pos + 1;
+			for (u32 i = end, same = 0; i < size && same < REWIND_MIN_GAP; i++)
+			{
+				if (src[i] == (keyframe ? 0 : ref[i]))
+					same++;
+				else
+				{
+					same = 0;
+					end = i + 1;
+				}
+			}
+
+			// emit the record
+			put_varint(m_out, m_skip);
+			put_varint(m_out, end - pos);
+			for (u32 i = pos; i < end; i++)
+				m_out.push_back(src[i] ^ (keyframe ? 0 : ref[i]));
+			if (!keyframe)
+				memcpy(ref + pos, src + pos, end - pos);
+			m_skip = 0;
+			pos = end;
+		}
+
+		// keyframes replace the reference outright
+		if (keyframe && (src != ref))
+			memcpy(ref, src, size);
+	}
+
+private:
+	std::vector<u8> &   m_out;      // output buffer
+	u32                 m_skip;     // unchanged bytes not yet accounted for
+};
+
+} // anonymous namespace
+
 //**************************************************************************
 //  INITIALIZATION
 //**************************************************************************
@@ -64,11 +171,36 @@ save_manager::save_manager(running_machine &machine)
 	: m_machine(machine)
 	, m_reg_allowed(true)
 	, m_illegal_regs(0)
+	, m_dirty_generation(0)
+	, m_dirty_bytes(0)
+	, m_file_queue(nullptr)
 {
 	m_rewind = std::make_unique<rewinder>(*this);
 }
 
 
+//-------------------------------------------------
+//  ~save_manager - destructor
+//-------------------------------------------------
+
+save_manager::~save_manager()
+{
+	// don't leave a write half-finished; if the worker is stuck, leave it the
+	// job and the queue rather than freeing them out from under it
+	if (m_file_job)
+	{
+		if (m_file_job->m_item != nullptr && !osd_work_item_wait(m_file_job->m_item, osd_ticks_per_second() * 100))
+		{
+			m_file_job.release();
+			return;
+		}
+		finish_file(false);
+	}
+	if (m_file_queue != nullptr)
+		osd_work_queue_free(m_file_queue);
+}
+
+
 //-------------------------------------------------
 //  allow_registration - allow/disallow
 //  registrations to happen
@@ -88,6 +220,14 @@ void save_manager::allow_registration(bool allowed)
 			if (m_entry_list[i]->m_name == m_entry_list[i + 1]->m_name)
 				fatalerror("Duplicate save state registration entry (%s)\n", m_entry_list[i]->m_name.c_str());
 
+		// assign each entry its offset within the final structure
+		u32 offset = 0;
+		for (auto &entry : m_entry_list)
+		{
+			entry->m_offset = offset;
+			offset += entry->m_typesize * entry->m_typecount;
+		}
+
 		dump_registry();
 
 		// everything is registered by now, evaluate the savestate size
@@ -227,6 +367,86 @@ void save_manager::dispatch_postload()
 }
 
 
+//-------------------------------------------------
+//  track_dirty - start tracking which pages of
+//  large entries are written between scans
+//-------------------------------------------------
+
+void save_manager::track_dirty()
+{
+	// only memory written through an address space can be tracked
+	for (device_memory_interface &memory : memory_interface_iterator(machine().root_device()))
+		for (int spacenum = 0; spacenum < memory.max_space_count(); spacenum++)
+			if (memory.has_space(spacenum))
+				track_dirty(memory.space(spacenum));
+}
+
+
+//-------------------------------------------------
+//  track_dirty - install write taps over every
+//  range of a space backed by a large entry
+//-------------------------------------------------
+
+void save_manager::track_dirty(address_space &space)
+{
+	for (address_map_entry &mapentry : space.map()->m_entrylist)
+	{
+		// find the entry holding the memory behind this range, if any
+		const u8 *const memory = reinterpret_cast<const u8 *>(mapentry.m_memory);
+		if (memory == nullptr)
+			continue;
+		auto found = std::find_if(m_entry_list.begin(), m_entry_list.end(),
+			[memory] (const std::unique_ptr<state_entry> &entry)
+			{
+				const u8 *const data = reinterpret_cast<const u8 *>(entry->m_data);
+				return (memory >= data) && (memory < data + entry->m_typesize * entry->m_typecount);
+			});
+		if ((found == m_entry_list.end()) || ((*found)->m_typesize * (*found)->m_typecount < DIRTY_TRACK_MIN))
+			continue;
+
+		// writes are stamped with the generation of the next scan
+		state_entry &entry = **found;
+		if (!entry.tracked())
+			entry.track_dirty();
+		const u32 base = memory - reinterpret_cast<const u8 *>(entry.m_data);
+		const offs_t addrstart = mapentry.m_addrstart;
+		const offs_t addrmirror = mapentry.m_addrmirror;
+		auto mark = [this, &entry, &space, base, addrstart, addrmirror] (offs_t offset)
+		{
+			entry.mark_dirty(base + space.address_to_byte((offset & ~addrmirror) - addrstart), m_dirty_generation + 1);
+		};
+		switch (space.data_width())
+		{
+			case 8:  space.install_write_tap(mapentry.m_addrstart, mapentry.m_addrend, addrmirror, "save_dirty", [mark] (offs_t offset, u8 &data, u8 mem_mask) { mark(offset); }); break;
+			case 16: space.install_write_tap(mapentry.m_addrstart, mapentry.m_addrend, addrmirror, "save_dirty", [mark] (offs_t offset, u16 &data, u16 mem_mask) { mark(offset); }); break;
+			case 32: space.install_write_tap(mapentry.m_addrstart, mapentry.m_addrend, addrmirror, "save_dirty", [mark] (offs_t offset, u32 &data, u32 mem_mask) { mark(offset); }); break;
+			case 64: space.install_write_tap(mapentry.m_addrstart, mapentry.m_addrend, addrmirror, "save_dirty", [mark] (offs_t offset, u64 &data, u64 mem_mask) { mark(offset); }); break;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  scan_dirty - collect the pages written since
+//  the previous scan; returns the new generation
+//-------------------------------------------------
+
+u32 save_manager::scan_dirty()
+{
+	// untracked entries count as changed in full
+	m_dirty_generation++;
+	m_dirty_bytes = 0;
+	for (auto &entry : m_entry_list)
+	{
+		if (entry->tracked())
+			m_dirty_bytes += entry->scan_dirty();
+		else
+			m_dirty_bytes += entry->m_typesize * entry->m_typecount;
+	}
+	return m_dirty_generation;
+}
+
+
 //-------------------------------------------------
 //  read_file - read the data from a file
 //-------------------------------------------------
@@ -296,12 +516,7 @@ save_error save_manager::write_file(emu_file &file)
 
 	// generate the header
 	u8 header[HEADER_SIZE];
-	memcpy(&header[0], STATE_MAGIC_NUM, 8);
-	header[8] = SAVE_VERSION;
-	header[9] = NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST);
-	strncpy((char *)&header[0x0a], machine().system().name, 0x1c - 0x0a);
-	u32 sig = signature();
-	*(u32 *)&header[0x1c] = little_endianize_int32(sig);
+	generate_header(header);
 
 	// write the header and turn on compression for the rest of the file
 	file.compress(FCOMPRESS_NONE);
@@ -324,6 +539,194 @@ save_error save_manager::write_file(emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  write_file_async - snapshot the state and
+//  start writing it out in the background
+//-------------------------------------------------
+
+save_error save_manager::write_file_async(std::unique_ptr<emu_file> &&file)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// call the pre-save functions, then take a copy of everything
+	dispatch_presave();
+	return start_file_job(std::move(file), false);
+}
+
+
+//-------------------------------------------------
+//  read_file_async - start reading a state file
+//  in the background; finish_file applies it
+//-------------------------------------------------
+
+save_error save_manager::read_file_async(std::unique_ptr<emu_file> &&file)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	return start_file_job(std::move(file), true);
+}
+
+
+//-------------------------------------------------
+//  file_ready - true if the background file
+//  operation has completed
+//-------------------------------------------------
+
+bool save_manager::file_ready() const
+{
+	return m_file_job && (!m_file_job->m_item || osd_work_item_wait(m_file_job->m_item, 0));
+}
+
+
+//-------------------------------------------------
+//  finish_file - wait for the background file
+//  operation, and apply the state if loading
+//-------------------------------------------------
+
+save_error save_manager::finish_file(bool apply)
+{
+	assert(m_file_job);
+	if (m_file_job->m_item != nullptr)
+	{
+		if (!osd_work_item_wait(m_file_job->m_item, osd_ticks_per_second() * 100))
+			fatalerror("save_manager::finish_file: background state file operation did not complete\n");
+		osd_work_item_release(m_file_job->m_item);
+	}
+	std::unique_ptr<file_job> const job(std::move(m_file_job));
+	if (job->m_result != STATERR_NONE || !job->m_load || !apply)
+		return job->m_result;
+
+	// the worker has already validated the header
+	const u8 *const header = job->m_data.data();
+
+	// determine whether or not to flip the data when done
+	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
+
+	// copy all the data, flipping if necessary
+	const u8 *src = header + HEADER_SIZE;
+	for (auto &entry : m_entry_list)
+	{
+		u32 totalsize = entry->m_typesize * entry->m_typecount;
+		memcpy(entry->m_data, src, totalsize);
+		src += totalsize;
+
+		// handle flipping
+		if (flip)
+			entry->flip_data();
+	}
+
+	// call the post-load functions
+	dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  start_file_job - set up the buffer and queue
+//  the background I/O
+//-------------------------------------------------
+
+save_error save_manager::start_file_job(std::unique_ptr<emu_file> &&file, bool load)
+{
+	// only one operation at a time
+	if (m_file_job)
+		finish_file();
+	if (m_file_queue == nullptr)
+		m_file_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+
+	m_file_job = std::make_unique<file_job>();
+	m_file_job->m_file = std::move(file);
+	m_file_job->m_load = load;
+	m_file_job->m_gamename = machine().system().name;
+	m_file_job->m_signature = signature();
+	m_file_job->m_data.resize(ram_state::get_size(*this));
+	m_file_job->m_result = STATERR_NONE;
+
+	// when saving, the header and data are captured now
+	if (!load)
+	{
+		u8 *dest = m_file_job->m_data.data();
+		generate_header(dest);
+		dest += HEADER_SIZE;
+		for (auto &entry : m_entry_list)
+		{
+			u32 totalsize = entry->m_typesize * entry->m_typecount;
+			memcpy(dest, entry->m_data, totalsize);
+			dest += totalsize;
+		}
+	}
+
+	// if it can't be queued, just do it here
+	m_file_job->m_item = (m_file_queue != nullptr) ? osd_work_item_queue(m_file_queue, file_job_callback, m_file_job.get(), 0) : nullptr;
+	if (m_file_job->m_item == nullptr)
+		file_job_callback(m_file_job.get(), 0);
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  file_job_callback - compress and write, or
+//  read and decompress, on a worker thread
+//-------------------------------------------------
+
+void *save_manager::file_job_callback(void *param, int threadid)
+{
+	file_job &job = *reinterpret_cast<file_job *>(param);
+	emu_file &file = *job.m_file;
+	u8 *const header = job.m_data.data();
+	u32 const datasize = job.m_data.size() - HEADER_SIZE;
+
+	// the header is uncompressed, the rest of the file isn't
+	file.compress(FCOMPRESS_NONE);
+	file.seek(0, SEEK_SET);
+	if (job.m_load)
+	{
+		// check the header before the body, whose size depends on the system
+		if (file.read(header, HEADER_SIZE) != HEADER_SIZE)
+			job.m_result = STATERR_READ_ERROR;
+		else if (validate_header(header, job.m_gamename, job.m_signature, nullptr, "Error: ") != STATERR_NONE)
+			job.m_result = STATERR_INVALID_HEADER;
+		file.compress(FCOMPRESS_MEDIUM);
+		if (job.m_result == STATERR_NONE && file.read(header + HEADER_SIZE, datasize) != datasize)
+			job.m_result = STATERR_READ_ERROR;
+	}
+	else
+	{
+		if (file.write(header, HEADER_SIZE) != HEADER_SIZE)
+			job.m_result = STATERR_WRITE_ERROR;
+		file.compress(FCOMPRESS_MEDIUM);
+		if (job.m_result == STATERR_NONE && file.write(header + HEADER_SIZE, datasize) != datasize)
+			job.m_result = STATERR_WRITE_ERROR;
+		if (job.m_result != STATERR_NONE)
+			file.remove_on_close();
+	}
+
+	// close it here too, since that flushes the compressor
+	job.m_file.reset();
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  generate_header - fill in the file header
+//-------------------------------------------------
+
+void save_manager::generate_header(u8 *header) const
+{
+	memcpy(&header[0], STATE_MAGIC_NUM, 8);
+	header[8] = SAVE_VERSION;
+	header[9] = NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST);
+	strncpy((char *)&header[0x0a], machine().system().name, 0x1c - 0x0a);
+	u32 sig = signature();
+	*(u32 *)&header[0x1c] = little_endianize_int32(sig);
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -566,17 +969,20 @@ rewinder::rewinder(save_manager &save)
 	: m_save(save)
 	, m_enabled(save.machine().options().rewind())
 	, m_capacity(save.machine().options().rewind_capacity())
+	, m_total_size(0)
 	, m_current_index(REWIND_INDEX_NONE)
-	, m_first_invalid_index(REWIND_INDEX_NONE)
 	, m_first_time_warning(true)
 	, m_first_time_note(true)
+	, m_reference_index(REWIND_INDEX_NONE)
+	, m_baseline_generation(0)
+	, m_baseline_valid(false)
 {
 }
 
 
 //-------------------------------------------------
 //  clamp_capacity - safety checks for commandline
-//  override
+//  override, and set up the reference image
 //-------------------------------------------------
 
 void rewinder::clamp_capacity()
@@ -584,28 +990,30 @@ void rewinder::clamp_capacity()
 	if (!m_enabled)
 		return;
 
-	const size_t total = m_capacity * 1024 * 1024;
-	const size_t single = ram_state::get_size(m_save);
-
-	// can't set below zero, but allow commandline to override options' upper limit
-	if (total < 0)
-		m_capacity = 0;
-
-	// if capacity is below savestate size, can't save anything
-	if (total < single)
+	// states are encoded, so whether they fit can only be checked once captured
+	if (m_capacity == 0)
 	{
 		m_enabled = false;
-		m_save.machine().logerror("Rewind has been disabled, because rewind capacity is smaller than savestate size.\n");
-		m_save.machine().logerror("Rewind buffer size: %d bytes. Savestate size: %d bytes.\n", total, single);
+		m_save.machine().logerror("Rewind has been disabled, because rewind capacity is zero.\n");
 		m_save.machine().popmessage("Rewind has been disabled. See error.log for details");
+		return;
 	}
+
+	// everything is registered by now, so the reference image can be sized
+	m_reference.assign(ram_state::get_size(m_save) - HEADER_SIZE, 0);
+	m_reference_index = REWIND_INDEX_NONE;
+
+	// optionally, large blocks only need encoding where they've been written; this
+	// misses writes that don't go through an address space, so it's off by default
+	if (m_save.machine().options().rewind_track_writes())
+		m_save.track_dirty();
 }
 
 
 //-------------------------------------------------
-//  invalidate - mark all the future states as
-//  invalid to prevent loading them, as the
-//  current input might have changed
+//  invalidate - discard all the future states to
+//  prevent loading them, as the current input
+//  might have changed
 //-------------------------------------------------
 
 void rewinder::invalidate()
@@ -616,12 +1024,14 @@ void rewinder::invalidate()
 	// is there anything to invalidate?
 	if (!current_index_is_last())
 	{
-		// all states starting from the current one will be invalid
-		m_first_invalid_index = m_current_index;
-
-		// actually invalidate
-		for (auto it = m_state_list.begin() + m_first_invalid_index; it < m_state_list.end(); ++it)
-			it->get()->m_valid = false;
+		// keep the reference image usable for capturing after the current state
+		if (m_reference_index > m_current_index)
+			reconstruct(m_current_index);
+
+		// all states after the current one are gone
+		for (auto it = m_state_list.begin() + m_current_index + 1; it < m_state_list.end(); ++it)
+			m_total_size -= (*it)->m_data.size();
+		m_state_list.erase(m_state_list.begin() + m_current_index + 1, m_state_list.end());
 	}
 }
 
@@ -639,51 +1049,46 @@ bool rewinder::capture()
 		return false;
 	}
 
-	if (current_index_is_last())
+	// if we have illegal registrations, complain and evacuate
+	if (m_save.m_illegal_regs > 0)
 	{
-		// we need to create a new state
-		std::unique_ptr<ram_state> state = std::make_unique<ram_state>(m_save);
-		const save_error error = state->save();
-
-		// validate the state
-		if (error == STATERR_NONE)
-			// it's safe to append
-			m_state_list.push_back(std::move(state));
-		else
-		{
-			// internal error, complain and evacuate
-			report_error(error, rewind_operation::SAVE);
-			return false;
-		}
+		report_error(STATERR_ILLEGAL_REGISTRATIONS, rewind_operation::SAVE);
+		return false;
 	}
-	else
-	{
-		// invalidate the future states
-		invalidate();
 
-		// update the existing state
-		ram_state *state = m_state_list.at(m_current_index).get();
-		const save_error error = state->save();
+	// capturing after stepping back replaces the states ahead of us
+	invalidate();
 
-		// validate the state
-		if (error != STATERR_NONE)
-		{
-			// internal error, complain and evacuate
-			report_error(error, rewind_operation::SAVE);
-			return false;
-		}
-	}
+	// start a new keyframe periodically, so loading never has to apply too many deltas
+	s32 deltas = 0;
+	for (s32 index = m_current_index; (index > REWIND_INDEX_NONE) && !m_state_list[index]->m_keyframe; index--)
+		deltas++;
+	auto state = std::make_unique<rewind_state>();
+	state->m_keyframe = m_state_list.empty() || (deltas + 1 >= KEYFRAME_INTERVAL);
 
-	// make sure we will fit in
-	if (!check_size())
-		// the list keeps growing
-		m_current_index++;
+	// deltas are taken against the newest state
+	if (!state->m_keyframe)
+		reconstruct(m_current_index);
 
-	// update first invalid index
-	if (current_index_is_last())
-		m_first_invalid_index = REWIND_INDEX_NONE;
-	else
-		m_first_invalid_index = m_current_index + 1;
+	// call the pre-save functions and encode the live data; where the live state
+	// still matches the reference, only pages that changed since then are looked at
+	m_save.dispatch_presave();
+	m_save.scan_dirty();
+	encode(*state, false, m_baseline_valid && !state->m_keyframe);
+	m_baseline_generation = m_save.dirty_generation();
+	m_baseline_valid = true;
+	if (VERBOSE)
+		m_save.machine().logerror("Rewind capture: %d bytes changed, %d bytes encoded\n", int(m_save.dirty_bytes()), int(state->m_data.size()));
+
+	// append it; the reference image now holds it
+	m_total_size += state->m_data.size();
+	m_state_list.push_back(std::move(state));
+	m_current_index = m_reference_index = m_state_list.size() - 1;
+
+	// make sure we fit in
+	check_size();
+	if (!m_enabled)
+		return false;
 
 	// success
 	report_error(STATERR_NONE, rewind_operation::SAVE);
@@ -705,35 +1110,39 @@ bool rewinder::step()
 	}
 
 	// do we have states to load?
-	if (m_current_index <= REWIND_INDEX_FIRST || m_first_invalid_index == REWIND_INDEX_FIRST)
+	if (m_current_index <= REWIND_INDEX_FIRST)
 	{
 		// no valid states, complain and evacuate
 		report_error(STATERR_NOT_FOUND, rewind_operation::LOAD);
 		return false;
 	}
 
-	// prepare to load the last valid index if we're too far ahead
-	if (m_first_invalid_index > REWIND_INDEX_NONE && m_current_index > m_first_invalid_index)
-		m_current_index = m_first_invalid_index;
-
-	// step back and obtain the state pointer
-	ram_state *state = m_state_list.at(--m_current_index).get();
+	// if we have illegal registrations, complain and evacuate
+	if (m_save.m_illegal_regs > 0)
+	{
+		report_error(STATERR_ILLEGAL_REGISTRATIONS, rewind_operation::LOAD);
+		return false;
+	}
 
-	// try to load and report the result
-	const save_error error = state->load();
-	report_error(error, rewind_operation::LOAD);
+	// step back and decode the state
+	reconstruct(--m_current_index);
 
-	if (error == save_error::STATERR_NONE)
-		return true;
+	// copy it back out and call the post-load functions; they may change the state
+	// behind the taps' backs, so the next capture compares everything
+	for (auto &entry : m_save.m_entry_list)
+		memcpy(entry->m_data, m_reference.data() + entry->m_offset, entry->m_typesize * entry->m_typecount);
+	m_baseline_valid = false;
+	m_save.dispatch_postload();
 
-	return false;
+	report_error(STATERR_NONE, rewind_operation::LOAD);
+	return true;
 }
 
 
 //-------------------------------------------------
-//  check_size - shrink the state list if it is
-//  about to hit the capacity. returns true if
-//  the list got shrank
+//  check_size - drop the oldest states if the
+//  list has grown beyond the capacity. returns
+//  true if any were dropped
 //-------------------------------------------------
 
 bool rewinder::check_size()
@@ -741,54 +1150,161 @@ bool rewinder::check_size()
 	if (!m_enabled)
 		return false;
 
-	// state sizes in bytes
-	const size_t singlesize = ram_state::get_size(m_save);
-	size_t totalsize = m_state_list.size() * singlesize;
-
 	// convert our limit from megabytes
 	const size_t capsize = m_capacity * 1024 * 1024;
 
-	// safety check that shouldn't be allowed to trigger
-	if (totalsize > capsize)
+	bool dropped = false;
+	while (m_total_size > capsize)
 	{
-		// states to remove
-		const u32 count = (totalsize - capsize) / singlesize;
+		// find the second keyframe; everything before it goes together
+		auto next = std::find_if(m_state_list.begin() + 1, m_state_list.end(), [] (const std::unique_ptr<rewind_state> &state) { return state->m_keyframe; });
+		if (next == m_state_list.end())
+		{
+			// a single keyframe that doesn't fit means nothing will
+			if (m_state_list.size() == 1)
+			{
+				m_enabled = false;
+				m_save.machine().logerror("Rewind has been disabled, because rewind capacity is smaller than an encoded savestate.\n");
+				m_save.machine().logerror("Rewind buffer size: %d bytes. Encoded savestate size: %d bytes.\n", capsize, m_total_size);
+				m_save.machine().popmessage("Rewind has been disabled. See error.log for details");
+				m_state_list.clear();
+				m_total_size = 0;
+				m_current_index = m_reference_index = REWIND_INDEX_NONE;
+				return true;
+			}
+
+			// otherwise turn the newest state into a keyframe so the rest can go
+			rewind_state &last = *m_state_list.back();
+			reconstruct(m_state_list.size() - 1);
+			m_total_size -= last.m_data.size();
+			last.m_keyframe = true;
+			encode(last, true);
+			m_total_size += last.m_data.size();
+			continue;
+		}
 
-		// drop everything that's beyond capacity
-		m_state_list.erase(m_state_list.begin(), m_state_list.begin() + count);
+		// drop the oldest group
+		const s32 count = next - m_state_list.begin();
+		for (auto it = m_state_list.begin(); it != next; ++it)
+			m_total_size -= (*it)->m_data.size();
+		m_state_list.erase(m_state_list.begin(), next);
+		m_current_index = std::max<s32>(m_current_index - count, REWIND_INDEX_NONE);
+		m_reference_index = (m_reference_index >= count) ? (m_reference_index - count) : REWIND_INDEX_NONE;
+		dropped = true;
+
+		if (m_first_time_note)
+		{
+			m_save.machine().logerror("Rewind note: Capacity has been reached. Old savestates will be erased.\n");
+			m_save.machine().logerror("Capacity: %d bytes. Encoded size: %d bytes. Savestate count: %d.\n",
+				capsize, m_total_size, m_state_list.size());
+			m_first_time_note = false;
+		}
 	}
 
-	// update before new check
-	totalsize = m_state_list.size() * singlesize;
+	return dropped;
+}
+
+
+//-------------------------------------------------
+//  encode - encode the live state (or the
+//  reference image) into the given state, and
+//  bring the reference image up to date
+//-------------------------------------------------
+
+void rewinder::encode(rewind_state &state, bool from_reference, bool use_tracking)
+{
+	delta_encoder encoder(state.m_data);
+	if (from_reference)
+		encoder.add(m_reference.data(), m_reference.data(), m_reference.size(), true);
+	else
+		for (auto &entry : m_save.m_entry_list)
+		{
+			const u8 *const src = reinterpret_cast<const u8 *>(entry->m_data);
+			u8 *const ref = m_reference.data() + entry->m_offset;
+			const u32 size = entry->m_typesize * entry->m_typecount;
+			if (!use_tracking || !entry->tracked())
+				encoder.add(src, ref, size, state.m_keyframe);
+			else
+				for (u32 page = 0, offset = 0; offset < size; page++, offset += state_entry::DIRTY_PAGE_SIZE)
+				{
+					// pages that haven't changed since the baseline still match the reference
+					const u32 length = std::min(size - offset, state_entry::DIRTY_PAGE_SIZE);
+					if (entry->page_dirty(page, m_baseline_generation))
+						encoder.add(src + offset, ref + offset, length, false);
+					else
+						encoder.skip(length);
+				}
+		}
+	state.m_data.shrink_to_fit();
+}
+
 
-	// check if capacity will be hit by the newly captured state
-	if (totalsize + singlesize >= capsize)
+//-------------------------------------------------
+//  apply - XOR a state's data into the reference
+//  image; keyframes replace it outright
+//-------------------------------------------------
+
+void rewinder::apply(const rewind_state &state)
+{
+	if (state.m_keyframe)
+		std::fill(m_reference.begin(), m_reference.end(), 0);
+
+	// the reference no longer matches what dirty tracking last saw
+	m_baseline_valid = false;
+
+	const u8 *src = state.m_data.data();
+	const u8 *const end = src + state.m_data.size();
+	u8 *dst = m_reference.data();
+	while (src < end)
 	{
-		// check if we have spare states ahead
-		if (!current_index_is_last())
-			// no need to move states around
-			return false;
+		dst += get_varint(src);
+		for (u32 count = get_varint(src); count > 0; count--)
+			*dst++ ^= *src++;
+	}
+	assert(dst <= m_reference.data() + m_reference.size());
+}
 
-		// we can now get the first state and invalidate it
-		std::unique_ptr<ram_state> first(std::move(m_state_list.front()));
-		first->m_valid = false;
 
-		// move it to the end for future use
-		m_state_list.push_back(std::move(first));
-		m_state_list.erase(m_state_list.begin());
+//-------------------------------------------------
+//  reconstruct - make the reference image hold
+//  the given state
+//-------------------------------------------------
 
-		if (m_first_time_note)
+void rewinder::reconstruct(s32 index)
+{
+	assert(index > REWIND_INDEX_NONE && index < s32(m_state_list.size()));
+	if (m_reference_index == index)
+		return;
+
+	// XOR deltas work in either direction, as long as no keyframe is in the way
+	if (m_reference_index != REWIND_INDEX_NONE)
+	{
+		const s32 lo = std::min(index, m_reference_index);
+		const s32 hi = std::max(index, m_reference_index);
+		bool direct = true;
+		for (s32 i = lo + 1; direct && (i <= hi); i++)
+			direct = !m_state_list[i]->m_keyframe;
+
+		if (direct)
 		{
-			m_save.machine().logerror("Rewind note: Capacity has been reached. Old savestates will be erased.\n");
-			m_save.machine().logerror("Capacity: %d bytes. Savestate size: %d bytes. Savestate count: %d.\n",
-				totalsize, singlesize, m_state_list.size());
-			m_first_time_note = false;
+			if (index < m_reference_index)
+				for (s32 i = m_reference_index; i > index; i--)
+					apply(*m_state_list[i]);
+			else
+				for (s32 i = m_reference_index + 1; i <= index; i++)
+					apply(*m_state_list[i]);
+			m_reference_index = index;
+			return;
 		}
-
-		return true;
 	}
 
-	return false;
+	// otherwise start from the nearest keyframe at or before it
+	s32 key = index;
+	while (!m_state_list[key]->m_keyframe)
+		key--;
+	for (s32 i = key; i <= index; i++)
+		apply(*m_state_list[i]);
+	m_reference_index = index;
 }
 
 
@@ -881,7 +1397,33 @@ state_entry::state_entry(void *data, const char *name, device_t *device, const c
 	, m_typesize(size)
 	, m_typecount(count)
 	, m_offset(0)
+	, m_dirty_pages(0)
+{
+}
+
+
+//-------------------------------------------------
+//  track_dirty - allocate page stamps; callers
+//  must not rely on pages written before this
+//-------------------------------------------------
+
+void state_entry::track_dirty()
+{
+	m_page_generation.assign(pages(), 0);
+	m_dirty_pages = 0;
+}
+
+
+//-------------------------------------------------
+//  scan_dirty - return the number of bytes in
+//  pages written since the previous scan
+//-------------------------------------------------
+
+u64 state_entry::scan_dirty()
 {
+	const u64 changed = std::min<u64>(u64(m_dirty_pages) << DIRTY_PAGE_SHIFT, m_typesize * m_typecount);
+	m_dirty_pages = 0;
+	return changed;
 }
 
 
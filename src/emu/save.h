@@ -71,6 +71,16 @@ public:
 	// helpers
 	void flip_data();
 
+	// dirty tracking, by stamping fixed-size pages as they are written
+	static constexpr u32 DIRTY_PAGE_SHIFT = 12;
+	static constexpr u32 DIRTY_PAGE_SIZE = 1 << DIRTY_PAGE_SHIFT;
+	void track_dirty();
+	bool tracked() const { return !m_page_generation.empty(); }
+	u32 pages() const { return (m_typesize * m_typecount + DIRTY_PAGE_SIZE - 1) >> DIRTY_PAGE_SHIFT; }
+	bool page_dirty(u32 page, u32 since) const { return m_page_generation[page] > since; }
+	void mark_dirty(u32 offset, u32 generation) { u32 &stamp = m_page_generation[offset >> DIRTY_PAGE_SHIFT]; if (stamp != generation) { stamp = generation; m_dirty_pages++; } }
+	u64 scan_dirty();
+
 	// state
 	void *          m_data;                 // pointer to the memory to save/restore
 	std::string     m_name;                 // full name
@@ -81,6 +91,8 @@ public:
 	u8              m_typesize;             // size of the raw data type
 	u32             m_typecount;            // number of items
 	u32             m_offset;               // offset within the final structure
+	std::vector<u32> m_page_generation;     // scan generation in which each page was last written
+	u32             m_dirty_pages;          // pages written since the last scan
 };
 
 class ram_state;
@@ -121,6 +133,7 @@ class save_manager
 public:
 	// construction/destruction
 	save_manager(running_machine &machine);
+	~save_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -178,11 +191,26 @@ public:
 	template<typename ItemType>
 	void save_pointer(ItemType *value, const char *valname, u32 count, int index = 0) { save_pointer(nullptr, "global", nullptr, index, value, valname, count); }
 
+	// dirty tracking
+	void track_dirty();
+	void track_dirty(address_space &space);
+	u32 scan_dirty();
+	u32 dirty_generation() const { return m_dirty_generation; }
+	u64 dirty_bytes() const { return m_dirty_bytes; }
+
 	// file processing
 	static save_error check_file(running_machine &machine, emu_file &file, const char *gamename, void (CLIB_DECL *errormsg)(const char *fmt, ...));
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// background file processing; the state is snapshotted or applied on
+	// this thread, while compression and I/O happen on a work queue
+	save_error write_file_async(std::unique_ptr<emu_file> &&file);
+	save_error read_file_async(std::unique_ptr<emu_file> &&file);
+	bool file_pending() const { return bool(m_file_job); }
+	bool file_ready() const;
+	save_error finish_file(bool apply = true);
+
 private:
 	// internal helpers
 	u32 signature() const;
@@ -199,11 +227,32 @@ private:
 		save_prepost_delegate m_func;                 // delegate
 	};
 
+	// a save file being written or read on a background thread
+	class file_job
+	{
+	public:
+		std::unique_ptr<emu_file> m_file;             // file being processed, closed by the worker
+		bool               m_load;                    // true if reading
+		const char *       m_gamename;                // system name the header must match when reading
+		u32                m_signature;               // registration signature the header must match when reading
+		std::vector<u8>    m_data;                    // header followed by uncompressed state data
+		save_error         m_result;                  // outcome of the I/O
+		osd_work_item *    m_item;                    // work item doing the I/O
+	};
+
+	save_error start_file_job(std::unique_ptr<emu_file> &&file, bool load);
+	void generate_header(u8 *header) const;
+	static void *file_job_callback(void *param, int threadid);
+
 	// internal state
 	running_machine &         m_machine;              // reference to our machine
 	std::unique_ptr<rewinder> m_rewind;               // rewinder
 	bool                      m_reg_allowed;          // are registrations allowed?
 	s32                       m_illegal_regs;         // number of illegal registrations
+	u32                       m_dirty_generation;     // number of dirty tracking scans so far
+	u64                       m_dirty_bytes;          // bytes that may have changed in the last scan
+	osd_work_queue *          m_file_queue;           // queue for background file I/O
+	std::unique_ptr<file_job> m_file_job;             // background file operation in progress
 
 	std::vector<std::unique_ptr<state_entry>>    m_entry_list;       // list of registered entries
 	std::vector<std::unique_ptr<ram_state>>      m_ramstate_list;    // list of ram states
@@ -228,14 +277,27 @@ public:
 
 class rewinder
 {
+	// a captured state, stored as a run-length encoded XOR against the state
+	// before it, or against zero for keyframes
+	class rewind_state
+	{
+	public:
+		bool               m_keyframe;                // true if this doesn't depend on earlier states
+		std::vector<u8>    m_data;                    // encoded data
+	};
+
 	save_manager & m_save;                            // reference to save_manager
 	bool           m_enabled;                         // enable rewind savestates
-	size_t         m_capacity;                        // total memory rewind states can occupy (MB, limited to 1-2048 in options)
+	size_t         m_capacity;                        // total memory encoded rewind states can occupy (MB, limited to 1-2048 in options)
+	size_t         m_total_size;                      // encoded size of all states in the list
 	s32            m_current_index;                   // where we are in time
-	s32            m_first_invalid_index;             // all states before this one are guarateed to be valid
 	bool           m_first_time_warning;              // keep track of warnings we report
 	bool           m_first_time_note;                 // keep track of notes
-	std::vector<std::unique_ptr<ram_state>> m_state_list; // rewinder's own ram states
+	std::vector<std::unique_ptr<rewind_state>> m_state_list; // rewinder's own states, oldest first
+	std::vector<u8> m_reference;                      // decoded image of the state at m_reference_index
+	s32            m_reference_index;                 // which state m_reference currently holds
+	u32            m_baseline_generation;             // dirty tracking generation when live state last matched m_reference
+	bool           m_baseline_valid;                  // false if m_reference has been changed since then
 
 	// load/save management
 	enum class rewind_operation
@@ -250,8 +312,13 @@ class rewinder
 		REWIND_INDEX_FIRST
 	};
 
+	static constexpr s32 KEYFRAME_INTERVAL = 16;     // maximum number of states per keyframe
+
 	bool check_size();
-	bool current_index_is_last() { return m_current_index == m_state_list.size() - 1; }
+	bool current_index_is_last() { return m_current_index == s32(m_state_list.size()) - 1; }
+	void encode(rewind_state &state, bool from_reference, bool use_tracking = false);
+	void apply(const rewind_state &state);
+	void reconstruct(s32 index);
 	void report_error(save_error type, rewind_operation operation);
 
 public:
@@ -56,7 +56,10 @@ emu_timer::emu_timer()
 		m_start(attotime::zero),
 		m_expire(attotime::never),
 		m_device(nullptr),
-		m_id(0)
+		m_id(0),
+		m_heap_expire(attotime::never),
+		m_heap_sequence(0),
+		m_heap_index(device_scheduler::timer_heap::npos)
 {
 }
 
@@ -97,6 +100,7 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 		register_save();
 
 	// insert into the list
+	assert(m_heap_index == device_scheduler::timer_heap::npos);
 	machine.scheduler().timer_list_insert(*this);
 	return *this;
 }
@@ -129,6 +133,7 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 		register_save();
 
 	// insert into the list
+	assert(m_heap_index == device_scheduler::timer_heap::npos);
 	machine().scheduler().timer_list_insert(*this);
 	return *this;
 }
@@ -160,9 +165,8 @@ bool emu_timer::enable(bool enable)
 		// set the enable flag
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		// queue or dequeue the timer
+		machine().scheduler().timer_heap_update(*this);
 	}
 	return old;
 }
@@ -194,12 +198,11 @@ void emu_timer::adjust(attotime start_delay, s32 param, const attotime &period)
 	m_expire = m_start + start_delay;
 	m_period = period;
 
-	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// re-queue the timer in its new order
+	scheduler.timer_heap_update(*this);
 
 	// if this was inserted as the head, abort the current timeslice and resync
-	if (this == scheduler.first_timer())
+	if (this == scheduler.next_timer())
 		scheduler.abort_timeslice();
 }
 
@@ -283,10 +286,8 @@ inline void emu_timer::schedule_next_period()
 	m_start = m_expire;
 	m_expire += m_period;
 
-	// remove and re-insert us
-	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// re-queue us
+	machine().scheduler().timer_heap_update(*this);
 }
 
 
@@ -323,15 +324,15 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
 	m_timer_list(nullptr),
+	m_timer_sequence(0),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
 	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
 {
-	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true);
-	m_timer_list->adjust(attotime::never);
+	// append a single never-expiring timer so there is always one in the heap
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -431,14 +432,14 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < m_timer_heap.top()->m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (m_timer_heap.top()->m_expire < target)
+			target = m_timer_heap.top()->m_expire;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string(PRECISION)));
@@ -671,25 +672,28 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
-	simple_list<emu_timer> private_list;
-	while (m_timer_list != nullptr)
+	// temporary timers go away entirely (except our special never-expiring one)
+	emu_timer *next;
+	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = next)
 	{
-		emu_timer &timer = *m_timer_list;
-
-		// temporary timers go away entirely (except our special never-expiring one)
-		if (timer.m_temporary && !timer.expire().is_never())
-			m_timer_allocator.reclaim(timer.release());
-
-		// permanent ones get added to our private list
-		else
-			private_list.append(timer_list_remove(timer));
+		next = timer->next();
+		if (timer->m_temporary && !timer->expire().is_never())
+			m_timer_allocator.reclaim(timer->release());
 	}
 
-	// now re-insert them; this effectively re-sorts them by time
-	emu_timer *timer;
-	while ((timer = private_list.detach_head()) != nullptr)
-		timer_list_insert(*timer);
+	// drain the heap in its old order, then re-queue everything; this effectively
+	// re-sorts by time while keeping the previous order for equal expiration times
+	std::vector<emu_timer *> private_list;
+	private_list.reserve(m_timer_heap.size());
+	while (!m_timer_heap.empty())
+		private_list.push_back(m_timer_heap.pop());
+	for (emu_timer *timer : private_list)
+		timer_heap_update(*timer);
+
+	// timers that were disabled before loading may have been enabled by it
+	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = timer->next())
+		if (!timer_heap::contains(*timer))
+			timer_heap_update(*timer);
 
 	m_suspend_changes_pending = true;
 	rebuild_execute_list();
@@ -815,55 +819,35 @@ void device_scheduler::rebuild_execute_list()
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  timer_list_insert - add a new timer to the
+//  list of all timers and queue it if enabled
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
 {
-	// disabled timers sort to the end
-	const attotime &expire = timer.m_enabled ? timer.m_expire : attotime::never;
-
-	// loop over the timer list
-	emu_timer *prevtimer = nullptr;
-	for (emu_timer *curtimer = m_timer_list; curtimer != nullptr; prevtimer = curtimer, curtimer = curtimer->next())
-	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
-		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
-
-			if (curtimer->m_prev != nullptr)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
-
-			curtimer->m_prev = &timer;
-			return timer;
-		}
-	}
-
-	// need to insert after the last one
-	if (prevtimer != nullptr)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
+	// the list is unordered, so just link it in at the head
+	timer.m_prev = nullptr;
+	timer.m_next = m_timer_list;
+	if (m_timer_list != nullptr)
+		m_timer_list->m_prev = &timer;
+	m_timer_list = &timer;
 
-	timer.m_prev = prevtimer;
-	timer.m_next = nullptr;
+	timer_heap_update(timer);
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  list of all timers and from the heap
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
+	// dequeue it if it's pending
+	if (timer_heap::contains(timer))
+		m_timer_heap.remove(timer);
+
 	// remove it from the list
 	if (timer.m_prev != nullptr)
 		timer.m_prev->m_next = timer.m_next;
@@ -877,19 +861,46 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 }
 
 
+//-------------------------------------------------
+//  timer_heap_update - (re)queue a timer after
+//  its expiration time or enable state changed
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_update(emu_timer &timer)
+{
+	// disabled timers are not queued at all
+	if (!timer.m_enabled)
+	{
+		if (timer_heap::contains(timer))
+			m_timer_heap.remove(timer);
+		return;
+	}
+
+	// the key is captured here so later changes to the timer (e.g. by loading
+	// a saved state) can't corrupt the heap; ties fire in the order queued
+	timer.m_heap_expire = timer.m_expire;
+	timer.m_heap_sequence = m_timer_sequence++;
+	if (timer_heap::contains(timer))
+		m_timer_heap.update(timer);
+	else
+		m_timer_heap.push(timer);
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
 
 inline void device_scheduler::execute_timers()
 {
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION)));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_heap.top()->m_expire.as_string(PRECISION)));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (m_timer_heap.top()->m_expire <= m_basetime)
 	{
-		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		// if this is a one-shot timer, disable it now; it stays at the head of
+		// the heap until it is rescheduled below or by the callback
+		emu_timer &timer = *m_timer_heap.top();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -989,7 +1000,14 @@ void device_scheduler::dump_timers() const
 {
 	machine().logerror("=============================================\n");
 	machine().logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
-	for (emu_timer *timer = first_timer(); timer != nullptr; timer = timer->next())
+
+	// the heap is only partially ordered, so sort a copy; disabled timers go at the end
+	std::vector<emu_timer *> queued(m_timer_heap.begin(), m_timer_heap.end());
+	std::sort(queued.begin(), queued.end(), [] (const emu_timer *a, const emu_timer *b) { return emu_timer::heap_traits::less(*a, *b); });
+	for (emu_timer *timer : queued)
 		timer->dump();
+	for (emu_timer *timer = first_timer(); timer != nullptr; timer = timer->next())
+		if (!timer_heap::contains(*timer))
+			timer->dump();
 	machine().logerror("=============================================\n");
 }
@@ -63,7 +63,7 @@ class emu_timer
 
 public:
 	// getters
-	emu_timer *next() const { return m_next; }
+	emu_timer *next() const { return m_next; } // next allocated timer, in no particular order
 	running_machine &machine() const { assert(m_machine != nullptr); return *m_machine; }
 	bool enabled() const { return m_enabled; }
 	int param() const { return m_param; }
@@ -91,10 +91,17 @@ private:
 	void schedule_next_period();
 	void dump() const;
 
+	// ordering for the scheduler's timer heap
+	struct heap_traits
+	{
+		static bool less(const emu_timer &a, const emu_timer &b) { return (a.m_heap_expire < b.m_heap_expire) || ((a.m_heap_expire == b.m_heap_expire) && (a.m_heap_sequence < b.m_heap_sequence)); }
+		static std::size_t &index(emu_timer &timer) { return timer.m_heap_index; }
+	};
+
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the list of all timers
+	emu_timer *         m_prev;         // previous timer in the list of all timers
 	timer_expired_delegate m_callback;  // callback function
 	s32                 m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -105,6 +112,9 @@ private:
 	attotime            m_expire;       // time when the timer will expire
 	device_t *          m_device;       // for device timers, a pointer to the device
 	device_timer_id     m_id;           // for device timers, the ID of the timer
+	attotime            m_heap_expire;  // expiration time when last queued
+	u64                 m_heap_sequence;// queueing order, to break ties between equal expiration times
+	std::size_t         m_heap_index;   // position in the timer heap, or npos if not queued
 };
 
 
@@ -124,6 +134,7 @@ public:
 	running_machine &machine() const { return m_machine; }
 	attotime time() const;
 	emu_timer *first_timer() const { return m_timer_list; }
+	emu_timer *next_timer() const { return m_timer_heap.top(); }
 	device_execute_interface *currently_executing() const { return m_executing_device; }
 	bool can_save() const;
 
@@ -164,6 +175,7 @@ private:
 	// timer helpers
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	void timer_heap_update(emu_timer &timer);
 	void execute_timers();
 
 	// internal state
@@ -172,8 +184,11 @@ private:
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// timers
+	typedef util::intrusive_heap<emu_timer, emu_timer::heap_traits> timer_heap;
+	emu_timer *                 m_timer_list;               // head of the list of all allocated timers
+	timer_heap                  m_timer_heap;               // enabled timers, ordered by expiration time
+	u64                         m_timer_sequence;           // sequence number for the next queued timer
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
 	// other internal states
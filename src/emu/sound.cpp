@@ -15,6 +15,11 @@
 #include "config.h"
 #include "wavwrite.h"
 
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define SOUND_MIX_SSE2 1
+#endif
+
 
 
 //**************************************************************************
@@ -58,7 +63,6 @@ sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample
 		m_max_samples_per_update(0),
 		m_input(inputs),
 		m_input_array(inputs),
-		m_resample_bufalloc(0),
 		m_output(outputs),
 		m_output_array(outputs),
 		m_output_bufalloc(0),
@@ -501,8 +505,7 @@ void sound_stream::recompute_sample_rate_data()
 		m_max_samples_per_update = 0;
 	}
 
-	// update resample and output buffer sizes
-	allocate_resample_buffers();
+	// update output buffer sizes
 	allocate_output_buffers();
 
 	// iterate over each input
@@ -526,6 +529,18 @@ void sound_stream::recompute_sample_rate_data()
 			else if (input.m_source->m_stream->m_sample_rate == m_sample_rate)
 				latency = 0;
 
+			// pick a resampler; filters that look further ahead add to the latency, and
+			// fall back to linear if that would take more than half an update
+			input.m_resampler = sound_resampler::create(m_device.machine().options().resampler(), input.m_source->m_stream->m_sample_rate, m_sample_rate);
+			if (input.m_resampler)
+			{
+				attoseconds_t const lookahead = input.m_resampler->lookahead() * new_attosecs_per_sample;
+				if (latency + lookahead < update_attoseconds / 2)
+					latency += lookahead;
+				else
+					input.m_resampler.reset();
+			}
+
 			// we generally don't want to tweak the latency, so we just keep the greatest
 			// one we've computed thus far
 			input.m_latency_attoseconds = std::max(input.m_latency_attoseconds, latency);
@@ -552,32 +567,6 @@ void sound_stream::recompute_sample_rate_data()
 }
 
 
-//-------------------------------------------------
-//  allocate_resample_buffers - recompute the
-//  resample buffer sizes and expand if necessary
-//-------------------------------------------------
-
-void sound_stream::allocate_resample_buffers()
-{
-	// compute the target number of samples
-	s32 bufsize = 2 * m_max_samples_per_update;
-
-	// if we don't have enough room, allocate more
-	if (m_resample_bufalloc < bufsize)
-	{
-		// this becomes the new allocation size
-		m_resample_bufalloc = bufsize;
-
-		// iterate over outputs and realloc their buffers
-		for (auto & elem : m_input) {
-			unsigned int old_size = elem.m_resample.size();
-			elem.m_resample.resize(m_resample_bufalloc);
-			memset(&elem.m_resample[old_size], 0, (m_resample_bufalloc - old_size)*sizeof(elem.m_resample[0]));
-		}
-	}
-}
-
-
 //-------------------------------------------------
 //  allocate_output_buffers - recompute the
 //  output buffer sizes and expand if necessary
@@ -637,6 +626,10 @@ void sound_stream::generate_samples(int samples)
 	VPRINTF(("generate_samples(%p, %d)\n", (void *) this, samples));
 	assert(samples > 0);
 
+	// resampled inputs come from the pool, and go back once the callback is done
+	stream_buffer_pool &pool = m_device.machine().sound().m_buffer_pool;
+	u32 const poolmark = pool.mark();
+
 	// ensure all inputs are up to date and generate resampled data
 	for (unsigned int inputnum = 0; inputnum < m_input.size(); inputnum++)
 	{
@@ -670,6 +663,7 @@ void sound_stream::generate_samples(int samples)
 	VPRINTF(("  callback(%p, %d)\n", (void *)this, samples));
 	m_callback(*this, inputs, outputs, samples);
 	VPRINTF(("  callback done\n"));
+	pool.release(poolmark);
 }
 
 
@@ -681,11 +675,11 @@ void sound_stream::generate_samples(int samples)
 stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, u32 numsamples)
 {
 	// if we don't have an output to pull data from, generate silence
-	stream_sample_t *dest = &input.m_resample[0];
+	stream_sample_t *dest = m_device.machine().sound().m_buffer_pool.acquire(numsamples);
 	if (input.m_source == nullptr || input.m_source->m_stream->m_attoseconds_per_sample == 0)
 	{
 		memset(dest, 0, numsamples * sizeof(*dest));
-		return &input.m_resample[0];
+		return dest;
 	}
 
 	// grab data from the output
@@ -716,80 +710,14 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, u32
 	// compute the stepping fraction
 	u32 step = (u64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
 
-	// if we have equal sample rates, we just need to copy
-	if (step == FRAC_ONE)
-	{
-		while (numsamples--)
-		{
-			// compute the sample
-			s64 sample = *source++;
-			*dest++ = (sample * gain) >> 8;
-		}
-	}
-
-	// input is undersampled: point sample except where our sample period covers a boundary
-	else if (step < FRAC_ONE)
-	{
-		while (numsamples != 0)
-		{
-			// fill in with point samples until we hit a boundary
-			int nextfrac;
-			while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
-			{
-				*dest++ = (source[0] * gain) >> 8;
-				basefrac = nextfrac;
-			}
-
-			// if we're done, we're done
-			if (s32(numsamples--) < 0)
-				break;
-
-			// compute starting and ending fractional positions
-			int startfrac = basefrac >> (FRAC_BITS - 12);
-			int endfrac = nextfrac >> (FRAC_BITS - 12);
-
-			// blend between the two samples accordingly
-			s64 sample = (s64(source[0]) * (0x1000 - startfrac) + s64(source[1]) * (endfrac - 0x1000)) / (endfrac - startfrac);
-			*dest++ = (sample * gain) >> 8;
-
-			// advance
-			basefrac = nextfrac & FRAC_MASK;
-			source++;
-		}
-	}
-
-	// input is oversampled: sum the energy
+	// use the input's resampler if there's enough history in the buffer for it; linear
+	// is called directly, so the default path doesn't pay for a virtual call
+	if (input.m_resampler && (basesample - input_stream.m_output_base_sampindex >= s32(input.m_resampler->history())))
+		input.m_resampler->resample(dest, source, basefrac, step, gain, numsamples);
 	else
-	{
-		// use 8 bits to allow some extra headroom
-		int smallstep = step >> (FRAC_BITS - 8);
-		while (numsamples--)
-		{
-			s64 remainder = smallstep;
-			int tpos = 0;
-
-			// compute the sample
-			s64 scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
-			s64 sample = s64(source[tpos++]) * scale;
-			remainder -= scale;
-			while (remainder > 0x100)
-			{
-				sample += s64(source[tpos++]) * s64(0x100);
-				remainder -= 0x100;
-			}
-			sample += s64(source[tpos]) * remainder;
-			sample /= smallstep;
-
-			*dest++ = (sample * gain) >> 8;
-
-			// advance
-			basefrac += step;
-			source += basefrac >> FRAC_BITS;
-			basefrac &= FRAC_MASK;
-		}
-	}
+		linear_resampler::convert(dest, source, basefrac, step, gain, numsamples);
 
-	return &input.m_resample[0];
+	return dest;
 }
 
 
@@ -829,6 +757,27 @@ sound_stream::stream_output::stream_output()
 
 
 
+//**************************************************************************
+//  STREAM BUFFER POOL
+//**************************************************************************
+
+//-------------------------------------------------
+//  acquire - hand out the next free buffer,
+//  growing it if it's too small
+//-------------------------------------------------
+
+stream_sample_t *stream_buffer_pool::acquire(u32 samples)
+{
+	if (m_used == m_buffers.size())
+		m_buffers.emplace_back();
+	std::vector<stream_sample_t> &buffer = m_buffers[m_used++];
+	if (buffer.size() < samples)
+		buffer.resize(samples);
+	return &buffer[0];
+}
+
+
+
 //**************************************************************************
 //  SOUND MANAGER
 //**************************************************************************
@@ -1093,12 +1042,18 @@ void sound_manager::update(void *ptr, int param)
 	for (speaker_device &speaker : speaker_device_iterator(machine().root_device()))
 		speaker.mix(&m_leftmix[0], &m_rightmix[0], samples_this_update, (m_muted & MUTE_REASON_SYSTEM));
 
-	// now downmix the final result
+	// now downmix the final result; at normal speed that's a straight clamp
 	u32 finalmix_step = machine().video().speed_factor();
 	u32 finalmix_offset = 0;
 	s16 *finalmix = &m_finalmix[0];
-	int sample;
-	for (sample = m_finalmix_leftover; sample < samples_this_update * 1000; sample += finalmix_step)
+	int sample = m_finalmix_leftover;
+	if (finalmix_step == 1000 && sample == 0)
+	{
+		clamp_interleave(finalmix, &m_leftmix[0], &m_rightmix[0], samples_this_update);
+		finalmix_offset = samples_this_update * 2;
+		sample = samples_this_update * 1000;
+	}
+	for ( ; sample < samples_this_update * 1000; sample += finalmix_step)
 	{
 		int sampindex = sample / 1000;
 
@@ -1153,3 +1108,29 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.stop();
 }
+
+
+//-------------------------------------------------
+//  clamp_interleave - clamp left and right mixes
+//  to 16 bits and interleave them
+//-------------------------------------------------
+
+void sound_manager::clamp_interleave(s16 *dest, const s32 *left, const s32 *right, int samples)
+{
+#if defined(SOUND_MIX_SSE2)
+	// saturating packs do the clamping
+	for ( ; samples >= 8; samples -= 8, left += 8, right += 8, dest += 16)
+	{
+		const __m128i l = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(left)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(left + 4)));
+		const __m128i r = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(right)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(right + 4)));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_unpacklo_epi16(l, r));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + 8), _mm_unpackhi_epi16(l, r));
+	}
+#endif
+
+	while (samples-- > 0)
+	{
+		*dest++ = std::max<s32>(-32768, std::min<s32>(32767, *left++));
+		*dest++ = std::max<s32>(-32768, std::min<s32>(32767, *right++));
+	}
+}
@@ -45,6 +45,27 @@ struct mixer_input
 };
 
 
+// ======================> stream_buffer_pool
+
+// scratch buffers for resampled stream inputs; since stream updates nest, they
+// are handed out and given back in stack order
+class stream_buffer_pool
+{
+public:
+	// construction/destruction
+	stream_buffer_pool() : m_used(0) { }
+
+	// buffers acquired after a mark are all released together
+	stream_sample_t *acquire(u32 samples);
+	u32 mark() const { return m_used; }
+	void release(u32 mark) { assert(mark <= m_used); m_used = mark; }
+
+private:
+	std::vector<std::vector<stream_sample_t>> m_buffers; // every buffer allocated so far
+	u32                 m_used;                 // how many of them are in use
+};
+
+
 // ======================> sound_stream
 
 class sound_stream
@@ -78,7 +99,7 @@ class sound_stream
 
 		// internal state
 		stream_output *     m_source;               // pointer to the sound_output for this source
-		std::vector<stream_sample_t> m_resample;  // buffer for resampling to the stream's sample rate
+		std::unique_ptr<sound_resampler> m_resampler; // converter from the source's sample rate, or nullptr for linear
 		attoseconds_t       m_latency_attoseconds;  // latency between this stream and the input stream
 		s16               m_gain;                 // gain to apply to this input
 		s16               m_user_gain;            // user-controlled gain to apply to this input
@@ -86,9 +107,9 @@ class sound_stream
 
 	// constants
 	static constexpr int OUTPUT_BUFFER_UPDATES  = 5;
-	static constexpr u32 FRAC_BITS              = 22;
-	static constexpr u32 FRAC_ONE               = 1 << FRAC_BITS;
-	static constexpr u32 FRAC_MASK              = FRAC_ONE - 1;
+	static constexpr u32 FRAC_BITS              = sound_resampler::FRAC_BITS;
+	static constexpr u32 FRAC_ONE               = sound_resampler::FRAC_ONE;
+	static constexpr u32 FRAC_MASK              = sound_resampler::FRAC_MASK;
 
 public:
 	// construction/destruction
@@ -127,7 +148,6 @@ private:
 
 	// internal helpers
 	void recompute_sample_rate_data();
-	void allocate_resample_buffers();
 	void allocate_output_buffers();
 	void postload();
 	void generate_samples(int samples);
@@ -152,9 +172,6 @@ private:
 	std::vector<stream_input> m_input;              // list of streams we directly depend upon
 	std::vector<stream_sample_t *> m_input_array;   // array of inputs for passing to the callback
 
-	// resample buffer information
-	u32                 m_resample_bufalloc;          // allocated size of each resample buffer
-
 	// output information
 	std::vector<stream_output> m_output;            // list of streams which directly depend upon us
 	std::vector<stream_sample_t *> m_output_array;  // array of outputs for passing to the callback
@@ -224,6 +241,7 @@ private:
 	void config_save(config_type cfg_type, util::xml::data_node *parentnode);
 
 	void update(void *ptr = nullptr, s32 param = 0);
+	static void clamp_interleave(s16 *dest, const s32 *left, const s32 *right, int samples);
 
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
@@ -233,6 +251,7 @@ private:
 	std::vector<s16>    m_finalmix;
 	std::vector<s32>    m_leftmix;
 	std::vector<s32>    m_rightmix;
+	stream_buffer_pool  m_buffer_pool;          // scratch buffers for resampled stream inputs
 
 	u8                  m_muted;
 	int                 m_attenuation;
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "screen.h"
 
 
@@ -700,6 +701,7 @@ inline void tilemap_t::realize_all_dirty_tiles()
 	{
 		memset(&m_tileflags[0], TILE_FLAG_DIRTY, m_tileflags.size());
 		m_all_tiles_dirty = false;
+		m_all_tiles_clean = false;
 		m_gfx_used = 0;
 	}
 }
@@ -948,14 +950,102 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	blit_parameters blit;
 	configure_blit_parameters(blit, screen.priority(), cliprect, flags, priority, priority_mask);
 
-	// flush the dirty state to all tiles as appropriate
-	realize_all_dirty_tiles();
-
 	// flip the tilemap around the center of the visible area
 	rectangle visarea = screen.visible_area();
 	u32 width = visarea.left() + visarea.right() + 1;
 	u32 height = visarea.top() + visarea.bottom() + 1;
 
+	// flush the dirty state to all tiles as appropriate
+	realize_all_dirty_tiles();
+
+	// tall draws are split into horizontal bands; each band owns its
+	// scanlines of both the destination and the priority bitmap
+	int const bands = m_manager->draw_bands(blit.cliprect);
+	if (bands > 1)
+	{
+		// the tile callbacks run driver code, so bring the tiles the
+		// bands will read up to date here rather than on the worker threads
+		blit_parameters update = blit;
+		for_each_instance(update, width, height, [this, &update] (int xpos, int ypos) { instance_update(update.cliprect, xpos, ypos); });
+
+		draw_band band[tilemap_manager::MAX_BANDS];
+		int const top = blit.cliprect.top();
+		int const lines = blit.cliprect.height();
+		for (int bandnum = 0; bandnum < bands; bandnum++)
+		{
+			band[bandnum].tilemap = this;
+			band[bandnum].screen = &screen;
+			band[bandnum].dest = &dest;
+			band[bandnum].blit = blit;
+			band[bandnum].blit.cliprect.sety(top + lines * bandnum / bands, top + lines * (bandnum + 1) / bands - 1);
+			band[bandnum].width = width;
+			band[bandnum].height = height;
+		}
+
+		// the first band is drawn on this thread while the others run; a
+		// band that can't be queued is drawn here too
+		osd_work_item *item[tilemap_manager::MAX_BANDS];
+		for (int bandnum = 1; bandnum < bands; bandnum++)
+		{
+			item[bandnum] = osd_work_item_queue(m_manager->draw_queue(), draw_band_callback<_BitmapClass>, &band[bandnum], 0);
+			if (item[bandnum] == nullptr)
+				draw_band_callback<_BitmapClass>(&band[bandnum], 0);
+		}
+		draw_band_callback<_BitmapClass>(&band[0], 0);
+
+		// the workers read the bands from this stack frame, so there is no
+		// leaving before each of them is done
+		for (int bandnum = 1; bandnum < bands; bandnum++)
+			if (item[bandnum] != nullptr)
+			{
+				while (!osd_work_item_wait(item[bandnum], osd_ticks_per_second() * 100))
+					osd_printf_warning("tilemap_t::draw: still waiting for a banded draw to complete\n");
+				osd_work_item_release(item[bandnum]);
+			}
+	}
+	else
+		draw_region(screen, dest, blit, width, height);
+g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  draw_band_callback - work item callback for
+//  drawing one band of a tilemap
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void *tilemap_t::draw_band_callback(void *param, int threadid)
+{
+	draw_band &band = *reinterpret_cast<draw_band *>(param);
+	band.tilemap->draw_region(*band.screen, *reinterpret_cast<_BitmapClass *>(band.dest), band.blit, band.width, band.height);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  draw_region - draw the tilemap within the
+//  blit cliprect
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void tilemap_t::draw_region(screen_device &screen, _BitmapClass &dest, blit_parameters &blit, u32 width, u32 height)
+{
+	for_each_instance(blit, width, height, [this, &screen, &dest, &blit] (int xpos, int ypos) { draw_instance(screen, dest, blit, xpos, ypos); });
+}
+
+
+//-------------------------------------------------
+//  for_each_instance - call func with the
+//  position of each instance of the tilemap that
+//  falls inside the blit cliprect in whichever
+//  scroll mode is active; blit.cliprect is
+//  narrowed to the instance's rows or columns
+//-------------------------------------------------
+
+template<typename _Func>
+void tilemap_t::for_each_instance(blit_parameters &blit, u32 width, u32 height, _Func &&func)
+{
 	// XY scrolling playfield
 	if (m_scrollrows == 1 && m_scrollcols == 1)
 	{
@@ -964,10 +1054,11 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 		int scrolly = effective_colscroll(0, height);
 		for (int ypos = scrolly - m_height; ypos <= blit.cliprect.bottom(); ypos += m_height)
 			for (int xpos = scrollx - m_width; xpos <= blit.cliprect.right(); xpos += m_width)
-				draw_instance(screen, dest, blit, xpos, ypos);
+				func(xpos, ypos);
 	}
 
-	// scrolling rows + vertical scroll
+	// scrolling rows + vertical scroll; this also handles rows narrower
+	// than a tile, where drawing a scanline at a time measured no faster
 	else if (m_scrollcols == 1)
 	{
 		const rectangle original_cliprect = blit.cliprect;
@@ -1000,7 +1091,7 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 
 				// iterate over X to handle wraparound
 				for (int xpos = scrollx - m_width; xpos <= original_cliprect.right(); xpos += m_width)
-					draw_instance(screen, dest, blit, xpos, ypos);
+					func(xpos, ypos);
 			}
 		}
 	}
@@ -1035,11 +1126,10 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 
 				// iterate over Y to handle wraparound
 				for (int ypos = scrolly - m_height; ypos <= original_cliprect.bottom(); ypos += m_height)
-					draw_instance(screen, dest, blit, xpos, ypos);
+					func(xpos, ypos);
 			}
 		}
 	}
-g_profiler.stop();
 }
 
 void tilemap_t::draw(screen_device &screen, bitmap_ind16 &dest, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask)
@@ -1102,6 +1192,37 @@ void tilemap_t::draw_roz(screen_device &screen, bitmap_rgb32 &dest, const rectan
 { draw_roz_common(screen, dest, cliprect, startx, starty, incxx, incxy, incyx, incyy, wraparound, flags, priority, priority_mask); }
 
 
+//-------------------------------------------------
+//  instance_update - update the dirty tiles that
+//  draw_instance would read for an instance at
+//  xpos,ypos clipped to cliprect
+//-------------------------------------------------
+
+void tilemap_t::instance_update(const rectangle &cliprect, int xpos, int ypos)
+{
+	// clip to the tilemap, as draw_instance does; x2/y2 are exclusive
+	int const x1 = (std::max)(xpos, cliprect.left()) - xpos;
+	int const x2 = (std::min)(xpos + int(m_width), cliprect.right() + 1) - xpos;
+	int const y1 = (std::max)(ypos, cliprect.top()) - ypos;
+	int const y2 = (std::min)(ypos + int(m_height), cliprect.bottom() + 1) - ypos;
+	if (x1 >= x2 || y1 >= y2)
+		return;
+
+	// update the tiles covered, rounding outward
+	u32 const mincol = x1 / m_tilewidth;
+	u32 const maxcol = (x2 + m_tilewidth - 1) / m_tilewidth;
+	u32 const minrow = y1 / m_tileheight;
+	u32 const maxrow = (y2 + m_tileheight - 1) / m_tileheight;
+	for (u32 row = minrow; row < maxrow; row++)
+	{
+		logical_index logindex = row * m_cols + mincol;
+		for (u32 col = mincol; col < maxcol; col++, logindex++)
+			if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
+				tile_update(logindex, col, row);
+	}
+}
+
+
 //-------------------------------------------------
 //  draw_instance - draw a single instance of the
 //  tilemap to the internal pixmap at the given
@@ -1512,8 +1633,17 @@ void tilemap_t::get_info_debug(u32 col, u32 row, u8 &gfxnum, u32 &code, u32 &col
 
 tilemap_manager::tilemap_manager(running_machine &machine)
 	: m_machine(machine),
-		m_instance(0)
+		m_instance(0),
+		m_max_bands(1),
+		m_draw_queue(nullptr)
 {
+	// banded drawing uses as many threads as the OSD gives the queue
+	if (machine.options().tilemap_bands())
+	{
+		m_draw_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+		if (m_draw_queue != nullptr)
+			m_max_bands = std::min(osd_work_queue_threads(m_draw_queue), MAX_BANDS);
+	}
 }
 
 
@@ -1537,6 +1667,9 @@ tilemap_manager::~tilemap_manager()
 				break;
 			}
 	}
+
+	if (m_draw_queue != nullptr)
+		osd_work_queue_free(m_draw_queue);
 }
 
 
@@ -1596,6 +1729,17 @@ void tilemap_manager::mark_all_dirty()
 }
 
 
+//-------------------------------------------------
+//  draw_bands - return how many bands to split a
+//  draw into
+//-------------------------------------------------
+
+int tilemap_manager::draw_bands(const rectangle &cliprect) const
+{
+	return std::max(std::min(cliprect.height() / MIN_BAND_HEIGHT, m_max_bands), 1);
+}
+
+
 
 //**************************************************************************
 //  TILEMAP DEVICE
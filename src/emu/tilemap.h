@@ -585,6 +585,17 @@ private:
 		u8                  alpha;
 	};
 
+	// one horizontal band of a threaded draw
+	struct draw_band
+	{
+		tilemap_t *         tilemap;
+		screen_device *     screen;
+		void *              dest;
+		blit_parameters     blit;
+		u32                 width;
+		u32                 height;
+	};
+
 	// inline helpers
 	s32 effective_rowscroll(int index, u32 screen_width);
 	s32 effective_colscroll(int index, u32 screen_height);
@@ -614,7 +625,11 @@ private:
 	void configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &priority_bitmap, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_roz_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound, u32 flags, u8 priority, u8 priority_mask);
+	template<class _BitmapClass> void draw_region(screen_device &screen, _BitmapClass &dest, blit_parameters &blit, u32 width, u32 height);
+	template<typename _Func> void for_each_instance(blit_parameters &blit, u32 width, u32 height, _Func &&func);
+	void instance_update(const rectangle &cliprect, int xpos, int ypos);
 	template<class _BitmapClass> void draw_instance(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos);
+	template<class _BitmapClass> static void *draw_band_callback(void *param, int threadid);
 	template<class _BitmapClass> void draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound);
 
 	// managers and devices
@@ -698,13 +713,23 @@ public:
 	void set_flip_all(u32 attributes);
 
 private:
+	// draws shorter than this many scanlines per band aren't worth splitting
+	static constexpr int MIN_BAND_HEIGHT = 32;
+	static constexpr int MAX_BANDS = 4;
+
 	// allocate an instance index
 	int alloc_instance() { return ++m_instance; }
 
+	// banded drawing
+	int draw_bands(const rectangle &cliprect) const;
+	osd_work_queue *draw_queue() const { return m_draw_queue; }
+
 	// internal state
 	running_machine &       m_machine;
 	simple_list<tilemap_t>  m_tilemap_list;
 	int                     m_instance;
+	int                     m_max_bands;            // most bands to split a draw into, 1 unless -tilemap_bands
+	osd_work_queue *        m_draw_queue;           // work queue for banded draws
 };
 
 
@@ -1471,6 +1471,26 @@ void lua_engine::initialize()
 						map.add(mapentry);
 					}
 					return map;
+				}),
+			"profile_start", [](addr_space &sp) { sp.space.profile_start(); },
+			"profile_stop", [](addr_space &sp) { sp.space.profile_stop(); },
+			"profile_reset", [](addr_space &sp) { sp.space.profile_reset(); },
+			"profiling", sol::property([](addr_space &sp) { return sp.space.profiling(); }),
+			"profile", sol::property([this](addr_space &sp) {
+					sol::table table = sol().create_table();
+					const double seconds = 1.0 / double(osd_ticks_per_second());
+					for (const auto &entry : sp.space.profile())
+					{
+						sol::table profentry = sol().create_table();
+						profentry["name"] = entry->m_name;
+						profentry["type"] = (entry->m_type == read_or_write::WRITE) ? "w" : "r";
+						profentry["offset"] = entry->m_start;
+						profentry["endoff"] = entry->m_end;
+						profentry["count"] = entry->m_count;
+						profentry["seconds"] = double(entry->m_ticks) * seconds;
+						table.add(profentry);
+					}
+					return table;
 				}));
 
 /* machine:ioport()
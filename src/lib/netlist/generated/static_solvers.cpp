@@ -0,0 +1,1202 @@
+// license:GPL-2.0+
+/*
+ * static_solvers.cpp
+ *
+ * Generated by "nltool -c static -o", do not edit.
+ *
+ */
+
+#include "../netlist_types.h"
+
+static void nl_gcr_260e13d5adc65b85_27(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+{
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+double m_A12 = m_A[12];
+double m_A13 = m_A[13];
+double m_A14 = m_A[14];
+double m_A15 = m_A[15];
+double m_A16 = m_A[16];
+double m_A17 = m_A[17];
+double m_A18 = m_A[18];
+double m_A19 = m_A[19];
+double m_A20 = m_A[20];
+double m_A21 = m_A[21];
+double m_A22 = m_A[22];
+double m_A23 = m_A[23];
+double m_A24 = m_A[24];
+double m_A25 = m_A[25];
+double m_A26 = m_A[26];
+const double f0 = 1.0 / m_A0;
+	const double f0_6 = -f0 * m_A13;
+	m_A15 += m_A1 * f0_6;
+	RHS[6] += f0_6 * RHS[0];
+const double f1 = 1.0 / m_A2;
+	const double f1_6 = -f1 * m_A14;
+	m_A15 += m_A3 * f1_6;
+	m_A16 += m_A4 * f1_6;
+	RHS[6] += f1_6 * RHS[1];
+	const double f1_8 = -f1 * m_A23;
+	m_A24 += m_A3 * f1_8;
+	m_A26 += m_A4 * f1_8;
+	RHS[8] += f1_8 * RHS[1];
+const double f2 = 1.0 / m_A5;
+	const double f2_7 = -f2 * m_A17;
+	m_A21 += m_A6 * f2_7;
+	RHS[7] += f2_7 * RHS[2];
+const double f3 = 1.0 / m_A7;
+	const double f3_7 = -f3 * m_A18;
+	m_A21 += m_A8 * f3_7;
+	RHS[7] += f3_7 * RHS[3];
+const double f4 = 1.0 / m_A9;
+	const double f4_7 = -f4 * m_A19;
+	m_A21 += m_A10 * f4_7;
+	RHS[7] += f4_7 * RHS[4];
+const double f5 = 1.0 / m_A11;
+	const double f5_7 = -f5 * m_A20;
+	m_A21 += m_A12 * f5_7;
+	RHS[7] += f5_7 * RHS[5];
+const double f6 = 1.0 / m_A15;
+	const double f6_8 = -f6 * m_A24;
+	m_A26 += m_A16 * f6_8;
+	RHS[8] += f6_8 * RHS[6];
+const double f7 = 1.0 / m_A21;
+	const double f7_8 = -f7 * m_A25;
+	m_A26 += m_A22 * f7_8;
+	RHS[8] += f7_8 * RHS[7];
+	V[8] = RHS[8] / m_A26;
+	double tmp7 = 0.0;
+	tmp7 += m_A22 * V[8];
+	V[7] = (RHS[7] - tmp7) / m_A21;
+	double tmp6 = 0.0;
+	tmp6 += m_A16 * V[8];
+	V[6] = (RHS[6] - tmp6) / m_A15;
+	double tmp5 = 0.0;
+	tmp5 += m_A12 * V[7];
+	V[5] = (RHS[5] - tmp5) / m_A11;
+	double tmp4 = 0.0;
+	tmp4 += m_A10 * V[7];
+	V[4] = (RHS[4] - tmp4) / m_A9;
+	double tmp3 = 0.0;
+	tmp3 += m_A8 * V[7];
+	V[3] = (RHS[3] - tmp3) / m_A7;
+	double tmp2 = 0.0;
+	tmp2 += m_A6 * V[7];
+	V[2] = (RHS[2] - tmp2) / m_A5;
+	double tmp1 = 0.0;
+	tmp1 += m_A3 * V[6];
+	tmp1 += m_A4 * V[8];
+	V[1] = (RHS[1] - tmp1) / m_A2;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[6];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+static void nl_gcr_2b052e2cee1cdc1a_250(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+{
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+double m_A12 = m_A[12];
+double m_A13 = m_A[13];
+double m_A14 = m_A[14];
+double m_A15 = m_A[15];
+double m_A16 = m_A[16];
+double m_A17 = m_A[17];
+double m_A18 = m_A[18];
+double m_A19 = m_A[19];
+double m_A20 = m_A[20];
+double m_A21 = m_A[21];
+double m_A22 = m_A[22];
+double m_A23 = m_A[23];
+double m_A24 = m_A[24];
+double m_A25 = m_A[25];
+double m_A26 = m_A[26];
+double m_A27 = m_A[27];
+double m_A28 = m_A[28];
+double m_A29 = m_A[29];
+double m_A30 = m_A[30];
+double m_A31 = m_A[31];
+double m_A32 = m_A[32];
+double m_A33 = m_A[33];
+double m_A34 = m_A[34];
+double m_A35 = m_A[35];
+double m_A36 = m_A[36];
+double m_A37 = m_A[37];
+double m_A38 = m_A[38];
+double m_A39 = m_A[39];
+double m_A40 = m_A[40];
+double m_A41 = m_A[41];
+double m_A42 = m_A[42];
+double m_A43 = m_A[43];
+double m_A44 = m_A[44];
+double m_A45 = m_A[45];
+double m_A46 = m_A[46];
+double m_A47 = m_A[47];
+double m_A48 = m_A[48];
+double m_A49 = m_A[49];
+double m_A50 = m_A[50];
+double m_A51 = m_A[51];
+double m_A52 = m_A[52];
+double m_A53 = m_A[53];
+double m_A54 = m_A[54];
+double m_A55 = m_A[55];
+double m_A56 = m_A[56];
+double m_A57 = m_A[57];
+double m_A58 = m_A[58];
+double m_A59 = m_A[59];
+double m_A60 = m_A[60];
+double m_A61 = m_A[61];
+double m_A62 = m_A[62];
+double m_A63 = m_A[63];
+double m_A64 = m_A[64];
+double m_A65 = m_A[65];
+double m_A66 = m_A[66];
+double m_A67 = m_A[67];
+double m_A68 = m_A[68];
+double m_A69 = m_A[69];
+double m_A70 = m_A[70];
+double m_A71 = m_A[71];
+double m_A72 = m_A[72];
+double m_A73 = m_A[73];
+double m_A74 = m_A[74];
+double m_A75 = m_A[75];
+double m_A76 = m_A[76];
+double m_A77 = m_A[77];
+double m_A78 = m_A[78];
+double m_A79 = m_A[79];
+double m_A80 = m_A[80];
+double m_A81 = m_A[81];
+double m_A82 = m_A[82];
+double m_A83 = m_A[83];
+double m_A84 = m_A[84];
+double m_A85 = m_A[85];
+double m_A86 = m_A[86];
+double m_A87 = m_A[87];
+double m_A88 = m_A[88];
+double m_A89 = m_A[89];
+double m_A90 = m_A[90];
+double m_A91 = m_A[91];
+double m_A92 = m_A[92];
+double m_A93 = m_A[93];
+double m_A94 = m_A[94];
+double m_A95 = m_A[95];
+double m_A96 = m_A[96];
+double m_A97 = m_A[97];
+double m_A98 = m_A[98];
+double m_A99 = m_A[99];
+double m_A100 = m_A[100];
+double m_A101 = m_A[101];
+double m_A102 = m_A[102];
+double m_A103 = m_A[103];
+double m_A104 = m_A[104];
+double m_A105 = m_A[105];
+double m_A106 = m_A[106];
+double m_A107 = m_A[107];
+double m_A108 = m_A[108];
+double m_A109 = m_A[109];
+double m_A110 = m_A[110];
+double m_A111 = m_A[111];
+double m_A112 = m_A[112];
+double m_A113 = m_A[113];
+double m_A114 = m_A[114];
+double m_A115 = m_A[115];
+double m_A116 = m_A[116];
+double m_A117 = m_A[117];
+double m_A118 = m_A[118];
+double m_A119 = m_A[119];
+double m_A120 = m_A[120];
+double m_A121 = m_A[121];
+double m_A122 = m_A[122];
+double m_A123 = m_A[123];
+double m_A124 = m_A[124];
+double m_A125 = m_A[125];
+double m_A126 = m_A[126];
+double m_A127 = m_A[127];
+double m_A128 = m_A[128];
+double m_A129 = m_A[129];
+double m_A130 = m_A[130];
+double m_A131 = m_A[131];
+double m_A132 = m_A[132];
+double m_A133 = m_A[133];
+double m_A134 = m_A[134];
+double m_A135 = m_A[135];
+double m_A136 = m_A[136];
+double m_A137 = m_A[137];
+double m_A138 = m_A[138];
+double m_A139 = m_A[139];
+double m_A140 = m_A[140];
+double m_A141 = m_A[141];
+double m_A142 = m_A[142];
+double m_A143 = m_A[143];
+double m_A144 = m_A[144];
+double m_A145 = m_A[145];
+double m_A146 = m_A[146];
+double m_A147 = m_A[147];
+double m_A148 = m_A[148];
+double m_A149 = m_A[149];
+double m_A150 = m_A[150];
+double m_A151 = m_A[151];
+double m_A152 = m_A[152];
+double m_A153 = m_A[153];
+double m_A154 = m_A[154];
+double m_A155 = m_A[155];
+double m_A156 = m_A[156];
+double m_A157 = m_A[157];
+double m_A158 = m_A[158];
+double m_A159 = m_A[159];
+double m_A160 = m_A[160];
+double m_A161 = m_A[161];
+double m_A162 = m_A[162];
+double m_A163 = m_A[163];
+double m_A164 = m_A[164];
+double m_A165 = m_A[165];
+double m_A166 = m_A[166];
+double m_A167 = m_A[167];
+double m_A168 = m_A[168];
+double m_A169 = m_A[169];
+double m_A170 = m_A[170];
+double m_A171 = m_A[171];
+double m_A172 = m_A[172];
+double m_A173 = m_A[173];
+double m_A174 = m_A[174];
+double m_A175 = m_A[175];
+double m_A176 = m_A[176];
+double m_A177 = m_A[177];
+double m_A178 = m_A[178];
+double m_A179 = m_A[179];
+double m_A180 = m_A[180];
+double m_A181 = m_A[181];
+double m_A182 = m_A[182];
+double m_A183 = m_A[183];
+double m_A184 = m_A[184];
+double m_A185 = m_A[185];
+double m_A186 = m_A[186];
+double m_A187 = m_A[187];
+double m_A188 = m_A[188];
+double m_A189 = m_A[189];
+double m_A190 = m_A[190];
+double m_A191 = m_A[191];
+double m_A192 = m_A[192];
+double m_A193 = m_A[193];
+double m_A194 = m_A[194];
+double m_A195 = m_A[195];
+double m_A196 = m_A[196];
+double m_A197 = m_A[197];
+double m_A198 = m_A[198];
+double m_A199 = m_A[199];
+double m_A200 = m_A[200];
+double m_A201 = m_A[201];
+double m_A202 = m_A[202];
+double m_A203 = m_A[203];
+double m_A204 = m_A[204];
+double m_A205 = m_A[205];
+double m_A206 = m_A[206];
+double m_A207 = m_A[207];
+double m_A208 = m_A[208];
+double m_A209 = m_A[209];
+double m_A210 = m_A[210];
+double m_A211 = m_A[211];
+double m_A212 = m_A[212];
+double m_A213 = m_A[213];
+double m_A214 = m_A[214];
+double m_A215 = m_A[215];
+double m_A216 = m_A[216];
+double m_A217 = m_A[217];
+double m_A218 = m_A[218];
+double m_A219 = m_A[219];
+double m_A220 = m_A[220];
+double m_A221 = m_A[221];
+double m_A222 = m_A[222];
+double m_A223 = m_A[223];
+double m_A224 = m_A[224];
+double m_A225 = m_A[225];
+double m_A226 = m_A[226];
+double m_A227 = m_A[227];
+double m_A228 = m_A[228];
+double m_A229 = m_A[229];
+double m_A230 = m_A[230];
+double m_A231 = m_A[231];
+double m_A232 = m_A[232];
+double m_A233 = m_A[233];
+double m_A234 = m_A[234];
+double m_A235 = m_A[235];
+double m_A236 = m_A[236];
+double m_A237 = m_A[237];
+double m_A238 = m_A[238];
+double m_A239 = m_A[239];
+double m_A240 = m_A[240];
+double m_A241 = m_A[241];
+double m_A242 = m_A[242];
+double m_A243 = m_A[243];
+double m_A244 = m_A[244];
+double m_A245 = m_A[245];
+double m_A246 = m_A[246];
+double m_A247 = m_A[247];
+double m_A248 = m_A[248];
+double m_A249 = m_A[249];
+const double f0 = 1.0 / m_A0;
+	const double f0_41 = -f0 * m_A118;
+	m_A119 += m_A1 * f0_41;
+	RHS[41] += f0_41 * RHS[0];
+const double f1 = 1.0 / m_A2;
+	const double f1_56 = -f1 * m_A193;
+	m_A195 += m_A3 * f1_56;
+	m_A197 += m_A4 * f1_56;
+	RHS[56] += f1_56 * RHS[1];
+const double f2 = 1.0 / m_A5;
+	const double f2_46 = -f2 * m_A136;
+	m_A137 += m_A6 * f2_46;
+	m_A138 += m_A7 * f2_46;
+	RHS[46] += f2_46 * RHS[2];
+	const double f2_56 = -f2 * m_A194;
+	m_A196 += m_A6 * f2_56;
+	m_A197 += m_A7 * f2_56;
+	RHS[56] += f2_56 * RHS[2];
+const double f3 = 1.0 / m_A8;
+	const double f3_52 = -f3 * m_A171;
+	m_A174 += m_A9 * f3_52;
+	RHS[52] += f3_52 * RHS[3];
+	const double f3_57 = -f3 * m_A199;
+	m_A201 += m_A9 * f3_57;
+	RHS[57] += f3_57 * RHS[3];
+const double f4 = 1.0 / m_A10;
+	const double f4_34 = -f4 * m_A85;
+	m_A87 += m_A11 * f4_34;
+	RHS[34] += f4_34 * RHS[4];
+const double f5 = 1.0 / m_A12;
+	const double f5_50 = -f5 * m_A158;
+	m_A160 += m_A13 * f5_50;
+	m_A161 += m_A14 * f5_50;
+	RHS[50] += f5_50 * RHS[5];
+	const double f5_52 = -f5 * m_A172;
+	m_A173 += m_A13 * f5_52;
+	m_A174 += m_A14 * f5_52;
+	RHS[52] += f5_52 * RHS[5];
+const double f6 = 1.0 / m_A15;
+	const double f6_35 = -f6 * m_A89;
+	m_A91 += m_A16 * f6_35;
+	RHS[35] += f6_35 * RHS[6];
+const double f7 = 1.0 / m_A17;
+	const double f7_36 = -f7 * m_A93;
+	m_A98 += m_A18 * f7_36;
+	RHS[36] += f7_36 * RHS[7];
+const double f8 = 1.0 / m_A19;
+	const double f8_34 = -f8 * m_A86;
+	m_A87 += m_A20 * f8_34;
+	m_A88 += m_A21 * f8_34;
+	RHS[34] += f8_34 * RHS[8];
+	const double f8_36 = -f8 * m_A94;
+	m_A97 += m_A20 * f8_36;
+	m_A98 += m_A21 * f8_36;
+	RHS[36] += f8_36 * RHS[8];
+const double f9 = 1.0 / m_A22;
+	const double f9_49 = -f9 * m_A152;
+	m_A156 += m_A23 * f9_49;
+	RHS[49] += f9_49 * RHS[9];
+const double f10 = 1.0 / m_A24;
+	const double f10_35 = -f10 * m_A90;
+	m_A91 += m_A25 * f10_35;
+	m_A92 += m_A26 * f10_35;
+	RHS[35] += f10_35 * RHS[10];
+	const double f10_53 = -f10 * m_A177;
+	m_A178 += m_A25 * f10_53;
+	m_A180 += m_A26 * f10_53;
+	RHS[53] += f10_53 * RHS[10];
+	const double f10_59 = -f10 * m_A211;
+	m_A213 += m_A25 * f10_59;
+	m_A215 += m_A26 * f10_59;
+	RHS[59] += f10_59 * RHS[10];
+const double f11 = 1.0 / m_A27;
+	const double f11_59 = -f11 * m_A212;
+	m_A215 += m_A28 * f11_59;
+	RHS[59] += f11_59 * RHS[11];
+const double f12 = 1.0 / m_A29;
+	const double f12_39 = -f12 * m_A108;
+	m_A111 += m_A30 * f12_39;
+	RHS[39] += f12_39 * RHS[12];
+const double f13 = 1.0 / m_A31;
+	const double f13_37 = -f13 * m_A101;
+	m_A103 += m_A32 * f13_37;
+	RHS[37] += f13_37 * RHS[13];
+const double f14 = 1.0 / m_A33;
+	const double f14_36 = -f14 * m_A95;
+	m_A96 += m_A34 * f14_36;
+	m_A98 += m_A35 * f14_36;
+	m_A99 += m_A36 * f14_36;
+	RHS[36] += f14_36 * RHS[14];
+	const double f14_49 = -f14 * m_A153;
+	m_A154 += m_A34 * f14_49;
+	m_A155 += m_A35 * f14_49;
+	m_A156 += m_A36 * f14_49;
+	RHS[49] += f14_49 * RHS[14];
+const double f15 = 1.0 / m_A37;
+	const double f15_37 = -f15 * m_A102;
+	m_A103 += m_A38 * f15_37;
+	m_A104 += m_A39 * f15_37;
+	m_A105 += m_A40 * f15_37;
+	RHS[37] += f15_37 * RHS[15];
+	const double f15_39 = -f15 * m_A109;
+	m_A110 += m_A38 * f15_39;
+	m_A111 += m_A39 * f15_39;
+	m_A112 += m_A40 * f15_39;
+	RHS[39] += f15_39 * RHS[15];
+	const double f15_51 = -f15 * m_A163;
+	m_A165 += m_A38 * f15_51;
+	m_A166 += m_A39 * f15_51;
+	m_A169 += m_A40 * f15_51;
+	RHS[51] += f15_51 * RHS[15];
+const double f16 = 1.0 / m_A41;
+	const double f16_60 = -f16 * m_A217;
+	m_A228 += m_A42 * f16_60;
+	RHS[60] += f16_60 * RHS[16];
+const double f17 = 1.0 / m_A43;
+	const double f17_60 = -f17 * m_A218;
+	m_A228 += m_A44 * f17_60;
+	RHS[60] += f17_60 * RHS[17];
+const double f18 = 1.0 / m_A45;
+	const double f18_44 = -f18 * m_A126;
+	m_A129 += m_A46 * f18_44;
+	RHS[44] += f18_44 * RHS[18];
+const double f19 = 1.0 / m_A47;
+	const double f19_40 = -f19 * m_A113;
+	m_A115 += m_A48 * f19_40;
+	RHS[40] += f19_40 * RHS[19];
+const double f20 = 1.0 / m_A49;
+	const double f20_45 = -f20 * m_A131;
+	m_A134 += m_A50 * f20_45;
+	RHS[45] += f20_45 * RHS[20];
+const double f21 = 1.0 / m_A51;
+	const double f21_48 = -f21 * m_A146;
+	m_A149 += m_A52 * f21_48;
+	RHS[48] += f21_48 * RHS[21];
+const double f22 = 1.0 / m_A53;
+	const double f22_45 = -f22 * m_A132;
+	m_A134 += m_A54 * f22_45;
+	RHS[45] += f22_45 * RHS[22];
+const double f23 = 1.0 / m_A55;
+	const double f23_47 = -f23 * m_A140;
+	m_A142 += m_A56 * f23_47;
+	m_A144 += m_A57 * f23_47;
+	RHS[47] += f23_47 * RHS[23];
+	const double f23_51 = -f23 * m_A164;
+	m_A167 += m_A56 * f23_51;
+	m_A169 += m_A57 * f23_51;
+	RHS[51] += f23_51 * RHS[23];
+const double f24 = 1.0 / m_A58;
+	const double f24_60 = -f24 * m_A219;
+	m_A228 += m_A59 * f24_60;
+	RHS[60] += f24_60 * RHS[24];
+const double f25 = 1.0 / m_A60;
+	const double f25_60 = -f25 * m_A220;
+	m_A228 += m_A61 * f25_60;
+	RHS[60] += f25_60 * RHS[25];
+const double f26 = 1.0 / m_A62;
+	const double f26_60 = -f26 * m_A221;
+	m_A228 += m_A63 * f26_60;
+	RHS[60] += f26_60 * RHS[26];
+const double f27 = 1.0 / m_A64;
+	const double f27_40 = -f27 * m_A114;
+	m_A115 += m_A65 * f27_40;
+	m_A116 += m_A66 * f27_40;
+	m_A117 += m_A67 * f27_40;
+	RHS[40] += f27_40 * RHS[27];
+	const double f27_44 = -f27 * m_A127;
+	m_A128 += m_A65 * f27_44;
+	m_A129 += m_A66 * f27_44;
+	m_A130 += m_A67 * f27_44;
+	RHS[44] += f27_44 * RHS[27];
+	const double f27_58 = -f27 * m_A206;
+	m_A207 += m_A65 * f27_58;
+	m_A208 += m_A66 * f27_58;
+	m_A209 += m_A67 * f27_58;
+	RHS[58] += f27_58 * RHS[27];
+const double f28 = 1.0 / m_A68;
+	const double f28_45 = -f28 * m_A133;
+	m_A134 += m_A69 * f28_45;
+	m_A135 += m_A70 * f28_45;
+	RHS[45] += f28_45 * RHS[28];
+	const double f28_55 = -f28 * m_A189;
+	m_A190 += m_A69 * f28_55;
+	m_A191 += m_A70 * f28_55;
+	RHS[55] += f28_55 * RHS[28];
+const double f29 = 1.0 / m_A71;
+	const double f29_47 = -f29 * m_A141;
+	m_A142 += m_A72 * f29_47;
+	m_A143 += m_A73 * f29_47;
+	m_A145 += m_A74 * f29_47;
+	RHS[47] += f29_47 * RHS[29];
+	const double f29_48 = -f29 * m_A147;
+	m_A148 += m_A72 * f29_48;
+	m_A149 += m_A73 * f29_48;
+	m_A151 += m_A74 * f29_48;
+	RHS[48] += f29_48 * RHS[29];
+	const double f29_61 = -f29 * m_A230;
+	m_A231 += m_A72 * f29_61;
+	m_A232 += m_A73 * f29_61;
+	m_A234 += m_A74 * f29_61;
+	RHS[61] += f29_61 * RHS[29];
+const double f30 = 1.0 / m_A75;
+	const double f30_36 = -f30 * m_A96;
+	m_A99 += m_A76 * f30_36;
+	m_A100 += m_A77 * f30_36;
+	RHS[36] += f30_36 * RHS[30];
+	const double f30_49 = -f30 * m_A154;
+	m_A156 += m_A76 * f30_49;
+	m_A157 += m_A77 * f30_49;
+	RHS[49] += f30_49 * RHS[30];
+	const double f30_63 = -f30 * m_A241;
+	m_A243 += m_A76 * f30_63;
+	m_A249 += m_A77 * f30_63;
+	RHS[63] += f30_63 * RHS[30];
+const double f31 = 1.0 / m_A78;
+	const double f31_60 = -f31 * m_A222;
+	m_A228 += m_A79 * f31_60;
+	RHS[60] += f31_60 * RHS[31];
+const double f32 = 1.0 / m_A80;
+	const double f32_50 = -f32 * m_A159;
+	m_A160 += m_A81 * f32_50;
+	m_A162 += m_A82 * f32_50;
+	RHS[50] += f32_50 * RHS[32];
+	const double f32_54 = -f32 * m_A182;
+	m_A184 += m_A81 * f32_54;
+	m_A186 += m_A82 * f32_54;
+	RHS[54] += f32_54 * RHS[32];
+const double f33 = 1.0 / m_A83;
+	const double f33_54 = -f33 * m_A183;
+	m_A186 += m_A84 * f33_54;
+	RHS[54] += f33_54 * RHS[33];
+	const double f33_62 = -f33 * m_A236;
+	m_A237 += m_A84 * f33_62;
+	RHS[62] += f33_62 * RHS[33];
+const double f34 = 1.0 / m_A87;
+	const double f34_36 = -f34 * m_A97;
+	m_A98 += m_A88 * f34_36;
+	RHS[36] += f34_36 * RHS[34];
+const double f35 = 1.0 / m_A91;
+	const double f35_53 = -f35 * m_A178;
+	m_A180 += m_A92 * f35_53;
+	RHS[53] += f35_53 * RHS[35];
+	const double f35_59 = -f35 * m_A213;
+	m_A215 += m_A92 * f35_59;
+	RHS[59] += f35_59 * RHS[35];
+const double f36 = 1.0 / m_A98;
+	const double f36_49 = -f36 * m_A155;
+	m_A156 += m_A99 * f36_49;
+	m_A157 += m_A100 * f36_49;
+	RHS[49] += f36_49 * RHS[36];
+const double f37 = 1.0 / m_A103;
+	const double f37_39 = -f37 * m_A110;
+	m_A111 += m_A104 * f37_39;
+	m_A112 += m_A105 * f37_39;
+	RHS[39] += f37_39 * RHS[37];
+	const double f37_51 = -f37 * m_A165;
+	m_A166 += m_A104 * f37_51;
+	m_A169 += m_A105 * f37_51;
+	RHS[51] += f37_51 * RHS[37];
+const double f38 = 1.0 / m_A106;
+	const double f38_60 = -f38 * m_A223;
+	m_A228 += m_A107 * f38_60;
+	RHS[60] += f38_60 * RHS[38];
+const double f39 = 1.0 / m_A111;
+	const double f39_51 = -f39 * m_A166;
+	m_A169 += m_A112 * f39_51;
+	RHS[51] += f39_51 * RHS[39];
+const double f40 = 1.0 / m_A115;
+	const double f40_44 = -f40 * m_A128;
+	m_A129 += m_A116 * f40_44;
+	m_A130 += m_A117 * f40_44;
+	RHS[44] += f40_44 * RHS[40];
+	const double f40_58 = -f40 * m_A207;
+	m_A208 += m_A116 * f40_58;
+	m_A209 += m_A117 * f40_58;
+	RHS[58] += f40_58 * RHS[40];
+const double f41 = 1.0 / m_A119;
+	const double f41_56 = -f41 * m_A195;
+	m_A197 += m_A120 * f41_56;
+	RHS[56] += f41_56 * RHS[41];
+const double f42 = 1.0 / m_A121;
+	const double f42_60 = -f42 * m_A224;
+	m_A228 += m_A122 * f42_60;
+	RHS[60] += f42_60 * RHS[42];
+const double f43 = 1.0 / m_A123;
+	const double f43_60 = -f43 * m_A225;
+	m_A228 += m_A124 * f43_60;
+	m_A229 += m_A125 * f43_60;
+	RHS[60] += f43_60 * RHS[43];
+	const double f43_63 = -f43 * m_A242;
+	m_A246 += m_A124 * f43_63;
+	m_A249 += m_A125 * f43_63;
+	RHS[63] += f43_63 * RHS[43];
+const double f44 = 1.0 / m_A129;
+	const double f44_58 = -f44 * m_A208;
+	m_A209 += m_A130 * f44_58;
+	RHS[58] += f44_58 * RHS[44];
+const double f45 = 1.0 / m_A134;
+	const double f45_55 = -f45 * m_A190;
+	m_A191 += m_A135 * f45_55;
+	RHS[55] += f45_55 * RHS[45];
+const double f46 = 1.0 / m_A137;
+	const double f46_56 = -f46 * m_A196;
+	m_A197 += m_A138 * f46_56;
+	m_A198 += m_A139 * f46_56;
+	RHS[56] += f46_56 * RHS[46];
+	const double f46_57 = -f46 * m_A200;
+	m_A203 += m_A138 * f46_57;
+	m_A204 += m_A139 * f46_57;
+	RHS[57] += f46_57 * RHS[46];
+const double f47 = 1.0 / m_A142;
+	const double f47_48 = -f47 * m_A148;
+	m_A149 += m_A143 * f47_48;
+	m_A150 += m_A144 * f47_48;
+	m_A151 += m_A145 * f47_48;
+	RHS[48] += f47_48 * RHS[47];
+	const double f47_51 = -f47 * m_A167;
+	m_A168 += m_A143 * f47_51;
+	m_A169 += m_A144 * f47_51;
+	m_A170 += m_A145 * f47_51;
+	RHS[51] += f47_51 * RHS[47];
+	const double f47_61 = -f47 * m_A231;
+	m_A232 += m_A143 * f47_61;
+	m_A233 += m_A144 * f47_61;
+	m_A234 += m_A145 * f47_61;
+	RHS[61] += f47_61 * RHS[47];
+const double f48 = 1.0 / m_A149;
+	const double f48_51 = -f48 * m_A168;
+	m_A169 += m_A150 * f48_51;
+	m_A170 += m_A151 * f48_51;
+	RHS[51] += f48_51 * RHS[48];
+	const double f48_61 = -f48 * m_A232;
+	m_A233 += m_A150 * f48_61;
+	m_A234 += m_A151 * f48_61;
+	RHS[61] += f48_61 * RHS[48];
+const double f49 = 1.0 / m_A156;
+	const double f49_63 = -f49 * m_A243;
+	m_A249 += m_A157 * f49_63;
+	RHS[63] += f49_63 * RHS[49];
+const double f50 = 1.0 / m_A160;
+	const double f50_52 = -f50 * m_A173;
+	m_A174 += m_A161 * f50_52;
+	m_A175 += m_A162 * f50_52;
+	RHS[52] += f50_52 * RHS[50];
+	const double f50_54 = -f50 * m_A184;
+	m_A185 += m_A161 * f50_54;
+	m_A186 += m_A162 * f50_54;
+	RHS[54] += f50_54 * RHS[50];
+const double f51 = 1.0 / m_A169;
+	const double f51_61 = -f51 * m_A233;
+	m_A234 += m_A170 * f51_61;
+	RHS[61] += f51_61 * RHS[51];
+const double f52 = 1.0 / m_A174;
+	const double f52_54 = -f52 * m_A185;
+	m_A186 += m_A175 * f52_54;
+	m_A187 += m_A176 * f52_54;
+	RHS[54] += f52_54 * RHS[52];
+	const double f52_57 = -f52 * m_A201;
+	m_A202 += m_A175 * f52_57;
+	m_A204 += m_A176 * f52_57;
+	RHS[57] += f52_57 * RHS[52];
+const double f53 = 1.0 / m_A179;
+	const double f53_59 = -f53 * m_A214;
+	m_A215 += m_A180 * f53_59;
+	m_A216 += m_A181 * f53_59;
+	RHS[59] += f53_59 * RHS[53];
+	const double f53_60 = -f53 * m_A226;
+	m_A227 += m_A180 * f53_60;
+	m_A228 += m_A181 * f53_60;
+	RHS[60] += f53_60 * RHS[53];
+const double f54 = 1.0 / m_A186;
+	const double f54_57 = -f54 * m_A202;
+	m_A204 += m_A187 * f54_57;
+	m_A205 += m_A188 * f54_57;
+	RHS[57] += f54_57 * RHS[54];
+	const double f54_62 = -f54 * m_A237;
+	m_A238 += m_A187 * f54_62;
+	m_A239 += m_A188 * f54_62;
+	RHS[62] += f54_62 * RHS[54];
+const double f55 = 1.0 / m_A191;
+	const double f55_63 = -f55 * m_A244;
+	m_A249 += m_A192 * f55_63;
+	RHS[63] += f55_63 * RHS[55];
+const double f56 = 1.0 / m_A197;
+	const double f56_57 = -f56 * m_A203;
+	m_A204 += m_A198 * f56_57;
+	RHS[57] += f56_57 * RHS[56];
+const double f57 = 1.0 / m_A204;
+	const double f57_62 = -f57 * m_A238;
+	m_A239 += m_A205 * f57_62;
+	RHS[62] += f57_62 * RHS[57];
+const double f58 = 1.0 / m_A209;
+	const double f58_63 = -f58 * m_A245;
+	m_A249 += m_A210 * f58_63;
+	RHS[63] += f58_63 * RHS[58];
+const double f59 = 1.0 / m_A215;
+	const double f59_60 = -f59 * m_A227;
+	m_A228 += m_A216 * f59_60;
+	RHS[60] += f59_60 * RHS[59];
+const double f60 = 1.0 / m_A228;
+	const double f60_63 = -f60 * m_A246;
+	m_A249 += m_A229 * f60_63;
+	RHS[63] += f60_63 * RHS[60];
+const double f61 = 1.0 / m_A234;
+	const double f61_63 = -f61 * m_A247;
+	m_A249 += m_A235 * f61_63;
+	RHS[63] += f61_63 * RHS[61];
+const double f62 = 1.0 / m_A239;
+	const double f62_63 = -f62 * m_A248;
+	m_A249 += m_A240 * f62_63;
+	RHS[63] += f62_63 * RHS[62];
+	V[63] = RHS[63] / m_A249;
+	double tmp62 = 0.0;
+	tmp62 += m_A240 * V[63];
+	V[62] = (RHS[62] - tmp62) / m_A239;
+	double tmp61 = 0.0;
+	tmp61 += m_A235 * V[63];
+	V[61] = (RHS[61] - tmp61) / m_A234;
+	double tmp60 = 0.0;
+	tmp60 += m_A229 * V[63];
+	V[60] = (RHS[60] - tmp60) / m_A228;
+	double tmp59 = 0.0;
+	tmp59 += m_A216 * V[60];
+	V[59] = (RHS[59] - tmp59) / m_A215;
+	double tmp58 = 0.0;
+	tmp58 += m_A210 * V[63];
+	V[58] = (RHS[58] - tmp58) / m_A209;
+	double tmp57 = 0.0;
+	tmp57 += m_A205 * V[62];
+	V[57] = (RHS[57] - tmp57) / m_A204;
+	double tmp56 = 0.0;
+	tmp56 += m_A198 * V[57];
+	V[56] = (RHS[56] - tmp56) / m_A197;
+	double tmp55 = 0.0;
+	tmp55 += m_A192 * V[63];
+	V[55] = (RHS[55] - tmp55) / m_A191;
+	double tmp54 = 0.0;
+	tmp54 += m_A187 * V[57];
+	tmp54 += m_A188 * V[62];
+	V[54] = (RHS[54] - tmp54) / m_A186;
+	double tmp53 = 0.0;
+	tmp53 += m_A180 * V[59];
+	tmp53 += m_A181 * V[60];
+	V[53] = (RHS[53] - tmp53) / m_A179;
+	double tmp52 = 0.0;
+	tmp52 += m_A175 * V[54];
+	tmp52 += m_A176 * V[57];
+	V[52] = (RHS[52] - tmp52) / m_A174;
+	double tmp51 = 0.0;
+	tmp51 += m_A170 * V[61];
+	V[51] = (RHS[51] - tmp51) / m_A169;
+	double tmp50 = 0.0;
+	tmp50 += m_A161 * V[52];
+	tmp50 += m_A162 * V[54];
+	V[50] = (RHS[50] - tmp50) / m_A160;
+	double tmp49 = 0.0;
+	tmp49 += m_A157 * V[63];
+	V[49] = (RHS[49] - tmp49) / m_A156;
+	double tmp48 = 0.0;
+	tmp48 += m_A150 * V[51];
+	tmp48 += m_A151 * V[61];
+	V[48] = (RHS[48] - tmp48) / m_A149;
+	double tmp47 = 0.0;
+	tmp47 += m_A143 * V[48];
+	tmp47 += m_A144 * V[51];
+	tmp47 += m_A145 * V[61];
+	V[47] = (RHS[47] - tmp47) / m_A142;
+	double tmp46 = 0.0;
+	tmp46 += m_A138 * V[56];
+	tmp46 += m_A139 * V[57];
+	V[46] = (RHS[46] - tmp46) / m_A137;
+	double tmp45 = 0.0;
+	tmp45 += m_A135 * V[55];
+	V[45] = (RHS[45] - tmp45) / m_A134;
+	double tmp44 = 0.0;
+	tmp44 += m_A130 * V[58];
+	V[44] = (RHS[44] - tmp44) / m_A129;
+	double tmp43 = 0.0;
+	tmp43 += m_A124 * V[60];
+	tmp43 += m_A125 * V[63];
+	V[43] = (RHS[43] - tmp43) / m_A123;
+	double tmp42 = 0.0;
+	tmp42 += m_A122 * V[60];
+	V[42] = (RHS[42] - tmp42) / m_A121;
+	double tmp41 = 0.0;
+	tmp41 += m_A120 * V[56];
+	V[41] = (RHS[41] - tmp41) / m_A119;
+	double tmp40 = 0.0;
+	tmp40 += m_A116 * V[44];
+	tmp40 += m_A117 * V[58];
+	V[40] = (RHS[40] - tmp40) / m_A115;
+	double tmp39 = 0.0;
+	tmp39 += m_A112 * V[51];
+	V[39] = (RHS[39] - tmp39) / m_A111;
+	double tmp38 = 0.0;
+	tmp38 += m_A107 * V[60];
+	V[38] = (RHS[38] - tmp38) / m_A106;
+	double tmp37 = 0.0;
+	tmp37 += m_A104 * V[39];
+	tmp37 += m_A105 * V[51];
+	V[37] = (RHS[37] - tmp37) / m_A103;
+	double tmp36 = 0.0;
+	tmp36 += m_A99 * V[49];
+	tmp36 += m_A100 * V[63];
+	V[36] = (RHS[36] - tmp36) / m_A98;
+	double tmp35 = 0.0;
+	tmp35 += m_A92 * V[59];
+	V[35] = (RHS[35] - tmp35) / m_A91;
+	double tmp34 = 0.0;
+	tmp34 += m_A88 * V[36];
+	V[34] = (RHS[34] - tmp34) / m_A87;
+	double tmp33 = 0.0;
+	tmp33 += m_A84 * V[54];
+	V[33] = (RHS[33] - tmp33) / m_A83;
+	double tmp32 = 0.0;
+	tmp32 += m_A81 * V[50];
+	tmp32 += m_A82 * V[54];
+	V[32] = (RHS[32] - tmp32) / m_A80;
+	double tmp31 = 0.0;
+	tmp31 += m_A79 * V[60];
+	V[31] = (RHS[31] - tmp31) / m_A78;
+	double tmp30 = 0.0;
+	tmp30 += m_A76 * V[49];
+	tmp30 += m_A77 * V[63];
+	V[30] = (RHS[30] - tmp30) / m_A75;
+	double tmp29 = 0.0;
+	tmp29 += m_A72 * V[47];
+	tmp29 += m_A73 * V[48];
+	tmp29 += m_A74 * V[61];
+	V[29] = (RHS[29] - tmp29) / m_A71;
+	double tmp28 = 0.0;
+	tmp28 += m_A69 * V[45];
+	tmp28 += m_A70 * V[55];
+	V[28] = (RHS[28] - tmp28) / m_A68;
+	double tmp27 = 0.0;
+	tmp27 += m_A65 * V[40];
+	tmp27 += m_A66 * V[44];
+	tmp27 += m_A67 * V[58];
+	V[27] = (RHS[27] - tmp27) / m_A64;
+	double tmp26 = 0.0;
+	tmp26 += m_A63 * V[60];
+	V[26] = (RHS[26] - tmp26) / m_A62;
+	double tmp25 = 0.0;
+	tmp25 += m_A61 * V[60];
+	V[25] = (RHS[25] - tmp25) / m_A60;
+	double tmp24 = 0.0;
+	tmp24 += m_A59 * V[60];
+	V[24] = (RHS[24] - tmp24) / m_A58;
+	double tmp23 = 0.0;
+	tmp23 += m_A56 * V[47];
+	tmp23 += m_A57 * V[51];
+	V[23] = (RHS[23] - tmp23) / m_A55;
+	double tmp22 = 0.0;
+	tmp22 += m_A54 * V[45];
+	V[22] = (RHS[22] - tmp22) / m_A53;
+	double tmp21 = 0.0;
+	tmp21 += m_A52 * V[48];
+	V[21] = (RHS[21] - tmp21) / m_A51;
+	double tmp20 = 0.0;
+	tmp20 += m_A50 * V[45];
+	V[20] = (RHS[20] - tmp20) / m_A49;
+	double tmp19 = 0.0;
+	tmp19 += m_A48 * V[40];
+	V[19] = (RHS[19] - tmp19) / m_A47;
+	double tmp18 = 0.0;
+	tmp18 += m_A46 * V[44];
+	V[18] = (RHS[18] - tmp18) / m_A45;
+	double tmp17 = 0.0;
+	tmp17 += m_A44 * V[60];
+	V[17] = (RHS[17] - tmp17) / m_A43;
+	double tmp16 = 0.0;
+	tmp16 += m_A42 * V[60];
+	V[16] = (RHS[16] - tmp16) / m_A41;
+	double tmp15 = 0.0;
+	tmp15 += m_A38 * V[37];
+	tmp15 += m_A39 * V[39];
+	tmp15 += m_A40 * V[51];
+	V[15] = (RHS[15] - tmp15) / m_A37;
+	double tmp14 = 0.0;
+	tmp14 += m_A34 * V[30];
+	tmp14 += m_A35 * V[36];
+	tmp14 += m_A36 * V[49];
+	V[14] = (RHS[14] - tmp14) / m_A33;
+	double tmp13 = 0.0;
+	tmp13 += m_A32 * V[37];
+	V[13] = (RHS[13] - tmp13) / m_A31;
+	double tmp12 = 0.0;
+	tmp12 += m_A30 * V[39];
+	V[12] = (RHS[12] - tmp12) / m_A29;
+	double tmp11 = 0.0;
+	tmp11 += m_A28 * V[59];
+	V[11] = (RHS[11] - tmp11) / m_A27;
+	double tmp10 = 0.0;
+	tmp10 += m_A25 * V[35];
+	tmp10 += m_A26 * V[59];
+	V[10] = (RHS[10] - tmp10) / m_A24;
+	double tmp9 = 0.0;
+	tmp9 += m_A23 * V[49];
+	V[9] = (RHS[9] - tmp9) / m_A22;
+	double tmp8 = 0.0;
+	tmp8 += m_A20 * V[34];
+	tmp8 += m_A21 * V[36];
+	V[8] = (RHS[8] - tmp8) / m_A19;
+	double tmp7 = 0.0;
+	tmp7 += m_A18 * V[36];
+	V[7] = (RHS[7] - tmp7) / m_A17;
+	double tmp6 = 0.0;
+	tmp6 += m_A16 * V[35];
+	V[6] = (RHS[6] - tmp6) / m_A15;
+	double tmp5 = 0.0;
+	tmp5 += m_A13 * V[50];
+	tmp5 += m_A14 * V[52];
+	V[5] = (RHS[5] - tmp5) / m_A12;
+	double tmp4 = 0.0;
+	tmp4 += m_A11 * V[34];
+	V[4] = (RHS[4] - tmp4) / m_A10;
+	double tmp3 = 0.0;
+	tmp3 += m_A9 * V[52];
+	V[3] = (RHS[3] - tmp3) / m_A8;
+	double tmp2 = 0.0;
+	tmp2 += m_A6 * V[46];
+	tmp2 += m_A7 * V[56];
+	V[2] = (RHS[2] - tmp2) / m_A5;
+	double tmp1 = 0.0;
+	tmp1 += m_A3 * V[41];
+	tmp1 += m_A4 * V[56];
+	V[1] = (RHS[1] - tmp1) / m_A2;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[41];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+static void nl_gcr_45431c6b375d5ae0_12(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+{
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+const double f0 = 1.0 / m_A0;
+	const double f0_2 = -f0 * m_A5;
+	m_A7 += m_A1 * f0_2;
+	RHS[2] += f0_2 * RHS[0];
+const double f1 = 1.0 / m_A2;
+	const double f1_2 = -f1 * m_A6;
+	m_A7 += m_A3 * f1_2;
+	m_A8 += m_A4 * f1_2;
+	RHS[2] += f1_2 * RHS[1];
+	const double f1_3 = -f1 * m_A9;
+	m_A10 += m_A3 * f1_3;
+	m_A11 += m_A4 * f1_3;
+	RHS[3] += f1_3 * RHS[1];
+const double f2 = 1.0 / m_A7;
+	const double f2_3 = -f2 * m_A10;
+	m_A11 += m_A8 * f2_3;
+	RHS[3] += f2_3 * RHS[2];
+	V[3] = RHS[3] / m_A11;
+	double tmp2 = 0.0;
+	tmp2 += m_A8 * V[3];
+	V[2] = (RHS[2] - tmp2) / m_A7;
+	double tmp1 = 0.0;
+	tmp1 += m_A3 * V[2];
+	tmp1 += m_A4 * V[3];
+	V[1] = (RHS[1] - tmp1) / m_A2;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[2];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+static void nl_gcr_745ccccd00b4c2a8_37(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+{
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+double m_A12 = m_A[12];
+double m_A13 = m_A[13];
+double m_A14 = m_A[14];
+double m_A15 = m_A[15];
+double m_A16 = m_A[16];
+double m_A17 = m_A[17];
+double m_A18 = m_A[18];
+double m_A19 = m_A[19];
+double m_A20 = m_A[20];
+double m_A21 = m_A[21];
+double m_A22 = m_A[22];
+double m_A23 = m_A[23];
+double m_A24 = m_A[24];
+double m_A25 = m_A[25];
+double m_A26 = m_A[26];
+double m_A27 = m_A[27];
+double m_A28 = m_A[28];
+double m_A29 = m_A[29];
+double m_A30 = m_A[30];
+double m_A31 = m_A[31];
+double m_A32 = m_A[32];
+double m_A33 = m_A[33];
+double m_A34 = m_A[34];
+double m_A35 = m_A[35];
+double m_A36 = m_A[36];
+const double f0 = 1.0 / m_A0;
+	const double f0_5 = -f0 * m_A13;
+	m_A14 += m_A1 * f0_5;
+	RHS[5] += f0_5 * RHS[0];
+const double f1 = 1.0 / m_A2;
+	const double f1_6 = -f1 * m_A16;
+	m_A18 += m_A3 * f1_6;
+	m_A19 += m_A4 * f1_6;
+	m_A20 += m_A5 * f1_6;
+	RHS[6] += f1_6 * RHS[1];
+	const double f1_8 = -f1 * m_A26;
+	m_A27 += m_A3 * f1_8;
+	m_A28 += m_A4 * f1_8;
+	m_A29 += m_A5 * f1_8;
+	RHS[8] += f1_8 * RHS[1];
+const double f2 = 1.0 / m_A6;
+	const double f2_6 = -f2 * m_A17;
+	m_A19 += m_A7 * f2_6;
+	m_A21 += m_A8 * f2_6;
+	RHS[6] += f2_6 * RHS[2];
+	const double f2_9 = -f2 * m_A31;
+	m_A33 += m_A7 * f2_9;
+	m_A36 += m_A8 * f2_9;
+	RHS[9] += f2_9 * RHS[2];
+const double f3 = 1.0 / m_A9;
+	const double f3_7 = -f3 * m_A22;
+	m_A24 += m_A10 * f3_7;
+	RHS[7] += f3_7 * RHS[3];
+const double f4 = 1.0 / m_A11;
+	const double f4_7 = -f4 * m_A23;
+	m_A24 += m_A12 * f4_7;
+	RHS[7] += f4_7 * RHS[4];
+	const double f4_9 = -f4 * m_A32;
+	m_A34 += m_A12 * f4_9;
+	RHS[9] += f4_9 * RHS[4];
+const double f5 = 1.0 / m_A14;
+	const double f5_6 = -f5 * m_A18;
+	m_A20 += m_A15 * f5_6;
+	RHS[6] += f5_6 * RHS[5];
+	const double f5_8 = -f5 * m_A27;
+	m_A29 += m_A15 * f5_8;
+	RHS[8] += f5_8 * RHS[5];
+const double f6 = 1.0 / m_A19;
+	const double f6_8 = -f6 * m_A28;
+	m_A29 += m_A20 * f6_8;
+	m_A30 += m_A21 * f6_8;
+	RHS[8] += f6_8 * RHS[6];
+	const double f6_9 = -f6 * m_A33;
+	m_A35 += m_A20 * f6_9;
+	m_A36 += m_A21 * f6_9;
+	RHS[9] += f6_9 * RHS[6];
+const double f7 = 1.0 / m_A24;
+	const double f7_9 = -f7 * m_A34;
+	m_A36 += m_A25 * f7_9;
+	RHS[9] += f7_9 * RHS[7];
+const double f8 = 1.0 / m_A29;
+	const double f8_9 = -f8 * m_A35;
+	m_A36 += m_A30 * f8_9;
+	RHS[9] += f8_9 * RHS[8];
+	V[9] = RHS[9] / m_A36;
+	double tmp8 = 0.0;
+	tmp8 += m_A30 * V[9];
+	V[8] = (RHS[8] - tmp8) / m_A29;
+	double tmp7 = 0.0;
+	tmp7 += m_A25 * V[9];
+	V[7] = (RHS[7] - tmp7) / m_A24;
+	double tmp6 = 0.0;
+	tmp6 += m_A20 * V[8];
+	tmp6 += m_A21 * V[9];
+	V[6] = (RHS[6] - tmp6) / m_A19;
+	double tmp5 = 0.0;
+	tmp5 += m_A15 * V[8];
+	V[5] = (RHS[5] - tmp5) / m_A14;
+	double tmp4 = 0.0;
+	tmp4 += m_A12 * V[7];
+	V[4] = (RHS[4] - tmp4) / m_A11;
+	double tmp3 = 0.0;
+	tmp3 += m_A10 * V[7];
+	V[3] = (RHS[3] - tmp3) / m_A9;
+	double tmp2 = 0.0;
+	tmp2 += m_A7 * V[6];
+	tmp2 += m_A8 * V[9];
+	V[2] = (RHS[2] - tmp2) / m_A6;
+	double tmp1 = 0.0;
+	tmp1 += m_A3 * V[5];
+	tmp1 += m_A4 * V[6];
+	tmp1 += m_A5 * V[8];
+	V[1] = (RHS[1] - tmp1) / m_A2;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[5];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+static void nl_gcr_ecd5f36fb3a774a6_7(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+{
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+const double f0 = 1.0 / m_A0;
+	const double f0_2 = -f0 * m_A4;
+	m_A6 += m_A1 * f0_2;
+	RHS[2] += f0_2 * RHS[0];
+const double f1 = 1.0 / m_A2;
+	const double f1_2 = -f1 * m_A5;
+	m_A6 += m_A3 * f1_2;
+	RHS[2] += f1_2 * RHS[1];
+	V[2] = RHS[2] / m_A6;
+	double tmp1 = 0.0;
+	tmp1 += m_A3 * V[2];
+	V[1] = (RHS[1] - tmp1) / m_A2;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[2];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+namespace netlist
+{
+	const static_solver_sym static_solvers[] =
+	{
+		{ "nl_gcr_260e13d5adc65b85_27", &nl_gcr_260e13d5adc65b85_27 },
+		{ "nl_gcr_2b052e2cee1cdc1a_250", &nl_gcr_2b052e2cee1cdc1a_250 },
+		{ "nl_gcr_45431c6b375d5ae0_12", &nl_gcr_45431c6b375d5ae0_12 },
+		{ "nl_gcr_745ccccd00b4c2a8_37", &nl_gcr_745ccccd00b4c2a8_37 },
+		{ "nl_gcr_ecd5f36fb3a774a6_7", &nl_gcr_ecd5f36fb3a774a6_7 },
+		{ nullptr, nullptr }
+	};
+} // namespace netlist
@@ -27,6 +27,30 @@ namespace netlist
 	 */
 	using netlist_sig_t = std::uint32_t;
 
+	//============================================================
+	//  Static solvers
+	//============================================================
+
+	/*! Signature of the solvers generated by "nltool -c static".
+	 */
+	using static_solver_fn = void (*)(double *m_A, double *RHS, double *V);
+
+	/*! A static solver compiled into the build.
+	 */
+	struct static_solver_sym
+	{
+		const char *name;
+		static_solver_fn func;
+	};
+
+	/*! Static solvers generated from frequently used netlists by
+	 *  "nltool -c static -o" into generated/static_solvers.cpp. The list
+	 *  ends with an entry without a name. nltool and MAME compile the
+	 *  generated file and pass the list on through
+	 *  callbacks_t::static_solvers().
+	 */
+	extern const static_solver_sym static_solvers[];
+
 	/* FIXME: belongs into nl_base.h to nlstate */
 	/**
 	 * @brief Interface definition for netlist callbacks into calling code
@@ -50,6 +74,9 @@ namespace netlist
 		/* logging callback */
 		virtual void vlog(const plib::plog_level &l, const pstring &ls) const = 0;
 
+		/* static solvers built in, nullptr if none */
+		virtual const static_solver_sym *static_solvers() const { return nullptr; }
+
 	};
 
 	using log_type =  plib::plog_base<callbacks_t, NL_DEBUG>;
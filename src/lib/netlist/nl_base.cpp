@@ -20,6 +20,8 @@
 #include "nl_errstr.h"
 
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <limits>
 
@@ -161,8 +163,8 @@ void detail::queue_t::on_pre_save(plib::state_manager_t &manager)
 	m_qsize = this->size();
 	for (std::size_t i = 0; i < m_qsize; i++ )
 	{
-		m_times[i] =  this->listptr()[i].m_exec_time.as_raw();
-		m_net_ids[i] = state().find_net_id(this->listptr()[i].m_object);
+		m_times[i] =  (*this)[i].m_exec_time.as_raw();
+		m_net_ids[i] = state().find_net_id((*this)[i].m_object);
 	}
 }
 
@@ -264,6 +266,68 @@ netlist_state_t::netlist_state_t(const pstring &aname,
 {
 	pstring libpath = plib::util::environment("NL_BOOSTLIB", plib::util::buildpath({".", "nlboost.so"}));
 	m_lib = plib::make_unique<plib::dynlib>(libpath);
+	m_static_cache = plib::util::environment("NL_SOLVER_CACHE", "");
+}
+
+static_solver_fn netlist_state_t::static_solver(const pstring &name, const pstring &code)
+{
+	/* built in */
+	const static_solver_sym *builtin = m_callbacks->static_solvers();
+	for (const static_solver_sym *sym = builtin; sym != nullptr && sym->name != nullptr; sym++)
+		if (name == sym->name)
+			return sym->func;
+
+	/* NL_BOOSTLIB */
+	if (m_lib->isLoaded())
+	{
+		auto func = m_lib->getsym<static_solver_fn>(name);
+		if (func != nullptr)
+			return func;
+	}
+
+	/* compiled on first use; the name is a hash of the code, so a cached library is always current */
+	if (m_static_cache == "")
+		return nullptr;
+
+#ifdef _WIN32
+	const pstring compiler = plib::util::environment("NL_COMPILER", "g++ -O2 -shared");
+	const pstring libname = plib::util::buildpath({m_static_cache, name + ".dll"});
+#else
+	const pstring compiler = plib::util::environment("NL_COMPILER", "c++ -O2 -fPIC -shared");
+	const pstring libname = plib::util::buildpath({m_static_cache, name + ".so"});
+#endif
+	if (!plib::util::exists(libname))
+	{
+		const pstring srcname = plib::util::buildpath({m_static_cache, name + ".cpp"});
+		const pstring tmpname = libname + ".tmp";
+		try
+		{
+			plib::pofilestream strm(srcname);
+			plib::putf8_writer w(&strm);
+			w.write(code);
+		}
+		catch (const plib::pexception &e)
+		{
+			log().warning("Unable to write static solver {1}: {2}", srcname, pstring(e.what()));
+			return nullptr;
+		}
+
+		/* build under a temporary name so other instances never see a partial library */
+		log().info("Compiling static solver {1} ...", name);
+		const pstring cmd = compiler + " -o \"" + tmpname + "\" \"" + srcname + "\"";
+		if (std::system(cmd.c_str()) != 0 || std::rename(tmpname.c_str(), libname.c_str()) != 0)
+		{
+			log().warning("Unable to compile static solver {1} with \"{2}\"", name, compiler);
+			std::remove(tmpname.c_str());
+			return nullptr;
+		}
+	}
+
+	auto lib = plib::make_unique<plib::dynlib>(libname);
+	auto func = lib->isLoaded() ? lib->getsym<static_solver_fn>(name) : nullptr;
+	if (func != nullptr)
+		m_static_libs.push_back(std::move(lib));
+	return func;
 }
 
 
@@ -1299,7 +1299,18 @@ namespace netlist
 		log_type & log() { return m_log; }
 		const log_type &log() const { return m_log; }
 
-		plib::dynlib &lib() { return *m_lib; }
+		/* static solvers */
+
+		/*! Look up a static solver, compiling it into the cache directory
+		 *  if it isn't built in or in the library named by NL_BOOSTLIB.
+		 *  Returns nullptr if the solver isn't available.
+		 */
+		static_solver_fn static_solver(const pstring &name, const pstring &code);
+
+		/*! Directory to keep compiled static solvers in; empty disables
+		 *  compiling them. Defaults to NL_SOLVER_CACHE.
+		 */
+		void set_static_solver_cache(const pstring &path) { m_static_cache = path; }
 
 		/* state handling */
 
@@ -1384,6 +1395,8 @@ namespace netlist
 
 		pstring                             m_name;
 		std::unique_ptr<plib::dynlib>       m_lib; // external lib needs to be loaded as long as netlist exists
+		pstring                             m_static_cache;
+		std::vector<std::unique_ptr<plib::dynlib>> m_static_libs; // compiled static solvers
 		plib::state_manager_t               m_state;
 		std::unique_ptr<callbacks_t>        m_callbacks;
 		log_type                            m_log;
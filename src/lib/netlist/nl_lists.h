@@ -21,6 +21,7 @@
 #include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 // ----------------------------------------------------------------------------------------
 // timed queue
@@ -88,6 +89,8 @@ namespace netlist
 			}
 
 			inline static constexpr pqentry_t never() noexcept { return pqentry_t(Time::never(), nullptr); }
+
+			inline static constexpr typename Time::internal_type key(const pqentry_t &e) noexcept { return e.m_exec_time.as_raw(); }
 		};
 
 		Time m_exec_time;
@@ -300,10 +303,268 @@ namespace netlist
 		nperfcount_t<KEEPSTAT> m_prof_call;
 	};
 
+	/*
+	 * Calendar queue, see R. Brown, "Calendar Queues", CACM 31(10), 1988.
+	 *
+	 * Entries are hashed by time into a ring of buckets, each covering a
+	 * power of two of time, and a bucket is kept sorted like
+	 * timed_queue_linear. Entries with equal time therefore leave both
+	 * queues in the same order. The number of buckets follows the queue size
+	 * and the bucket width the spacing of the earliest entries, so a push
+	 * only moves the few entries sharing its bucket however deep the queue is.
+	 */
+	template <class T, bool TS, bool KEEPSTAT, class QueueOp = typename T::QueueOp>
+	class timed_queue_calendar : plib::nocopyassignmove
+	{
+	public:
+
+		using key_type = decltype(QueueOp::key(QueueOp::never()));
+
+		explicit timed_queue_calendar(const std::size_t list_size)
+		: m_buckets(MIN_BUCKETS)
+		, m_mask(MIN_BUCKETS - 1)
+		, m_shift(0)
+		, m_width(1)
+		, m_never(QueueOp::never())
+		{
+			m_list.reserve(list_size);
+			clear();
+		}
+
+		std::size_t capacity() const noexcept { return m_list.capacity(); }
+		bool empty() const noexcept { return m_size == 0; }
+
+		void push(T e) noexcept
+		{
+			/* Lock */
+			lock_guard_type lck(m_lock);
+			insert(e);
+			if (++m_size > 2 * m_buckets.size())
+				resize(m_buckets.size() * 2);
+			m_prof_call.inc();
+		}
+
+		T pop() noexcept
+		{
+			std::vector<T> &b(m_buckets[find_top()]);
+			T ret(b.back());
+			b.pop_back();
+			m_sorted = false;
+			if (--m_size < m_buckets.size() / 2 && m_buckets.size() > MIN_BUCKETS)
+				resize(m_buckets.size() / 2);
+			else if (m_missed)
+				resize(m_buckets.size());
+			return ret;
+		}
+
+		const T &top() const noexcept { return (m_size == 0) ? m_never : m_buckets[find_top()].back(); }
+
+		void remove(const T &elem) noexcept
+		{
+			/* Lock */
+			lock_guard_type lck(m_lock);
+			m_prof_remove.inc();
+
+			/* try the bucket for the entry's time first */
+			if (!erase(m_buckets[bucket(QueueOp::key(elem))], elem))
+				for (auto &b : m_buckets)
+					if (erase(b, elem))
+						return;
+		}
+
+		/* without the time every bucket may have to be searched */
+		template <class R>
+		void remove(const R elem) noexcept
+		{
+			/* Lock */
+			lock_guard_type lck(m_lock);
+			m_prof_remove.inc();
+
+			for (auto &b : m_buckets)
+				if (erase(b, elem))
+					return;
+		}
+
+		void retime(const T &elem) noexcept
+		{
+			/* Lock */
+			lock_guard_type lck(m_lock);
+			m_prof_retime.inc();
+
+			for (auto &b : m_buckets)
+				if (erase(b, elem)) // partial equal!
+				{
+					insert(elem);
+					++m_size;
+					return;
+				}
+		}
+
+		void clear() noexcept
+		{
+			lock_guard_type lck(m_lock);
+			for (auto &b : m_buckets)
+				b.clear();
+			m_size = 0;
+			m_cur = 0;
+			m_start = 0;
+			m_sorted = false;
+			m_missed = false;
+		}
+
+		// save state support & mame disasm
+
+		std::size_t size() const noexcept { return m_size; }
+
+		/* same order as timed_queue_linear, sorted on demand */
+		const T & operator[](const std::size_t index) const noexcept
+		{
+			if (!m_sorted)
+			{
+				gather();
+				std::reverse(m_list.begin(), m_list.end());
+				m_sorted = true;
+			}
+			return m_list[index];
+		}
+
+	private:
+		using mutex_type = pspin_mutex<TS>;
+		using lock_guard_type = std::lock_guard<mutex_type>;
+
+		static constexpr const std::size_t MIN_BUCKETS = 16;
+		static constexpr const std::size_t WIDTH_SAMPLES = 25;
+
+		std::size_t bucket(const key_type k) const noexcept { return static_cast<std::size_t>(k >> m_shift) & m_mask; }
+
+		void insert(const T &e) noexcept
+		{
+			const key_type k(QueueOp::key(e));
+			if (k < m_start)
+			{
+				m_start = k & ~(m_width - 1);
+				m_cur = bucket(k);
+			}
+			std::vector<T> &b(m_buckets[bucket(k)]);
+			b.push_back(e);
+			auto i(b.end() - 1);
+			for (; i != b.begin() && QueueOp::less(*(i - 1), e); --i)
+			{
+				*i = *(i - 1);
+				m_prof_sortmove.inc();
+			}
+			*i = e;
+			m_sorted = false;
+		}
+
+		template <class R>
+		bool erase(std::vector<T> &b, const R &elem) noexcept
+		{
+			for (auto i = b.end(); i != b.begin(); )
+				if (QueueOp::equal(*--i, elem))
+				{
+					b.erase(i);
+					--m_size;
+					m_sorted = false;
+					return true;
+				}
+			return false;
+		}
+
+		/* find the bucket holding the earliest entry; the queue must not be empty */
+		std::size_t find_top() const noexcept
+		{
+			for (std::size_t n = m_buckets.size(); n > 0; --n)
+			{
+				const std::vector<T> &b(m_buckets[m_cur]);
+				if (!b.empty() && QueueOp::key(b.back()) < m_start + m_width)
+					return m_cur;
+				m_cur = (m_cur + 1) & m_mask;
+				m_start += m_width;
+			}
+
+			/* nothing within a year, jump straight to the earliest entry and
+			 * have the next pop fit the bucket width to the queue
+			 */
+			m_missed = true;
+			std::size_t best = m_buckets.size();
+			for (std::size_t i = 0; i < m_buckets.size(); i++)
+				if (!m_buckets[i].empty() && (best == m_buckets.size() || QueueOp::less(m_buckets[i].back(), m_buckets[best].back())))
+					best = i;
+			m_cur = best;
+			m_start = QueueOp::key(m_buckets[best].back()) & ~(m_width - 1);
+			return best;
+		}
+
+		/* all entries into m_list by ascending time, latest push first among equal times */
+		void gather() const
+		{
+			m_list.clear();
+			for (auto &b : m_buckets)
+				m_list.insert(m_list.end(), b.rbegin(), b.rend());
+			std::stable_sort(m_list.begin(), m_list.end(), [](const T &a, const T &b) { return QueueOp::less(a, b); });
+		}
+
+		void resize(const std::size_t buckets)
+		{
+			gather();
+			for (auto &b : m_buckets)
+				b.clear();
+			m_buckets.resize(buckets);
+			m_mask = buckets - 1;
+
+			/* make a bucket about three times the mean spacing of the earliest entries */
+			const std::size_t samples = (m_list.size() < WIDTH_SAMPLES) ? m_list.size() : WIDTH_SAMPLES;
+			if (samples > 1)
+			{
+				const key_type spacing = 3 * (QueueOp::key(m_list[samples - 1]) - QueueOp::key(m_list[0])) / static_cast<key_type>(samples - 1);
+				if (spacing > 0)
+				{
+					for (m_shift = 0; (key_type(1) << m_shift) < spacing; m_shift++) { }
+					m_width = key_type(1) << m_shift;
+				}
+			}
+
+			for (auto i = m_list.rbegin(); i != m_list.rend(); ++i)
+				m_buckets[bucket(QueueOp::key(*i))].push_back(*i);
+			if (!m_list.empty())
+			{
+				m_start = QueueOp::key(m_list[0]) & ~(m_width - 1);
+				m_cur = bucket(m_start);
+			}
+			m_sorted = false;
+			m_missed = false;
+		}
+
+		mutex_type                  m_lock;
+		std::vector<std::vector<T>> m_buckets;
+		std::size_t                 m_mask;
+		unsigned                    m_shift;
+		key_type                    m_width;
+		std::size_t                 m_size;
+		mutable std::size_t         m_cur;      // bucket holding m_start
+		mutable key_type            m_start;    // no entry is earlier than this
+		mutable std::vector<T>      m_list;     // scratch for resizing and sorted access
+		mutable bool                m_sorted;
+		mutable bool                m_missed;   // last search went past a year
+		const T                     m_never;
+
+	public:
+		// profiling
+		nperfcount_t<KEEPSTAT> m_prof_sortmove;
+		nperfcount_t<KEEPSTAT> m_prof_call;
+		nperfcount_t<KEEPSTAT> m_prof_remove;
+		nperfcount_t<KEEPSTAT> m_prof_retime;
+	};
+
 	/*
 	 * Use timed_queue_heap to use stdc++ heap functions instead of linear processing.
 	 *
 	 * This slows down processing by about 25% on a Kaby Lake.
+	 *
+	 * timed_queue_calendar overtakes the linear queue at about 40 pending
+	 * events, but the TTL netlists keep only a handful pending and are
+	 * faster on the linear queue. benchmarks/nlqueue.cpp compares the two.
 	 */
 
 	template <class T, bool TS, bool KEEPSTAT, class QueueOp = typename T::QueueOp>
@@ -56,6 +56,11 @@ public:
 		m_sym = dl.getsym<calltype>(name);
 	}
 
+	void load(calltype sym)
+	{
+		m_sym = sym;
+	}
+
 	R operator ()(Args&&... args) const
 	{
 		return m_sym(std::forward<Args>(args)...);
@@ -6,6 +6,7 @@
 #include "ptypes.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <initializer_list>
@@ -38,6 +39,15 @@ namespace plib
 			else
 				return pstring(std::getenv(var.c_str()));
 		}
+
+		bool exists(const pstring &filename)
+		{
+			std::FILE *f = std::fopen(filename.c_str(), "rb");
+			if (f == nullptr)
+				return false;
+			std::fclose(f);
+			return true;
+		}
 	} // namespace util
 
 	std::vector<pstring> psplit(const pstring &str, const pstring &onstr, bool ignore_empty)
@@ -25,6 +25,7 @@ namespace plib
 	{
 		const pstring buildpath(std::initializer_list<pstring> list );
 		const pstring environment(const pstring &var, const pstring &default_val);
+		bool exists(const pstring &filename);
 	} // namespace util
 
 	namespace container
@@ -44,6 +44,9 @@ public:
 		opt_loadstate(*this,"",  "loadstate",   "",         "load state from file and continue from there"),
 		opt_savestate(*this,"",  "savestate",   "",         "save state to file at end of run"),
 
+		opt_grp6(*this,     "Options for static command",   "These options are only used by the static command."),
+		opt_output(*this,   "o", "output",      "",         "add the static solvers to a database file to be compiled into the build, instead of writing them to stdout"),
+
 		opt_grp4(*this,     "Options for convert command",  "These options are only used by the convert command."),
 		opt_type(*this,     "y", "type",        0,          std::vector<pstring>({"spice","eagle","rinf"}), "type of file to be converted: spice,eagle,rinf"),
 
@@ -56,7 +59,9 @@ public:
 		opt_ex2(*this,     "nltool --cmd=listdevices",
 				"List all known devices."),
 		opt_ex3(*this,     "nltool --cmd=header --tab-width=8 --line-width=80",
-				"Create the header file needed for including netlists as code.")
+				"Create the header file needed for including netlists as code."),
+		opt_ex4(*this,     "nltool -c static -o generated/static_solvers.cpp -f nl_mario.cpp -n mario",
+				"Add the static solvers for netlist \"mario\" to the solvers compiled into the build.")
 		{}
 
 	plib::option_group  opt_grp1;
@@ -76,6 +81,8 @@ public:
 	plib::option_str    opt_inp;
 	plib::option_str    opt_loadstate;
 	plib::option_str    opt_savestate;
+	plib::option_group  opt_grp6;
+	plib::option_str    opt_output;
 	plib::option_group  opt_grp4;
 	plib::option_str_limit<unsigned> opt_type;
 	plib::option_group  opt_grp5;
@@ -84,6 +91,7 @@ public:
 	plib::option_example opt_ex1;
 	plib::option_example opt_ex2;
 	plib::option_example opt_ex3;
+	plib::option_example opt_ex4;
 
 	int execute() override;
 	pstring usage() override;
@@ -91,6 +99,7 @@ public:
 private:
 	void run();
 	void static_compile();
+	void write_static_solvers(const pstring &fname, const std::map<pstring, pstring> &mp);
 
 	void mac_out(const pstring &s, const bool cont = true);
 	void cmac(const netlist::factory::element_t *e);
@@ -158,6 +167,7 @@ public:
 	{ }
 
 	void vlog(const plib::plog_level &l, const pstring &ls) const override;
+	const netlist::static_solver_sym *static_solvers() const override { return netlist::static_solvers; }
 
 private:
 	tool_app_t &m_app;
@@ -431,20 +441,112 @@ void tool_app_t::static_compile()
 			opt_logs(),
 			m_options, opt_rfolders());
 
-	plib::putf8_writer w(&pout_strm);
 	std::map<pstring, pstring> mp;
 
 	nt.solver()->create_solver_code(mp);
 
-	for (auto &e : mp)
+	if (opt_output() == "")
 	{
-		w.write(e.second);
+		plib::putf8_writer w(&pout_strm);
+		for (auto &e : mp)
+		{
+			w.write(e.second);
+		}
 	}
+	else
+		write_static_solvers(opt_output(), mp);
 
 	nt.stop();
 
 }
 
+/* The database holds one static function per solver, followed by the table
+ * netlist_state_t::static_solver searches. Solver names are hashes of their
+ * code, so solvers shared by several netlists are only kept once.
+ */
+static std::map<pstring, pstring> read_static_solvers(const pstring &fname)
+{
+	std::map<pstring, pstring> ret;
+	if (!plib::util::exists(fname))
+		return ret;
+
+	plib::putf8_reader r = plib::putf8_reader(plib::pifilestream(fname));
+	pstring l;
+	pstring name;
+	pstring code;
+	while (r.readline(l))
+	{
+		if (name == "")
+		{
+			if (plib::startsWith(l, "static void nl_"))
+			{
+				name = l.substr(12, l.find("(") - 12);
+				code = l + "\n";
+			}
+		}
+		else
+		{
+			code += l + "\n";
+			if (l == "}")
+			{
+				ret[name] = code;
+				name = "";
+			}
+		}
+	}
+	return ret;
+}
+
+void tool_app_t::write_static_solvers(const pstring &fname, const std::map<pstring, pstring> &mp)
+{
+	auto solvers = read_static_solvers(fname);
+	std::size_t added = 0;
+
+	for (auto &e : mp)
+	{
+		/* solvers which can't be compiled have no name */
+		if (e.first == "" || solvers.find(e.first) != solvers.end())
+			continue;
+
+		/* keep the code out of the global namespace and drop the blank lines */
+		pstring code;
+		for (auto &l : plib::psplit(e.second, "\n"))
+			if (l != "")
+				code += (code == "" ? plib::replace_all(l, pstring("extern \"C\" void"), pstring("static void")) : l) + "\n";
+		solvers[e.first] = code;
+		added++;
+	}
+
+	plib::pofilestream strm(fname);
+	plib::putf8_writer w(&strm);
+	w.writeline("// license:GPL-2.0+");
+	w.writeline("/*");
+	w.writeline(" * static_solvers.cpp");
+	w.writeline(" *");
+	w.writeline(" * Generated by \"nltool -c static -o\", do not edit.");
+	w.writeline(" *");
+	w.writeline(" */");
+	w.writeline("");
+	w.writeline("#include \"../netlist_types.h\"");
+	w.writeline("");
+	for (auto &e : solvers)
+	{
+		w.write(e.second);
+		w.writeline("");
+	}
+	w.writeline("namespace netlist");
+	w.writeline("{");
+	w.writeline("\tconst static_solver_sym static_solvers[] =");
+	w.writeline("\t{");
+	for (auto &e : solvers)
+		w.writeline("\t\t{ \"" + e.first + "\", &" + e.first + " },");
+	w.writeline("\t\t{ nullptr, nullptr }");
+	w.writeline("\t};");
+	w.writeline("} // namespace netlist");
+
+	pout("{1} static solvers added, {2} in {3}\n", added, solvers.size(), fname);
+}
+
 void tool_app_t::mac_out(const pstring &s, const bool cont)
 {
 	if (cont)
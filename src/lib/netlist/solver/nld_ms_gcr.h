@@ -185,15 +185,12 @@ void matrix_solver_GCR_t<FT, SIZE>::vsetup(analog_net_t::list_t &nets)
 
 	// FIXME: Move me
 
-	if (state().lib().isLoaded())
-	{
-		pstring symname = static_compile_name();
-		m_proc.load(this->state().lib(), symname);
-		if (m_proc.resolved())
-			this->log().warning("External static solver {1} found ...", symname);
-		else
-			this->log().warning("External static solver {1} not found ...", symname);
-	}
+	auto code = create_solver_code();
+	m_proc.load(this->state().static_solver(code.first, code.second));
+	if (m_proc.resolved())
+		this->log().verbose("Static solver {1} found ...", code.first);
+	else
+		this->log().verbose("Static solver {1} not found ...", code.first);
 
 }
 
@@ -185,6 +185,9 @@ inline void chd_file::be_write_sha1(uint8_t *base, util::sha1_t value)
 
 inline void chd_file::file_read(uint64_t offset, void *dest, uint32_t length)
 {
+	// the file position is shared with read-ahead
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	// no file = failure
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
@@ -204,6 +207,9 @@ inline void chd_file::file_read(uint64_t offset, void *dest, uint32_t length)
 
 inline void chd_file::file_write(uint64_t offset, const void *source, uint32_t length)
 {
+	// the file position is shared with read-ahead
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	// no file = failure
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
@@ -224,6 +230,9 @@ inline void chd_file::file_write(uint64_t offset, const void *source, uint32_t l
 
 inline uint64_t chd_file::file_append(const void *source, uint32_t length, uint32_t alignment)
 {
+	// the file position is shared with read-ahead
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	// no file = failure
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
@@ -289,7 +298,10 @@ inline uint8_t chd_file::bits_for_value(uint64_t value)
 
 chd_file::chd_file()
 	: m_file(nullptr),
-		m_owns_file(false)
+		m_owns_file(false),
+		m_hunk_cache(DEFAULT_CACHE_HUNKS),
+		m_readahead_queue(nullptr),
+		m_readahead_item(nullptr)
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
@@ -566,6 +578,23 @@ void chd_file::set_parent_sha1(util::sha1_t parent)
 	file_write(m_parentsha1_offset, rawbuf, sizeof(rawbuf));
 }
 
+/**
+ * @fn  void chd_file::set_cache_hunks(uint32_t count)
+ *
+ * @brief   -------------------------------------------------
+ *            set_cache_hunks - set how many decompressed hunks are kept for reuse; anything
+ *            already cached is discarded
+ *          -------------------------------------------------.
+ *
+ * @param   count   Number of hunks to cache; at least one is always kept.
+ */
+
+void chd_file::set_cache_hunks(uint32_t count)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	hunk_cache((std::max<uint32_t>)(count, 1)).swap(m_hunk_cache);
+}
+
 /**
  * @fn  chd_error chd_file::create(util::core_file &file, uint64_t logicalbytes, uint32_t hunkbytes, uint32_t unitbytes, chd_codec_type compression[4])
  *
@@ -801,6 +830,28 @@ chd_error chd_file::open(util::core_file &file, bool writeable, chd_file *parent
 
 void chd_file::close()
 {
+	// let any read-ahead finish before tearing anything down; it works on this
+	// object directly, so there's nothing that could be left alive for it if
+	// we gave up, and it only decompresses a bounded number of hunks
+	if (m_readahead_item != nullptr)
+	{
+		while (!osd_work_item_wait(m_readahead_item, 30 * osd_ticks_per_second()))
+			;
+		osd_work_item_release(m_readahead_item);
+		m_readahead_item = nullptr;
+	}
+	if (m_readahead_queue != nullptr)
+	{
+		osd_work_queue_free(m_readahead_queue);
+		m_readahead_queue = nullptr;
+	}
+
+	// say how the cache did for anything that read through it
+	if (m_cache_hits + m_cache_misses != 0)
+		osd_printf_verbose("CHD cache: %u hunks, %u hits, %u misses, %u read ahead, %.3f s decompressing\n",
+				cache_hunks(), uint32_t(m_cache_hits), uint32_t(m_cache_misses), uint32_t(m_cache_readahead),
+				double(m_decompress_ticks) / double(osd_ticks_per_second()));
+
 	// reset file characteristics
 	if (m_owns_file && m_file)
 		delete m_file;
@@ -842,8 +893,14 @@ void chd_file::close()
 	m_compressed.clear();
 
 	// reset caching
-	m_cache.clear();
-	m_cachehunk = ~0;
+	m_hunk_cache.clear();
+	m_last_hunk = ~0;
+	m_sequential = 0;
+	m_readahead_start = 0;
+	m_cache_hits = 0;
+	m_cache_misses = 0;
+	m_cache_readahead = 0;
+	m_decompress_ticks = 0;
 }
 
 /**
@@ -871,6 +928,8 @@ void chd_file::close()
 
 chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	// wrap this for clean reporting
 	try
 	{
@@ -1016,6 +1075,8 @@ chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 
 chd_error chd_file::write_hunk(uint32_t hunknum, const void *buffer)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	// wrap this for clean reporting
 	try
 	{
@@ -1062,15 +1123,16 @@ chd_error chd_file::write_hunk(uint32_t hunknum, const void *buffer)
 			// write the map entry back
 			be_write(rawmap, rawentry, 4);
 			file_write(m_mapoffset + hunknum * 4, rawmap, 4);
-
-			// update the cached hunk if we just wrote it
-			if (hunknum == m_cachehunk && buffer != &m_cache[0])
-				memcpy(&m_cache[0], buffer, m_hunkbytes);
 		}
 
 		// otherwise, just overwrite
 		else
 			file_write(uint64_t(rawentry) * uint64_t(m_hunkbytes), buffer, m_hunkbytes);
+
+		// update the cached copy if there is one
+		auto const cached = m_hunk_cache.find(hunknum);
+		if (cached != m_hunk_cache.end() && buffer != &cached->second[0])
+			memcpy(&cached->second[0], buffer, m_hunkbytes);
 		return CHDERR_NONE;
 	}
 
@@ -1123,8 +1185,8 @@ chd_error chd_file::write_units(uint64_t unitnum, const void *buffer, uint32_t c
  * @fn  chd_error chd_file::read_bytes(uint64_t offset, void *buffer, uint32_t bytes)
  *
  * @brief   -------------------------------------------------
- *            read_bytes - read from the CHD at a byte level, using the cache to handle partial
- *            hunks
+ *            read_bytes - read from the CHD at a byte level, going through the hunk cache
+ *            for anything it holds and for partial hunks
  *          -------------------------------------------------.
  *
  * @param   offset          The offset.
@@ -1136,6 +1198,8 @@ chd_error chd_file::write_units(uint64_t unitnum, const void *buffer, uint32_t c
 
 chd_error chd_file::read_bytes(uint64_t offset, void *buffer, uint32_t bytes)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	// iterate over hunks
 	uint32_t first_hunk = offset / m_hunkbytes;
 	uint32_t last_hunk = (offset + bytes - 1) / m_hunkbytes;
@@ -1146,22 +1210,24 @@ chd_error chd_file::read_bytes(uint64_t offset, void *buffer, uint32_t bytes)
 		uint32_t startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		uint32_t endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just read directly from disk unless it's the cached hunk
+		// if it's a full block that isn't cached, just read directly from disk
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		cache_note_access(curhunk);
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && m_hunk_cache.count(curhunk) == 0)
+		{
+			m_cache_misses++;
+			osd_ticks_t const start = osd_ticks();
 			err = read_hunk(curhunk, dest);
+			m_decompress_ticks += osd_ticks() - start;
+		}
 
 		// otherwise, read from the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
-			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
-			}
-			memcpy(dest, &m_cache[startoffs], endoffs + 1 - startoffs);
+			std::vector<uint8_t> *const cached = cache_lookup(curhunk, err);
+			if (cached == nullptr)
+				return err;
+			memcpy(dest, &(*cached)[startoffs], endoffs + 1 - startoffs);
 		}
 
 		// handle errors and advance
@@ -1176,8 +1242,8 @@ chd_error chd_file::read_bytes(uint64_t offset, void *buffer, uint32_t bytes)
  * @fn  chd_error chd_file::write_bytes(uint64_t offset, const void *buffer, uint32_t bytes)
  *
  * @brief   -------------------------------------------------
- *            write_bytes - write to the CHD at a byte level, using the cache to handle partial
- *            hunks
+ *            write_bytes - write to the CHD at a byte level, using the hunk cache to handle
+ *            partial hunks
  *          -------------------------------------------------.
  *
  * @param   offset  The offset.
@@ -1189,6 +1255,8 @@ chd_error chd_file::read_bytes(uint64_t offset, void *buffer, uint32_t bytes)
 
 chd_error chd_file::write_bytes(uint64_t offset, const void *buffer, uint32_t bytes)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	// iterate over hunks
 	uint32_t first_hunk = offset / m_hunkbytes;
 	uint32_t last_hunk = (offset + bytes - 1) / m_hunkbytes;
@@ -1199,23 +1267,19 @@ chd_error chd_file::write_bytes(uint64_t offset, const void *buffer, uint32_t by
 		uint32_t startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		uint32_t endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just write directly to disk unless it's the cached hunk
+		// if it's a full block, just write directly to disk; write_hunk keeps any cached copy current
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1)
 			err = write_hunk(curhunk, source);
 
 		// otherwise, write from the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
-			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
-			}
-			memcpy(&m_cache[startoffs], source, endoffs + 1 - startoffs);
-			err = write_hunk(curhunk, &m_cache[0]);
+			std::vector<uint8_t> *const cached = cache_lookup(curhunk, err);
+			if (cached == nullptr)
+				return err;
+			memcpy(&(*cached)[startoffs], source, endoffs + 1 - startoffs);
+			err = write_hunk(curhunk, &(*cached)[0]);
 		}
 
 		// handle errors and advance
@@ -1226,6 +1290,148 @@ chd_error chd_file::write_bytes(uint64_t offset, const void *buffer, uint32_t by
 	return CHDERR_NONE;
 }
 
+/**
+ * @fn  std::vector<uint8_t> *chd_file::cache_lookup(uint32_t hunknum, chd_error &err)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_lookup - return the cached copy of a hunk, reading it into the cache if
+ *            it isn't there; the caller must hold the lock
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum     The hunknum.
+ * @param [out] err     Set to the error if the hunk couldn't be read.
+ *
+ * @return  The cached hunk, or nullptr on error.
+ */
+
+std::vector<uint8_t> *chd_file::cache_lookup(uint32_t hunknum, chd_error &err)
+{
+	auto const found = m_hunk_cache.find(hunknum);
+	if (found != m_hunk_cache.end())
+	{
+		m_cache_hits++;
+		return &found->second;
+	}
+	m_cache_misses++;
+	return cache_fill(hunknum, err);
+}
+
+/**
+ * @fn  std::vector<uint8_t> *chd_file::cache_fill(uint32_t hunknum, chd_error &err)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_fill - read a hunk into the cache, evicting the least recently used one
+ *            if it's full; the caller must hold the lock
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum     The hunknum.
+ * @param [out] err     Set to the error if the hunk couldn't be read.
+ *
+ * @return  The cached hunk, or nullptr on error.
+ */
+
+std::vector<uint8_t> *chd_file::cache_fill(uint32_t hunknum, chd_error &err)
+{
+	std::vector<uint8_t> &buffer = m_hunk_cache[hunknum];
+	buffer.resize(m_hunkbytes);
+
+	osd_ticks_t const start = osd_ticks();
+	err = read_hunk(hunknum, &buffer[0]);
+	m_decompress_ticks += osd_ticks() - start;
+
+	// don't leave a bad hunk behind
+	if (err != CHDERR_NONE)
+	{
+		m_hunk_cache.erase(hunknum);
+		return nullptr;
+	}
+	return &buffer;
+}
+
+/**
+ * @fn  void chd_file::cache_note_access(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_note_access - track the read pattern, and once reads are clearly
+ *            sequential start decompressing the following hunks in the background; the
+ *            caller must hold the lock
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunk about to be read.
+ */
+
+void chd_file::cache_note_access(uint32_t hunknum)
+{
+	if (hunknum == m_last_hunk)
+		return;
+	m_sequential = (hunknum == m_last_hunk + 1) ? (m_sequential + 1) : 0;
+	m_last_hunk = hunknum;
+
+	// only worth it for compressed files, and only if read-ahead can't push out the hunks being used
+	if (m_sequential < 2 || !compressed() || m_hunk_cache.max_size() < 2 * READAHEAD_HUNKS)
+		return;
+
+	// only one read-ahead at a time; release the last one once it's done
+	if (m_readahead_item != nullptr)
+	{
+		if (!osd_work_item_wait(m_readahead_item, 0))
+			return;
+		osd_work_item_release(m_readahead_item);
+		m_readahead_item = nullptr;
+	}
+
+	// find the first following hunk that isn't already cached
+	uint32_t const end = (std::min)(hunknum + 1 + READAHEAD_HUNKS, m_hunkcount);
+	uint32_t first = hunknum + 1;
+	while (first < end && m_hunk_cache.count(first) != 0)
+		first++;
+	if (first >= end)
+		return;
+
+	// queue the work, or forget about it if we can't
+	if (m_readahead_queue == nullptr)
+		m_readahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	if (m_readahead_queue == nullptr)
+		return;
+	m_readahead_start = first;
+	m_readahead_item = osd_work_item_queue(m_readahead_queue, readahead_callback, this, 0);
+}
+
+/**
+ * @fn  void *chd_file::readahead_callback(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_callback - decompress hunks ahead of a sequential reader, taking the
+ *            lock one hunk at a time so demand reads aren't held up for long
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   The chd_file.
+ * @param   threadid        The threadid.
+ *
+ * @return  nullptr.
+ */
+
+void *chd_file::readahead_callback(void *param, int threadid)
+{
+	chd_file &chd = *reinterpret_cast<chd_file *>(param);
+	for (uint32_t index = 0; index < READAHEAD_HUNKS; index++)
+	{
+		std::lock_guard<std::recursive_mutex> lock(chd.m_mutex);
+		uint32_t const hunknum = chd.m_readahead_start + index;
+		if (hunknum >= chd.m_hunkcount)
+			break;
+
+		// the reader may have got here first
+		if (chd.m_hunk_cache.count(hunknum) != 0)
+			continue;
+		chd_error err;
+		if (chd.cache_fill(hunknum, err) == nullptr)
+			break;
+		chd.m_cache_readahead++;
+	}
+	return nullptr;
+}
+
 /**
  * @fn  chd_error chd_file::read_metadata(chd_metadata_tag searchtag, uint32_t searchindex, std::string &output)
  *
@@ -2464,9 +2670,8 @@ void chd_file::create_open_common()
 	else
 		file_read(m_mapoffset, &m_rawmap[0], m_rawmap.size());
 
-	// allocate the temporary compressed buffer and a buffer for caching
+	// allocate the temporary compressed buffer; cached hunks are allocated as they're read
 	m_compressed.resize(m_hunkbytes);
-	m_cache.resize(m_hunkbytes);
 }
 
 /**
@@ -2759,6 +2964,7 @@ chd_file_compressor::chd_file_compressor()
 		m_read_done_offset(0),
 		m_read_error(false),
 		m_work_queue(nullptr),
+		m_ratio_budget(0),
 		m_write_hunk(0)
 {
 	// zap arrays
@@ -2830,7 +3036,7 @@ void chd_file_compressor::compress_begin()
 	for (auto & elem : m_codecs)
 	{
 		delete elem;
-		elem = new chd_compressor_group(*this, m_compression);
+		elem = new chd_compressor_group(*this, m_compression, m_ratio_budget);
 	}
 
 	// reset write state
@@ -22,6 +22,7 @@
 #include "hashing.h"
 #include "chdcodec.h"
 #include <atomic>
+#include <mutex>
 
 /***************************************************************************
 
@@ -298,6 +299,10 @@ class chd_file
 	static const uint32_t V5_HEADER_SIZE = 124;
 	static const uint32_t MAX_HEADER_SIZE = V5_HEADER_SIZE;
 
+	// caching
+	static const uint32_t DEFAULT_CACHE_HUNKS = 16;     // decompressed hunks kept by default
+	static const uint32_t READAHEAD_HUNKS = 4;          // hunks decompressed ahead of sequential reads
+
 public:
 	// construction/destruction
 	chd_file();
@@ -326,6 +331,14 @@ public:
 	void set_raw_sha1(util::sha1_t rawdata);
 	void set_parent_sha1(util::sha1_t parent);
 
+	// hunk cache
+	void set_cache_hunks(uint32_t count);
+	uint32_t cache_hunks() const { return m_hunk_cache.max_size(); }
+	uint64_t cache_hits() const { return m_cache_hits; }
+	uint64_t cache_misses() const { return m_cache_misses; }
+	uint64_t cache_readahead() const { return m_cache_readahead; }
+	osd_ticks_t decompress_ticks() const { return m_decompress_ticks; }
+
 	// file create
 	chd_error create(const char *filename, uint64_t logicalbytes, uint32_t hunkbytes, uint32_t unitbytes, chd_codec_type compression[4]);
 	chd_error create(util::core_file &file, uint64_t logicalbytes, uint32_t hunkbytes, uint32_t unitbytes, chd_codec_type compression[4]);
@@ -400,6 +413,12 @@ private:
 	void metadata_update_hash();
 	static int CLIB_DECL metadata_hash_compare(const void *elem1, const void *elem2);
 
+	// cache helpers
+	std::vector<uint8_t> *cache_lookup(uint32_t hunknum, chd_error &err);
+	std::vector<uint8_t> *cache_fill(uint32_t hunknum, chd_error &err);
+	void cache_note_access(uint32_t hunknum);
+	static void *readahead_callback(void *param, int threadid);
+
 	// file characteristics
 	util::core_file *       m_file;             // handle to the open core file
 	bool                    m_owns_file;        // flag indicating if this file should be closed on chd_close()
@@ -435,8 +454,18 @@ private:
 	std::vector<uint8_t>          m_compressed;       // temporary buffer for compressed data
 
 	// caching
-	std::vector<uint8_t>          m_cache;            // single-hunk cache for partial reads/writes
-	uint32_t                  m_cachehunk;        // which hunk is in the cache?
+	typedef util::lru_cache_map<uint32_t, std::vector<uint8_t>> hunk_cache;
+	std::recursive_mutex    m_mutex;            // serializes file, codec and cache access with read-ahead
+	hunk_cache              m_hunk_cache;       // most recently used decompressed hunks
+	uint32_t                  m_last_hunk;        // last hunk read through the cache
+	uint32_t                  m_sequential;       // consecutive hunks read in order
+	osd_work_queue *        m_readahead_queue;  // queue for decompressing ahead, allocated on demand
+	osd_work_item *         m_readahead_item;   // the read-ahead queued or running, if any
+	uint32_t                  m_readahead_start;  // first hunk the pending read-ahead should decompress
+	std::atomic<uint64_t>   m_cache_hits;       // reads satisfied from the cache
+	std::atomic<uint64_t>   m_cache_misses;     // reads that had to decompress
+	std::atomic<uint64_t>   m_cache_readahead;  // hunks decompressed ahead of demand
+	std::atomic<osd_ticks_t> m_decompress_ticks;// time spent reading and decompressing hunks
 };
 
 
@@ -451,6 +480,7 @@ public:
 	virtual ~chd_file_compressor();
 
 	// compression management
+	void set_ratio_budget(uint32_t percent) { m_ratio_budget = percent; }
 	void compress_begin();
 	chd_error compress_continue(double &progress, double &ratio);
 
@@ -575,6 +605,7 @@ private:
 	std::vector<uint8_t>          m_compressed_buffer;// buffer containing compressed data
 	work_item               m_work_item[WORK_BUFFER_HUNKS]; // status of each hunk
 	chd_compressor_group *  m_codecs[WORK_MAX_THREADS]; // codecs to use
+	uint32_t                  m_ratio_budget;     // percent of size to give up for faster decompression
 
 	// output state
 	uint32_t                  m_write_hunk;       // next hunk to write
@@ -18,6 +18,7 @@
 #include <zlib.h>
 #include "lzma/C/LzmaEnc.h"
 #include "lzma/C/LzmaDec.h"
+#include <zstd.h>
 #include <new>
 
 
@@ -159,6 +160,44 @@ private:
 };
 
 
+// ======================> chd_zstd_compressor
+
+// Zstandard compressor
+class chd_zstd_compressor : public chd_compressor
+{
+public:
+	// construction/destruction
+	chd_zstd_compressor(chd_file &chd, uint32_t hunkbytes, bool lossy);
+	~chd_zstd_compressor();
+
+	// core functionality
+	virtual uint32_t compress(const uint8_t *src, uint32_t srclen, uint8_t *dest) override;
+
+private:
+	// internal state
+	ZSTD_CCtx *             m_context;
+};
+
+
+// ======================> chd_zstd_decompressor
+
+// Zstandard decompressor
+class chd_zstd_decompressor : public chd_decompressor
+{
+public:
+	// construction/destruction
+	chd_zstd_decompressor(chd_file &chd, uint32_t hunkbytes, bool lossy);
+	~chd_zstd_decompressor();
+
+	// core functionality
+	virtual void decompress(const uint8_t *src, uint32_t complen, uint8_t *dest, uint32_t destlen) override;
+
+private:
+	// internal state
+	ZSTD_DCtx *             m_context;
+};
+
+
 // ======================> chd_huffman_compressor
 
 // Huffman compressor
@@ -460,22 +499,27 @@ private:
 //  CODEC LIST
 //**************************************************************************
 
-// static list of available known codecs
+// static list of available known codecs; the cost column is the time to decompress
+// a 16k hunk in units of 10us (the median over executable, text and PCM samples on
+// x86-64), used to trade size for speed within a ratio budget; it's a fixed table
+// rather than timed at run time so the same input always gives the same CHD
 const chd_codec_list::codec_entry chd_codec_list::s_codec_list[] =
 {
 	// general codecs
-	{ CHD_CODEC_ZLIB,       false,  "Deflate",              &chd_codec_list::construct_compressor<chd_zlib_compressor>,     &chd_codec_list::construct_decompressor<chd_zlib_decompressor> },
-	{ CHD_CODEC_LZMA,       false,  "LZMA",                 &chd_codec_list::construct_compressor<chd_lzma_compressor>,     &chd_codec_list::construct_decompressor<chd_lzma_decompressor> },
-	{ CHD_CODEC_HUFFMAN,    false,  "Huffman",              &chd_codec_list::construct_compressor<chd_huffman_compressor>,  &chd_codec_list::construct_decompressor<chd_huffman_decompressor> },
-	{ CHD_CODEC_FLAC,       false,  "FLAC",                 &chd_codec_list::construct_compressor<chd_flac_compressor>,     &chd_codec_list::construct_decompressor<chd_flac_decompressor> },
+	{ CHD_CODEC_ZLIB,       false,  "Deflate",              4,   &chd_codec_list::construct_compressor<chd_zlib_compressor>,     &chd_codec_list::construct_decompressor<chd_zlib_decompressor> },
+	{ CHD_CODEC_LZMA,       false,  "LZMA",                 29,  &chd_codec_list::construct_compressor<chd_lzma_compressor>,     &chd_codec_list::construct_decompressor<chd_lzma_decompressor> },
+	{ CHD_CODEC_HUFFMAN,    false,  "Huffman",              13,  &chd_codec_list::construct_compressor<chd_huffman_compressor>,  &chd_codec_list::construct_decompressor<chd_huffman_decompressor> },
+	{ CHD_CODEC_FLAC,       false,  "FLAC",                 11,  &chd_codec_list::construct_compressor<chd_flac_compressor>,     &chd_codec_list::construct_decompressor<chd_flac_decompressor> },
+	{ CHD_CODEC_ZSTD,       false,  "Zstandard",            2,   &chd_codec_list::construct_compressor<chd_zstd_compressor>,     &chd_codec_list::construct_decompressor<chd_zstd_decompressor> },
 
 	// general codecs with CD frontend
-	{ CHD_CODEC_CD_ZLIB,    false,  "CD Deflate",           &chd_codec_list::construct_compressor<chd_cd_compressor<chd_zlib_compressor, chd_zlib_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_zlib_decompressor, chd_zlib_decompressor> > },
-	{ CHD_CODEC_CD_LZMA,    false,  "CD LZMA",              &chd_codec_list::construct_compressor<chd_cd_compressor<chd_lzma_compressor, chd_zlib_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_lzma_decompressor, chd_zlib_decompressor> > },
-	{ CHD_CODEC_CD_FLAC,    false,  "CD FLAC",              &chd_codec_list::construct_compressor<chd_cd_flac_compressor>,  &chd_codec_list::construct_decompressor<chd_cd_flac_decompressor> },
+	{ CHD_CODEC_CD_ZLIB,    false,  "CD Deflate",           4,   &chd_codec_list::construct_compressor<chd_cd_compressor<chd_zlib_compressor, chd_zlib_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_zlib_decompressor, chd_zlib_decompressor> > },
+	{ CHD_CODEC_CD_LZMA,    false,  "CD LZMA",              29,  &chd_codec_list::construct_compressor<chd_cd_compressor<chd_lzma_compressor, chd_zlib_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_lzma_decompressor, chd_zlib_decompressor> > },
+	{ CHD_CODEC_CD_FLAC,    false,  "CD FLAC",              11,  &chd_codec_list::construct_compressor<chd_cd_flac_compressor>,  &chd_codec_list::construct_decompressor<chd_cd_flac_decompressor> },
+	{ CHD_CODEC_CD_ZSTD,    false,  "CD Zstandard",         2,   &chd_codec_list::construct_compressor<chd_cd_compressor<chd_zstd_compressor, chd_zstd_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_zstd_decompressor, chd_zstd_decompressor> > },
 
 	// A/V codecs
-	{ CHD_CODEC_AVHUFF,     false,  "A/V Huffman",          &chd_codec_list::construct_compressor<chd_avhuff_compressor>,   &chd_codec_list::construct_decompressor<chd_avhuff_decompressor> },
+	{ CHD_CODEC_AVHUFF,     false,  "A/V Huffman",          13,  &chd_codec_list::construct_compressor<chd_avhuff_compressor>,   &chd_codec_list::construct_decompressor<chd_avhuff_decompressor> },
 };
 
 
@@ -590,6 +634,18 @@ const char *chd_codec_list::codec_name(chd_codec_type type)
 }
 
 
+//-------------------------------------------------
+//  decompress_cost - return the relative cost of
+//  decompressing a hunk with the given codec
+//-------------------------------------------------
+
+uint32_t chd_codec_list::decompress_cost(chd_codec_type type)
+{
+	const codec_entry *entry = find_in_list(type);
+	return (entry == nullptr) ? 0 : entry->m_decompress_cost;
+}
+
+
 //-------------------------------------------------
 //  find_in_list - create a new compressor
 //  instance of the given type
@@ -614,9 +670,9 @@ const chd_codec_list::codec_entry *chd_codec_list::find_in_list(chd_codec_type t
 //  chd_compressor_group - constructor
 //-------------------------------------------------
 
-chd_compressor_group::chd_compressor_group(chd_file &chd, uint32_t compressor_list[4])
+chd_compressor_group::chd_compressor_group(chd_file &chd, uint32_t compressor_list[4], uint32_t ratio_budget)
 	: m_hunkbytes(chd.hunk_bytes()),
-		m_compress_test(m_hunkbytes)
+		m_ratio_budget(ratio_budget)
 #if CHDCODEC_VERIFY_COMPRESSION
 		,m_decompressed(m_hunkbytes)
 #endif
@@ -625,11 +681,16 @@ chd_compressor_group::chd_compressor_group(chd_file &chd, uint32_t compressor_li
 	for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
 	{
 		m_compressor[codecnum] = nullptr;
+#if CHDCODEC_VERIFY_COMPRESSION
+		m_decompressor[codecnum] = nullptr;
+#endif
+		m_cost[codecnum] = chd_codec_list::decompress_cost(compressor_list[codecnum]);
 		if (compressor_list[codecnum] != CHD_CODEC_NONE)
 		{
 			m_compressor[codecnum] = chd_codec_list::new_compressor(compressor_list[codecnum], chd);
 			if (m_compressor[codecnum] == nullptr)
 				throw CHDERR_UNKNOWN_COMPRESSION;
+			m_compress_test[codecnum].resize(m_hunkbytes);
 #if CHDCODEC_VERIFY_COMPRESSION
 			m_decompressor[codecnum] = chd_codec_list::new_decompressor(compressor_list[codecnum], chd);
 			if (m_decompressor[codecnum] == nullptr)
@@ -649,33 +710,41 @@ chd_compressor_group::~chd_compressor_group()
 	// delete the codecs and the test buffer
 	for (auto & elem : m_compressor)
 		delete elem;
+#if CHDCODEC_VERIFY_COMPRESSION
+	for (auto & elem : m_decompressor)
+		delete elem;
+#endif
 }
 
 
 //-------------------------------------------------
 //  find_best_compressor - iterate over all codecs
 //  to determine which one produces the best
-//  compression for this hunk
+//  compression for this hunk; with a ratio budget,
+//  the cheapest to decode of those within budget of
+//  the smallest wins
 //-------------------------------------------------
 
 int8_t chd_compressor_group::find_best_compressor(const uint8_t *src, uint8_t *compressed, uint32_t &complen)
 {
-	// determine best compression technique
-	complen = m_hunkbytes;
+	// try every codec, noting the smallest result
+	uint32_t compsize[ARRAY_LENGTH(m_compressor)];
+	uint32_t smallest = m_hunkbytes;
 	int8_t compression = -1;
 	for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
+	{
+		compsize[codecnum] = m_hunkbytes;
 		if (m_compressor[codecnum] != nullptr)
 		{
 			// attempt to compress, swallowing errors
 			try
 			{
-				// if this is the best one, copy the data into the permanent buffer
-				uint32_t compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, &m_compress_test[0]);
+				uint32_t compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, &m_compress_test[codecnum][0]);
 #if CHDCODEC_VERIFY_COMPRESSION
 				try
 				{
 					memset(m_decompressed, 0, m_hunkbytes);
-					m_decompressor[codecnum]->decompress(m_compress_test, compbytes, m_decompressed, m_hunkbytes);
+					m_decompressor[codecnum]->decompress(m_compress_test[codecnum], compbytes, m_decompressed, m_hunkbytes);
 				}
 				catch (...)
 				{
@@ -683,10 +752,10 @@ int8_t chd_compressor_group::find_best_compressor(const uint8_t *src, uint8_t *c
 
 				if (memcmp(src, m_decompressed, m_hunkbytes) != 0)
 				{
-					compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, m_compress_test);
+					compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, m_compress_test[codecnum]);
 					try
 					{
-						m_decompressor[codecnum]->decompress(m_compress_test, compbytes, m_decompressed, m_hunkbytes);
+						m_decompressor[codecnum]->decompress(m_compress_test[codecnum], compbytes, m_decompressed, m_hunkbytes);
 					}
 					catch (...)
 					{
@@ -695,19 +764,39 @@ int8_t chd_compressor_group::find_best_compressor(const uint8_t *src, uint8_t *c
 				}
 printf("   codec%d=%d bytes            \n", codecnum, compbytes);
 #endif
-				if (compbytes < complen)
+				compsize[codecnum] = compbytes;
+				if (compbytes < smallest)
 				{
 					compression = codecnum;
-					complen = compbytes;
-					memcpy(compressed, &m_compress_test[0], compbytes);
+					smallest = compbytes;
 				}
 			}
 			catch (...) { }
 		}
+	}
 
-	// if the best is none, copy it over
+	// trade some size for speed if allowed: of the results within budget of the smallest,
+	// take the codec that is cheapest to decode; storing the hunk uncompressed is never
+	// chosen this way, and ties keep the earlier codec so the output is reproducible
+	if (compression != -1 && m_ratio_budget != 0)
+	{
+		uint64_t const limit = uint64_t(smallest) * (100 + m_ratio_budget) / 100;
+		for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
+			if (compsize[codecnum] < m_hunkbytes && compsize[codecnum] <= limit && m_cost[codecnum] < m_cost[compression])
+				compression = codecnum;
+	}
+
+	// copy the winner over, or the raw data if nothing helped
 	if (compression == -1)
+	{
+		complen = m_hunkbytes;
 		memcpy(compressed, src, m_hunkbytes);
+	}
+	else
+	{
+		complen = compsize[compression];
+		memcpy(compressed, &m_compress_test[compression][0], complen);
+	}
 	return compression;
 }
 
@@ -1193,6 +1282,93 @@ void chd_lzma_decompressor::decompress(const uint8_t *src, uint32_t complen, uin
 
 
 
+//**************************************************************************
+//  ZSTANDARD COMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_zstd_compressor - constructor
+//-------------------------------------------------
+
+chd_zstd_compressor::chd_zstd_compressor(chd_file &chd, uint32_t hunkbytes, bool lossy)
+	: chd_compressor(chd, hunkbytes, lossy),
+		m_context(ZSTD_createCCtx())
+{
+	if (m_context == nullptr)
+		throw std::bad_alloc();
+}
+
+
+//-------------------------------------------------
+//  ~chd_zstd_compressor - destructor
+//-------------------------------------------------
+
+chd_zstd_compressor::~chd_zstd_compressor()
+{
+	ZSTD_freeCCtx(m_context);
+}
+
+
+//-------------------------------------------------
+//  compress - compress data using the Zstandard
+//  codec
+//-------------------------------------------------
+
+uint32_t chd_zstd_compressor::compress(const uint8_t *src, uint32_t srclen, uint8_t *dest)
+{
+	// CHDs are compressed once and read many times, so spend the time; the
+	// levels above 19 only help with inputs far bigger than a hunk
+	size_t const result = ZSTD_compressCCtx(m_context, dest, srclen, src, srclen, 19);
+
+	// if we ended up with more data than we started with, return an error
+	if (ZSTD_isError(result) || result >= srclen)
+		throw CHDERR_COMPRESSION_ERROR;
+	return result;
+}
+
+
+
+//**************************************************************************
+//  ZSTANDARD DECOMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_zstd_decompressor - constructor
+//-------------------------------------------------
+
+chd_zstd_decompressor::chd_zstd_decompressor(chd_file &chd, uint32_t hunkbytes, bool lossy)
+	: chd_decompressor(chd, hunkbytes, lossy),
+		m_context(ZSTD_createDCtx())
+{
+	if (m_context == nullptr)
+		throw std::bad_alloc();
+}
+
+
+//-------------------------------------------------
+//  ~chd_zstd_decompressor - destructor
+//-------------------------------------------------
+
+chd_zstd_decompressor::~chd_zstd_decompressor()
+{
+	ZSTD_freeDCtx(m_context);
+}
+
+
+//-------------------------------------------------
+//  decompress - decompress data using the
+//  Zstandard codec
+//-------------------------------------------------
+
+void chd_zstd_decompressor::decompress(const uint8_t *src, uint32_t complen, uint8_t *dest, uint32_t destlen)
+{
+	size_t const result = ZSTD_decompressDCtx(m_context, dest, destlen, src, complen);
+	if (ZSTD_isError(result) || result != destlen)
+		throw CHDERR_DECOMPRESSION_ERROR;
+}
+
+
+
 //**************************************************************************
 //  HUFFMAN COMPRESSOR
 //**************************************************************************
@@ -111,6 +111,7 @@ public:
 	// utilities
 	static bool codec_exists(chd_codec_type type) { return (find_in_list(type) != nullptr); }
 	static const char *codec_name(chd_codec_type type);
+	static uint32_t decompress_cost(chd_codec_type type);
 
 private:
 	// an entry in the list
@@ -119,6 +120,7 @@ private:
 		chd_codec_type      m_type;
 		bool                m_lossy;
 		const char *        m_name;
+		uint32_t            m_decompress_cost;
 		chd_compressor *    (*m_construct_compressor)(chd_file &, uint32_t, bool);
 		chd_decompressor *  (*m_construct_decompressor)(chd_file &, uint32_t, bool);
 	};
@@ -144,7 +146,7 @@ class chd_compressor_group
 {
 public:
 	// construction/destruction
-	chd_compressor_group(chd_file &file, chd_codec_type compressor_list[4]);
+	chd_compressor_group(chd_file &file, chd_codec_type compressor_list[4], uint32_t ratio_budget = 0);
 	~chd_compressor_group();
 
 	// find the best compressor
@@ -153,8 +155,10 @@ public:
 private:
 	// internal state
 	uint32_t                  m_hunkbytes;        // number of bytes in a hunk
+	uint32_t                  m_ratio_budget;     // percent larger than the smallest result allowed for faster decompression
 	chd_compressor *        m_compressor[4];    // array of active codecs
-	std::vector<uint8_t>          m_compress_test;    // test buffer for compression
+	uint32_t                  m_cost[4];          // relative decompression cost of each codec
+	std::vector<uint8_t>          m_compress_test[4]; // test buffers for compression
 #if CHDCODEC_VERIFY_COMPRESSION
 	chd_decompressor *      m_decompressor[4];  // array of active codecs
 	std::vector<uint8_t>          m_decompressed;     // verification buffer
@@ -175,11 +179,13 @@ const chd_codec_type CHD_CODEC_ZLIB         = CHD_MAKE_TAG('z','l','i','b');
 const chd_codec_type CHD_CODEC_LZMA         = CHD_MAKE_TAG('l','z','m','a');
 const chd_codec_type CHD_CODEC_HUFFMAN      = CHD_MAKE_TAG('h','u','f','f');
 const chd_codec_type CHD_CODEC_FLAC         = CHD_MAKE_TAG('f','l','a','c');
+const chd_codec_type CHD_CODEC_ZSTD         = CHD_MAKE_TAG('z','s','t','d');
 
 // general codecs with CD frontend
 const chd_codec_type CHD_CODEC_CD_ZLIB      = CHD_MAKE_TAG('c','d','z','l');
 const chd_codec_type CHD_CODEC_CD_LZMA      = CHD_MAKE_TAG('c','d','l','z');
 const chd_codec_type CHD_CODEC_CD_FLAC      = CHD_MAKE_TAG('c','d','f','l');
+const chd_codec_type CHD_CODEC_CD_ZSTD      = CHD_MAKE_TAG('c','d','z','s');
 
 // A/V codecs
 const chd_codec_type CHD_CODEC_AVHUFF       = CHD_MAKE_TAG('a','v','h','u');
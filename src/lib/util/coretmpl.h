@@ -16,6 +16,7 @@
 #include "osdcore.h"
 #include "corealloc.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstddef>
@@ -957,6 +958,136 @@ private:
 };
 
 
+// ======================> intrusive_heap
+
+// an intrusive_heap is a d-ary min-heap of pointers to objects that record
+// their own position, so arbitrary members can be removed or re-keyed in
+// O(log n); Traits must provide static less(T const &, T const &) and
+// index(T &) returning a reference to a std::size_t owned by the object
+template <typename T, typename Traits, unsigned Arity = 4>
+class intrusive_heap
+{
+public:
+	static constexpr std::size_t npos = ~std::size_t(0);
+
+	intrusive_heap() { static_assert(1U < Arity, "heap must have an arity of at least two"); }
+	intrusive_heap(intrusive_heap const &) = delete;
+	intrusive_heap &operator=(intrusive_heap const &) = delete;
+
+	// simple getters
+	bool empty() const noexcept { return m_heap.empty(); }
+	std::size_t size() const noexcept { return m_heap.size(); }
+	T *top() const noexcept { return m_heap.empty() ? nullptr : m_heap.front(); }
+	static bool contains(T &item) noexcept { return Traits::index(item) != npos; }
+
+	// unordered iteration over the current members
+	typename std::vector<T *>::const_iterator begin() const noexcept { return m_heap.begin(); }
+	typename std::vector<T *>::const_iterator end() const noexcept { return m_heap.end(); }
+
+	void reserve(std::size_t count) { m_heap.reserve(count); }
+
+	// add an object that is not currently a member
+	void push(T &item)
+	{
+		assert(!contains(item));
+		m_heap.push_back(&item);
+		Traits::index(item) = m_heap.size() - 1;
+		sift_up(m_heap.size() - 1);
+	}
+
+	// remove and return the smallest member
+	T *pop()
+	{
+		T *const result = top();
+		if (result != nullptr)
+			remove(*result);
+		return result;
+	}
+
+	// remove an arbitrary member
+	void remove(T &item)
+	{
+		std::size_t const pos = Traits::index(item);
+		assert((pos < m_heap.size()) && (m_heap[pos] == &item));
+		Traits::index(item) = npos;
+		T *const last = m_heap.back();
+		m_heap.pop_back();
+		if (last != &item)
+		{
+			place(pos, *last);
+			update(*last);
+		}
+	}
+
+	// restore ordering after the key of a member has changed
+	void update(T &item)
+	{
+		std::size_t const pos = Traits::index(item);
+		assert((pos < m_heap.size()) && (m_heap[pos] == &item));
+		if ((pos > 0) && Traits::less(item, *m_heap[(pos - 1) / Arity]))
+			sift_up(pos);
+		else
+			sift_down(pos);
+	}
+
+	// remove all members
+	void clear()
+	{
+		for (T *item : m_heap)
+			Traits::index(*item) = npos;
+		m_heap.clear();
+	}
+
+private:
+	void place(std::size_t pos, T &item)
+	{
+		m_heap[pos] = &item;
+		Traits::index(item) = pos;
+	}
+
+	void sift_up(std::size_t pos)
+	{
+		T &item(*m_heap[pos]);
+		while (pos > 0)
+		{
+			std::size_t const parent = (pos - 1) / Arity;
+			if (!Traits::less(item, *m_heap[parent]))
+				break;
+			place(pos, *m_heap[parent]);
+			pos = parent;
+		}
+		place(pos, item);
+	}
+
+	void sift_down(std::size_t pos)
+	{
+		T &item(*m_heap[pos]);
+		std::size_t const count = m_heap.size();
+		while (true)
+		{
+			// find the smallest child, if any
+			std::size_t const first = (pos * Arity) + 1;
+			if (first >= count)
+				break;
+			std::size_t const last = std::min<std::size_t>(first + Arity, count);
+			std::size_t best = first;
+			for (std::size_t child = first + 1; child < last; ++child)
+				if (Traits::less(*m_heap[child], *m_heap[best]))
+					best = child;
+
+			// stop when the item is no larger than all of its children
+			if (!Traits::less(*m_heap[best], item))
+				break;
+			place(pos, *m_heap[best]);
+			pos = best;
+		}
+		place(pos, item);
+	}
+
+	std::vector<T *> m_heap;
+};
+
+
 template <typename E>
 using enable_enum_t = typename std::enable_if_t<std::is_enum<E>::value, typename std::underlying_type_t<E> >;
 
@@ -200,29 +200,33 @@ void dc_state::g2_dma_execute(address_space &space, int channel)
 	uint32_t src,dst,size;
 	dst = m_g2_dma[channel].g2_addr;
 	src = m_g2_dma[channel].root_addr;
-	size = 0;
 
 	/* 0 rounding size = 32 Mbytes */
 	if (m_g2_dma[channel].size == 0) { m_g2_dma[channel].size = 0x200000; }
 
-	if (m_g2_dma[channel].dir == 0)
+	/* RAM to RAM transfers that don't overlap are copied as a block; anything else a dword at a time, in order */
+	const uint32_t from = (m_g2_dma[channel].dir == 0) ? src : dst;
+	const uint32_t to = (m_g2_dma[channel].dir == 0) ? dst : src;
+	const uint32_t count = (m_g2_dma[channel].size + 3) / 4;
+	const uint32_t last = count * 4 - 1;
+	const uint8_t *fromptr = reinterpret_cast<const uint8_t *>(space.get_read_ptr(from));
+	const uint8_t *fromend = reinterpret_cast<const uint8_t *>(space.get_read_ptr(from + last));
+	uint8_t *toptr = reinterpret_cast<uint8_t *>(space.get_write_ptr(to));
+	uint8_t *toend = reinterpret_cast<uint8_t *>(space.get_write_ptr(to + last));
+	if (fromptr && fromend && toptr && toend && (fromend - fromptr == last) && (toend - toptr == last) && (fromptr + last < toptr || toptr + last < fromptr))
 	{
-		for (; size<m_g2_dma[channel].size; size += 4)
-		{
-			space.write_dword(dst,space.read_dword(src));
-			src+=4;
-			dst+=4;
-		}
+		std::vector<uint32_t> buffer(count);
+		space.read_block(from, buffer.data(), count);
+		space.write_block(to, buffer.data(), count);
 	}
 	else
 	{
-		for (; size<m_g2_dma[channel].size; size += 4)
-		{
-			space.write_dword(src,space.read_dword(dst));
-			src+=4;
-			dst+=4;
-		}
+		for (uint32_t i = 0; i < count; i++)
+			space.write_dword(to + i * 4, space.read_dword(from + i * 4));
 	}
+	size = count * 4;
+	src += size;
+	dst += size;
 
 	/* update the params*/
 	m_g2_dma[channel].g2_addr = g2bus_regs[SB_ADSTAG + (channel * 8)] = dst;
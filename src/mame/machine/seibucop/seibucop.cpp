@@ -783,7 +783,6 @@ WRITE16_MEMBER(raiden2cop_device::cop_dma_trigger_w)
 	case 0x09:
 	{
 		uint32_t src, dst, size;
-		int i;
 
 		src = (cop_dma_src[cop_dma_mode] << 6);
 		dst = (cop_dma_dst[cop_dma_mode] << 6);
@@ -791,30 +790,20 @@ WRITE16_MEMBER(raiden2cop_device::cop_dma_trigger_w)
 
 		//      printf("%08x %08x %08x\n",src,dst,size);
 
-		for (i = 0; i < size; i++)
-		{
-			m_host_space->write_word(dst, m_host_space->read_word(src));
-			src += 2;
-			dst += 2;
-		}
+		dma_copy_words(src, dst, size);
 
 		break;
 	}
 	/********************************************************************************************************************/
 	case 0x0e:  // Godzilla / Seibu Cup Soccer
 	{
-		uint32_t src, dst, size, i;
+		uint32_t src, dst, size;
 
 		src = (cop_dma_src[cop_dma_mode] << 6);
 		dst = (cop_dma_dst[cop_dma_mode] << 6);
 		size = ((cop_dma_size[cop_dma_mode] << 5) - (cop_dma_dst[cop_dma_mode] << 6) + 0x20) / 2;
 
-		for (i = 0; i < size; i++)
-		{
-			m_host_space->write_word(dst, m_host_space->read_word(src));
-			src += 2;
-			dst += 2;
-		}
+		dma_copy_words(src, dst, size);
 
 		break;
 	}
@@ -263,6 +263,7 @@ private:
 	void dma_tilemap_buffer();
 	void dma_palette_buffer();
 	void dma_fill();
+	void dma_copy_words(uint32_t src, uint32_t dst, uint32_t size);
 	void dma_palette_brightness();
 	void dma_zsorting(uint16_t data);
 };
@@ -27,6 +27,36 @@ void raiden2cop_device::dma_palette_buffer()
 	}
 }
 
+// plain word copies (0x09 and 0x0e); RAM to RAM copies that don't overlap are done as a block,
+// anything else a word at a time, in the same order as before
+void raiden2cop_device::dma_copy_words(uint32_t src, uint32_t dst, uint32_t size)
+{
+	// a size register below the destination makes the count wrap; don't go round the space more than once
+	size = std::min<uint32_t>(size, (m_host_space->addrmask() >> 1) + 1);
+	if (size == 0)
+		return;
+
+	const uint32_t last = size * 2 - 1;
+	const uint8_t *srcptr = reinterpret_cast<const uint8_t *>(m_host_space->get_read_ptr(src));
+	const uint8_t *srcend = reinterpret_cast<const uint8_t *>(m_host_space->get_read_ptr(src + last));
+	uint8_t *dstptr = reinterpret_cast<uint8_t *>(m_host_space->get_write_ptr(dst));
+	uint8_t *dstend = reinterpret_cast<uint8_t *>(m_host_space->get_write_ptr(dst + last));
+	if (srcptr && srcend && dstptr && dstend && (srcend - srcptr == last) && (dstend - dstptr == last) && (srcptr + last < dstptr || dstptr + last < srcptr))
+	{
+		std::vector<uint16_t> buffer(size);
+		m_host_space->read_block(src, buffer.data(), size);
+		m_host_space->write_block(dst, buffer.data(), size);
+		return;
+	}
+
+	for (uint32_t i = 0; i < size; i++)
+	{
+		m_host_space->write_word(dst, m_host_space->read_word(src));
+		src += 2;
+		dst += 2;
+	}
+}
+
 // these are typically used to transfer palette data from one RAM buffer to another, applying fade values to it prior to the 0x15 transfer
 void raiden2cop_device::dma_palette_brightness()
 {
@@ -43,6 +43,7 @@ public:
 	model3_renderer(model3_state &state, int width, int height)
 		: poly_manager<float, model3_polydata, 6, 50000>(state.machine())
 	{
+		configure_bins(width, height);
 		m_fb = std::make_unique<bitmap_rgb32>(width, height);
 		m_zb = std::make_unique<bitmap_ind32>(width, height);
 	}
@@ -13,28 +13,45 @@
 tc0780fpa_renderer::tc0780fpa_renderer(device_t &parent, screen_device &screen, const uint8_t *texture_ram)
 	: poly_manager<float, tc0780fpa_polydata, 6, 10000>(screen)
 {
-	int width = screen.width();
-	int height = screen.height();
+	init(screen.width(), screen.height(), texture_ram);
 
+	m_cliprect = screen.cliprect();
+
+	// save state
+	parent.save_item(NAME(*m_fb[0]));
+	parent.save_item(NAME(*m_fb[1]));
+	parent.save_item(NAME(*m_zb));
+}
+
+tc0780fpa_renderer::tc0780fpa_renderer(int width, int height, const uint8_t *texture_ram, uint8_t flags)
+	: poly_manager<float, tc0780fpa_polydata, 6, 10000>(flags)
+{
+	init(width, height, texture_ram);
+
+	m_cliprect.set(0, width - 1, 0, height - 1);
+}
+
+void tc0780fpa_renderer::init(int width, int height, const uint8_t *texture_ram)
+{
 	m_fb[0] = std::make_unique<bitmap_ind16>(width, height);
 	m_fb[1] = std::make_unique<bitmap_ind16>(width, height);
 	m_zb = std::make_unique<bitmap_ind16>(width, height);
 
 	m_texture = texture_ram;
-
-	m_cliprect = screen.cliprect();
+	m_texture_dirty = true;
 
 	m_current_fb = 0;
 
-	// save state
-	parent.save_item(NAME(*m_fb[0]));
-	parent.save_item(NAME(*m_fb[1]));
-	parent.save_item(NAME(*m_zb));
+	// name the callbacks for polygon stream captures
+	capture_name(render_delegate(&tc0780fpa_renderer::render_solid_scan, this), "render_solid_scan");
+	capture_name(render_delegate(&tc0780fpa_renderer::render_shade_scan, this), "render_shade_scan");
+	capture_name(render_delegate(&tc0780fpa_renderer::render_texture_scan, this), "render_texture_scan");
 }
 
 void tc0780fpa_renderer::swap_buffers()
 {
 	wait("Finished render");
+	capture_data(CAPTURE_SWAP, nullptr, 0);
 
 	m_current_fb ^= 1;
 
@@ -159,6 +176,13 @@ void tc0780fpa_renderer::render(uint16_t *polygon_fifo, int length)
 
 	uint16_t cmd = polygon_fifo[0];
 
+	// captures need the textures the primitives are drawn with
+	if (m_texture_dirty && capturing())
+	{
+		capture_data(CAPTURE_TEXTURE, m_texture, 2048 * 2048);
+		m_texture_dirty = false;
+	}
+
 	int ptr = 1;
 	switch (cmd & 0x7)
 	{
@@ -416,6 +440,7 @@ void tc0780fpa_device::device_start()
 	save_item(NAME(m_tex_offset));
 	save_item(NAME(m_texbase_x));
 	save_item(NAME(m_texbase_y));
+	machine().save().register_postload(save_prepost_delegate(FUNC(tc0780fpa_renderer::texture_changed), m_renderer.get()));
 }
 
 //-------------------------------------------------
@@ -462,6 +487,7 @@ WRITE16_MEMBER(tc0780fpa_device::tex_w)
 
 	int index = (((m_texbase_y * 32) + y) * 2048) + ((m_texbase_x * 32) + x);
 	m_texture[index] = data & 0xff;
+	m_renderer->texture_changed();
 
 	m_tex_offset++;
 }
@@ -21,7 +21,15 @@ struct tc0780fpa_polydata
 class tc0780fpa_renderer : public poly_manager<float, tc0780fpa_polydata, 6, 10000>
 {
 public:
+	// tags of the driver data in polygon stream captures
+	enum : uint32_t
+	{
+		CAPTURE_TEXTURE,            // texture RAM, whenever it changed since the last one
+		CAPTURE_SWAP                // swap_buffers
+	};
+
 	tc0780fpa_renderer(device_t &parent, screen_device &screen, const uint8_t *texture_ram);
+	tc0780fpa_renderer(int width, int height, const uint8_t *texture_ram, uint8_t flags = 0); // for replaying captures
 
 	void render_solid_scan(int32_t scanline, const extent_t &extent, const tc0780fpa_polydata &extradata, int threadid);
 	void render_shade_scan(int32_t scanline, const extent_t &extent, const tc0780fpa_polydata &extradata, int threadid);
@@ -30,11 +38,15 @@ public:
 	void render(uint16_t *polygon_fifo, int length);
 	void draw(bitmap_ind16 &bitmap, const rectangle &cliprect);
 	void swap_buffers();
+	void texture_changed() { m_texture_dirty = true; }
 
 private:
+	void init(int width, int height, const uint8_t *texture_ram);
+
 	std::unique_ptr<bitmap_ind16> m_fb[2];
 	std::unique_ptr<bitmap_ind16> m_zb;
 	const uint8_t *m_texture;
+	bool m_texture_dirty;
 
 	rectangle m_cliprect;
 
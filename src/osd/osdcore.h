@@ -557,6 +557,24 @@ osd_work_queue *osd_work_queue_alloc(int flags);
 int osd_work_queue_items(osd_work_queue *queue);
 
 
+/*-----------------------------------------------------------------------------
+    osd_work_queue_threads: return the number of threads processing items
+
+    Parameters:
+
+        queue - pointer to an osd_work_queue that was previously created via
+            osd_work_queue_alloc
+
+    Return value:
+
+        The number of threads that process items on the queue, including
+        the thread calling osd_work_queue_wait for WORK_QUEUE_FLAG_MULTI
+        queues. This follows the configured processor count, so it is the
+        number of pieces worth splitting work into.
+-----------------------------------------------------------------------------*/
+int osd_work_queue_threads(osd_work_queue *queue);
+
+
 /*-----------------------------------------------------------------------------
     osd_work_queue_wait: wait for the queue to be empty
 
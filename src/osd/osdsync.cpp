@@ -338,6 +338,17 @@ int osd_work_queue_items(osd_work_queue *queue)
 }
 
 
+//============================================================
+//  osd_work_queue_threads
+//============================================================
+
+int osd_work_queue_threads(osd_work_queue *queue)
+{
+	// multi queues are also worked on by the thread waiting on them
+	return queue->threads + ((queue->flags & WORK_QUEUE_FLAG_MULTI) ? 1 : 0);
+}
+
+
 //============================================================
 //  osd_work_queue_wait
 //============================================================
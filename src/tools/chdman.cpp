@@ -26,8 +26,10 @@
 #include <iostream>
 #include <cassert>
 #include <cstring>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <unordered_map>
 
@@ -104,6 +106,7 @@ const int MODE_GDI = 2;
 #define OPTION_VERBOSE "verbose"
 #define OPTION_FIX "fix"
 #define OPTION_NUMPROCESSORS "numprocessors"
+#define OPTION_RATIO_BUDGET "ratiobudget"
 #define OPTION_SIZE "size"
 #define OPTION_TEMPLATE "template"
 
@@ -154,7 +157,7 @@ struct command_description
 	const char *name;
 	void (*handler)(parameters_t &);
 	const char *description;
-	const char *valid_options[16];
+	const char *valid_options[20];
 };
 
 
@@ -548,6 +551,192 @@ private:
 };
 
 
+// ======================> parallel_chd_reader
+
+// fills consecutive chunks of output from a CHD on worker threads, each with
+// its own handle on the file so the decompressors run in parallel, and hands
+// the chunks back in order
+class parallel_chd_reader
+{
+public:
+	// a worker's private view of the input
+	struct context
+	{
+		~context() { if (cdrom != nullptr) cdrom_close(cdrom); }
+
+		chd_file        parent;
+		chd_file        chd;
+		cdrom_file *    cdrom = nullptr;
+	};
+
+	// fills a chunk on a worker thread, returning the number of bytes produced
+	typedef std::function<uint32_t (context &ctx, uint64_t chunk, uint8_t *dest)> fill_func;
+
+	// consumes a chunk on the calling thread; chunks arrive in order
+	typedef std::function<void (uint64_t chunk, const uint8_t *data, uint32_t length)> consume_func;
+
+	// construction/destruction
+	parallel_chd_reader(const parameters_t &params, bool cdrom = false)
+		: m_params(params),
+			m_cdrom(cdrom),
+			m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI)),
+			m_fill(nullptr) { }
+
+	~parallel_chd_reader()
+	{
+		if (m_queue != nullptr)
+			osd_work_queue_free(m_queue);
+	}
+
+	// bytes per chunk for the given record size, at least one record
+	static uint32_t chunk_bytes(uint32_t recordbytes) { return (std::max)(CHUNK_BYTES / recordbytes, 1U) * recordbytes; }
+
+	// fill and consume the given number of chunks of up to chunkbytes each
+	void run(uint64_t chunks, uint32_t chunkbytes, const fill_func &fill, const consume_func &consume)
+	{
+		m_fill = &fill;
+		std::vector<work_item> items((std::min<uint64_t>)(chunks, CHUNKS_IN_FLIGHT));
+		for (std::size_t index = 0; index < items.size(); index++)
+		{
+			items[index].m_reader = this;
+			items[index].m_data.resize(chunkbytes);
+			queue(items[index], index);
+		}
+
+		try
+		{
+			for (uint64_t chunk = 0; chunk < chunks; chunk++)
+			{
+				// wait for this chunk and pass it on
+				work_item &item = items[chunk % items.size()];
+				wait(item);
+				if (item.m_error != CHDERR_NONE)
+					report_error(1, "Error reading CHD file (%s): %s", m_params.find(OPTION_INPUT)->second->c_str(), chd_file::error_string(item.m_error));
+				consume(chunk, &item.m_data[0], item.m_length);
+
+				// reuse the buffer for the next chunk not yet queued
+				if (chunk + items.size() < chunks)
+					queue(item, chunk + items.size());
+			}
+		}
+		catch (...)
+		{
+			// the workers still reference the buffers
+			for (work_item &item : items)
+				wait(item);
+			throw;
+		}
+	}
+
+private:
+	// constants
+	static const uint32_t CHUNK_BYTES = 1024 * 1024;
+	static const uint32_t CHUNKS_IN_FLIGHT = 32;
+
+	// a chunk being filled
+	struct work_item
+	{
+		parallel_chd_reader *   m_reader = nullptr;
+		uint64_t                m_chunk = 0;
+		std::vector<uint8_t>    m_data;
+		uint32_t                m_length = 0;
+		chd_error               m_error = CHDERR_NONE;
+		osd_work_item *         m_osd = nullptr;
+	};
+
+	// queue a chunk to be filled, doing it right away if it can't be queued
+	void queue(work_item &item, uint64_t chunk)
+	{
+		item.m_chunk = chunk;
+		item.m_length = 0;
+		item.m_error = CHDERR_NONE;
+		item.m_osd = (m_queue != nullptr) ? osd_work_item_queue(m_queue, fill_static, &item, 0) : nullptr;
+		if (item.m_osd == nullptr)
+			fill_static(&item, 0);
+	}
+
+	// wait for a chunk to be filled
+	void wait(work_item &item)
+	{
+		if (item.m_osd != nullptr)
+		{
+			while (!osd_work_item_wait(item.m_osd, osd_ticks_per_second()))
+				;
+			osd_work_item_release(item.m_osd);
+			item.m_osd = nullptr;
+		}
+	}
+
+	// take an idle context, opening another if there isn't one
+	std::unique_ptr<context> acquire_context()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_context_lock);
+			if (!m_contexts.empty())
+			{
+				std::unique_ptr<context> result = std::move(m_contexts.back());
+				m_contexts.pop_back();
+				return result;
+			}
+		}
+
+		auto result = std::make_unique<context>();
+		auto parent_str = m_params.find(OPTION_INPUT_PARENT);
+		if (parent_str != m_params.end())
+		{
+			chd_error err = result->parent.open(parent_str->second->c_str());
+			if (err != CHDERR_NONE)
+				throw err;
+		}
+		chd_error err = result->chd.open(m_params.find(OPTION_INPUT)->second->c_str(), false, result->parent.opened() ? &result->parent : nullptr);
+		if (err != CHDERR_NONE)
+			throw err;
+
+		// each chunk is read start to finish by one worker, so read-ahead would only duplicate work
+		result->chd.set_cache_hunks(1);
+		if (m_cdrom)
+		{
+			result->cdrom = cdrom_open(&result->chd);
+			if (result->cdrom == nullptr)
+				throw CHDERR_INVALID_DATA;
+		}
+		return result;
+	}
+
+	void release_context(std::unique_ptr<context> &&ctx)
+	{
+		std::lock_guard<std::mutex> lock(m_context_lock);
+		m_contexts.push_back(std::move(ctx));
+	}
+
+	// worker callback
+	static void *fill_static(void *param, int threadid)
+	{
+		work_item &item = *reinterpret_cast<work_item *>(param);
+		parallel_chd_reader &reader = *item.m_reader;
+		try
+		{
+			std::unique_ptr<context> ctx = reader.acquire_context();
+			item.m_length = (*reader.m_fill)(*ctx, item.m_chunk, &item.m_data[0]);
+			reader.release_context(std::move(ctx));
+		}
+		catch (chd_error &err)
+		{
+			item.m_error = err;
+		}
+		return nullptr;
+	}
+
+	// internal state
+	const parameters_t &                    m_params;
+	bool                                    m_cdrom;
+	osd_work_queue *                        m_queue;
+	const fill_func *                       m_fill;
+	std::mutex                              m_context_lock;
+	std::vector<std::unique_ptr<context>>   m_contexts;
+};
+
+
 
 //**************************************************************************
 //  GLOBAL VARIABLES
@@ -589,7 +778,8 @@ static const option_description s_options[] =
 	{ OPTION_INDEX,                 "ix",   true, " <index>: indexed instance of this metadata tag" },
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
-	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression, verification or extraction" },
+	{ OPTION_RATIO_BUDGET,          "rb",   true, " <percent>: accept output up to this much larger to use codecs that decompress faster" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -611,7 +801,8 @@ static const command_description s_commands[] =
 	{ COMMAND_VERIFY, do_verify, ": verifies a CHD's integrity",
 		{
 			REQUIRED OPTION_INPUT,
-			OPTION_INPUT_PARENT
+			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -628,7 +819,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_HUNK_SIZE,
 			REQUIRED OPTION_UNIT_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_RATIO_BUDGET
 		}
 	},
 
@@ -649,7 +841,8 @@ static const command_description s_commands[] =
 			OPTION_CHS,
 			OPTION_SIZE,
 			OPTION_SECTOR_SIZE,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_RATIO_BUDGET
 		}
 	},
 
@@ -661,7 +854,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_INPUT,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_RATIO_BUDGET
 		}
 	},
 
@@ -675,7 +869,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_FRAMES,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_RATIO_BUDGET
 		}
 	},
 
@@ -688,7 +883,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -701,7 +897,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -712,6 +909,7 @@ static const command_description s_commands[] =
 			OPTION_OUTPUT_FORCE,
 			REQUIRED OPTION_INPUT,
 			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -739,7 +937,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_HUNKS,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_RATIO_BUDGET
 		}
 	},
 
@@ -1188,6 +1387,24 @@ static void parse_numprocessors(const parameters_t &params)
 }
 
 
+//-------------------------------------------------
+//  parse_ratio_budget - handle the ratiobudget
+//  option
+//-------------------------------------------------
+
+static void parse_ratio_budget(const parameters_t &params, chd_file_compressor &chd)
+{
+	auto ratio_budget_str = params.find(OPTION_RATIO_BUDGET);
+	if (ratio_budget_str == params.end())
+		return;
+
+	int percent = atoi(ratio_budget_str->second->c_str());
+	if (percent < 0)
+		report_error(1, "Invalid ratio budget '%s' specified", ratio_budget_str->second->c_str());
+	chd.set_ratio_budget(percent);
+}
+
+
 //-------------------------------------------------
 //  compression_string - create a friendly string
 //  describing a set of compressors
@@ -1566,25 +1783,29 @@ static void do_verify(parameters_t &params)
 	if (raw_sha1 == util::sha1_t::null)
 		report_error(0, "No verification to be done; CHD has no checksum");
 
-	// create an array to read into
-	std::vector<uint8_t> buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
-
-	// read all the data and build up an SHA-1
+	// decompress all the data in parallel and build up an SHA-1 in order
+	parse_numprocessors(params);
+	uint64_t const logical_bytes = input_chd.logical_bytes();
+	uint32_t const chunkbytes = parallel_chd_reader::chunk_bytes(input_chd.hunk_bytes());
 	util::sha1_creator rawsha1;
-	for (uint64_t offset = 0; offset < input_chd.logical_bytes(); )
-	{
-		progress(false, "Verifying, %.1f%% complete... \r", 100.0 * double(offset) / double(input_chd.logical_bytes()));
-
-		// determine how much to read
-		uint32_t bytes_to_read = (std::min<uint64_t>)(buffer.size(), input_chd.logical_bytes() - offset);
-		chd_error err = input_chd.read_bytes(offset, &buffer[0], bytes_to_read);
-		if (err != CHDERR_NONE)
-			report_error(1, "Error reading CHD file (%s): %s", params.find(OPTION_INPUT)->second->c_str(), chd_file::error_string(err));
+	parallel_chd_reader reader(params);
+	reader.run((logical_bytes + chunkbytes - 1) / chunkbytes, chunkbytes,
+		[logical_bytes, chunkbytes] (parallel_chd_reader::context &ctx, uint64_t chunk, uint8_t *dest)
+		{
+			uint64_t const offset = chunk * chunkbytes;
+			uint32_t const bytes_to_read = (std::min<uint64_t>)(chunkbytes, logical_bytes - offset);
+			chd_error err = ctx.chd.read_bytes(offset, dest, bytes_to_read);
+			if (err != CHDERR_NONE)
+				throw err;
+			return bytes_to_read;
+		},
+		[logical_bytes, chunkbytes, &rawsha1] (uint64_t chunk, const uint8_t *data, uint32_t length)
+		{
+			progress(false, "Verifying, %.1f%% complete... \r", 100.0 * double(chunk * chunkbytes) / double(logical_bytes));
 
-		// add to the checksum
-		rawsha1.append(&buffer[0], bytes_to_read);
-		offset += bytes_to_read;
-	}
+			// add to the checksum
+			rawsha1.append(data, length);
+		});
 	util::sha1_t computed_sha1 = rawsha1.finish();
 
 	// finish up
@@ -1708,6 +1929,7 @@ static void do_create_raw(parameters_t &params)
 			chd->clone_all_metadata(output_parent);
 
 		// compress it generically
+		parse_ratio_budget(params, *chd);
 		compress_common(*chd);
 	}
 	catch (...)
@@ -1917,7 +2139,10 @@ static void do_create_hd(parameters_t &params)
 
 		// compress it generically
 		if (input_file)
+		{
+			parse_ratio_budget(params, *chd);
 			compress_common(*chd);
+		}
 	}
 	catch (...)
 	{
@@ -2007,6 +2232,7 @@ static void do_create_cd(parameters_t &params)
 			report_error(1, "Error adding CD metadata: %s", chd_file::error_string(err));
 
 		// compress it generically
+		parse_ratio_budget(params, *chd);
 		compress_common(*chd);
 		delete chd;
 	}
@@ -2126,6 +2352,7 @@ static void do_create_ld(parameters_t &params)
 			report_error(1, "Error adding AV metadata: %s\n", chd_file::error_string(err));
 
 		// create the compressor and then run it generically
+		parse_ratio_budget(params, *chd);
 		compress_common(*chd);
 
 		// write the final LD metadata
@@ -2270,6 +2497,7 @@ static void do_copy(parameters_t &params)
 		}
 
 		// compress it generically
+		parse_ratio_budget(params, *chd);
 		compress_common(*chd);
 		delete chd;
 	}
@@ -2326,26 +2554,29 @@ static void do_extract_raw(parameters_t &params)
 		if (filerr != osd_file::error::NONE)
 			report_error(1, "Unable to open file (%s)", output_file_str->second->c_str());
 
-		// copy all data
-		std::vector<uint8_t> buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
-		for (uint64_t offset = input_start; offset < input_end; )
-		{
-			progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(offset - input_start) / double(input_end - input_start));
-
-			// determine how much to read
-			uint32_t bytes_to_read = (std::min<uint64_t>)(buffer.size(), input_end - offset);
-			chd_error err = input_chd.read_bytes(offset, &buffer[0], bytes_to_read);
-			if (err != CHDERR_NONE)
-				report_error(1, "Error reading CHD file (%s): %s", params.find(OPTION_INPUT)->second->c_str(), chd_file::error_string(err));
-
-			// write to the output
-			uint32_t count = output_file->write(&buffer[0], bytes_to_read);
-			if (count != bytes_to_read)
-				report_error(1, "Error writing to file; check disk space (%s)", output_file_str->second->c_str());
+		// copy all data, decompressing in parallel and writing in order
+		parse_numprocessors(params);
+		uint32_t const chunkbytes = parallel_chd_reader::chunk_bytes(input_chd.hunk_bytes());
+		parallel_chd_reader reader(params);
+		reader.run((input_end - input_start + chunkbytes - 1) / chunkbytes, chunkbytes,
+			[input_start, input_end, chunkbytes] (parallel_chd_reader::context &ctx, uint64_t chunk, uint8_t *dest)
+			{
+				uint64_t const offset = input_start + chunk * chunkbytes;
+				uint32_t const bytes_to_read = (std::min<uint64_t>)(chunkbytes, input_end - offset);
+				chd_error err = ctx.chd.read_bytes(offset, dest, bytes_to_read);
+				if (err != CHDERR_NONE)
+					throw err;
+				return bytes_to_read;
+			},
+			[input_start, input_end, chunkbytes, &output_file, output_file_str] (uint64_t chunk, const uint8_t *data, uint32_t length)
+			{
+				progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(chunk * chunkbytes) / double(input_end - input_start));
 
-			// advance
-			offset += bytes_to_read;
-		}
+				// write to the output
+				uint32_t count = output_file->write(data, length);
+				if (count != length)
+					report_error(1, "Error writing to file; check disk space (%s)", output_file_str->second->c_str());
+			});
 
 		// finish up
 		output_file.reset();
@@ -2451,9 +2682,10 @@ static void do_extract_cd(parameters_t &params)
 		}
 
 		// iterate over tracks and copy all data
+		parse_numprocessors(params);
+		parallel_chd_reader reader(params, true);
 		uint64_t outputoffs = 0;
 		uint32_t discoffs = 0;
-		std::vector<uint8_t> buffer;
 		for (int tracknum = 0; tracknum < toc->numtrks; tracknum++)
 		{
 			std::string trackbin_name(basename);
@@ -2498,51 +2730,56 @@ static void do_extract_cd(parameters_t &params)
 				output_frame_size = trackinfo.datasize;
 			}
 
-			// resize the buffer for the track
-			buffer.resize((TEMP_BUFFER_SIZE / output_frame_size) * output_frame_size);
-
-			// now read and output the actual data
-			uint32_t bufferoffs = 0;
-			uint32_t actualframes = trackinfo.frames - trackinfo.padframes;
-			for (uint32_t frame = 0; frame < actualframes; frame++)
-			{
-				progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(outputoffs) / double(total_bytes));
-
-				// read the data
-				cdrom_read_data(cdrom, cdrom_get_track_start_phys(cdrom, tracknum) + frame, &buffer[bufferoffs], trackinfo.trktype, true);
-
-				// for CDRWin and GDI audio tracks must be reversed
-				// in the case of GDI and CHD version < 5 we assuming source CHD image is GDROM so audio tracks is already reversed
-				if (((mode == MODE_GDI && input_chd.version() > 4) || (mode == MODE_CUEBIN)) && (trackinfo.trktype == CD_TRACK_AUDIO))
-					for (int swapindex = 0; swapindex < trackinfo.datasize; swapindex += 2)
+			// for CDRWin and GDI audio tracks must be reversed
+			// in the case of GDI and CHD version < 5 we assuming source CHD image is GDROM so audio tracks is already reversed
+			bool const swap = ((mode == MODE_GDI && input_chd.version() > 4) || (mode == MODE_CUEBIN)) && (trackinfo.trktype == CD_TRACK_AUDIO);
+			bool const subcode = trackinfo.subtype != CD_SUB_NONE && (mode == MODE_NORMAL);
+
+			// now read the actual data in parallel chunks of frames, and output it in order
+			uint32_t const actualframes = trackinfo.frames - trackinfo.padframes;
+			uint32_t const chunkbytes = parallel_chd_reader::chunk_bytes(output_frame_size);
+			uint32_t const chunkframes = chunkbytes / output_frame_size;
+			uint32_t const trackstart = cdrom_get_track_start_phys(cdrom, tracknum);
+			reader.run((actualframes + chunkframes - 1) / chunkframes, chunkbytes,
+				[&trackinfo, swap, subcode, actualframes, chunkframes, trackstart] (parallel_chd_reader::context &ctx, uint64_t chunk, uint8_t *dest)
+				{
+					uint8_t *const start = dest;
+					uint32_t const endframe = (std::min<uint64_t>)((chunk + 1) * chunkframes, actualframes);
+					for (uint32_t frame = chunk * chunkframes; frame < endframe; frame++)
 					{
-						uint8_t swaptemp = buffer[bufferoffs + swapindex];
-						buffer[bufferoffs + swapindex] = buffer[bufferoffs + swapindex + 1];
-						buffer[bufferoffs + swapindex + 1] = swaptemp;
-					}
-				bufferoffs += trackinfo.datasize;
-				discoffs++;
+						// read the data
+						cdrom_read_data(ctx.cdrom, trackstart + frame, dest, trackinfo.trktype, true);
+						if (swap)
+							for (int swapindex = 0; swapindex < trackinfo.datasize; swapindex += 2)
+							{
+								uint8_t swaptemp = dest[swapindex];
+								dest[swapindex] = dest[swapindex + 1];
+								dest[swapindex + 1] = swaptemp;
+							}
+						dest += trackinfo.datasize;
 
-				// read the subcode data
-				if (trackinfo.subtype != CD_SUB_NONE && (mode == MODE_NORMAL))
+						// read the subcode data
+						if (subcode)
+						{
+							cdrom_read_subcode(ctx.cdrom, trackstart + frame, dest, true);
+							dest += trackinfo.subsize;
+						}
+					}
+					return uint32_t(dest - start);
+				},
+				[&outputoffs, &output_bin_file, output_file_str, total_bytes, chunkframes] (uint64_t chunk, const uint8_t *data, uint32_t length)
 				{
-					cdrom_read_subcode(cdrom, cdrom_get_track_start_phys(cdrom, tracknum) + frame, &buffer[bufferoffs], true);
-					bufferoffs += trackinfo.subsize;
-				}
+					progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(outputoffs) / double(total_bytes));
 
-				// write it out if we need to
-				if (bufferoffs == buffer.size() || frame == actualframes - 1)
-				{
+					// write it out
 					output_bin_file->seek(outputoffs, SEEK_SET);
-					uint32_t byteswritten = output_bin_file->write(&buffer[0], bufferoffs);
-					if (byteswritten != bufferoffs)
-						report_error(1, "Error writing frame %d to file (%s): %s\n", frame, output_file_str->second->c_str(), chd_file::error_string(CHDERR_WRITE_ERROR));
-					outputoffs += bufferoffs;
-					bufferoffs = 0;
-				}
-			}
+					uint32_t byteswritten = output_bin_file->write(data, length);
+					if (byteswritten != length)
+						report_error(1, "Error writing frame %d to file (%s): %s\n", uint32_t(chunk * chunkframes), output_file_str->second->c_str(), chd_file::error_string(CHDERR_WRITE_ERROR));
+					outputoffs += length;
+				});
 
-			discoffs += trackinfo.padframes;
+			discoffs += actualframes + trackinfo.padframes;
 		}
 
 		// finish up
@@ -0,0 +1,436 @@
+#include "catch.hpp"
+#include "emu.h"
+#include "cpu/drcuml.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+using namespace uml;
+
+constexpr u8 FLAGS_INTEGER = FLAG_C | FLAG_V | FLAG_Z | FLAG_S;
+
+
+//-------------------------------------------------
+//  guest_state - what the blocks operate on,
+//  laid out like a front-end's core state
+//-------------------------------------------------
+
+struct guest_state
+{
+	u64     r[8];
+	u32     pc;
+	s32     icount;
+	u32     count;
+	u32     flags;
+};
+
+guest_state s_state;
+
+
+//-------------------------------------------------
+//  machine_state - everything a block can change
+//-------------------------------------------------
+
+struct machine_state
+{
+	u64         ireg[REG_I_COUNT];
+	guest_state guest;
+	u64         exitcode;
+};
+
+bool operator==(machine_state const &a, machine_state const &b)
+{
+	return !memcmp(a.ireg, b.ireg, sizeof(a.ireg)) && !memcmp(&a.guest, &b.guest, sizeof(a.guest)) && a.exitcode == b.exitcode;
+}
+
+
+//-------------------------------------------------
+//  uml_evaluator - runs a list of instructions
+//  with the C back-end's semantics; 32-bit
+//  register writes leave the upper half alone,
+//  and any flag an instruction modifies without
+//  being asked to produce it gets a random
+//  value, so reading it shows up as a
+//  difference
+//-------------------------------------------------
+
+class uml_evaluator
+{
+public:
+	uml_evaluator(std::vector<instruction> const &instlist) : m_inst(instlist), m_flags(0), m_undefined(0x1234)
+	{
+		for (size_t index = 0; index < m_inst.size(); index++)
+			if (m_inst[index].opcode() == OP_LABEL)
+				m_labels[m_inst[index].param(0).label()] = index;
+	}
+
+	void run(machine_state &state)
+	{
+		m_ireg = state.ireg;
+		m_flags = 0;
+		s_state = state.guest;
+
+		size_t pc = 0;
+		for (u32 steps = 0; pc < m_inst.size(); steps++)
+		{
+			REQUIRE(steps < 100000);
+			instruction const &inst(m_inst[pc++]);
+			u8 const size(inst.size());
+			switch (inst.opcode())
+			{
+			case OP_NOP:
+			case OP_LABEL:
+			case OP_COMMENT:
+				break;
+
+			case OP_EXIT:
+				if (condition(inst.condition()))
+				{
+					state.exitcode = read(inst, 0, 4);
+					state.guest = s_state;
+					return;
+				}
+				break;
+
+			case OP_JMP:
+				if (condition(inst.condition()))
+					pc = m_labels.at(inst.param(0).label());
+				break;
+
+			case OP_GETFLGS:
+				write(inst, 0, 4, m_flags & inst.param(1).immediate());
+				break;
+
+			case OP_MOV:
+				if (condition(inst.condition()))
+					write(inst, 0, size, read(inst, 1, size));
+				break;
+
+			case OP_SET:
+				write(inst, 0, size, condition(inst.condition()) ? 1 : 0);
+				break;
+
+			case OP_SEXT:
+			{
+				u8 const srcsize(1 << inst.param(2).size());
+				u64 const src(read(inst, 1, srcsize));
+				u64 const sign(u64(1) << (srcsize * 8 - 1));
+				u64 const result(((src ^ sign) - sign) & mask(size));
+				write(inst, 0, size, result);
+				set_flags(inst, sz_flags(result, size));
+				break;
+			}
+
+			case OP_ADD:
+			case OP_ADDC:
+			{
+				u64 const a(read(inst, 1, size)), b(read(inst, 2, size));
+				u64 const carry((inst.opcode() == OP_ADDC) ? (m_flags & FLAG_C) : 0);
+				u64 const result((a + b + carry) & mask(size));
+				u8 flags(sz_flags(result, size));
+				if ((result < a) || (carry && result == a))
+					flags |= FLAG_C;
+				if (~(a ^ b) & (a ^ result) & sign(size))
+					flags |= FLAG_V;
+				write(inst, 0, size, result);
+				set_flags(inst, flags);
+				break;
+			}
+
+			case OP_SUB:
+			case OP_CMP:
+			{
+				int const first((inst.opcode() == OP_SUB) ? 1 : 0);
+				u64 const a(read(inst, first, size)), b(read(inst, first + 1, size));
+				u64 const result((a - b) & mask(size));
+				u8 flags(sz_flags(result, size));
+				if (a < b)
+					flags |= FLAG_C;
+				if ((a ^ b) & (a ^ result) & sign(size))
+					flags |= FLAG_V;
+				if (inst.opcode() == OP_SUB)
+					write(inst, 0, size, result);
+				set_flags(inst, flags);
+				break;
+			}
+
+			case OP_AND:
+			case OP_OR:
+			case OP_XOR:
+			{
+				u64 const a(read(inst, 1, size)), b(read(inst, 2, size));
+				u64 const result((inst.opcode() == OP_AND) ? (a & b) : (inst.opcode() == OP_OR) ? (a | b) : (a ^ b));
+				write(inst, 0, size, result);
+				set_flags(inst, sz_flags(result, size));
+				break;
+			}
+
+			case OP_SHL:
+			{
+				u64 const a(read(inst, 1, size));
+				u32 const count(read(inst, 2, size) & (size * 8 - 1));
+				u64 const result((a << count) & mask(size));
+				u8 flags(sz_flags(result, size));
+				if (count != 0 && ((a >> (size * 8 - count)) & 1))
+					flags |= FLAG_C;
+				write(inst, 0, size, result);
+				set_flags(inst, flags);
+				break;
+			}
+
+			default:
+				FAIL("unexpected opcode " << int(inst.opcode()));
+			}
+		}
+		FAIL("ran off the end of the block");
+	}
+
+private:
+	static u64 mask(u8 size) { return (size == 8) ? ~u64(0) : ((u64(1) << (size * 8)) - 1); }
+	static u64 sign(u8 size) { return u64(1) << (size * 8 - 1); }
+	static u8 sz_flags(u64 result, u8 size) { return ((result == 0) ? FLAG_Z : 0) | ((result & sign(size)) ? FLAG_S : 0); }
+
+	u64 read(instruction const &inst, int pnum, u8 size) const
+	{
+		parameter const &param(inst.param(pnum));
+		if (param.is_immediate())
+			return param.immediate() & mask(size);
+		if (param.is_int_register())
+			return m_ireg[param.ireg() - REG_I0] & mask(size);
+		REQUIRE(param.is_memory());
+		switch (size)
+		{
+		case 1: return *reinterpret_cast<u8 const *>(param.memory());
+		case 2: return *reinterpret_cast<u16 const *>(param.memory());
+		case 4: return *reinterpret_cast<u32 const *>(param.memory());
+		default: return *reinterpret_cast<u64 const *>(param.memory());
+		}
+	}
+
+	void write(instruction const &inst, int pnum, u8 size, u64 value)
+	{
+		parameter const &param(inst.param(pnum));
+		if (param.is_int_register())
+		{
+			u64 &reg(m_ireg[param.ireg() - REG_I0]);
+			reg = (size == 8) ? value : ((reg & ~mask(4)) | u32(value));
+			return;
+		}
+		REQUIRE(param.is_memory());
+		if (size == 8)
+			*reinterpret_cast<u64 *>(param.memory()) = value;
+		else
+			*reinterpret_cast<u32 *>(param.memory()) = u32(value);
+	}
+
+	void set_flags(instruction const &inst, u8 computed)
+	{
+		u8 const produced(inst.flags());
+		u8 const undefined(inst.modified_flags() & FLAGS_INTEGER & ~produced);
+		m_flags = (m_flags & ~(produced | undefined)) | (computed & produced) | (m_undefined() & undefined);
+	}
+
+	bool condition(condition_t cond) const
+	{
+		bool const c(m_flags & FLAG_C), v(m_flags & FLAG_V), z(m_flags & FLAG_Z), s(m_flags & FLAG_S);
+		switch (cond)
+		{
+		case COND_ALWAYS:   return true;
+		case COND_Z:        return z;
+		case COND_NZ:       return !z;
+		case COND_S:        return s;
+		case COND_NS:       return !s;
+		case COND_C:        return c;
+		case COND_NC:       return !c;
+		case COND_V:        return v;
+		case COND_NV:       return !v;
+		case COND_A:        return !c && !z;
+		case COND_BE:       return c || z;
+		case COND_G:        return !z && (s == v);
+		case COND_LE:       return z || (s != v);
+		case COND_L:        return s != v;
+		case COND_GE:       return s == v;
+		default:            FAIL("unexpected condition " << int(cond)); return false;
+		}
+	}
+
+	std::vector<instruction> const &m_inst;
+	std::map<u32, size_t> m_labels;
+	u64 *m_ireg;
+	u8 m_flags;
+	std::minstd_rand m_undefined;
+};
+
+
+//-------------------------------------------------
+//  build_block - a random block shaped like the
+//  output of the MIPS III front-end, with flags
+//  read across labels, loops and partial writes;
+//  the flags are stored before every exit
+//-------------------------------------------------
+
+std::vector<instruction> build_block(std::mt19937 &rng, u32 count)
+{
+	std::vector<instruction> block;
+	auto add = [&block] () -> instruction & { block.emplace_back(); return block.back(); };
+	auto exit = [&add] (condition_t cond, u32 code)
+	{
+		add().getflgs(mem(&s_state.flags), FLAGS_INTEGER);
+		add().exit(cond, code);
+	};
+
+	u32 labelnum = 1;
+	for (u32 index = 0; index < count; index++)
+	{
+		u32 const seed(rng());
+		u32 const rs = (seed >> 8) & 7, rt = (seed >> 12) & 7, rd = (seed >> 16) & 7;
+		u32 const imm = (seed >> 20) & 0xff;
+
+		add().mov(mem(&s_state.pc), 0x80001000 + index * 4);
+		switch ((seed >> 24) % 11)
+		{
+		case 0: // addiu
+			add().add(I0, mem(&s_state.r[rs]), imm);
+			add().dsext(mem(&s_state.r[rt]), I0, SIZE_DWORD);
+			break;
+
+		case 1: // lui followed by ori
+			add().dmov(mem(&s_state.r[rt]), s64(s32(imm << 24)));
+			add().dor(mem(&s_state.r[rt]), mem(&s_state.r[rt]), imm);
+			break;
+
+		case 2: // slt
+			add().dcmp(mem(&s_state.r[rs]), mem(&s_state.r[rt]));
+			add().dset(COND_L, mem(&s_state.r[rd]));
+			break;
+
+		case 3: // beq over an exit
+			add().cmp(mem(&s_state.r[rs]), mem(&s_state.r[rt]));
+			add().jmp(COND_NZ, labelnum);
+			add().mov(mem(&s_state.pc), 0x80002000 + index * 4);
+			exit(COND_ALWAYS, 0);
+			add().label(labelnum++);
+			break;
+
+		case 4: // redundant loads and stores
+			add().dmov(I0, mem(&s_state.r[rs]));
+			add().dmov(mem(&s_state.r[rt]), I0);
+			add().dmov(I1, mem(&s_state.r[rs]));
+			add().dadd(mem(&s_state.r[rd]), I1, mem(&s_state.r[rt]));
+			break;
+
+		case 5: // 32-bit and 64-bit views of the same register
+			add().mov(I2, 0x80000000 | imm);
+			add().dadd(mem(&s_state.r[rd]), I2, imm);
+			add().dmov(I2, 0x80000000 | imm);
+			add().dmov(I3, (u64(imm) << 40) | 0xfffffff0);
+			add().add(mem(&s_state.r[rt]), I3, 0x20);
+			break;
+
+		case 6: // partial write of something known
+			add().dmov(mem(&s_state.r[rs]), imm);
+			add().mov(mem(&s_state.r[rs]), I0);
+			add().dadd(mem(&s_state.r[rd]), mem(&s_state.r[rs]), 0);
+			break;
+
+		case 7: // carry through an instruction that leaves the flags alone
+			add().add(I1, mem(&s_state.r[rs]), mem(&s_state.r[rt]));
+			add().mov(I2, imm);
+			add().addc(mem(&s_state.r[rd]), I1, I2);
+			break;
+
+		case 8: // flags arriving at a label from two places
+			add().dcmp(mem(&s_state.r[rs]), mem(&s_state.r[rt]));
+			add().jmp(COND_Z, labelnum);
+			add().dadd(mem(&s_state.r[rd]), mem(&s_state.r[rd]), 1);
+			add().label(labelnum++);
+			add().dset(COND_L, mem(&s_state.r[rt]));
+			break;
+
+		case 9: // backward loop
+			add().mov(mem(&s_state.count), (imm & 3) + 1);
+			add().label(labelnum);
+			add().dadd(mem(&s_state.r[rd]), mem(&s_state.r[rd]), mem(&s_state.r[rs]));
+			add().sub(mem(&s_state.count), mem(&s_state.count), 1);
+			add().jmp(COND_NZ, labelnum++);
+			break;
+
+		case 10: // move and shift
+			add().dmov(mem(&s_state.r[rd]), mem(&s_state.r[rs]));
+			add().dshl(mem(&s_state.r[rd]), mem(&s_state.r[rd]), imm & 31);
+			add()._xor(I0, mem(&s_state.r[rd]), 0);
+			add()._and(mem(&s_state.r[rt]), I0, 0xffffffff);
+			break;
+		}
+
+		// cycle counting at the end of each instruction
+		add().sub(mem(&s_state.icount), mem(&s_state.icount), 1);
+		exit(COND_S, 1);
+	}
+	exit(COND_ALWAYS, 2);
+	return block;
+}
+
+
+//-------------------------------------------------
+//  live_instructions - count what the optimizer
+//  left in place
+//-------------------------------------------------
+
+u32 live_instructions(std::vector<instruction> const &block)
+{
+	u32 live = 0;
+	for (instruction const &inst : block)
+		if (inst.opcode() != OP_NOP)
+			live++;
+	return live;
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("Block optimizer preserves behavior", "[drcuml]")
+{
+	u32 sourcelive = 0, optimizedlive = 0;
+	for (u32 seed = 1; seed <= 200; seed++)
+	{
+		std::mt19937 rng(seed);
+		std::vector<instruction> source(build_block(rng, 48));
+
+		// without the optimizer, every instruction produces all of its flags
+		std::vector<instruction> optimized(source);
+		for (instruction &inst : source)
+			inst.set_flags(inst.output_flags());
+		drcuml_optimizer().optimize(optimized.data(), optimized.size());
+		sourcelive += live_instructions(source);
+		optimizedlive += live_instructions(optimized);
+
+		// a few random starting states, including running out of cycles part way through
+		for (int start = 0; start < 4; start++)
+		{
+			machine_state initial;
+			for (u64 &reg : initial.ireg)
+				reg = (u64(rng()) << 32) | rng();
+			for (u64 &reg : initial.guest.r)
+				reg = (start & 1) ? (rng() & 3) : ((u64(rng()) << 32) | rng());
+			initial.guest.pc = 0;
+			initial.guest.icount = rng() % 64;
+			initial.guest.count = 0;
+			initial.guest.flags = 0;
+			initial.exitcode = ~u64(0);
+
+			machine_state expected(initial), actual(initial);
+			uml_evaluator(source).run(expected);
+			uml_evaluator(optimized).run(actual);
+			INFO("seed " << seed << ", start " << start << ", exit " << expected.exitcode << "/" << actual.exitcode);
+			REQUIRE(expected == actual);
+		}
+	}
+
+	// make sure there was something to check
+	REQUIRE(optimizedlive < sourcelive);
+}
@@ -0,0 +1,202 @@
+#include "catch.hpp"
+#include "emu.h"
+#include "drawgfxm.h"
+
+#include <random>
+
+
+namespace {
+
+//-------------------------------------------------
+//  draw_params - one randomly chosen draw
+//-------------------------------------------------
+
+struct draw_params
+{
+	u32 color;
+	const pen_t *paldata;
+	int flipx, flipy;
+	s32 destx, desty;
+	u32 scalex, scaley;
+	u32 trans;
+	u32 pmask;
+};
+
+
+//-------------------------------------------------
+//  test_gfx - a raw gfx element that can draw
+//  through both the per-pixel and row cores
+//-------------------------------------------------
+
+#define TEST_DRAW(NAME, CORE, PIXEL_TYPE, BITMAP_TYPE, PIXEL_OP, ROW_OP, PRIORITY_TYPE) \
+	void NAME(bool rows, BITMAP_TYPE &dest, bitmap_ind8 &priority, const rectangle &cliprect, const draw_params &params) \
+	{ \
+		u32 code = 0, color = params.color; \
+		const pen_t *paldata = params.paldata; \
+		int flipx = params.flipx, flipy = params.flipy; \
+		s32 destx = params.destx, desty = params.desty; \
+		u32 scalex = params.scalex, scaley = params.scaley; \
+		u32 trans_pen = params.trans, trans_mask = params.trans; \
+		u32 pmask = params.pmask | (1 << 31); \
+		(void)paldata; (void)color; (void)trans_pen; (void)trans_mask; (void)pmask; (void)scalex; (void)scaley; \
+		if (rows) \
+			CORE##_ROW_CORE(PIXEL_TYPE, ROW_OP, PRIORITY_TYPE); \
+		else \
+			CORE##_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE); \
+	}
+
+class test_gfx : public gfx_element
+{
+public:
+	test_gfx(u8 *base, u16 width, u16 height) : gfx_element(nullptr, base, width, height, width, 0x10000, 0, 0x100) { }
+
+	TEST_DRAW(transpen, DRAWGFX, u16, bitmap_ind16, PIXEL_OP_REBASE_TRANSPEN, ROW_OP_REBASE_TRANSPEN, NO_PRIORITY)
+	TEST_DRAW(transpen, DRAWGFX, u32, bitmap_rgb32, PIXEL_OP_REMAP_TRANSPEN, ROW_OP_REMAP_TRANSPEN, NO_PRIORITY)
+	TEST_DRAW(transmask, DRAWGFX, u16, bitmap_ind16, PIXEL_OP_REBASE_TRANSMASK, ROW_OP_REBASE_TRANSMASK, NO_PRIORITY)
+	TEST_DRAW(transmask, DRAWGFX, u32, bitmap_rgb32, PIXEL_OP_REMAP_TRANSMASK, ROW_OP_REMAP_TRANSMASK, NO_PRIORITY)
+	TEST_DRAW(prio_transpen, DRAWGFX, u16, bitmap_ind16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, ROW_OP_REBASE_TRANSPEN_PRIORITY, u8)
+	TEST_DRAW(prio_transpen, DRAWGFX, u32, bitmap_rgb32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, ROW_OP_REMAP_TRANSPEN_PRIORITY, u8)
+	TEST_DRAW(prio_transmask, DRAWGFX, u16, bitmap_ind16, PIXEL_OP_REBASE_TRANSMASK_PRIORITY, ROW_OP_REBASE_TRANSMASK_PRIORITY, u8)
+	TEST_DRAW(prio_transmask, DRAWGFX, u32, bitmap_rgb32, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, ROW_OP_REMAP_TRANSMASK_PRIORITY, u8)
+
+	TEST_DRAW(zoom_transpen, DRAWGFXZOOM, u16, bitmap_ind16, PIXEL_OP_REBASE_TRANSPEN, ROW_OP_REBASE_TRANSPEN, NO_PRIORITY)
+	TEST_DRAW(zoom_transpen, DRAWGFXZOOM, u32, bitmap_rgb32, PIXEL_OP_REMAP_TRANSPEN, ROW_OP_REMAP_TRANSPEN, NO_PRIORITY)
+	TEST_DRAW(zoom_transmask, DRAWGFXZOOM, u16, bitmap_ind16, PIXEL_OP_REBASE_TRANSMASK, ROW_OP_REBASE_TRANSMASK, NO_PRIORITY)
+	TEST_DRAW(zoom_transmask, DRAWGFXZOOM, u32, bitmap_rgb32, PIXEL_OP_REMAP_TRANSMASK, ROW_OP_REMAP_TRANSMASK, NO_PRIORITY)
+	TEST_DRAW(prio_zoom_transpen, DRAWGFXZOOM, u16, bitmap_ind16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, ROW_OP_REBASE_TRANSPEN_PRIORITY, u8)
+	TEST_DRAW(prio_zoom_transpen, DRAWGFXZOOM, u32, bitmap_rgb32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, ROW_OP_REMAP_TRANSPEN_PRIORITY, u8)
+	TEST_DRAW(prio_zoom_transmask, DRAWGFXZOOM, u16, bitmap_ind16, PIXEL_OP_REBASE_TRANSMASK_PRIORITY, ROW_OP_REBASE_TRANSMASK_PRIORITY, u8)
+	TEST_DRAW(prio_zoom_transmask, DRAWGFXZOOM, u32, bitmap_rgb32, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, ROW_OP_REMAP_TRANSMASK_PRIORITY, u8)
+};
+
+#undef TEST_DRAW
+
+
+//-------------------------------------------------
+//  draw_harness - random sources, palettes and
+//  destinations for comparing the two cores
+//-------------------------------------------------
+
+class draw_harness
+{
+public:
+	draw_harness() : m_rng(0x5eed), m_palette(0x10000)
+	{
+		for (pen_t &pen : m_palette)
+			pen = m_rng();
+	}
+
+	// draw the same thing through both cores and check every pixel
+	template <typename BitmapType, typename Draw>
+	void check(Draw &&draw, bool zoom, bool mask, int count)
+	{
+		// odd sizes leave leftovers after the vector blocks
+		static const u16 sizes[][2] = { { 8, 8 }, { 16, 16 }, { 23, 13 }, { 32, 32 }, { 61, 7 }, { 300, 5 } };
+
+		for (int pass = 0; pass < count; pass++)
+		{
+			const u16 width = sizes[pass % ARRAY_LENGTH(sizes)][0];
+			const u16 height = sizes[pass % ARRAY_LENGTH(sizes)][1];
+
+			// masks only cover 32 pens
+			std::vector<u8> source(width * height);
+			for (u8 &pixel : source)
+				pixel = mask ? (m_rng() & 0x1f) : (m_rng() & 0x0f) | ((m_rng() % 8 == 0) ? 0xf0 : 0);
+			test_gfx gfx(&source[0], width, height);
+
+			draw_params params;
+			params.color = (m_rng() & 0x3f) * 0x100 + ((m_rng() % 4 == 0) ? 0xff80 : 0);
+			params.paldata = &m_palette[(m_rng() & 0xff) * 0x100];
+			params.flipx = m_rng() & 1;
+			params.flipy = m_rng() & 1;
+			params.destx = s32(m_rng() % (DEST_WIDTH + width)) - width;
+			params.desty = s32(m_rng() % (DEST_HEIGHT + height)) - height;
+			params.scalex = zoom ? 0x2000 + m_rng() % 0x38000 : 0x10000;
+			params.scaley = zoom ? 0x2000 + m_rng() % 0x38000 : 0x10000;
+			params.trans = mask ? m_rng() : (m_rng() % 4 == 0) ? 0xf0 : (m_rng() & 0x0f);
+			params.pmask = m_rng();
+
+			rectangle cliprect(m_rng() % 64, DEST_WIDTH - 1 - m_rng() % 64, m_rng() % 32, DEST_HEIGHT - 1 - m_rng() % 32);
+			if (pass % 7 == 0)
+				cliprect.set(0, DEST_WIDTH - 1, 0, DEST_HEIGHT - 1);
+
+			BitmapType expected(DEST_WIDTH, DEST_HEIGHT), actual(DEST_WIDTH, DEST_HEIGHT);
+			bitmap_ind8 expectedpri(DEST_WIDTH, DEST_HEIGHT), actualpri(DEST_WIDTH, DEST_HEIGHT);
+			for (int y = 0; y < DEST_HEIGHT; y++)
+				for (int x = 0; x < DEST_WIDTH; x++)
+				{
+					actual.pix(y, x) = expected.pix(y, x) = m_rng();
+					actualpri.pix(y, x) = expectedpri.pix(y, x) = m_rng() & 0x3f;
+				}
+
+			draw(gfx, false, expected, expectedpri, cliprect, params);
+			draw(gfx, true, actual, actualpri, cliprect, params);
+
+			int mismatches = 0;
+			for (int y = 0; y < DEST_HEIGHT; y++)
+				for (int x = 0; x < DEST_WIDTH; x++)
+					if (expected.pix(y, x) != actual.pix(y, x) || expectedpri.pix(y, x) != actualpri.pix(y, x))
+						mismatches++;
+			INFO("pass " << pass << " size " << width << "x" << height << " at " << params.destx << "," << params.desty << " flip " << params.flipx << params.flipy << " scale " << params.scalex << "," << params.scaley);
+			REQUIRE(mismatches == 0);
+		}
+	}
+
+private:
+	static constexpr int DEST_WIDTH = 384;
+	static constexpr int DEST_HEIGHT = 96;
+
+	std::mt19937 m_rng;
+	std::vector<pen_t> m_palette;
+};
+
+} // anonymous namespace
+
+
+#define CHECK_DRAW(NAME, BITMAP_TYPE, ZOOM, MASK) \
+	draw_harness().check<BITMAP_TYPE>([] (test_gfx &gfx, bool rows, BITMAP_TYPE &dest, bitmap_ind8 &priority, const rectangle &cliprect, const draw_params &params) \
+			{ gfx.NAME(rows, dest, priority, cliprect, params); }, ZOOM, MASK, 300)
+
+TEST_CASE("drawgfx row cores match the pixel cores", "[emu][drawgfx]")
+{
+	SECTION("transpen")
+	{
+		CHECK_DRAW(transpen, bitmap_ind16, false, false);
+		CHECK_DRAW(transpen, bitmap_rgb32, false, false);
+	}
+	SECTION("transmask")
+	{
+		CHECK_DRAW(transmask, bitmap_ind16, false, true);
+		CHECK_DRAW(transmask, bitmap_rgb32, false, true);
+	}
+	SECTION("prio_transpen")
+	{
+		CHECK_DRAW(prio_transpen, bitmap_ind16, false, false);
+		CHECK_DRAW(prio_transpen, bitmap_rgb32, false, false);
+	}
+	SECTION("prio_transmask")
+	{
+		CHECK_DRAW(prio_transmask, bitmap_ind16, false, true);
+		CHECK_DRAW(prio_transmask, bitmap_rgb32, false, true);
+	}
+	SECTION("zoom_transpen")
+	{
+		CHECK_DRAW(zoom_transpen, bitmap_ind16, true, false);
+		CHECK_DRAW(zoom_transpen, bitmap_rgb32, true, false);
+	}
+	SECTION("zoom_transmask")
+	{
+		CHECK_DRAW(zoom_transmask, bitmap_ind16, true, true);
+		CHECK_DRAW(zoom_transmask, bitmap_rgb32, true, true);
+	}
+	SECTION("prio_zoom_transpen")
+	{
+		CHECK_DRAW(prio_zoom_transpen, bitmap_ind16, true, false);
+		CHECK_DRAW(prio_zoom_transpen, bitmap_rgb32, true, false);
+	}
+	SECTION("prio_zoom_transmask")
+	{
+		CHECK_DRAW(prio_zoom_transmask, bitmap_ind16, true, true);
+		CHECK_DRAW(prio_zoom_transmask, bitmap_rgb32, true, true);
+	}
+}
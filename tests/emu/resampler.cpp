@@ -0,0 +1,175 @@
+#include "catch.hpp"
+#include "emu.h"
+#include "resampler.h"
+
+#include <vector>
+
+
+namespace {
+
+const u32 OUTPUT_RATE = 48000;
+const u32 OUTPUT_SAMPLES = 8;
+const s64 UNITY_GAIN = 0x100;
+
+//-------------------------------------------------
+//  run - resample a block of source samples that
+//  starts at the resampler's history
+//-------------------------------------------------
+
+std::vector<stream_sample_t> run(const sound_resampler &resampler, const std::vector<stream_sample_t> &source, u32 step)
+{
+	std::vector<stream_sample_t> dest(OUTPUT_SAMPLES);
+	resampler.resample(&dest[0], &source[resampler.history()], 0, step, UNITY_GAIN, OUTPUT_SAMPLES);
+	return dest;
+}
+
+
+//-------------------------------------------------
+//  source_length - enough source for a run
+//-------------------------------------------------
+
+size_t source_length(const sound_resampler &resampler, u32 step)
+{
+	return resampler.history() + ((u64(step) * OUTPUT_SAMPLES) >> sound_resampler::FRAC_BITS) + 1 + resampler.lookahead();
+}
+
+
+//-------------------------------------------------
+//  reference_resample - the sound core's loops
+//  from before the resamplers were split out,
+//  with upsampling stopped at numsamples
+//-------------------------------------------------
+
+void reference_resample(stream_sample_t *dest, const stream_sample_t *source, u32 basefrac, u32 step, s64 gain, u32 numsamples)
+{
+	constexpr u32 FRAC_BITS = sound_resampler::FRAC_BITS;
+	constexpr u32 FRAC_ONE = sound_resampler::FRAC_ONE;
+	constexpr u32 FRAC_MASK = sound_resampler::FRAC_MASK;
+
+	if (step == FRAC_ONE)
+	{
+		while (numsamples--)
+			*dest++ = (s64(*source++) * gain) >> 8;
+	}
+	else if (step < FRAC_ONE)
+	{
+		while (numsamples != 0)
+		{
+			int nextfrac;
+			while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
+			{
+				*dest++ = (source[0] * gain) >> 8;
+				basefrac = nextfrac;
+			}
+			if (s32(numsamples--) <= 0)
+				break;
+			int startfrac = basefrac >> (FRAC_BITS - 12);
+			int endfrac = nextfrac >> (FRAC_BITS - 12);
+			s64 sample = (s64(source[0]) * (0x1000 - startfrac) + s64(source[1]) * (endfrac - 0x1000)) / (endfrac - startfrac);
+			*dest++ = (sample * gain) >> 8;
+			basefrac = nextfrac & FRAC_MASK;
+			source++;
+		}
+	}
+	else
+	{
+		int smallstep = step >> (FRAC_BITS - 8);
+		while (numsamples--)
+		{
+			s64 remainder = smallstep;
+			int tpos = 0;
+			s64 scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
+			s64 sample = s64(source[tpos++]) * scale;
+			remainder -= scale;
+			while (remainder > 0x100)
+			{
+				sample += s64(source[tpos++]) * s64(0x100);
+				remainder -= 0x100;
+			}
+			sample += s64(source[tpos]) * remainder;
+			sample /= smallstep;
+			*dest++ = (sample * gain) >> 8;
+			basefrac += step;
+			source += basefrac >> FRAC_BITS;
+			basefrac &= FRAC_MASK;
+		}
+	}
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("sinc resampler is only used where its kernel spans the ratio", "[emu]")
+{
+	CHECK(dynamic_cast<sinc_resampler *>(sound_resampler::create("sinc", 96000, OUTPUT_RATE).get()) != nullptr);
+	CHECK(dynamic_cast<sinc_resampler *>(sound_resampler::create("sinc", 22050, OUTPUT_RATE).get()) != nullptr);
+	CHECK(dynamic_cast<sinc_resampler *>(sound_resampler::create("sinc", 3579545, OUTPUT_RATE).get()) == nullptr);
+	CHECK(dynamic_cast<sinc_resampler *>(sound_resampler::create("sinc", OUTPUT_RATE, OUTPUT_RATE).get()) == nullptr);
+	CHECK(sound_resampler::create("linear", 96000, OUTPUT_RATE) == nullptr);
+}
+
+TEST_CASE("high ratio downsampling sees every source sample", "[emu]")
+{
+	const u32 source_rate = 3579545;
+	const u32 step = (u64(source_rate) << sound_resampler::FRAC_BITS) / OUTPUT_RATE;
+	auto created = sound_resampler::create("sinc", source_rate, OUTPUT_RATE);
+	const sound_resampler &resampler = created ? *created : sound_resampler::linear();
+
+	// an impulse anywhere away from the ends must reach the output
+	const size_t length = source_length(resampler, step);
+	const size_t first = resampler.history() + 2 * (step >> sound_resampler::FRAC_BITS);
+	for (size_t position = first; position < first + (step >> sound_resampler::FRAC_BITS) + 1; position++)
+	{
+		std::vector<stream_sample_t> source(length, 0);
+		source[position] = 0x10000;
+		bool heard = false;
+		for (stream_sample_t sample : run(resampler, source, step))
+			heard = heard || (sample != 0);
+		INFO("impulse at " << position);
+		CHECK(heard);
+	}
+}
+
+TEST_CASE("resamplers preserve a constant level", "[emu]")
+{
+	for (u32 source_rate : { 22050U, 96000U, 3579545U })
+	{
+		const u32 step = (u64(source_rate) << sound_resampler::FRAC_BITS) / OUTPUT_RATE;
+		auto created = sound_resampler::create("sinc", source_rate, OUTPUT_RATE);
+		const sound_resampler &resampler = created ? *created : sound_resampler::linear();
+		const std::vector<stream_sample_t> source(source_length(resampler, step), 1000);
+		for (stream_sample_t sample : run(resampler, source, step))
+		{
+			INFO("source rate " << source_rate);
+			CHECK(sample >= 998);
+			CHECK(sample <= 1000);
+		}
+	}
+}
+
+TEST_CASE("linear resampler matches the per-sample code it replaced", "[emu]")
+{
+	const stream_sample_t GUARD = 0x5a5a5a5a;
+	u32 seed = 1;
+	auto random = [&seed] () { seed = seed * 1103515245 + 12345; return seed >> 8; };
+
+	for (u32 source_rate : { 8000U, 22050U, 44100U, 47999U, 48000U, 48001U, 55930U, 96000U, 447443U, 3579545U })
+		for (int pass = 0; pass < 50; pass++)
+		{
+			const u32 step = (u64(source_rate) << sound_resampler::FRAC_BITS) / OUTPUT_RATE;
+			const u32 numsamples = 1 + random() % 200;
+			const u32 basefrac = random() & sound_resampler::FRAC_MASK;
+			const s64 gain = (pass == 0) ? UNITY_GAIN : (s64(random() % 0x400) - 0x80);
+			std::vector<stream_sample_t> source(((u64(step) * (numsamples + 1)) >> sound_resampler::FRAC_BITS) + 2);
+			// every so often use full scale samples, to push the blends and averages
+			// to the widest values they can take
+			for (stream_sample_t &sample : source)
+				sample = (pass % 5 == 4) ? ((random() & 1) ? 0x7fffffff : -0x7fffffff - 1) : (s32(random()) - 0x800000);
+
+			std::vector<stream_sample_t> expected(numsamples + 4, GUARD), actual(numsamples + 4, GUARD);
+			reference_resample(&expected[0], &source[0], basefrac, step, gain, numsamples);
+			linear_resampler::convert(&actual[0], &source[0], basefrac, step, gain, numsamples);
+			INFO("source rate " << source_rate << ", pass " << pass);
+			CHECK(actual == expected);
+		}
+}